@@ -0,0 +1,247 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+// --- ROOT system ---
+#include <TObjArray.h>
+#include <TLorentzVector.h>
+#include <TVector3.h>
+#include <TMath.h>
+
+// --- AliRoot system ---
+#include "AliVCluster.h"
+#include "AliVTrack.h"
+#include "AliMixedEvent.h"
+#include "AliLog.h"
+
+// --- CaloTrackCorrelations ---
+#include "AliCaloTrackParticle.h"
+#include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
+
+/// \cond CLASSIMP
+ClassImp(AliCaloTrackEtaPhiGrid) ;
+/// \endcond
+
+//____________________________________________
+/// Default constructor.
+/// Cells of 0.1x0.1 in |eta| < 1 and full phi.
+//____________________________________________
+AliCaloTrackEtaPhiGrid::AliCaloTrackEtaPhiGrid() :
+TObject(),
+fNEtaBins(0),    fEtaMin(0),      fEtaMax(0),
+fNPhiBins(0),    fEtaBinWidth(0), fPhiBinWidth(0),
+fFilled(kFALSE),
+fPt(),           fEta(),          fPhi(),
+fID(),           fHasID(),        fObject(),
+fCellOffset()
+{
+  SetBinning(20, -1., 1., 63);
+}
+
+//____________________________________________
+/// Define the cells, clears the index.
+/// \param nEta: number of eta bins.
+/// \param etaMin: lower edge of eta binning.
+/// \param etaMax: upper edge of eta binning.
+/// \param nPhi: number of phi bins in [0,2pi[.
+//____________________________________________
+void AliCaloTrackEtaPhiGrid::SetBinning(Int_t nEta, Float_t etaMin, Float_t etaMax, Int_t nPhi)
+{
+  if ( nEta < 1 || nPhi < 1 || etaMax <= etaMin )
+  {
+    AliWarning(Form("Wrong binning: nEta %d, eta [%2.2f,%2.2f], nPhi %d, keep previous",nEta,etaMin,etaMax,nPhi));
+    return;
+  }
+
+  fNEtaBins    = nEta;
+  fEtaMin      = etaMin;
+  fEtaMax      = etaMax;
+  fNPhiBins    = nPhi;
+  fEtaBinWidth = (etaMax-etaMin)/nEta;
+  fPhiBinWidth = TMath::TwoPi()/nPhi;
+
+  Clear();
+}
+
+//____________________________________________
+/// Remove all entries, to be called for each new event.
+//____________________________________________
+void AliCaloTrackEtaPhiGrid::Clear(Option_t *)
+{
+  fFilled = kFALSE;
+
+  fPt    .clear();
+  fEta   .clear();
+  fPhi   .clear();
+  fID    .clear();
+  fHasID .clear();
+  fObject.clear();
+
+  fCellOffset.assign(GetNCells()+1, 0);
+}
+
+//____________________________________________
+/// \return eta bin, objects out of range go to first/last bin.
+/// \param eta: pseudorapidity.
+//____________________________________________
+Int_t AliCaloTrackEtaPhiGrid::GetEtaBin(Float_t eta) const
+{
+  Int_t ieta = TMath::FloorNint((eta-fEtaMin)/fEtaBinWidth);
+
+  if ( ieta <  0         ) return 0;
+  if ( ieta >= fNEtaBins ) return fNEtaBins-1;
+
+  return ieta;
+}
+
+//____________________________________________
+/// \return phi bin.
+/// \param phi: azimuthal angle, in [0,2pi[.
+//____________________________________________
+Int_t AliCaloTrackEtaPhiGrid::GetPhiBin(Float_t phi) const
+{
+  Int_t iphi = TMath::FloorNint(phi/fPhiBinWidth);
+
+  if ( iphi <  0         ) return 0;
+  if ( iphi >= fNPhiBins ) return fNPhiBins-1;
+
+  return iphi;
+}
+
+//____________________________________________
+/// Fill the index with the tracks or clusters of the list.
+/// Entries are tracks (AliVTrack), clusters (AliVCluster)
+/// or mixed event particles (AliCaloTrackParticle).
+///
+/// \param list: array with tracks or clusters from the reader.
+/// \param reader: pointer to AliCaloTrackReader, for the vertex and track ID.
+//____________________________________________
+void AliCaloTrackEtaPhiGrid::Fill(TObjArray * list, AliCaloTrackReader * reader)
+{
+  Clear();
+
+  fFilled = kTRUE;
+
+  if ( !list ) return;
+
+  Int_t nEntries = list->GetEntriesFast();
+
+  // Kinematics in list order
+  //
+  std::vector<Float_t>  pt ; pt .reserve(nEntries);
+  std::vector<Float_t>  eta; eta.reserve(nEntries);
+  std::vector<Float_t>  phi; phi.reserve(nEntries);
+  std::vector<Int_t>    id ; id .reserve(nEntries);
+  std::vector<UChar_t>  hasID; hasID.reserve(nEntries);
+  std::vector<TObject*> obj; obj.reserve(nEntries);
+  std::vector<Int_t>    cell; cell.reserve(nEntries);
+
+  TLorentzVector mom;
+  TVector3       vec;
+
+  for(Int_t ipr = 0; ipr < nEntries; ipr++)
+  {
+    TObject * object = list->At(ipr);
+
+    if ( !object ) continue;
+
+    Float_t ptEntry  = 0;
+    Float_t etaEntry = 0;
+    Float_t phiEntry = 0;
+    Int_t   idEntry  = -1;
+    Bool_t  hasIDEntry = kTRUE;
+
+    AliVCluster * calo  = dynamic_cast<AliVCluster*> (object);
+    AliVTrack   * track = dynamic_cast<AliVTrack*>   (object);
+
+    if ( calo )
+    {
+      // Get the index where the cluster comes, to retrieve the corresponding vertex
+      Int_t evtIndex = 0 ;
+      if ( reader->GetMixedEvent() )
+        evtIndex = reader->GetMixedEvent()->EventIndexForCaloCluster(calo->GetID()) ;
+
+      // Assume that come from vertex in straight line
+      calo->GetMomentum(mom,reader->GetVertex(evtIndex)) ;
+
+      ptEntry  = mom.Pt()  ;
+      etaEntry = mom.Eta() ;
+      phiEntry = mom.Phi() ;
+      idEntry  = calo->GetID();
+    }
+    else if ( track )
+    {
+      vec.SetXYZ(track->Px(),track->Py(),track->Pz());
+
+      ptEntry  = vec.Pt()  ;
+      etaEntry = vec.Eta() ;
+      phiEntry = vec.Phi() ;
+      idEntry  = reader->GetTrackID(track) ;
+    }
+    else
+    {// Mixed event stored in AliCaloTrackParticles
+      AliCaloTrackParticle * mix = dynamic_cast<AliCaloTrackParticle*>(object) ;
+
+      if ( !mix )
+      {
+        AliWarning("Wrong track/calo data type, continue");
+        continue;
+      }
+
+      ptEntry  = mix->Pt()  ;
+      etaEntry = mix->Eta() ;
+      phiEntry = mix->Phi() ;
+      hasIDEntry = kFALSE;
+    }
+
+    if ( phiEntry < 0 ) phiEntry+=TMath::TwoPi();
+
+    pt   .push_back(ptEntry);
+    eta  .push_back(etaEntry);
+    phi  .push_back(phiEntry);
+    id   .push_back(idEntry);
+    hasID.push_back(hasIDEntry);
+    obj  .push_back(object);
+    cell .push_back(GetCell(GetEtaBin(etaEntry),GetPhiBin(phiEntry)));
+
+    fCellOffset[cell.back()+1]++;
+  }
+
+  // Sort by cell, keeping the list order inside each cell
+  //
+  Int_t nCells = GetNCells();
+  for(Int_t icell = 0; icell < nCells; icell++)
+    fCellOffset[icell+1] += fCellOffset[icell];
+
+  Int_t nFilled = pt.size();
+  fPt    .resize(nFilled);
+  fEta   .resize(nFilled);
+  fPhi   .resize(nFilled);
+  fID    .resize(nFilled);
+  fHasID .resize(nFilled);
+  fObject.resize(nFilled);
+
+  std::vector<Int_t> next(fCellOffset.begin(), fCellOffset.end()-1);
+  for(Int_t i = 0; i < nFilled; i++)
+  {
+    Int_t j = next[cell[i]]++;
+    fPt    [j] = pt   [i];
+    fEta   [j] = eta  [i];
+    fPhi   [j] = phi  [i];
+    fID    [j] = id   [i];
+    fHasID [j] = hasID[i];
+    fObject[j] = obj  [i];
+  }
+}
@@ -0,0 +1,104 @@
+#ifndef ALICALOTRACKETAPHIGRID_H
+#define ALICALOTRACKETAPHIGRID_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+//_________________________________________________________________________
+/// \class AliCaloTrackEtaPhiGrid
+/// \ingroup CaloTrackCorrelationsBase
+/// \brief (eta, phi) binned index of the tracks or clusters of an event
+///
+/// Kinematics (pT, eta, phi in [0,2pi[) and identifiers of the objects of one
+/// of the reader lists (CTS tracks, EMCal or PHOS clusters) are stored in flat
+/// arrays, sorted by (eta, phi) cell. All objects of a cell are found between
+/// GetCellFirst() and GetCellLast(), so that cone or band sums only need to visit
+/// the cells close to the candidate. Objects outside the eta range are kept in
+/// the first/last eta bin.
+///
+/// Cluster momenta are calculated as in AliIsolationCut, assuming that the
+/// cluster comes from the vertex of its event. The index is filled on demand
+/// by AliCaloTrackReader, see AliCaloTrackReader::GetCTSTracksGrid().
+//_________________________________________________________________________
+
+// --- ROOT system ---
+#include <TObject.h>
+#include <vector>
+class TObjArray ;
+
+// --- ANALYSIS system ---
+class AliCaloTrackReader ;
+
+class AliCaloTrackEtaPhiGrid : public TObject {
+
+ public:
+
+  AliCaloTrackEtaPhiGrid() ;
+
+  /// Virtual destructor.
+  virtual ~AliCaloTrackEtaPhiGrid() { ; }
+
+  void       SetBinning(Int_t nEta, Float_t etaMin, Float_t etaMax, Int_t nPhi) ;
+
+  void       Fill(TObjArray * list, AliCaloTrackReader * reader) ;
+
+  void       Clear(Option_t * opt = "") ;
+
+  Bool_t     IsFilled()                   const { return fFilled                 ; }
+  Int_t      GetNEntries()                const { return fPt.size()              ; }
+
+  Int_t      GetNEtaBins()                const { return fNEtaBins               ; }
+  Int_t      GetNPhiBins()                const { return fNPhiBins               ; }
+  Int_t      GetNCells()                  const { return fNEtaBins*fNPhiBins     ; }
+  Int_t      GetEtaBin(Float_t eta)       const ;
+  Int_t      GetPhiBin(Float_t phi)       const ;
+  Int_t      GetCell(Int_t ieta, Int_t iphi) const { return ieta*fNPhiBins+iphi  ; }
+  Float_t    GetEtaBinWidth()             const { return fEtaBinWidth            ; }
+  Float_t    GetPhiBinWidth()             const { return fPhiBinWidth            ; }
+
+  /// \return first entry of cell icell.
+  Int_t      GetCellFirst(Int_t icell)    const { return fCellOffset[icell]      ; }
+  /// \return last entry +1 of cell icell.
+  Int_t      GetCellLast (Int_t icell)    const { return fCellOffset[icell+1]    ; }
+
+  Float_t    GetPt   (Int_t i)            const { return fPt[i]                  ; }
+  Float_t    GetEta  (Int_t i)            const { return fEta[i]                 ; }
+  Float_t    GetPhi  (Int_t i)            const { return fPhi[i]                 ; }
+  /// \return cluster ID or track ID (AliCaloTrackReader::GetTrackID), only if HasID().
+  Int_t      GetID   (Int_t i)            const { return fID[i]                  ; }
+  /// \return kFALSE for mixed event entries (AliCaloTrackParticle).
+  Bool_t     HasID   (Int_t i)            const { return fHasID[i]               ; }
+  /// \return the track or cluster object in the reader list.
+  TObject *  GetObject(Int_t i)           const { return fObject[i]              ; }
+
+ private:
+
+  Int_t      fNEtaBins ;                ///< Number of eta bins.
+  Float_t    fEtaMin ;                  ///< Lower edge of eta binning.
+  Float_t    fEtaMax ;                  ///< Upper edge of eta binning.
+  Int_t      fNPhiBins ;                ///< Number of phi bins in [0,2pi[.
+  Float_t    fEtaBinWidth ;             ///< Eta bin width.
+  Float_t    fPhiBinWidth ;             ///< Phi bin width.
+
+  Bool_t     fFilled ;                  //!<! Index filled for the current event.
+
+  std::vector<Float_t>   fPt ;          //!<! pT of the entries, sorted by cell.
+  std::vector<Float_t>   fEta ;         //!<! eta of the entries, sorted by cell.
+  std::vector<Float_t>   fPhi ;         //!<! phi of the entries, sorted by cell.
+  std::vector<Int_t>     fID ;          //!<! Track or cluster ID of the entries.
+  std::vector<UChar_t>   fHasID ;       //!<! Entry has an ID.
+  std::vector<TObject*>  fObject ;      //!<! Track or cluster of the entries.
+  std::vector<Int_t>     fCellOffset ;  //!<! First entry of each cell, GetNCells()+1 values.
+
+  /// Copy constructor not implemented.
+  AliCaloTrackEtaPhiGrid(              const AliCaloTrackEtaPhiGrid & g) ;
+
+  /// Assignment operator not implemented.
+  AliCaloTrackEtaPhiGrid & operator = (const AliCaloTrackEtaPhiGrid & g) ;
+
+  /// \cond CLASSIMP
+  ClassDef(AliCaloTrackEtaPhiGrid,1) ;
+  /// \endcond
+
+} ;
+
+#endif //ALICALOTRACKETAPHIGRID_H
@@ -47,6 +47,7 @@
 // ---- CaloTrackCorr ---
 #include "AliCalorimeterUtils.h"
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 #include "AliMCAnalysisUtils.h"
 
 // ---- Jets ----
@@ -84,6 +85,9 @@ fAODBranchList(0x0),
 fCTSTracks(0x0),             fEMCALClusters(0x0),
 fDCALClusters(0x0),          fPHOSClusters(0x0),
 fEMCALCells(0x0),            fPHOSCells(0x0),
+fCTSTracksGrid(0x0),         fEMCALClustersGrid(0x0),         fPHOSClustersGrid(0x0),
+fEtaPhiGridNEtaBins(20),     fEtaPhiGridEtaMin(-1.),          fEtaPhiGridEtaMax(1.),
+fEtaPhiGridNPhiBins(63),
 fInputEvent(0x0),            fOutputEvent(0x0),               fMC(0x0),
 fSelectEmbeddedClusters(kFALSE),
 fFillCTS(0),                 fFillEMCAL(0),
@@ -244,6 +248,10 @@ void AliCaloTrackReader::DeletePointers()
     delete fPHOSClusters ;
   }
   
+  delete fCTSTracksGrid ;
+  delete fEMCALClustersGrid ;
+  delete fPHOSClustersGrid ;
+  
   if(fVertex)
   {
     for (Int_t i = 0; i < fNMixedEvent; i++)
@@ -4480,6 +4488,10 @@ void AliCaloTrackReader::ResetLists()
   if(fEMCALClusters)   fEMCALClusters -> Clear("C");
   if(fPHOSClusters)    fPHOSClusters  -> Clear("C");
   
+  if(fCTSTracksGrid)     fCTSTracksGrid     -> Clear();
+  if(fEMCALClustersGrid) fEMCALClustersGrid -> Clear();
+  if(fPHOSClustersGrid)  fPHOSClustersGrid  -> Clear();
+  
   fV0ADC[0] = 0;   fV0ADC[1] = 0;
   fV0Mul[0] = 0;   fV0Mul[1] = 0;
   
@@ -4488,6 +4500,26 @@ void AliCaloTrackReader::ResetLists()
   //fBackgroundJets->Reset();
 }
 
+//___________________________________________
+/// \return (eta,phi) binned index of one of the arrays
+/// of tracks or clusters, created at first call and filled
+/// at first call in the event.
+/// \param grid: index of the array.
+/// \param list: array of tracks or clusters.
+//___________________________________________
+AliCaloTrackEtaPhiGrid * AliCaloTrackReader::GetEtaPhiGrid(AliCaloTrackEtaPhiGrid *& grid, TObjArray * list)
+{
+  if ( !grid )
+  {
+    grid = new AliCaloTrackEtaPhiGrid();
+    grid->SetBinning(fEtaPhiGridNEtaBins, fEtaPhiGridEtaMin, fEtaPhiGridEtaMax, fEtaPhiGridNPhiBins);
+  }
+  
+  if ( !grid->IsFilled() ) grid->Fill(list, this);
+  
+  return grid;
+}
+
 //___________________________________________
 /// Tag event depending on trigger name.
 /// Set also the L1 bit defining the EGA or EJE triggers.
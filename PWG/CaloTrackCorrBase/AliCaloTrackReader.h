@@ -55,6 +55,7 @@ class AliVCluster;
 // --- CaloTrackCorr / EMCAL ---
 #include "AliFiducialCut.h"
 class AliCalorimeterUtils;
+class AliCaloTrackEtaPhiGrid;
 #include "AliAnaWeights.h"
 #include "AliMCAnalysisUtils.h"
 
@@ -351,6 +352,15 @@ public:
   virtual AliVCaloCells* GetEMCALCells()             const { return fEMCALCells             ; }
   virtual AliVCaloCells* GetPHOSCells()              const { return fPHOSCells              ; }
   
+  // (eta,phi) binned index of the arrays, filled on first access in the event
+  
+  AliCaloTrackEtaPhiGrid * GetCTSTracksGrid()              { return GetEtaPhiGrid(fCTSTracksGrid    , fCTSTracks    ) ; }
+  AliCaloTrackEtaPhiGrid * GetEMCALClustersGrid()          { return GetEtaPhiGrid(fEMCALClustersGrid, fEMCALClusters) ; }
+  AliCaloTrackEtaPhiGrid * GetPHOSClustersGrid()           { return GetEtaPhiGrid(fPHOSClustersGrid , fPHOSClusters ) ; }
+  
+  void             SetEtaPhiGridBinning(Int_t nEta, Float_t etaMin, Float_t etaMax, Int_t nPhi)
+                   { fEtaPhiGridNEtaBins = nEta ; fEtaPhiGridEtaMin = etaMin ; fEtaPhiGridEtaMax = etaMax ; fEtaPhiGridNPhiBins = nPhi ; }
+  
   //-------------------------------------
   // Event/track selection methods
   //-------------------------------------
@@ -975,6 +985,16 @@ public:
   AliVCaloCells  * fEMCALCells ;                   //!<! Temporal array with EMCAL AliVCaloCells.
   AliVCaloCells  * fPHOSCells ;                    //!<! Temporal array with PHOS  AliVCaloCells.
 
+  AliCaloTrackEtaPhiGrid * GetEtaPhiGrid(AliCaloTrackEtaPhiGrid *& grid, TObjArray * list) ;
+  
+  AliCaloTrackEtaPhiGrid * fCTSTracksGrid ;        //!<! (eta,phi) index of fCTSTracks.
+  AliCaloTrackEtaPhiGrid * fEMCALClustersGrid ;    //!<! (eta,phi) index of fEMCALClusters.
+  AliCaloTrackEtaPhiGrid * fPHOSClustersGrid ;     //!<! (eta,phi) index of fPHOSClusters.
+  Int_t            fEtaPhiGridNEtaBins;            ///<  Number of eta bins of the (eta,phi) index.
+  Float_t          fEtaPhiGridEtaMin;              ///<  Lower eta edge of the (eta,phi) index.
+  Float_t          fEtaPhiGridEtaMax;              ///<  Upper eta edge of the (eta,phi) index.
+  Int_t            fEtaPhiGridNPhiBins;            ///<  Number of phi bins of the (eta,phi) index.
+
   AliVEvent      * fInputEvent;                    //!<! pointer to esd or aod input.
   AliAODEvent    * fOutputEvent;                   //!<! pointer to aod output.
   AliMCEvent     * fMC;                            //!<! Monte Carlo Event Handler.  
@@ -1249,7 +1269,7 @@ public:
   AliCaloTrackReader & operator = (const AliCaloTrackReader & r) ; 
   
   /// \cond CLASSIMP
-  ClassDef(AliCaloTrackReader,95) ;
+  ClassDef(AliCaloTrackReader,96) ;
   /// \endcond
 
 } ;
@@ -29,6 +29,7 @@
 
 // --- CaloTrackCorrelations --- 
 #include "AliCaloTrackReader.h"
+#include "AliCaloTrackEtaPhiGrid.h"
 #include "AliCalorimeterUtils.h"
 #include "AliCaloPID.h"
 #include "AliFiducialCut.h"
@@ -56,6 +57,7 @@ fFracIsThresh(1),    fIsTMClusterInConeRejected(1), fDistMinToTrigger(-1.),
 fDebug(0),           fMomentum(),                   fTrackVector(),
 fEMCEtaSize(-1),     fEMCPhiMin(-1),                fEMCPhiMax(-1),
 fTPCEtaSize(-1),     fTPCPhiSize(-1),
+fGridCellMask(),
 // Histograms
 fHistoRanges(0),                            fNCentBins(0),
 fhPtInCone(0),       
@@ -960,6 +962,247 @@ void AliIsolationCut::CalculateTrackSignalInCone
   if ( bFillAOD && reftracks ) pCandidate->AddObjArray(reftracks);  
 }
 
+//_________________________________________________________________________________________________________________________________
+/// Get the pt sum and number of tracks or clusters inside a set of cones and UE regions
+/// around the candidate, for a set of pT thresholds, in one pass.
+/// Only the cells of the reader (eta,phi) index close to the candidate are visited,
+/// see AliCaloTrackEtaPhiGrid. Particles are selected as in CalculateCaloSignalInCone()
+/// and CalculateTrackSignalInCone(), no histogram is filled.
+/// All output arrays have nCones*nPtThres entries, index icone*nPtThres+ithres,
+/// and only particles with pT > ptThres[ithres] are considered for that entry.
+/// Output arrays can be null if not needed, the corresponding cells are then not visited.
+///
+/// \param pCandidate: Kinematics and + of candidate particle for isolation.
+/// \param reader: pointer to AliCaloTrackReader. Needed to access event info.
+/// \param detector: AliFiducialCut::kCTS for tracks, kEMCAL or kPHOS for clusters.
+/// \param pid: pointer to AliCaloPID, for the cluster-track matching rejection.
+/// \param nCones: number of cone sizes.
+/// \param coneSizes: cone sizes, the UE bands are at each size plus fConeSizeBandGap.
+/// \param nPtThres: number of pT thresholds.
+/// \param ptThres: pT thresholds.
+/// \param coneptsum: pT sum in cone, output.
+/// \param nPart: number of particles in cone with pT below fPtThresholdMax, output.
+/// \param etaBandPtSum: pT sum in eta band, same phi as candidate, output.
+/// \param phiBandPtSum: pT sum in phi band, same eta as candidate, output.
+/// \param perpConePtSum: pT sum in the two perpendicular cones, not divided by 2, output.
+/// \param nPartEtaBand: number of particles in eta band, output.
+/// \param nPartPhiBand: number of particles in phi band, output.
+/// \param nPartPerpCone: number of particles in the two perpendicular cones, not divided by 2, output.
+//_________________________________________________________________________________________________________________________________
+void AliIsolationCut::CalculateSignalInCones
+(
+ AliCaloTrackParticleCorrelation * pCandidate, AliCaloTrackReader * reader,
+ Int_t     detector     , AliCaloPID * pid,
+ Int_t     nCones       , const Float_t * coneSizes,
+ Int_t     nPtThres     , const Float_t * ptThres,
+ Float_t * coneptsum    , Int_t   * nPart,
+ Float_t * etaBandPtSum , Float_t * phiBandPtSum,
+ Float_t * perpConePtSum,
+ Int_t   * nPartEtaBand , Int_t   * nPartPhiBand,
+ Int_t   * nPartPerpCone
+)
+{
+  Int_t nOut = nCones*nPtThres;
+  
+  for(Int_t i = 0; i < nOut; i++)
+  {
+    if ( coneptsum     ) coneptsum    [i] = 0;
+    if ( nPart         ) nPart        [i] = 0;
+    if ( etaBandPtSum  ) etaBandPtSum [i] = 0;
+    if ( phiBandPtSum  ) phiBandPtSum [i] = 0;
+    if ( perpConePtSum ) perpConePtSum[i] = 0;
+    if ( nPartEtaBand  ) nPartEtaBand [i] = 0;
+    if ( nPartPhiBand  ) nPartPhiBand [i] = 0;
+    if ( nPartPerpCone ) nPartPerpCone[i] = 0;
+  }
+  
+  if ( nOut <= 0 ) return ;
+  
+  // Get the index of tracks or clusters
+  //
+  AliCaloTrackEtaPhiGrid * grid = 0x0;
+  if      ( detector == AliFiducialCut::kCTS   ) grid = reader->GetCTSTracksGrid();
+  else if ( detector == AliFiducialCut::kEMCAL ) grid = reader->GetEMCALClustersGrid();
+  else if ( detector == AliFiducialCut::kPHOS  ) grid = reader->GetPHOSClustersGrid();
+  
+  if ( !grid )
+  {
+    AliWarning(Form("No (eta,phi) index for detector %d",detector));
+    return ;
+  }
+  
+  Bool_t isCluster = ( detector != AliFiducialCut::kCTS );
+  
+  // Init parameters
+  //
+  Float_t phiC  = pCandidate->Phi() ;
+  if ( phiC < 0 ) phiC+=TMath::TwoPi();
+  Float_t etaC  = pCandidate->Eta() ;
+  
+  Float_t maxCone = 0;
+  for(Int_t icone = 0; icone < nCones; icone++)
+    maxCone = TMath::Max(maxCone, coneSizes[icone]);
+  Float_t maxBand = maxCone+fConeSizeBandGap;
+  
+  // Cells which can contribute to the requested regions
+  //
+  fGridCellMask.assign(grid->GetNCells(), 0);
+  
+  if ( coneptsum     || nPart         ) MarkGridCells(grid, etaC, phiC, maxCone, maxCone);
+  if ( phiBandPtSum  || nPartPhiBand  ) MarkGridCells(grid, etaC, phiC, maxBand, TMath::PiOver2());
+  if ( etaBandPtSum  || nPartEtaBand  ) MarkGridCells(grid, etaC, phiC, -1     , maxBand);
+  if ( perpConePtSum || nPartPerpCone )
+  {
+    MarkGridCells(grid, etaC, phiC+TMath::PiOver2(), maxCone, maxCone);
+    MarkGridCells(grid, etaC, phiC-TMath::PiOver2(), maxCone, maxCone);
+  }
+  
+  Bool_t rejectMatched = ( isCluster && pid && fIsTMClusterInConeRejected && fPartInCone == kNeutralAndCharged );
+  
+  Int_t nCells = grid->GetNCells();
+  for(Int_t icell = 0; icell < nCells; icell++)
+  {
+    if ( !fGridCellMask[icell] ) continue ;
+    
+    for(Int_t ipr = grid->GetCellFirst(icell); ipr < grid->GetCellLast(icell); ipr++)
+    {
+      // Do not count the candidate or its daughters
+      if ( grid->HasID(ipr) )
+      {
+        Int_t id = grid->GetID(ipr);
+        
+        if ( isCluster )
+        {
+          if ( id == pCandidate->GetCaloLabel(0) || id == pCandidate->GetCaloLabel(1) ) continue ;
+        }
+        else if ( pCandidate->GetDetectorTag() == AliFiducialCut::kCTS )
+        {
+          Bool_t contained = kFALSE;
+          for(Int_t i = 0; i < 4; i++)
+          {
+            if ( id == pCandidate->GetTrackLabel(i) ) contained = kTRUE;
+          }
+          
+          if ( contained ) continue ;
+        }
+      }
+      
+      Float_t pt  = grid->GetPt (ipr);
+      Float_t eta = grid->GetEta(ipr);
+      Float_t phi = grid->GetPhi(ipr);
+      
+      Float_t rad = Radius(etaC, phiC, eta, phi);
+      
+      // Exclude particles too close to the candidate, inactive by default
+      if ( rad < fDistMinToTrigger ) continue ;
+      
+      // Skip matched clusters with tracks in case of neutral+charged analysis
+      if ( rejectMatched && grid->HasID(ipr) )
+      {
+        AliVCluster * calo = dynamic_cast<AliVCluster*>(grid->GetObject(ipr));
+        Bool_t bRes = kFALSE, bEoP = kFALSE;
+        if ( calo && pid->IsTrackMatched(calo, reader->GetCaloUtils(), reader->GetInputEvent(), bEoP, bRes) ) continue ;
+      }
+      
+      // Angles between trigger and particle
+      Double_t dEta = etaC - eta;
+      Double_t dPhi = phiC - phi;
+      
+      // Shift phi angle when trigger is close to 0 or 360
+      if ( dPhi >=  TMath::Pi() ) dPhi-=TMath::TwoPi();
+      if ( dPhi <= -TMath::Pi() ) dPhi+=TMath::TwoPi();
+      
+      Double_t radPerpPlu = TMath::Sqrt((dPhi+TMath::PiOver2())*(dPhi+TMath::PiOver2()) + dEta*dEta);
+      Double_t radPerpMin = TMath::Sqrt((dPhi-TMath::PiOver2())*(dPhi-TMath::PiOver2()) + dEta*dEta);
+      
+      for(Int_t icone = 0; icone < nCones; icone++)
+      {
+        Float_t coneSize = coneSizes[icone];
+        Float_t bandSize = coneSize+fConeSizeBandGap;
+        
+        Bool_t inCone    = ( rad <= coneSize );
+        Bool_t outBand   = ( rad >  bandSize );
+        Bool_t inPhiBand = ( outBand && TMath::Abs(dPhi) <= TMath::PiOver2() && TMath::Abs(dEta) < bandSize );
+        Bool_t inEtaBand = ( outBand && TMath::Abs(dPhi) <  bandSize );
+        Bool_t inPerp    = ( radPerpPlu < coneSize || radPerpMin < coneSize );
+        
+        if ( !inCone && !inPhiBand && !inEtaBand && !inPerp ) continue ;
+        
+        for(Int_t ithres = 0; ithres < nPtThres; ithres++)
+        {
+          if ( pt <= ptThres[ithres] ) continue ;
+          
+          Int_t index = icone*nPtThres+ithres;
+          
+          if ( inCone )
+          {
+            if ( coneptsum ) coneptsum[index] += pt;
+            if ( nPart && pt < fPtThresholdMax ) nPart[index]++;
+          }
+          
+          if ( inPhiBand )
+          {
+            if ( phiBandPtSum ) phiBandPtSum[index] += pt;
+            if ( nPartPhiBand ) nPartPhiBand[index]++;
+          }
+          
+          if ( inEtaBand )
+          {
+            if ( etaBandPtSum ) etaBandPtSum[index] += pt;
+            if ( nPartEtaBand ) nPartEtaBand[index]++;
+          }
+          
+          if ( inPerp )
+          {
+            if ( perpConePtSum ) perpConePtSum[index] += pt;
+            if ( nPartPerpCone ) nPartPerpCone[index]++;
+          }
+        } // pT thresholds
+      } // cones
+    } // particles in cell
+  } // cells
+}
+
+//_________________________________________________________________________________________________________________________________
+/// Flag the cells of the (eta,phi) index overlapping with a window around a direction.
+/// A small margin is added, so that no particle at the window edge is lost by rounding.
+/// \param grid: (eta,phi) index.
+/// \param etaC: pseudorapidity of the window center.
+/// \param phiC: azimuthal angle of the window center.
+/// \param dEta: half width of the window in eta, full eta range if negative.
+/// \param dPhi: half width of the window in phi.
+//_________________________________________________________________________________________________________________________________
+void AliIsolationCut::MarkGridCells(const AliCaloTrackEtaPhiGrid * grid, Float_t etaC, Float_t phiC, Float_t dEta, Float_t dPhi)
+{
+  const Float_t margin = 1.e-3;
+  
+  Int_t etaFirst = 0;
+  Int_t etaLast  = grid->GetNEtaBins()-1;
+  if ( dEta >= 0 )
+  {
+    etaFirst = grid->GetEtaBin(etaC-dEta-margin);
+    etaLast  = grid->GetEtaBin(etaC+dEta+margin);
+  }
+  
+  Int_t nPhi     = grid->GetNPhiBins();
+  Int_t phiFirst = TMath::FloorNint((phiC-dPhi-margin)/grid->GetPhiBinWidth());
+  Int_t phiLast  = TMath::FloorNint((phiC+dPhi+margin)/grid->GetPhiBinWidth());
+  if ( phiLast-phiFirst >= nPhi-1 )
+  {
+    phiFirst = 0;
+    phiLast  = nPhi-1;
+  }
+  
+  for(Int_t ieta = etaFirst; ieta <= etaLast; ieta++)
+  {
+    for(Int_t k = phiFirst; k <= phiLast; k++)
+    {
+      Int_t iphi = ((k % nPhi) + nPhi) % nPhi;
+      fGridCellMask[grid->GetCell(ieta,iphi)] = 1;
+    }
+  }
+}
+
 //_________________________________________________________________________________________________________________________________
 /// Get normalization of cluster background band.
 //_________________________________________________________________________________________________________________________________
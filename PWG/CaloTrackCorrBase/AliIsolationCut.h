@@ -24,10 +24,12 @@ class TObjArray ;
 class TList ;
 class TH3F ;
 #include <TLorentzVector.h>
+#include <vector>
 
 // --- ANALYSIS system ---
 class AliCaloTrackParticleCorrelation ;
 class AliCaloTrackReader ;
+class AliCaloTrackEtaPhiGrid ;
 class AliCaloPID ;
 class AliHistogramRanges ;
 
@@ -103,6 +105,16 @@ class AliIsolationCut : public TObject {
                                         Double_t  histoWeight=1,
                                         Float_t centrality = -1, Int_t cenBin = -1) ;
   
+  void       CalculateSignalInCones    (AliCaloTrackParticleCorrelation * pCandidate, AliCaloTrackReader * reader,
+                                        Int_t     detector    , AliCaloPID * pid,
+                                        Int_t     nCones      , const Float_t * coneSizes,
+                                        Int_t     nPtThres    , const Float_t * ptThres,
+                                        Float_t * coneptsum   , Int_t   * nPart,
+                                        Float_t * etaBandPtSum, Float_t * phiBandPtSum,
+                                        Float_t * perpConePtSum = 0x0,
+                                        Int_t   * nPartEtaBand  = 0x0, Int_t * nPartPhiBand = 0x0,
+                                        Int_t   * nPartPerpCone = 0x0) ;
+  
   // Cone background studies medthods
 
   void       GetDetectorAngleLimits( AliCaloTrackReader * reader, Int_t calorimeter );
@@ -256,6 +268,10 @@ class AliIsolationCut : public TObject {
   Float_t    fTPCEtaSize;                              ///< Eta size of TPC
   Float_t    fTPCPhiSize;                              ///< Phi size of TPC, it is 360 degrees, but here set to half.
   
+  std::vector<UChar_t> fGridCellMask;                  //!<! Cells of the (eta,phi) index to visit in CalculateSignalInCones(), temporal.
+  
+  void       MarkGridCells(const AliCaloTrackEtaPhiGrid * grid, Float_t etaC, Float_t phiC, Float_t dEta, Float_t dPhi) ;
+  
   // Histograms
   
   AliHistogramRanges * fHistoRanges;                   ///!  Histogram bins and ranges  data-base
@@ -423,7 +439,7 @@ class AliIsolationCut : public TObject {
   AliIsolationCut & operator = (const AliIsolationCut & g) ; 
 
   /// \cond CLASSIMP
-  ClassDef(AliIsolationCut,20) ;
+  ClassDef(AliIsolationCut,21) ;
   /// \endcond
 
 } ;
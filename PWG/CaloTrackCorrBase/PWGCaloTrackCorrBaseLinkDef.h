@@ -13,6 +13,7 @@
 #pragma link C++ class AliCaloTrackParticle+;
 #pragma link C++ class AliCaloTrackParticleCorrelation+;
 #pragma link C++ class AliCaloTrackReader+;
+#pragma link C++ class AliCaloTrackEtaPhiGrid+;
 #pragma link C++ class AliCaloTrackESDReader+;
 #pragma link C++ class AliCaloTrackAODReader+;
 #pragma link C++ class AliCaloTrackMCReader+;
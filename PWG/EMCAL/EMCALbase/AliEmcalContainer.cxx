@@ -24,6 +24,7 @@
  * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
  ************************************************************************************/
+#include <TBufferFile.h>
 #include <TClonesArray.h>
 #include "AliVEvent.h"
 #include "AliLog.h"
@@ -56,10 +57,12 @@ AliEmcalContainer::AliEmcalContainer():
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
   fIsEmbedding(kFALSE),
+  fShareAcceptance(kFALSE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fAcceptanceConfig(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -86,10 +89,12 @@ AliEmcalContainer::AliEmcalContainer(const char *name):
   fMaxMCLabel(-1),
   fMassHypothesis(-1),
   fIsEmbedding(kFALSE),
+  fShareAcceptance(kFALSE),
   fClArray(0),
   fCurrentID(0),
   fLabelMap(0),
   fLoadedClass(0),
+  fAcceptanceConfig(),
   fClassName()
 {
   fVertex[0] = 0;
@@ -155,6 +160,8 @@ void AliEmcalContainer::SetArray(const AliVEvent *event)
   }
 
   fLabelMap = dynamic_cast<AliNamedArrayI*>(event->FindListObject(fClArrayName + "_Map"));
+
+  if (fShareAcceptance) UpdateAcceptanceConfig();
 }
 
 void AliEmcalContainer::NextEvent(const AliVEvent * event)
@@ -165,9 +172,47 @@ void AliEmcalContainer::NextEvent(const AliVEvent * event)
   if (!event) return;
 
   GetVertexFromEvent(event);
+
+  // the key is built in SetArray(), here only if it was invalidated since then
+  if (fShareAcceptance && fAcceptanceConfig.empty()) UpdateAcceptanceConfig();
+}
+
+void AliEmcalContainer::UpdateAcceptanceConfig()
+{
+  // The name of the container is only a label and does not enter the selection
+  TString name(fName);
+  fName = "";
+  TBufferFile buffer(TBuffer::kWrite);
+  Streamer(buffer);
+  fName = name;
+
+  fAcceptanceConfig = IsA()->GetName();
+  fAcceptanceConfig.append(buffer.Buffer(), buffer.Length());
+}
+
+const AliEmcalContainerAcceptanceCache::AcceptanceEntry *AliEmcalContainer::GetSharedAcceptance() const
+{
+  if (!fShareAcceptance || !fClArray || fAcceptanceConfig.empty()) return NULL;
+
+  AliEmcalContainerAcceptanceCache &cache = AliEmcalContainerAcceptanceCache::Instance();
+  AliEmcalContainerAcceptanceCache::AcceptanceEntry *entry = cache.FindEntry(fClArray, fAcceptanceConfig);
+  if (entry) return entry;
+
+  entry = &(cache.CreateEntry(fClArray, fAcceptanceConfig));
+  for(int index = 0; index < GetNEntries(); index++){
+    UInt_t rejectionReason = 0;
+    if(!AcceptObject(index, rejectionReason)) continue;
+    entry->fIndices.push_back(index);
+    entry->fMomenta.push_back(AliTLorentzVector());
+    GetMomentum(entry->fMomenta.back(), index);
+  }
+  return entry;
 }
 
 Int_t AliEmcalContainer::GetNAcceptEntries() const{
+  const AliEmcalContainerAcceptanceCache::AcceptanceEntry *shared = GetSharedAcceptance();
+  if (shared) return shared->fIndices.size();
+
   Int_t result = 0;
   for(int index = 0; index < GetNEntries(); index++){
     UInt_t rejectionReason = 0;
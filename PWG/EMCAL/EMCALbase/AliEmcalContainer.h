@@ -37,9 +37,13 @@ class AliVEvent;
 class AliNamedArrayI;
 class AliVParticle;
 
+#include <string>
+
 #include <TNamed.h>
 #include <TClonesArray.h>
 
+#include "AliEmcalContainerAcceptanceCache.h"
+
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_object<TObject> > AliEmcalIterableContainer;
 typedef EMCALIterableContainer::AliEmcalIterableContainerT<TObject, EMCALIterableContainer::operator_star_pair<TObject> > AliEmcalIterableMomentumContainer;
@@ -289,6 +293,37 @@ class AliEmcalContainer : public TObject {
    */
   Bool_t                      GetIsEmbedding() const                    { return fIsEmbedding; }
 
+  /**
+   * @brief Share the selection result with identically configured containers
+   *
+   * If enabled, the accepted indices and the momentum vectors of the accepted objects are
+   * evaluated once per event and stored in the AliEmcalContainerAcceptanceCache, where they
+   * are found by all containers with the same configuration connected to the same array
+   * (for example the same track container in different tasks of a train). The configuration
+   * is serialized once, when connecting to the array (SetArray). If cuts are changed afterwards,
+   * InvalidateAcceptanceConfig() must be called so that the key is rebuilt at the next event.
+   * @param[in] b If true the selection result is shared
+   */
+  void                        SetShareAcceptance(Bool_t b)              { fShareAcceptance = b; fAcceptanceConfig.clear(); }
+  /**
+   * @brief Force rebuilding the acceptance cache key at the next event, to be called
+   * when cuts are changed after the container is connected to the array (see SetShareAcceptance)
+   */
+  void                        InvalidateAcceptanceConfig()              { fAcceptanceConfig.clear(); }
+
+  /**
+   * @brief Get acceptance sharing status
+   * @return True if the selection result is shared with identically configured containers
+   */
+  Bool_t                      GetShareAcceptance() const                { return fShareAcceptance; }
+
+  /**
+   * @brief Get the selection result from the acceptance cache, evaluating the selection
+   * if it is not yet available for the current event.
+   * @return Shared selection result (NULL if sharing is disabled)
+   */
+  const AliEmcalContainerAcceptanceCache::AcceptanceEntry *GetSharedAcceptance() const;
+
   const char*                 GetName()                       const { return fName.Data()               ; }
 
   /**
@@ -372,6 +407,12 @@ class AliEmcalContainer : public TObject {
    */
   void                        GetVertexFromEvent(const AliVEvent * event);
 
+  /**
+   * @brief Serialize the persistent configuration of the container, used
+   * as key in the acceptance cache (see SetShareAcceptance).
+   */
+  void                        UpdateAcceptanceConfig();
+
   TString                     fName;                    ///< object name
   TString                     fClArrayName;             ///< name of branch
   TString                     fBaseClassName;           ///< name of the base class that this container can handle
@@ -389,11 +430,13 @@ class AliEmcalContainer : public TObject {
   Int_t                       fMaxMCLabel;              ///< maximum MC label
   Double_t                    fMassHypothesis;          ///< if < 0 it will use a PID mass when available
   Bool_t                      fIsEmbedding;             ///< if true, this container will connect to an external event
+  Bool_t                      fShareAcceptance;         ///< if true, the selection result is shared with identically configured containers
   TClonesArray               *fClArray;                 //!<! Pointer to array in input event
   Int_t                       fCurrentID;               //!<! current ID for automatic loops
   AliNamedArrayI             *fLabelMap;                //!<! Label-Index map
   Double_t                    fVertex[3];               //!<! event vertex array
   TClass                     *fLoadedClass;             //!<! Class of the objects contained in the TClonesArray
+  std::string                 fAcceptanceConfig;        //!<! Serialized configuration, key in the acceptance cache
 
  private:
   TString                     fClassName;               ///< name of the class in the TClonesArray
@@ -401,6 +444,6 @@ class AliEmcalContainer : public TObject {
   AliEmcalContainer(const AliEmcalContainer& obj); // copy constructor
   AliEmcalContainer& operator=(const AliEmcalContainer& other); // assignment
 
-  ClassDef(AliEmcalContainer,9);
+  ClassDef(AliEmcalContainer,10);
 };
 #endif
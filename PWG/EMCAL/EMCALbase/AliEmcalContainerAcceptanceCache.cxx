@@ -0,0 +1,137 @@
+/************************************************************************************
+ * Copyright (C) 2016, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <TClonesArray.h>
+#include <TTree.h>
+
+#include "AliAnalysisManager.h"
+
+#include "AliEmcalContainerAcceptanceCache.h"
+
+ClassImp(AliEmcalContainerAcceptanceCache);
+
+AliEmcalContainerAcceptanceCache::AliEmcalContainerAcceptanceCache():
+  TObject(),
+  fTreeNumber(-1),
+  fEventStamp(-1),
+  fNextGeneration(1),
+  fFirstGeneration(1),
+  fEntries()
+{
+}
+
+/**
+ * Access to the process-wide cache instance shared by all containers.
+ * @return Cache instance
+ */
+AliEmcalContainerAcceptanceCache &AliEmcalContainerAcceptanceCache::Instance()
+{
+  static AliEmcalContainerAcceptanceCache gCache;
+  return gCache;
+}
+
+/**
+ * Get the event currently processed by the analysis manager, used to determine
+ * whether the content of the cache belongs to the current event. The entry number
+ * restarts with every tree of the input chain, therefore the event is identified
+ * by the tree number together with the entry.
+ * @param[out] treeNumber Number of the current tree in the input chain (-1 if not available)
+ * @param[out] entry Current entry in the tree (-1 if no analysis manager is available)
+ */
+void AliEmcalContainerAcceptanceCache::GetCurrentEventId(Int_t &treeNumber, Long64_t &entry)
+{
+  treeNumber = -1;
+  entry = -1;
+  AliAnalysisManager *mgr = AliAnalysisManager::GetAnalysisManager();
+  if (!mgr) return;
+  TTree *tree = mgr->GetTree();
+  treeNumber = tree ? tree->GetTreeNumber() : -1;
+  entry = mgr->GetCurrentEntry();
+}
+
+/**
+ * Clear the cache in case the analysis manager moved to the next event.
+ */
+void AliEmcalContainerAcceptanceCache::CheckEvent()
+{
+  Int_t treeNumber = -1;
+  Long64_t stamp = -1;
+  GetCurrentEventId(treeNumber, stamp);
+  if (stamp != fEventStamp || treeNumber != fTreeNumber) {
+    fEntries.clear();
+    fFirstGeneration = fNextGeneration;
+    fTreeNumber = treeNumber;
+    fEventStamp = stamp;
+  }
+}
+
+/**
+ * Find the selection result for a given input array and container configuration
+ * in the current event. The entry is only returned if the number of objects in the
+ * array did not change since the selection was performed.
+ * @param array Input array the container is connected to
+ * @param config Serialized configuration of the container
+ * @return Selection result (NULL if not available)
+ */
+AliEmcalContainerAcceptanceCache::AcceptanceEntry *AliEmcalContainerAcceptanceCache::FindEntry(const TClonesArray *array, const std::string &config)
+{
+  CheckEvent();
+  if (fEventStamp < 0) return NULL;
+  auto found = fEntries.find(AcceptanceKey(array, config));
+  if (found == fEntries.end()) return NULL;
+  if (found->second.fNEntries != array->GetEntriesFast()) return NULL;
+  return &(found->second);
+}
+
+/**
+ * Create (or reset) the entry for a given input array and container configuration.
+ * The caller is responsible for filling the selection result.
+ * @param array Input array the container is connected to
+ * @param config Serialized configuration of the container
+ * @return Empty selection result
+ */
+AliEmcalContainerAcceptanceCache::AcceptanceEntry &AliEmcalContainerAcceptanceCache::CreateEntry(const TClonesArray *array, const std::string &config)
+{
+  CheckEvent();
+  AcceptanceEntry &entry = fEntries[AcceptanceKey(array, config)];
+  entry.fNEntries = array->GetEntriesFast();
+  entry.fGeneration = fNextGeneration++;
+  entry.fIndices.clear();
+  entry.fMomenta.clear();
+  return entry;
+}
+
+/**
+ * Remove all selection results.
+ * @param opt Not used
+ */
+void AliEmcalContainerAcceptanceCache::Clear(Option_t *)
+{
+  fEntries.clear();
+  fFirstGeneration = fNextGeneration;
+  fTreeNumber = -1;
+  fEventStamp = -1;
+}
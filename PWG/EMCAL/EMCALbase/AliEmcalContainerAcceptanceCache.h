@@ -0,0 +1,98 @@
+#ifndef ALIEMCALCONTAINERACCEPTANCECACHE_H
+#define ALIEMCALCONTAINERACCEPTANCECACHE_H
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <TObject.h>
+
+#include "AliTLorentzVector.h"
+
+class TClonesArray;
+
+/**
+ * @class AliEmcalContainerAcceptanceCache
+ * @brief Per-event store of accepted indices and momenta shared between EMCAL containers
+ * @ingroup EMCALCOREFW
+ *
+ * Iterating over the accepted objects of an EMCAL container evaluates the full
+ * selection (AliEmcalContainer::AcceptObject) for every object in the underlying
+ * array each time an iterable container is created. In trains where many tasks
+ * use identically configured containers on the same input array the selection is
+ * repeated once per task and loop.
+ *
+ * Containers which enable the acceptance sharing (AliEmcalContainer::SetShareAcceptance)
+ * store the result of the selection - the accepted indices together with the
+ * momentum vectors of the accepted objects - in this cache. Entries are keyed by
+ * the input array and the (serialized) persistent configuration of the container,
+ * so containers with identical cuts in different tasks find the same entry. The
+ * cache is cleared automatically as soon as the analysis manager moves to the next
+ * event, identified by the number of the tree in the input chain and the entry in
+ * that tree.
+ *
+ * Each selection result carries a generation number, which changes whenever the
+ * entry is (re)built. Users keeping a pointer to a result (e.g. the momenta in
+ * AliEmcalIterableContainerT) check with IsCurrent() that it was not rebuilt or
+ * removed in the meantime.
+ *
+ * The cache is a single instance per process, see Instance().
+ */
+class AliEmcalContainerAcceptanceCache : public TObject {
+ public:
+  /**
+   * @struct AcceptanceEntry
+   * @brief Selection result of one container configuration for one input array
+   */
+  struct AcceptanceEntry {
+    Int_t                           fNEntries;    ///< Number of entries in the array at the time of the selection
+    ULong64_t                       fGeneration;  ///< Generation of the selection result, changes whenever the entry is rebuilt
+    std::vector<Int_t>              fIndices;     ///< Indices of accepted objects
+    std::vector<AliTLorentzVector>  fMomenta;     ///< Momentum vectors of the accepted objects
+  };
+
+  AliEmcalContainerAcceptanceCache();
+  virtual ~AliEmcalContainerAcceptanceCache() {}
+
+  static AliEmcalContainerAcceptanceCache &Instance();
+  static void GetCurrentEventId(Int_t &treeNumber, Long64_t &entry);
+
+  AcceptanceEntry *FindEntry(const TClonesArray *array, const std::string &config);
+  AcceptanceEntry &CreateEntry(const TClonesArray *array, const std::string &config);
+
+  /**
+   * Check that a selection result is still the one with the given generation. The entry
+   * is only dereferenced if it belongs to the current event, i.e. has not been deleted.
+   * @param entry Selection result
+   * @param generation Generation of the selection result when it was obtained
+   * @return True if the selection result was neither rebuilt nor removed
+   */
+  Bool_t IsCurrent(const AcceptanceEntry *entry, ULong64_t generation) const { return entry && generation >= fFirstGeneration && entry->fGeneration == generation; }
+
+  /// Number of container configurations stored for the current event
+  Int_t GetNumberOfEntries() const { return fEntries.size(); }
+
+  virtual void Clear(Option_t *opt = "");
+
+ protected:
+  void CheckEvent();
+
+  typedef std::pair<const TClonesArray *, std::string> AcceptanceKey;
+
+  Int_t                                     fTreeNumber;    //!<! Number of the input tree of the event the cache was filled for
+  Long64_t                                  fEventStamp;    //!<! Entry (in the input tree) of the event the cache was filled for
+  ULong64_t                                 fNextGeneration;  //!<! Generation assigned to the next (re)built selection result
+  ULong64_t                                 fFirstGeneration; //!<! First generation of the current event, older selection results have been removed
+  std::map<AcceptanceKey, AcceptanceEntry>  fEntries;       //!<! Selection results, keyed by input array and container configuration
+
+ private:
+  AliEmcalContainerAcceptanceCache(const AliEmcalContainerAcceptanceCache &);
+  AliEmcalContainerAcceptanceCache &operator=(const AliEmcalContainerAcceptanceCache &);
+
+  ClassDef(AliEmcalContainerAcceptanceCache, 2);
+};
+
+#endif
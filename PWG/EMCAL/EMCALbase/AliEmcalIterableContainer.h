@@ -10,6 +10,7 @@
 #include <type_traits>
 #include <TArrayI.h>
 #include "AliTLorentzVector.h"
+#include "AliEmcalContainerAcceptanceCache.h"
 
 
 #if (__GNUC__ >= 3) && !defined(__INTEL_COMPILER)
@@ -151,7 +152,11 @@ public:
       }
       else {
         this->fCurrentElement.second = (*fkData)[fCurrent];
-        fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
+        if (fkData->fkAcceptEntry && AliEmcalContainerAcceptanceCache::Instance().IsCurrent(fkData->fkAcceptEntry, fkData->fAcceptGeneration)
+            && fCurrent < static_cast<int>(fkData->fkAcceptEntry->fMomenta.size()))
+          this->fCurrentElement.first = fkData->fkAcceptEntry->fMomenta[fCurrent];
+        else
+          fkData->GetContainer()->GetMomentum(this->fCurrentElement.first, fkData->GetInternalIndex(fCurrent));
       }
     }
   };
@@ -217,6 +222,8 @@ private:
   const AliEmcalContainer     *fkContainer;         ///< Container to be iterated over
   TArrayI                     fAcceptIndices;       ///< Array of accepted indices
   Bool_t                      fUseAccepted;         ///< Switch between accepted and all objects
+  const AliEmcalContainerAcceptanceCache::AcceptanceEntry *fkAcceptEntry; ///< Selection result in the acceptance cache providing the momenta (not owned, can be NULL)
+  ULong64_t                   fAcceptGeneration;    ///< Generation of the selection result when the accepted indices were taken from it
 
   inline int GetInternalIndex(int index) const {
     if (fUseAccepted) {
@@ -243,7 +250,9 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT():
   fkContainer(NULL),
   fAcceptIndices(),
-  fUseAccepted(kFALSE)
+  fUseAccepted(kFALSE),
+  fkAcceptEntry(NULL),
+  fAcceptGeneration(0)
 {
 
 }
@@ -258,7 +267,9 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT(const AliEmcalContainer *cont, bool useAccept):
   fkContainer(cont),
   fAcceptIndices(),
-  fUseAccepted(useAccept)
+  fUseAccepted(useAccept),
+  fkAcceptEntry(NULL),
+  fAcceptGeneration(0)
 {
   if (fUseAccepted) BuildAcceptIndices();
 }
@@ -272,7 +283,9 @@ template <typename T, typename STAR>
 AliEmcalIterableContainerT<T, STAR>::AliEmcalIterableContainerT(const AliEmcalIterableContainerT<T, STAR> &ref):
   fkContainer(ref.fkContainer),
   fAcceptIndices(ref.fAcceptIndices),
-  fUseAccepted(ref.fUseAccepted)
+  fUseAccepted(ref.fUseAccepted),
+  fkAcceptEntry(ref.fkAcceptEntry),
+  fAcceptGeneration(ref.fAcceptGeneration)
 {
 
 }
@@ -289,6 +302,8 @@ AliEmcalIterableContainerT<T, STAR> &AliEmcalIterableContainerT<T, STAR>::operat
     fkContainer = ref.fkContainer;
     fAcceptIndices = ref.fAcceptIndices;
     fUseAccepted = ref.fUseAccepted;
+    fkAcceptEntry = ref.fkAcceptEntry;
+    fAcceptGeneration = ref.fAcceptGeneration;
   }
   return *this;
 }
@@ -329,16 +344,30 @@ T *AliEmcalIterableContainerT<T, STAR>::operator[](int index) const {
 /**
  * Build list of accepted indices inside the container.
  * For this all objects inside the container are checked
- * for being accepted or not.
+ * for being accepted or not. In case the container shares
+ * its selection result (see AliEmcalContainer::SetShareAcceptance)
+ * the accepted indices and momenta are taken from the acceptance
+ * cache instead.
  */
 template <typename T, typename STAR>
 void AliEmcalIterableContainerT<T, STAR>::BuildAcceptIndices(){
-  fAcceptIndices.Set(fkContainer->GetNAcceptEntries());
+  const AliEmcalContainerAcceptanceCache::AcceptanceEntry *shared = fkContainer->GetSharedAcceptance();
+  if(shared){
+    fAcceptIndices.Set(shared->fIndices.size(), shared->fIndices.data());
+    // the momenta are only used as long as the entry is not rebuilt, they have to match the indices
+    fkAcceptEntry = shared;
+    fAcceptGeneration = shared->fGeneration;
+    return;
+  }
+
+  // Single pass over the objects, the array is shrunk to the number of accepted objects afterwards
+  fAcceptIndices.Set(fkContainer->GetNEntries());
   int acceptCounter = 0;
   for(int index = 0; index < fkContainer->GetNEntries(); index++){
     UInt_t rejectionReason = 0;
     if(fkContainer->AcceptObject(index, rejectionReason)) fAcceptIndices[acceptCounter++] = index;
   }
+  fAcceptIndices.Set(acceptCounter);
 }
 
 ///////////////////////////////////////////////////////////////////////
@@ -0,0 +1,248 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#include <algorithm>
+#include <numeric>
+
+#include <TMath.h>
+#include <TVector2.h>
+
+#include "AliEmcalTrackClusterMatchIndex.h"
+
+/// \cond CLASSIMP
+ClassImp(PWG::EMCAL::AliEmcalTrackClusterMatchIndex)
+/// \endcond
+
+using namespace PWG::EMCAL;
+
+AliEmcalTrackClusterMatchIndex::AliEmcalTrackClusterMatchIndex():
+  TObject(),
+  fNbinsEta(16),
+  fEtaMin(-0.8),
+  fEtaMax(0.8),
+  fNbinsPhi(64),
+  fClusterEta(),
+  fClusterPhi(),
+  fCellOffsets(),
+  fCellClusters(),
+  fPendingTracks(),
+  fPendingClusters(),
+  fPendingDistances(),
+  fTrackOffsets(),
+  fTrackMatches(),
+  fTrackMatchDistances(),
+  fClusterOffsets(),
+  fClusterMatches(),
+  fClusterMatchDistances()
+{
+}
+
+AliEmcalTrackClusterMatchIndex::AliEmcalTrackClusterMatchIndex(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi):
+  TObject(),
+  fNbinsEta(1),
+  fEtaMin(-0.8),
+  fEtaMax(0.8),
+  fNbinsPhi(1),
+  fClusterEta(),
+  fClusterPhi(),
+  fCellOffsets(),
+  fCellClusters(),
+  fPendingTracks(),
+  fPendingClusters(),
+  fPendingDistances(),
+  fTrackOffsets(),
+  fTrackMatches(),
+  fTrackMatchDistances(),
+  fClusterOffsets(),
+  fClusterMatches(),
+  fClusterMatchDistances()
+{
+  SetGrid(nbinsEta, etaMin, etaMax, nbinsPhi);
+}
+
+void AliEmcalTrackClusterMatchIndex::SetGrid(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi){
+  fNbinsEta = nbinsEta > 0 ? nbinsEta : 1;
+  fNbinsPhi = nbinsPhi > 0 ? nbinsPhi : 1;
+  if(etaMax > etaMin) {
+    fEtaMin = etaMin;
+    fEtaMax = etaMax;
+  } else {
+    // Degenerated range: use a single row of cells in eta
+    fEtaMin = etaMin;
+    fEtaMax = etaMin + 1.;
+    fNbinsEta = 1;
+  }
+  Clear();
+}
+
+void AliEmcalTrackClusterMatchIndex::Clear(Option_t *){
+  fClusterEta.clear();
+  fClusterPhi.clear();
+  fCellOffsets.clear();
+  fCellClusters.clear();
+  fPendingTracks.clear();
+  fPendingClusters.clear();
+  fPendingDistances.clear();
+  fTrackOffsets.clear();
+  fTrackMatches.clear();
+  fTrackMatchDistances.clear();
+  fClusterOffsets.clear();
+  fClusterMatches.clear();
+  fClusterMatchDistances.clear();
+}
+
+Int_t AliEmcalTrackClusterMatchIndex::AddCluster(Double_t eta, Double_t phi){
+  fClusterEta.push_back(eta);
+  fClusterPhi.push_back(phi);
+  return fClusterEta.size() - 1;
+}
+
+Int_t AliEmcalTrackClusterMatchIndex::GetEtaBin(Double_t eta) const {
+  if(!(eta > fEtaMin)) return 0;     // also catches NaN
+  Int_t bin = static_cast<Int_t>((eta - fEtaMin) / (fEtaMax - fEtaMin) * fNbinsEta);
+  return bin < fNbinsEta ? bin : fNbinsEta - 1;
+}
+
+Int_t AliEmcalTrackClusterMatchIndex::GetPhiBin(Double_t phi) const {
+  phi = TVector2::Phi_0_2pi(phi);
+  if(!(phi > 0.)) return 0;         // also catches NaN
+  Int_t bin = static_cast<Int_t>(phi / TMath::TwoPi() * fNbinsPhi);
+  return bin < fNbinsPhi ? bin : fNbinsPhi - 1;
+}
+
+void AliEmcalTrackClusterMatchIndex::BuildGrid(){
+  const Int_t ncells = fNbinsEta * fNbinsPhi, nclusters = fClusterEta.size();
+  std::vector<Int_t> cellOfCluster(nclusters);
+  fCellOffsets.assign(ncells + 1, 0);
+  for(Int_t icl = 0; icl < nclusters; icl++) {
+    cellOfCluster[icl] = GetEtaBin(fClusterEta[icl]) * fNbinsPhi + GetPhiBin(fClusterPhi[icl]);
+    fCellOffsets[cellOfCluster[icl] + 1]++;
+  }
+  for(Int_t icell = 0; icell < ncells; icell++) fCellOffsets[icell + 1] += fCellOffsets[icell];
+
+  // Counting sort, keeping clusters within a cell in ascending order
+  std::vector<Int_t> cursor(fCellOffsets.begin(), fCellOffsets.end() - 1);
+  fCellClusters.resize(nclusters);
+  for(Int_t icl = 0; icl < nclusters; icl++) fCellClusters[cursor[cellOfCluster[icl]]++] = icl;
+}
+
+void AliEmcalTrackClusterMatchIndex::GetCellRange(Double_t etaMin, Double_t etaMax, Double_t phi, Double_t dPhi, Int_t &firstEta, Int_t &lastEta, Int_t &firstPhi, Int_t &nPhi) const {
+  // Small tolerance against rounding at the cell boundaries
+  const Double_t kTolerance = 1e-9;
+  firstEta = GetEtaBin(etaMin - kTolerance);
+  lastEta = GetEtaBin(etaMax + kTolerance);
+  if(etaMin > etaMax) lastEta = firstEta - 1;
+  if(!(dPhi < TMath::Pi())) {
+    // Full azimuth (also for NaN)
+    firstPhi = 0;
+    nPhi = fNbinsPhi;
+    return;
+  }
+  if(dPhi < 0) dPhi = 0;
+  dPhi += kTolerance;
+  Double_t phiCenter = TVector2::Phi_0_2pi(phi);
+  if(!(phiCenter >= 0.)) phiCenter = 0.;
+  const Double_t cellWidth = TMath::TwoPi() / fNbinsPhi;
+  firstPhi = static_cast<Int_t>(TMath::Floor((phiCenter - dPhi) / cellWidth));
+  Int_t lastPhi = static_cast<Int_t>(TMath::Floor((phiCenter + dPhi) / cellWidth));
+  nPhi = std::min(lastPhi - firstPhi + 1, fNbinsPhi);
+}
+
+Int_t AliEmcalTrackClusterMatchIndex::FindClustersInRange(Double_t etaMin, Double_t etaMax, Double_t phi, Double_t dPhi, std::vector<Int_t> &clusters) const {
+  clusters.clear();
+  if(fCellOffsets.empty()) return 0;
+  Int_t firstEta, lastEta, firstPhi, nPhi;
+  GetCellRange(etaMin, etaMax, phi, dPhi, firstEta, lastEta, firstPhi, nPhi);
+  for(Int_t ieta = firstEta; ieta <= lastEta; ieta++) {
+    for(Int_t iphi = 0; iphi < nPhi; iphi++) {
+      Int_t icell = ieta * fNbinsPhi + (((firstPhi + iphi) % fNbinsPhi) + fNbinsPhi) % fNbinsPhi;
+      clusters.insert(clusters.end(), fCellClusters.begin() + fCellOffsets[icell], fCellClusters.begin() + fCellOffsets[icell + 1]);
+    }
+  }
+  std::sort(clusters.begin(), clusters.end());
+  return clusters.size();
+}
+
+Bool_t AliEmcalTrackClusterMatchIndex::HasClusterInWindow(Double_t eta, Double_t phi, Double_t dEta, Double_t dPhi) const {
+  if(fCellOffsets.empty()) return kFALSE;
+  Int_t firstEta, lastEta, firstPhi, nPhi;
+  GetCellRange(eta - dEta, eta + dEta, phi, dPhi, firstEta, lastEta, firstPhi, nPhi);
+  for(Int_t ieta = firstEta; ieta <= lastEta; ieta++) {
+    for(Int_t iphi = 0; iphi < nPhi; iphi++) {
+      Int_t icell = ieta * fNbinsPhi + (((firstPhi + iphi) % fNbinsPhi) + fNbinsPhi) % fNbinsPhi;
+      if(fCellOffsets[icell + 1] > fCellOffsets[icell]) return kTRUE;
+    }
+  }
+  return kFALSE;
+}
+
+void AliEmcalTrackClusterMatchIndex::AddMatch(Int_t track, Int_t cluster, Double_t distance){
+  fPendingTracks.push_back(track);
+  fPendingClusters.push_back(cluster);
+  fPendingDistances.push_back(distance);
+}
+
+void AliEmcalTrackClusterMatchIndex::BuildMatches(Int_t ntracks, Int_t nclusters){
+  const Int_t nmatches = fPendingDistances.size();
+  std::vector<Int_t> order(nmatches);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [this](Int_t a, Int_t b) { return fPendingDistances[a] < fPendingDistances[b]; });
+
+  fTrackOffsets.assign(ntracks + 1, 0);
+  fClusterOffsets.assign(nclusters + 1, 0);
+  for(Int_t imatch = 0; imatch < nmatches; imatch++) {
+    Int_t track = fPendingTracks[imatch], cluster = fPendingClusters[imatch];
+    if(track < 0 || track >= ntracks || cluster < 0 || cluster >= nclusters) continue;
+    fTrackOffsets[track + 1]++;
+    fClusterOffsets[cluster + 1]++;
+  }
+  for(Int_t itrk = 0; itrk < ntracks; itrk++) fTrackOffsets[itrk + 1] += fTrackOffsets[itrk];
+  for(Int_t icl = 0; icl < nclusters; icl++) fClusterOffsets[icl + 1] += fClusterOffsets[icl];
+
+  fTrackMatches.resize(fTrackOffsets[ntracks]);
+  fTrackMatchDistances.resize(fTrackOffsets[ntracks]);
+  fClusterMatches.resize(fClusterOffsets[nclusters]);
+  fClusterMatchDistances.resize(fClusterOffsets[nclusters]);
+  std::vector<Int_t> trackCursor(fTrackOffsets.begin(), fTrackOffsets.end() - 1),
+                     clusterCursor(fClusterOffsets.begin(), fClusterOffsets.end() - 1);
+  for(auto imatch : order) {
+    Int_t track = fPendingTracks[imatch], cluster = fPendingClusters[imatch];
+    if(track < 0 || track >= ntracks || cluster < 0 || cluster >= nclusters) continue;
+    fTrackMatches[trackCursor[track]] = cluster;
+    fTrackMatchDistances[trackCursor[track]++] = fPendingDistances[imatch];
+    fClusterMatches[clusterCursor[cluster]] = track;
+    fClusterMatchDistances[clusterCursor[cluster]++] = fPendingDistances[imatch];
+  }
+}
+
+Double_t AliEmcalTrackClusterMatchIndex::GetMaxBendingAngle(Double_t pt, Double_t bfield, Double_t radius){
+  if(bfield == 0.) return 0.;
+  if(!(pt > 0.)) return -1.;
+  // Radius of curvature: R[m] = pt[GeV/c] / (0.3 B[T]), with B[T] = B[kG] / 10
+  Double_t sinBending = 0.3 * TMath::Abs(bfield / 10.) * (radius / 100.) / (2. * pt);
+  if(sinBending >= 1.) return -1.;
+  return TMath::ASin(sinBending);
+}
@@ -0,0 +1,263 @@
+/************************************************************************************
+ * Copyright (C) 2026, Copyright Holders of the ALICE Collaboration                 *
+ * All rights reserved.                                                             *
+ *                                                                                  *
+ * Redistribution and use in source and binary forms, with or without               *
+ * modification, are permitted provided that the following conditions are met:      *
+ *     * Redistributions of source code must retain the above copyright             *
+ *       notice, this list of conditions and the following disclaimer.              *
+ *     * Redistributions in binary form must reproduce the above copyright          *
+ *       notice, this list of conditions and the following disclaimer in the        *
+ *       documentation and/or other materials provided with the distribution.       *
+ *     * Neither the name of the <organization> nor the                             *
+ *       names of its contributors may be used to endorse or promote products       *
+ *       derived from this software without specific prior written permission.      *
+ *                                                                                  *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND  *
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED    *
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE           *
+ * DISCLAIMED. IN NO EVENT SHALL ALICE COLLABORATION BE LIABLE FOR ANY              *
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES       *
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;     *
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND      *
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT       *
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS    *
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.                     *
+ ************************************************************************************/
+#ifndef ALIEMCALTRACKCLUSTERMATCHINDEX_H
+#define ALIEMCALTRACKCLUSTERMATCHINDEX_H
+
+#include <vector>
+#include <TObject.h>
+
+namespace PWG {
+
+namespace EMCAL{
+
+/**
+ * @class AliEmcalTrackClusterMatchIndex
+ * @brief Geometric (eta, phi) index of calorimeter clusters and flat storage of track-cluster matches
+ * @ingroup EMCALCOREFW
+ * @since Oct 18, 2026
+ *
+ * Track-cluster matching usually compares every track with every cluster in the event. Since
+ * a match is only possible if the track points close to the cluster, the clusters are instead
+ * sorted once per event into a grid of cells in (eta, phi), so that for each track only the
+ * clusters in the cells overlapping the matching window need to be tested. The grid is stored
+ * in compressed form (cluster indices sorted by cell and an offset per cell). Phi is treated
+ * periodically, clusters outside the eta range are assigned to the edge cells.
+ *
+ * ~~~{.cxx}
+ * PWG::EMCAL::AliEmcalTrackClusterMatchIndex index(16, -0.8, 0.8, 64);
+ * index.Clear();
+ * for(auto clust : clusters) index.AddCluster(clusterEta, clusterPhi);
+ * index.BuildGrid();
+ * std::vector<Int_t> candidates;
+ * index.FindClustersInWindow(trackEta, trackPhi, 0.1, 0.1, candidates);
+ * ~~~
+ *
+ * In addition accepted matches can be stored via AddMatch. After BuildMatches the matches
+ * are available as flat arrays per track and per cluster, both sorted by matching distance.
+ * Matches with equal distance keep the order in which they were added.
+ */
+class AliEmcalTrackClusterMatchIndex : public TObject {
+public:
+
+  /**
+   * Default constructor, defining a grid of 16x64 cells covering -0.8 < eta < 0.8
+   */
+  AliEmcalTrackClusterMatchIndex();
+
+  /**
+   * Constructor, defining the grid
+   * @param[in] nbinsEta Number of cells in eta
+   * @param[in] etaMin Lower edge of the grid in eta
+   * @param[in] etaMax Upper edge of the grid in eta
+   * @param[in] nbinsPhi Number of cells in phi (covering full azimuth)
+   */
+  AliEmcalTrackClusterMatchIndex(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi);
+
+  /**
+   * Destructor
+   */
+  virtual ~AliEmcalTrackClusterMatchIndex() {}
+
+  /**
+   * Redefine the grid. Removes all clusters and matches.
+   * @param[in] nbinsEta Number of cells in eta
+   * @param[in] etaMin Lower edge of the grid in eta
+   * @param[in] etaMax Upper edge of the grid in eta
+   * @param[in] nbinsPhi Number of cells in phi (covering full azimuth)
+   */
+  void SetGrid(Int_t nbinsEta, Double_t etaMin, Double_t etaMax, Int_t nbinsPhi);
+
+  /**
+   * Remove all clusters and matches, keeping the grid definition. To be
+   * called at the beginning of each event.
+   * @param[in] option Not used
+   */
+  virtual void Clear(Option_t *option = "");
+
+  /**
+   * Add cluster to the index
+   * @param[in] eta Cluster eta
+   * @param[in] phi Cluster phi (any range)
+   * @return Index of the cluster in the index (number of clusters added before)
+   */
+  Int_t AddCluster(Double_t eta, Double_t phi);
+
+  /**
+   * Sort the clusters added so far into the grid. Must be called
+   * before any cluster lookup.
+   */
+  void BuildGrid();
+
+  /**
+   * Get the number of clusters in the index
+   * @return Number of clusters
+   */
+  Int_t GetNumberOfClusters() const { return fClusterEta.size(); }
+
+  /**
+   * Find all clusters in cells overlapping with a range in eta and phi. As the test is done on
+   * cell level the result can contain clusters outside the range, which need to be rejected
+   * by the exact matching criterion.
+   * @param[in] etaMin Lower limit in eta
+   * @param[in] etaMax Upper limit in eta
+   * @param[in] phi Center of the range in phi
+   * @param[in] dPhi Half width of the range in phi
+   * @param[out] clusters Indices of the candidate clusters, sorted in ascending order
+   * @return Number of candidate clusters
+   */
+  Int_t FindClustersInRange(Double_t etaMin, Double_t etaMax, Double_t phi, Double_t dPhi, std::vector<Int_t> &clusters) const;
+
+  /**
+   * Find all clusters in cells overlapping with a window around a given point
+   * @param[in] eta Center of the window in eta
+   * @param[in] phi Center of the window in phi
+   * @param[in] dEta Half width of the window in eta
+   * @param[in] dPhi Half width of the window in phi
+   * @param[out] clusters Indices of the candidate clusters, sorted in ascending order
+   * @return Number of candidate clusters
+   */
+  Int_t FindClustersInWindow(Double_t eta, Double_t phi, Double_t dEta, Double_t dPhi, std::vector<Int_t> &clusters) const {
+    return FindClustersInRange(eta - dEta, eta + dEta, phi, dPhi, clusters);
+  }
+
+  /**
+   * Check whether any cell overlapping with a window around a given point contains a cluster.
+   * @param[in] eta Center of the window in eta
+   * @param[in] phi Center of the window in phi
+   * @param[in] dEta Half width of the window in eta
+   * @param[in] dPhi Half width of the window in phi
+   * @return True if at least one of the cells is populated
+   */
+  Bool_t HasClusterInWindow(Double_t eta, Double_t phi, Double_t dEta, Double_t dPhi) const;
+
+  /**
+   * Store match between a track and a cluster
+   * @param[in] track Index of the track
+   * @param[in] cluster Index of the cluster
+   * @param[in] distance Matching distance
+   */
+  void AddMatch(Int_t track, Int_t cluster, Double_t distance);
+
+  /**
+   * Build the per-track and per-cluster match arrays from the matches added
+   * so far, sorted by matching distance.
+   * @param[in] ntracks Number of tracks in the event
+   * @param[in] nclusters Number of clusters in the event
+   */
+  void BuildMatches(Int_t ntracks, Int_t nclusters);
+
+  /**
+   * Get the number of clusters matched to a track
+   * @param[in] track Index of the track
+   * @return Number of matched clusters (0 if the track index is out of range)
+   */
+  Int_t GetNumberOfClustersMatchedToTrack(Int_t track) const { return GetNumberOfEntries(fTrackOffsets, track); }
+
+  /**
+   * Get the cluster matched to a track
+   * @param[in] track Index of the track
+   * @param[in] imatch Rank of the match, 0 being the closest cluster
+   * @return Index of the cluster (-1 if not existing)
+   */
+  Int_t GetClusterMatchedToTrack(Int_t track, Int_t imatch = 0) const { return imatch < GetNumberOfClustersMatchedToTrack(track) ? fTrackMatches[fTrackOffsets[track] + imatch] : -1; }
+
+  /**
+   * Get the distance of a cluster matched to a track
+   * @param[in] track Index of the track
+   * @param[in] imatch Rank of the match, 0 being the closest cluster
+   * @return Matching distance (-1 if not existing)
+   */
+  Double_t GetDistanceOfClusterMatchedToTrack(Int_t track, Int_t imatch = 0) const { return imatch < GetNumberOfClustersMatchedToTrack(track) ? fTrackMatchDistances[fTrackOffsets[track] + imatch] : -1.; }
+
+  /**
+   * Get the number of tracks matched to a cluster
+   * @param[in] cluster Index of the cluster
+   * @return Number of matched tracks (0 if the cluster index is out of range)
+   */
+  Int_t GetNumberOfTracksMatchedToCluster(Int_t cluster) const { return GetNumberOfEntries(fClusterOffsets, cluster); }
+
+  /**
+   * Get the track matched to a cluster
+   * @param[in] cluster Index of the cluster
+   * @param[in] imatch Rank of the match, 0 being the closest track
+   * @return Index of the track (-1 if not existing)
+   */
+  Int_t GetTrackMatchedToCluster(Int_t cluster, Int_t imatch = 0) const { return imatch < GetNumberOfTracksMatchedToCluster(cluster) ? fClusterMatches[fClusterOffsets[cluster] + imatch] : -1; }
+
+  /**
+   * Get the distance of a track matched to a cluster
+   * @param[in] cluster Index of the cluster
+   * @param[in] imatch Rank of the match, 0 being the closest track
+   * @return Matching distance (-1 if not existing)
+   */
+  Double_t GetDistanceOfTrackMatchedToCluster(Int_t cluster, Int_t imatch = 0) const { return imatch < GetNumberOfTracksMatchedToCluster(cluster) ? fClusterMatchDistances[fClusterOffsets[cluster] + imatch] : -1.; }
+
+  /**
+   * Get the maximum difference in azimuth between the momentum direction of a charged track
+   * at the vertex and its position at a given radius, caused by the bending in the magnetic field.
+   * @param[in] pt Transverse momentum of the track (GeV/c)
+   * @param[in] bfield Magnetic field (kG, as returned by AliVEvent::GetMagneticField)
+   * @param[in] radius Radius in the transverse plane (cm)
+   * @return Difference in azimuth, or -1 if the track curls up before reaching the radius
+   */
+  static Double_t GetMaxBendingAngle(Double_t pt, Double_t bfield, Double_t radius);
+
+private:
+  Int_t GetEtaBin(Double_t eta) const;
+  Int_t GetPhiBin(Double_t phi) const;
+  Int_t GetNumberOfEntries(const std::vector<Int_t> &offsets, Int_t index) const {
+    return (index >= 0 && index + 1 < static_cast<Int_t>(offsets.size())) ? offsets[index + 1] - offsets[index] : 0;
+  }
+  void GetCellRange(Double_t etaMin, Double_t etaMax, Double_t phi, Double_t dPhi, Int_t &firstEta, Int_t &lastEta, Int_t &firstPhi, Int_t &nPhi) const;
+
+  Int_t                                       fNbinsEta;                          ///< Number of cells in eta
+  Double_t                                    fEtaMin;                            ///< Lower edge of the grid in eta
+  Double_t                                    fEtaMax;                            ///< Upper edge of the grid in eta
+  Int_t                                       fNbinsPhi;                          ///< Number of cells in phi
+  std::vector<Double_t>                       fClusterEta;                        //!<! Eta of the clusters
+  std::vector<Double_t>                       fClusterPhi;                        //!<! Phi of the clusters
+  std::vector<Int_t>                          fCellOffsets;                       //!<! Position of the first cluster of each cell in fCellClusters (one entry per cell + 1)
+  std::vector<Int_t>                          fCellClusters;                      //!<! Cluster indices, sorted by cell
+  std::vector<Int_t>                          fPendingTracks;                     //!<! Track index of the matches added
+  std::vector<Int_t>                          fPendingClusters;                   //!<! Cluster index of the matches added
+  std::vector<Double_t>                       fPendingDistances;                  //!<! Distance of the matches added
+  std::vector<Int_t>                          fTrackOffsets;                      //!<! Position of the first match of each track in fTrackMatches
+  std::vector<Int_t>                          fTrackMatches;                      //!<! Clusters matched to tracks, sorted by track and distance
+  std::vector<Double_t>                       fTrackMatchDistances;               //!<! Distances corresponding to fTrackMatches
+  std::vector<Int_t>                          fClusterOffsets;                    //!<! Position of the first match of each cluster in fClusterMatches
+  std::vector<Int_t>                          fClusterMatches;                    //!<! Tracks matched to clusters, sorted by cluster and distance
+  std::vector<Double_t>                       fClusterMatchDistances;             //!<! Distances corresponding to fClusterMatches
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalTrackClusterMatchIndex, 1);
+  /// \endcond
+};
+
+}
+
+}
+#endif /* ALIEMCALTRACKCLUSTERMATCHINDEX_H */
@@ -13,6 +13,7 @@
 #pragma link C++ class AliEmcalEmbeddingQA+;
 #pragma link C++ class AliClusterContainer+;
 #pragma link C++ class AliEmcalContainer+;
+#pragma link C++ class AliEmcalContainerAcceptanceCache+;
 #pragma link C++ class AliEmcalContainerUtils+;
 #pragma link C++ class AliEmcalParticle+;
 #pragma link C++ class AliEmcalPhysicsSelection+;
@@ -49,6 +50,7 @@
 #pragma link C++ class PWG::EMCAL::AliEmcalESDTrackCutsGenerator+;
 #pragma link C++ class PWG::EMCAL::AliEmcalESDtrackCutsWrapper+;
 #pragma link C++ class PWG::EMCAL::AliEmcalMCPartonInfo+;
+#pragma link C++ class PWG::EMCAL::AliEmcalTrackClusterMatchIndex+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSelResultPtr+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalAODHybridTrackCuts+;
 #pragma link C++ class PWG::EMCAL::TestAliEmcalTrackSelectionAOD+;
@@ -103,8 +103,7 @@ Bool_t AliEmcalCorrectionCellBadChannel::Run()
   CheckIfRunChanged();
   
   // CONFIGURE THE RECO UTILS -------------------------------------------------
-
-  fRecoUtils->SwitchOnBadChannelsRemoval();
+  ConfigureRecoUtilsForCellCorrection();
   
   // START PROCESSING ---------------------------------------------------------
   // Test if cells present
@@ -130,6 +129,23 @@ Bool_t AliEmcalCorrectionCellBadChannel::Run()
   return kTRUE;
 }
 
+/**
+ * The bad channel removal can be fused with other cell corrections, unless the
+ * QA histograms before and after the correction are requested.
+ */
+Bool_t AliEmcalCorrectionCellBadChannel::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto;
+}
+
+/**
+ * Switch on the bad channel removal in the reco utils.
+ */
+void AliEmcalCorrectionCellBadChannel::ConfigureRecoUtilsForCellCorrection()
+{
+  fRecoUtils->SwitchOnBadChannelsRemoval();
+}
+
 /**
  * This function is called if the run changes (it inherits from the base component),
  * to load a new bad channel and fill relevant variables.
@@ -0,0 +1,166 @@
+// AliEmcalCorrectionCellCalibrationTable
+//
+
+#include "AliEmcalCorrectionCellCalibrationTable.h"
+
+#include <algorithm>
+
+#include <AliVCaloCells.h>
+#include "AliEmcalCorrectionComponent.h"
+
+/// \cond CLASSIMP
+ClassImp(AliEmcalCorrectionCellCalibrationTable);
+/// \endcond
+
+/**
+ * Default constructor
+ */
+AliEmcalCorrectionCellCalibrationTable::AliEmcalCorrectionCellCalibrationTable():
+  fComponents(),
+  fNCells(0),
+  fRun(-1),
+  fMasked(),
+  fEnergyScale(),
+  fTimeShift()
+{
+}
+
+/**
+ * Check whether a component is fused in this table.
+ *
+ * @param[in] component Component to check
+ *
+ * @return True if the component is part of the table
+ */
+bool AliEmcalCorrectionCellCalibrationTable::Contains(const AliEmcalCorrectionComponent * component) const
+{
+  return std::find(fComponents.begin(), fComponents.end(), component) != fComponents.end();
+}
+
+/**
+ * Executes the fused components for the current event. The run dependent calibrations of
+ * each component are updated, the table is rebuilt if the run changed, and then it is applied
+ * to the cells in a single pass. If any component cannot be fused for the current run (for
+ * example, for PAR runs), the components are instead executed one after another.
+ *
+ * @return True if the cells were corrected successfully
+ */
+Bool_t AliEmcalCorrectionCellCalibrationTable::Run()
+{
+  if (fComponents.empty()) return kFALSE;
+
+  Int_t run = -1;
+  for (auto component : fComponents) {
+    run = component->PrepareCellCorrection();
+  }
+  if (run < 0) return kFALSE;
+
+  for (auto component : fComponents) {
+    if (!component->IsCellCorrectionFusable()) {
+      for (auto comp : fComponents) {
+        comp->Run();
+      }
+      // Force a rebuild once the components can be fused again
+      fNCells = 0;
+      return kTRUE;
+    }
+  }
+
+  if (run != fRun || fNCells == 0) {
+    fNCells = 0;
+    for (auto component : fComponents) {
+      component->AddToCellCalibrationTable(*this);
+    }
+    fRun = run;
+  }
+
+  return fComponents.front()->ApplyCellCalibrationTable(*this);
+}
+
+/**
+ * Reset the table for a given number of cells, such that it corresponds to no correction.
+ *
+ * @param[in] nCells Number of cells in the calorimeter
+ */
+void AliEmcalCorrectionCellCalibrationTable::Reset(Int_t nCells)
+{
+  fNCells = nCells;
+  Int_t size = 2 * kNBCSlots * nCells;
+  fMasked.assign(size, kFALSE);
+  fEnergyScale.assign(size, 1.);
+  fTimeShift.assign(size, 0.);
+}
+
+/**
+ * Add the effect of one correction step on a cell to the table.
+ *
+ * @param[in] isHighGain True for the high gain table
+ * @param[in] bcSlot Bunch crossing slot (see GetBCSlot())
+ * @param[in] absId Cell ID
+ * @param[in] accepted False if the cell was rejected by the correction step
+ * @param[in] energyScale Energy calibration factor applied in the correction step
+ * @param[in] timeShift Time shift applied in the correction step
+ */
+void AliEmcalCorrectionCellCalibrationTable::AddCorrectionStep(Bool_t isHighGain, Int_t bcSlot, Int_t absId, Bool_t accepted, Double_t energyScale, Double_t timeShift)
+{
+  if (absId < 0 || absId >= fNCells) return;
+
+  Int_t index = Index(isHighGain, bcSlot, absId);
+  if (!accepted) {
+    // Rejected cells are set to E = 0 and t = -1, independent of any previous correction
+    fMasked[index] = kTRUE;
+    fEnergyScale[index] = 0.;
+    fTimeShift[index] = 0.;
+  }
+  else {
+    fEnergyScale[index] *= energyScale;
+    fTimeShift[index] += timeShift;
+  }
+}
+
+/**
+ * Apply the table to the cells in a single pass. The cells are sorted afterwards, as in
+ * AliEmcalCorrectionComponent::UpdateCells().
+ *
+ * @param[in,out] cells Cells to be corrected
+ * @param[in] bc Bunch crossing number of the event
+ */
+void AliEmcalCorrectionCellCalibrationTable::Apply(AliVCaloCells * cells, Int_t bc) const
+{
+  if (!cells) return;
+
+  const Int_t bcSlot = GetBCSlot(bc);
+  Short_t  absId   = -1;
+  Double_t ecell   = 0;
+  Double_t tcell   = 0;
+  Double_t efrac   = 0;
+  Int_t    mclabel = -1;
+
+  Int_t nCells = cells->GetNumberOfCells();
+  for (Int_t iCell = 0; iCell < nCells; iCell++)
+  {
+    cells->GetCell(iCell, absId, ecell, tcell, mclabel, efrac);
+    Bool_t isHighGain = cells->GetHighGain(iCell);
+
+    if (absId < 0 || absId >= fNCells) {
+      // Cells which do not exist are rejected by AliEMCALRecoUtils::AcceptCalibrateCell()
+      ecell = 0;
+      tcell = -1;
+    }
+    else {
+      Int_t index = Index(isHighGain, bcSlot, absId);
+      if (fMasked[index]) {
+        ecell = 0;
+        tcell = -1 + fTimeShift[index];
+      }
+      else {
+        ecell *= fEnergyScale[index];
+        tcell += fTimeShift[index];
+      }
+    }
+
+    cells->SetCell(iCell, absId, ecell, tcell, mclabel, efrac, isHighGain);
+  }
+
+  cells->Sort();
+}
@@ -0,0 +1,86 @@
+#ifndef ALIEMCALCORRECTIONCELLCALIBRATIONTABLE_H
+#define ALIEMCALCORRECTIONCELLCALIBRATIONTABLE_H
+
+#include <vector>
+
+#include <Rtypes.h>
+
+class AliEmcalCorrectionComponent;
+class AliVCaloCells;
+
+/**
+ * @class AliEmcalCorrectionCellCalibrationTable
+ * @ingroup EMCALCORRECTIONFW
+ * @brief Flat, cell ID indexed calibration table for fused cell corrections
+ *
+ * Cell level correction components (bad channel removal, energy calibration, single
+ * channel calibration and time calibration) each loop over all cells and look up their
+ * calibration in the histograms stored in AliEMCALRecoUtils, including the geometry
+ * lookup of the supermodule and row/column of each cell. When several of these components
+ * are executed one after another on the same cells, they can instead be fused into one
+ * pass over the cells. For this, the combined effect of all components in the group is
+ * stored once per run in flat arrays indexed by gain, bunch crossing and cell ID:
+ *
+ * - a mask for cells which were rejected by any of the components,
+ * - the product of all energy calibration factors,
+ * - the sum of all time shifts (for masked cells: the sum of all shifts applied after the
+ *   last component which rejected the cell, with respect to the time -1 set for rejected cells).
+ *
+ * The table is filled by the components themselves (see AliEmcalCorrectionComponent::AddToCellCalibrationTable()),
+ * which guarantees that the result is identical (up to floating point rounding) to running the
+ * components one after another.
+ * Only components which are linear in the cell energy and additive in the cell time (ie. no
+ * energy dependent corrections) can be fused. This is steered by AliEmcalCorrectionTask.
+ *
+ * @date Oct 18, 2026
+ */
+class AliEmcalCorrectionCellCalibrationTable {
+ public:
+  /// Number of bunch crossing slots: bc%4 and a separate slot for an undefined (negative) bunch crossing
+  static const Int_t kNBCSlots = 5;
+
+  AliEmcalCorrectionCellCalibrationTable();
+  virtual ~AliEmcalCorrectionCellCalibrationTable() {}
+
+  // Configure the group of components
+  void AddComponent(AliEmcalCorrectionComponent * component) { fComponents.push_back(component); }
+  /// Components which are fused in this table, in order of execution
+  const std::vector<AliEmcalCorrectionComponent *> & GetComponents() const { return fComponents; }
+  bool Contains(const AliEmcalCorrectionComponent * component) const;
+
+  // Steering
+  Bool_t Run();
+  /// Run for which the table was built
+  Int_t GetRun() const { return fRun; }
+
+  // Filling the table
+  void Reset(Int_t nCells);
+  void AddCorrectionStep(Bool_t isHighGain, Int_t bcSlot, Int_t absId, Bool_t accepted, Double_t energyScale, Double_t timeShift);
+  /// Number of cells stored in the table. 0 if the table was not built yet.
+  Int_t GetNumberOfCells() const { return fNCells; }
+
+  // Applying the table
+  void Apply(AliVCaloCells * cells, Int_t bc) const;
+
+  /// Retrieve the bunch crossing slot for a given bunch crossing
+  static Int_t GetBCSlot(Int_t bc) { return bc < 0 ? kNBCSlots - 1 : bc % 4; }
+  /// Retrieve the bunch crossing used to probe a given slot
+  static Int_t GetBCFromSlot(Int_t bcSlot) { return bcSlot == kNBCSlots - 1 ? -1 : bcSlot; }
+
+ protected:
+  /// Index in the flat arrays
+  Int_t Index(Bool_t isHighGain, Int_t bcSlot, Int_t absId) const { return ((isHighGain ? 0 : 1) * kNBCSlots + bcSlot) * fNCells + absId; }
+
+  std::vector<AliEmcalCorrectionComponent *> fComponents; //!<! Fused components, in order of execution (not owned)
+  Int_t                 fNCells;                          //!<! Number of cells in the table
+  Int_t                 fRun;                             //!<! Run for which the table was built
+  std::vector<Bool_t>   fMasked;                          //!<! Cell was rejected by one of the components
+  std::vector<Float_t>  fEnergyScale;                     //!<! Combined energy calibration factor
+  std::vector<Double_t> fTimeShift;                       //!<! Combined time shift (in seconds)
+
+  /// \cond CLASSIMP
+  ClassDef(AliEmcalCorrectionCellCalibrationTable, 1); // Flat cell calibration table for fused EMCal cell corrections
+  /// \endcond
+};
+
+#endif /* ALIEMCALCORRECTIONCELLCALIBRATIONTABLE_H */
@@ -109,7 +109,7 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   CheckIfRunChanged();
   
   // CONFIGURE THE RECO UTILS -------------------------------------------------
-  fRecoUtils->SwitchOnRecalibration();
+  ConfigureRecoUtilsForCellCorrection();
   
   // START PROCESSING ---------------------------------------------------------
   // Test if cells present
@@ -141,6 +141,23 @@ Bool_t AliEmcalCorrectionCellEnergy::Run()
   return kTRUE;
 }
 
+/**
+ * The energy calibration can be fused with other cell corrections, unless the
+ * QA histograms are requested or the energy dependent shaper correction is applied.
+ */
+Bool_t AliEmcalCorrectionCellEnergy::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto && !fUseShaperCorrection;
+}
+
+/**
+ * Switch on the energy recalibration in the reco utils.
+ */
+void AliEmcalCorrectionCellEnergy::ConfigureRecoUtilsForCellCorrection()
+{
+  fRecoUtils->SwitchOnRecalibration();
+}
+
 /**
  * Initialize the energy calibration.
  */
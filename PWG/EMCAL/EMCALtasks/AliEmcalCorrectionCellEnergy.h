@@ -32,6 +32,10 @@ class AliEmcalCorrectionCellEnergy : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections
+  Bool_t IsCellCorrectionFusable() const;
+  void ConfigureRecoUtilsForCellCorrection();
   
 protected:
   TH1F* fCellEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
@@ -90,7 +90,7 @@ Bool_t AliEmcalCorrectionCellSingleChannelCalibration::Run()
   CheckIfRunChanged();
   
   // CONFIGURE THE RECO UTILS -------------------------------------------------
-  fRecoUtils->SwitchOnRecalibration();
+  ConfigureRecoUtilsForCellCorrection();
   
   // START PROCESSING ---------------------------------------------------------
   // Test if cells present
@@ -122,6 +122,23 @@ Bool_t AliEmcalCorrectionCellSingleChannelCalibration::Run()
   return kTRUE;
 }
 
+/**
+ * The single channel calibration can be fused with other cell corrections, unless
+ * the QA histograms before and after the correction are requested.
+ */
+Bool_t AliEmcalCorrectionCellSingleChannelCalibration::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto;
+}
+
+/**
+ * Switch on the energy recalibration in the reco utils.
+ */
+void AliEmcalCorrectionCellSingleChannelCalibration::ConfigureRecoUtilsForCellCorrection()
+{
+  fRecoUtils->SwitchOnRecalibration();
+}
+
 /**
  * Initialize the energy calibration.
  */
@@ -33,6 +33,10 @@ class AliEmcalCorrectionCellSingleChannelCalibration : public AliEmcalCorrection
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections
+  Bool_t IsCellCorrectionFusable() const;
+  void ConfigureRecoUtilsForCellCorrection();
   
  protected:
   TH1F* fCellSingleChannelEnergyDistBefore;        //!<! cell energy distribution, before energy calibration
@@ -114,22 +114,7 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
   CheckIfRunChanged();
   
   // CONFIGURE THE RECO UTILS -------------------------------------------------
-  if (fCalibrateTimeVsE)
-    fRecoUtils->SwitchOnTimeECorrection();
-  else 
-    fRecoUtils->SwitchOffTimeECorrection();
-  
-  // allows time calibration
-  if (fCalibrateTime)
-    fRecoUtils->SwitchOnTimeRecalibration();
-  else
-    fRecoUtils->SwitchOffTimeRecalibration();
-  
-  // allows time calibration with L1 phase
-  if (fCalibrateTimeL1Phase)
-    fRecoUtils->SwitchOnL1PhaseInTimeRecalibration();
-  else
-    fRecoUtils->SwitchOffL1PhaseInTimeRecalibration();
+  ConfigureRecoUtilsForCellCorrection();
   
   // START PROCESSING ---------------------------------------------------------
   // Test if cells present
@@ -155,6 +140,39 @@ Bool_t AliEmcalCorrectionCellTimeCalib::Run()
 }
 
 
+/**
+ * The time calibration can be fused with other cell corrections, unless the QA histograms
+ * are requested, the energy dependent time calibration is applied, or the L1 phase changes
+ * within the run (PAR runs).
+ */
+Bool_t AliEmcalCorrectionCellTimeCalib::IsCellCorrectionFusable() const
+{
+  return !fCreateHisto && !fCalibrateTimeVsE && !fRecoUtils->IsParRun();
+}
+
+/**
+ * Switch on the requested time calibrations in the reco utils.
+ */
+void AliEmcalCorrectionCellTimeCalib::ConfigureRecoUtilsForCellCorrection()
+{
+  if (fCalibrateTimeVsE)
+    fRecoUtils->SwitchOnTimeECorrection();
+  else 
+    fRecoUtils->SwitchOffTimeECorrection();
+  
+  // allows time calibration
+  if (fCalibrateTime)
+    fRecoUtils->SwitchOnTimeRecalibration();
+  else
+    fRecoUtils->SwitchOffTimeRecalibration();
+  
+  // allows time calibration with L1 phase
+  if (fCalibrateTimeL1Phase)
+    fRecoUtils->SwitchOnL1PhaseInTimeRecalibration();
+  else
+    fRecoUtils->SwitchOffL1PhaseInTimeRecalibration();
+}
+
 /**
  * Initialize the energy dependent time calibration.
  */
@@ -32,6 +32,10 @@ class AliEmcalCorrectionCellTimeCalib : public AliEmcalCorrectionComponent {
   void UserCreateOutputObjects();
   Bool_t Run();
   Bool_t CheckIfRunChanged();
+
+  // Fused cell corrections
+  Bool_t IsCellCorrectionFusable() const;
+  void ConfigureRecoUtilsForCellCorrection();
   
 protected:
   TH1F* fCellTimeDistBefore;            //!<! cell energy distribution, before time calibration
@@ -3,8 +3,11 @@
 
 #include "AliEmcalCorrectionClusterTrackMatcher.h"
 
+#include <vector>
+
 #include <TH1.h>
 #include <TList.h>
+#include <TVector3.h>
 
 #include "AliClusterContainer.h"
 #include "AliParticleContainer.h"
@@ -15,6 +18,7 @@
 #include "AliEmcalParticle.h"
 #include "AliEMCALGeometry.h"
 #include "AliMCEvent.h"
+#include "AliVEvent.h"
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionClusterTrackMatcher);
@@ -38,12 +42,14 @@ AliEmcalCorrectionClusterTrackMatcher::AliEmcalCorrectionClusterTrackMatcher() :
   fUseOuterParamInESDs(kFALSE),
   fUpdateTracks(kTRUE),
   fUpdateClusters(kTRUE),
+  fPropagateOnlyReachableTracks(kFALSE),
   fClusterContainerIndexMap(),
   fParticleContainerIndexMap(),
   fEmcalTracks(0),
   fEmcalClusters(0),
   fNEmcalTracks(0),
   fNEmcalClusters(0),
+  fMatchIndex(),
   fHistMatchEtaAll(0),
   fHistMatchPhiAll(0),
   fNMCGenerToAccept(0),
@@ -82,6 +88,12 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::Initialize()
   GetProperty("maxDist", fMaxDistance);
   GetProperty("updateClusters", fUpdateClusters);
   GetProperty("updateTracks", fUpdateTracks);
+  GetProperty("propagateOnlyReachableTracks", fPropagateOnlyReachableTracks);
+
+  // Grid used to find the cluster candidates for each track. The cell size follows the
+  // matching distance, such that a track has to be compared to the clusters of a few cells only.
+  const Double_t cellSize = TMath::Max(fMaxDistance, 0.05);
+  fMatchIndex.SetGrid(TMath::CeilNint(1.6 / cellSize), -0.8, 0.8, TMath::CeilNint(TMath::TwoPi() / cellSize));
   
   // Track extrapolation to EMCal surface
   //
@@ -250,6 +262,7 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 
   fNEmcalTracks = 0;
   fNEmcalClusters = 0;
+  fMatchIndex.Clear();
 
   AliVCluster* cluster = 0;
   AliVTrack* track = 0;
@@ -286,9 +299,16 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
       AliEmcalParticle(cluster, fClusterContainerIndexMap.GlobalIndexFromLocalIndex(clusCont, clusIterator.current_index()), fVertex[0], fVertex[1], fVertex[2], AliVCluster::kNonLinCorr);
       emcalCluster->SetMatchedPtr(fEmcalTracks);
 
+      // Add the cluster to the matching grid, using the same position as in GetEtaPhiDiff
+      Float_t pos[3] = {0};
+      cluster->GetPosition(pos);
+      TVector3 cpos(pos);
+      fMatchIndex.AddCluster(cpos.Eta(), cpos.Phi());
+
       fNEmcalClusters++;
     }
   }
+  fMatchIndex.BuildGrid();
   
   Double_t mass;
   if (fUsePIDmass) {
@@ -300,6 +320,12 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
     mass = 0.1396;
   }
 
+  Double_t bfield = 0.;
+  if (fPropagateOnlyReachableTracks) {
+    AliVEvent * event = fEventManager.InputEvent();
+    if (event) bfield = event->GetMagneticField();
+  }
+
   AliParticleContainer * partCont = 0;
   TIter nextPartCont(&fParticleCollArray);
   while ((partCont = static_cast<AliParticleContainer*>(nextPartCont()))) {
@@ -342,8 +368,10 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
           if ( !generOK ) continue;
         }
         
-        // Propagate the track
-        AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
+        // Propagate the track, unless it cannot be matched to any cluster anyway
+        if (!fPropagateOnlyReachableTracks || CanTrackReachCluster(track, bfield)) {
+          AliEMCALRecoUtils::ExtrapolateTrackToEMCalSurface(track, fPropDist, mass, 20, 0.35, kFALSE, fUseDCA, fUseOuterParamInESDs);
+        }
       }
 
       // Reset properties of the track to fix TRefArray errors which occur when AddTrackMatched(obj) is called.
@@ -372,17 +400,20 @@ void AliEmcalCorrectionClusterTrackMatcher::GenerateEmcalParticles()
 }
 
 /**
- * Set the links between tracks and clusters.
+ * Set the links between tracks and clusters. Only the clusters in the cells of the
+ * matching grid which overlap with the matching window of the track are tested.
  */
 void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
 {
   const Double_t maxd2 = fMaxDistance*fMaxDistance;
+  std::vector<Int_t> candidates;
 
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
     AliVTrack* track = emcalTrack->GetTrack();
 
-    for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
+    fMatchIndex.FindClustersInWindow(track->GetTrackEtaOnEMCal(), track->GetTrackPhiOnEMCal(), fMaxDistance, fMaxDistance, candidates);
+    for (auto icluster : candidates) {
       AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
       AliVCluster* cluster = emcalCluster->GetCluster();
       
@@ -394,8 +425,7 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
       if (d2 > maxd2) continue;
       
       Double_t d = TMath::Sqrt(d2);
-      emcalCluster->AddMatchedObj(itrack, d);
-      emcalTrack->AddMatchedObj(icluster, d);
+      fMatchIndex.AddMatch(itrack, icluster, d);
       AliDebug(2, Form("Now matching cluster E = %.3f, pT = %.3f, eta = %.3f, phi = %.3f "
                        "with track pT = %.3f, eta = %.3f, phi = %.3f"
                        "Track eta, phi on EMCal = %.3f, %.3f, d = %.3f",
@@ -417,6 +447,8 @@ void AliEmcalCorrectionClusterTrackMatcher::DoMatching()
       }
     }
   }
+
+  fMatchIndex.BuildMatches(fNEmcalTracks, fNEmcalClusters);
 }
 
 /**
@@ -426,14 +458,14 @@ void AliEmcalCorrectionClusterTrackMatcher::UpdateClusters()
 {
   for (Int_t icluster = 0; icluster < fNEmcalClusters; icluster++) {
     AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(icluster));
-    const Int_t N = emcalCluster->GetNumberOfMatchedObj();
+    const Int_t N = fMatchIndex.GetNumberOfTracksMatchedToCluster(icluster);
     AliVCluster* cluster = emcalCluster->GetCluster();
     AliDebug(3, Form("Cluster E = %.2f, eta = %.2f, phi = %.2f, Nmatch = %d", cluster->GetNonLinCorrEnergy(), emcalCluster->Eta(), emcalCluster->Phi(), N));
     
     if (N <= 0) continue;
     
     // Set the first match distance
-    const UInt_t firstMatchId = emcalCluster->GetMatchedObjId();
+    const Int_t firstMatchId = fMatchIndex.GetTrackMatchedToCluster(icluster);
     AliEmcalParticle* emcalTrackFirstMatch = static_cast<AliEmcalParticle*>(fEmcalTracks->At(firstMatchId));
     AliVTrack* trackFirstMatch = emcalTrackFirstMatch->GetTrack();
     Double_t deta = 999;
@@ -449,7 +481,7 @@ void AliEmcalCorrectionClusterTrackMatcher::UpdateClusters()
     // Copy the matched tracks in the cluster. Note: different methods for ESD/AOD
     if (ac) {
       for (Int_t i=0; i < N; ++i) {
-        Int_t id = emcalCluster->GetMatchedObjId(i);
+        Int_t id = fMatchIndex.GetTrackMatchedToCluster(icluster, i);
         AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(id));
         
         AliDebug(3, Form("Pt = %.2f, eta = %.2f, phi = %.2f", emcalTrack->Pt(), emcalTrack->Eta(), emcalTrack->Phi()));
@@ -461,7 +493,7 @@ void AliEmcalCorrectionClusterTrackMatcher::UpdateClusters()
     else {
       TArrayI arr(N);
       for (Int_t i = 0; i < N; ++i) {
-        Int_t id = emcalCluster->GetMatchedObjId(i);
+        Int_t id = fMatchIndex.GetTrackMatchedToCluster(icluster, i);
         AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(id));
         arr.AddAt(emcalTrack->IdInCollection(), i);
       }
@@ -478,9 +510,9 @@ void AliEmcalCorrectionClusterTrackMatcher::UpdateTracks()
   for (Int_t itrack = 0; itrack < fNEmcalTracks; itrack++) {
     AliEmcalParticle* emcalTrack = static_cast<AliEmcalParticle*>(fEmcalTracks->At(itrack));
 
-    if (emcalTrack->GetNumberOfMatchedObj() <= 0) continue;
+    if (fMatchIndex.GetNumberOfClustersMatchedToTrack(itrack) <= 0) continue;
     
-    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(emcalTrack->GetMatchedObjId()));
+    AliEmcalParticle* emcalCluster = static_cast<AliEmcalParticle*>(fEmcalClusters->At(fMatchIndex.GetClusterMatchedToTrack(itrack)));
     
     AliVTrack* track = emcalTrack->GetTrack();
     track->SetEMCALcluster(emcalCluster->IdInCollection());
@@ -513,3 +545,24 @@ Bool_t AliEmcalCorrectionClusterTrackMatcher::IsTrackInEmcalAcceptance(AliVParti
     return kFALSE;
   }
 }
+
+/**
+ * Determines whether a track can reach a cell of the matching grid containing a cluster, using
+ * \f$\eta\f$/\f$\phi\f$ at the vertex and the maximum bending of the track in the magnetic field
+ * up to the propagation distance. The window is enlarged by the matching distance and a margin
+ * accounting for the vertex position and multiple scattering. Used to skip the propagation of
+ * tracks which cannot be matched.
+ * @param[in] track Track to check
+ * @param[in] bfield Magnetic field (kG)
+ * @return True if a cluster can be reached, false otherwise
+ */
+Bool_t AliEmcalCorrectionClusterTrackMatcher::CanTrackReachCluster(const AliVTrack* track, Double_t bfield) const
+{
+  if (!fMatchIndex.GetNumberOfClusters()) return kFALSE;
+
+  Double_t bending = PWG::EMCAL::AliEmcalTrackClusterMatchIndex::GetMaxBendingAngle(track->Pt(), bfield, fPropDist);
+  if (bending < 0) return kFALSE;
+
+  const Double_t margin = 0.05;
+  return fMatchIndex.HasClusterInWindow(track->Eta(), track->Phi(), fMaxDistance + margin, bending + fMaxDistance + margin);
+}
@@ -2,6 +2,7 @@
 #define ALIEMCALCORRECTIONCLUSTERTRACKMATCHER_H
 
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalTrackClusterMatchIndex.h"
 
 #if !(defined(__CINT__) || defined(__MAKECINT__))
 #include "AliEmcalContainerIndexMap.h"
@@ -35,6 +36,12 @@ class AliVParticle;
  ~~~
  will directly return a pointer to the matched track.
  
+ In order to avoid testing every track against every cluster, the clusters are sorted into a grid in
+ \f$\eta\f$ and \f$\phi\f$ (PWG::EMCAL::AliEmcalTrackClusterMatchIndex) and each track is only compared to the clusters
+ in the cells overlapping with its matching window. The result is identical to the full comparison. Optionally
+ (`propagateOnlyReachableTracks`) the propagation is skipped for tracks which cannot reach any cell containing a
+ cluster, based on the direction of the track at the vertex and its maximum bending in the magnetic field.
+ 
  To get the cluster matched to a track one can use (both ESD and AOD):
  ~~~{.cxx}
  Int_t iCluster = track->GetEMCALcluster();
@@ -72,6 +79,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   void          UpdateTracks();
   void          UpdateClusters();
   Bool_t        IsTrackInEmcalAcceptance(AliVParticle* part, Double_t edges=0.9) const;
+  Bool_t        CanTrackReachCluster(const AliVTrack* track, Double_t bfield) const;
   
   void          SetNumberOfMCGeneratorsToAccept(Int_t nGen){ fNMCGenerToAccept = nGen ;
                     if      ( nGen > 5 ) fNMCGenerToAccept = 5 ;
@@ -88,6 +96,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   Bool_t        fUseOuterParamInESDs;   ///< Use TPC outer parameters instead of inner parameters for track propagation, ESDs only
   Bool_t        fUpdateTracks;          ///< update tracks with matching info
   Bool_t        fUpdateClusters;        ///< update clusters with matching info
+  Bool_t        fPropagateOnlyReachableTracks; ///< if true then propagate only tracks which can reach a cell of the matching grid containing a cluster
   
 #if !(defined(__CINT__) || defined(__MAKECINT__))
   // Handle mapping between index and containers
@@ -99,6 +108,7 @@ class AliEmcalCorrectionClusterTrackMatcher : public AliEmcalCorrectionComponent
   TClonesArray *fEmcalClusters;         //!<!emcal clusters
   Int_t         fNEmcalTracks;          //!<!number of emcal tracks
   Int_t         fNEmcalClusters;        //!<!number of emcal clusters
+  PWG::EMCAL::AliEmcalTrackClusterMatchIndex fMatchIndex; //!<!grid of clusters in eta-phi and matches found
   TH1          *fHistMatchEtaAll;       //!<!deta distribution
   TH1          *fHistMatchPhiAll;       //!<!dphi distribution
   TH1          *fHistMatchEta[10][9][2]; //!<!deta distribution
@@ -116,7 +126,7 @@ private:
   static RegisterCorrectionComponent<AliEmcalCorrectionClusterTrackMatcher> reg;
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 5); // EMCal cluster track matcher correction component
+  ClassDef(AliEmcalCorrectionClusterTrackMatcher, 6); // EMCal cluster track matcher correction component
   /// \endcond
 };
 
@@ -8,6 +8,7 @@
 
 #include <AliAnalysisManager.h>
 #include <AliVEvent.h>
+#include <AliAODCaloCells.h>
 #include <AliEMCALRecoUtils.h>
 #include <AliOADBContainer.h>
 #include "AliEmcalList.h"
@@ -16,6 +17,7 @@
 #include "AliParticleContainer.h"
 #include "AliMCParticleContainer.h"
 #include "AliDataFile.h"
+#include "AliEmcalCorrectionCellCalibrationTable.h"
 
 /// \cond CLASSIMP
 ClassImp(AliEmcalCorrectionComponent);
@@ -227,6 +229,105 @@ void AliEmcalCorrectionComponent::UpdateCells()
   fCaloCells->Sort();
 }
 
+/**
+ * Prepare the component for a fused cell correction of the current event. This performs the same
+ * per event steps as Run() before the cells are updated, namely determining the pass and loading
+ * the run dependent calibrations.
+ *
+ * @return Run number of the current event, or -1 if the event is not available
+ */
+Int_t AliEmcalCorrectionComponent::PrepareCellCorrection()
+{
+  if (!fEventManager.InputEvent()) {
+    AliError("Event ptr = 0, returning");
+    return -1;
+  }
+
+  if(fGetPassFromFileName)
+    GetPass();
+
+  CheckIfRunChanged();
+
+  return fRun;
+}
+
+/**
+ * Add the cell correction of this component to a fused calibration table. The reco utils of the
+ * component are applied to a set of probe cells containing every cell ID with unit energy and
+ * zero time, separately for high and low gain and for each bunch crossing slot. The resulting
+ * energy and time then correspond to the calibration factor and time shift of each cell, while
+ * rejected cells are identified by E = 0 and t = -1 as set by AliEMCALRecoUtils::RecalibrateCells().
+ *
+ * @param[in,out] table Calibration table to be updated. It is initialized if it is empty.
+ */
+void AliEmcalCorrectionComponent::AddToCellCalibrationTable(AliEmcalCorrectionCellCalibrationTable & table)
+{
+  if (!fGeom || !fRecoUtils) {
+    AliError("Geometry or reco utils not available, cannot fill the cell calibration table");
+    return;
+  }
+
+  Int_t nCells = fGeom->GetNCells();
+  if (table.GetNumberOfCells() == 0)
+    table.Reset(nCells);
+
+  ConfigureRecoUtilsForCellCorrection();
+
+  AliAODCaloCells probeCells("probeCells", "probeCells", AliVCaloCells::kEMCALCell);
+  probeCells.CreateContainer(nCells);
+
+  Short_t  absId   = -1;
+  Double_t ecell   = 0;
+  Double_t tcell   = 0;
+  Double_t efrac   = 0;
+  Int_t    mclabel = -1;
+
+  for (Int_t iGain = 0; iGain < 2; iGain++)
+  {
+    Bool_t isHighGain = (iGain == 0);
+    for (Int_t bcSlot = 0; bcSlot < AliEmcalCorrectionCellCalibrationTable::kNBCSlots; bcSlot++)
+    {
+      for (Int_t iCell = 0; iCell < nCells; iCell++)
+        probeCells.SetCell(iCell, iCell, 1., 0., -1, 0., isHighGain);
+      probeCells.Sort();
+
+      fRecoUtils->ResetCellsCalibrated();
+      fRecoUtils->RecalibrateCells(&probeCells, AliEmcalCorrectionCellCalibrationTable::GetBCFromSlot(bcSlot));
+
+      for (Int_t iCell = 0; iCell < nCells; iCell++)
+      {
+        probeCells.GetCell(iCell, absId, ecell, tcell, mclabel, efrac);
+        Bool_t accepted = !(ecell == 0 && tcell == -1);
+        table.AddCorrectionStep(isHighGain, bcSlot, absId, accepted, ecell, tcell);
+      }
+    }
+  }
+  fRecoUtils->ResetCellsCalibrated();
+}
+
+/**
+ * Apply a fused cell calibration table to the cells of this component. Replaces UpdateCells()
+ * for all of the components which are fused in the table.
+ *
+ * @param[in] table Calibration table to be applied
+ *
+ * @return True if the cells were corrected
+ */
+Bool_t AliEmcalCorrectionComponent::ApplyCellCalibrationTable(const AliEmcalCorrectionCellCalibrationTable & table)
+{
+  if (!fEventManager.InputEvent()) return kFALSE;
+
+  if (fCaloCells->GetNumberOfCells()<=0)
+  {
+    AliDebug(2, Form("Number of EMCAL cells = %d, returning", fCaloCells->GetNumberOfCells()));
+    return kFALSE;
+  }
+
+  table.Apply(fCaloCells, fEventManager.InputEvent()->GetBunchCrossNumber());
+
+  return kTRUE;
+}
+
 /**
  * Check whether the run changed.
  */
@@ -13,6 +13,7 @@ class AliVCaloCells;
 class AliVTrack;
 class AliVCluster;
 class AliVEvent;
+class AliEmcalCorrectionCellCalibrationTable;
 #include <AliLog.h>
 #include <AliEMCALGeometry.h>
 #include "AliYAMLConfiguration.h"
@@ -60,6 +61,15 @@ class AliEmcalCorrectionComponent : public TNamed {
   void FillCellQA(TH1F* h);
   Int_t InitBadChannels();
 
+  // Fused cell corrections
+  /// True if the cell correction of the component can be fused with other cell components (see AliEmcalCorrectionCellCalibrationTable)
+  virtual Bool_t IsCellCorrectionFusable() const { return kFALSE; }
+  /// Switch on the corrections in the reco utils which are applied by the component to the cells
+  virtual void ConfigureRecoUtilsForCellCorrection() {}
+  Int_t PrepareCellCorrection();
+  void AddToCellCalibrationTable(AliEmcalCorrectionCellCalibrationTable & table);
+  Bool_t ApplyCellCalibrationTable(const AliEmcalCorrectionCellCalibrationTable & table);
+
   // Containers and cells
   AliParticleContainer   *AddParticleContainer(const char *n)                    { return AliEmcalContainerUtils::AddContainer<AliParticleContainer>(n, fParticleCollArray); }
   AliTrackContainer      *AddTrackContainer(const char *n)                       { return AliEmcalContainerUtils::AddContainer<AliTrackContainer>(n, fParticleCollArray); }
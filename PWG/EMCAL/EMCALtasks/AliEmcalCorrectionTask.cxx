@@ -5,6 +5,7 @@
 
 #include "AliEmcalCorrectionTask.h"
 #include "AliEmcalCorrectionComponent.h"
+#include "AliEmcalCorrectionCellCalibrationTable.h"
 
 #include <vector>
 #include <set>
@@ -46,6 +47,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask() :
   fOrderedComponentsToExecute(),
   fCorrectionComponents(),
   fConfigurationInitialized(false),
+  fFuseCellCorrections(kFALSE),
+  fCellCalibrationTables(),
   fIsEsd(false),
   fEventInitialized(false),
   fCent(0),
@@ -91,6 +94,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const char * name) :
   fOrderedComponentsToExecute(),
   fCorrectionComponents(),
   fConfigurationInitialized(false),
+  fFuseCellCorrections(kFALSE),
+  fCellCalibrationTables(),
   fIsEsd(false),
   fEventInitialized(false),
   fCent(0),
@@ -136,6 +141,8 @@ AliEmcalCorrectionTask::AliEmcalCorrectionTask(const AliEmcalCorrectionTask & ta
   fOrderedComponentsToExecute(task.fOrderedComponentsToExecute),
   fCorrectionComponents(task.fCorrectionComponents),  // TODO: These should be copied!
   fConfigurationInitialized(task.fConfigurationInitialized),
+  fFuseCellCorrections(task.fFuseCellCorrections),
+  fCellCalibrationTables(),
   fIsEsd(task.fIsEsd),
   fEventInitialized(task.fEventInitialized),
   fCent(task.fCent),
@@ -199,6 +206,8 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
   swap(first.fOrderedComponentsToExecute, second.fOrderedComponentsToExecute);
   swap(first.fCorrectionComponents, second.fCorrectionComponents);
   swap(first.fConfigurationInitialized, second.fConfigurationInitialized);
+  swap(first.fFuseCellCorrections, second.fFuseCellCorrections);
+  swap(first.fCellCalibrationTables, second.fCellCalibrationTables);
   swap(first.fIsEsd, second.fIsEsd);
   swap(first.fEventInitialized, second.fEventInitialized);
   swap(first.fCent, second.fCent);
@@ -227,6 +236,10 @@ void swap(AliEmcalCorrectionTask & first, AliEmcalCorrectionTask & second)
 AliEmcalCorrectionTask::~AliEmcalCorrectionTask()
 {
   // Destructor
+  for (auto table : fCellCalibrationTables)
+  {
+    delete table;
+  }
 }
 
 void AliEmcalCorrectionTask::Initialize(bool removeDummyTask)
@@ -274,6 +287,12 @@ void AliEmcalCorrectionTask::Initialize(bool removeDummyTask)
   // Determine component execution order
   DetermineComponentsToExecute(fOrderedComponentsToExecute);
 
+  // Determine whether cell corrections should be fused. Not required, so the value set by the user is kept if it is not available.
+  bool fuseCellCorrections = fFuseCellCorrections;
+  if (fYAMLConfig.GetProperty("fuseCellCorrections", fuseCellCorrections, false)) {
+    fFuseCellCorrections = fuseCellCorrections;
+  }
+
   // Check for user defined settings that are not in the default file
   CheckForUnmatchedUserSettings();
 
@@ -1204,6 +1223,63 @@ void AliEmcalCorrectionTask::ExecOnceComponents()
       AddContainersToComponent(component, AliEmcalContainerUtils::kCaloCells, true);
     }
   }
+
+  if (fFuseCellCorrections) {
+    SetupFusedCellCorrections();
+  }
+}
+
+/**
+ * Groups consecutive cell correction components which can be fused (see
+ * AliEmcalCorrectionComponent::IsCellCorrectionFusable()) and operate on the same cells
+ * into calibration tables. Each group is then executed in a single pass over the cells
+ * using a flat, cell ID indexed calibration table which is built once per run.
+ */
+void AliEmcalCorrectionTask::SetupFusedCellCorrections()
+{
+  AliEmcalCorrectionCellCalibrationTable * table = nullptr;
+  AliVCaloCells * tableCells = nullptr;
+  for (auto component : fCorrectionComponents)
+  {
+    AliVCaloCells * cells = component->GetCaloCells();
+    if (!cells || !component->IsCellCorrectionFusable()) {
+      table = nullptr;
+      continue;
+    }
+    if (!table || cells != tableCells) {
+      table = new AliEmcalCorrectionCellCalibrationTable;
+      tableCells = cells;
+      fCellCalibrationTables.push_back(table);
+    }
+    table->AddComponent(component);
+  }
+
+  for (auto fusedTable : fCellCalibrationTables)
+  {
+    std::stringstream components;
+    for (auto component : fusedTable->GetComponents()) {
+      components << " " << component->GetName();
+    }
+    AliInfoStream() << "Fusing cell corrections:" << components.str() << "\n";
+  }
+}
+
+/**
+ * Retrieve the fused calibration table which contains a component.
+ *
+ * @param[in] component Correction component
+ *
+ * @return The calibration table, or nullptr if the component is not fused
+ */
+AliEmcalCorrectionCellCalibrationTable * AliEmcalCorrectionTask::GetCellCalibrationTable(const AliEmcalCorrectionComponent * component) const
+{
+  for (auto table : fCellCalibrationTables)
+  {
+    if (table->Contains(component)) {
+      return table;
+    }
+  }
+  return nullptr;
 }
 
 /**
@@ -1306,6 +1382,8 @@ Bool_t AliEmcalCorrectionTask::RetrieveEventObjects()
 Bool_t AliEmcalCorrectionTask::Run()
 {
   // Run the initialization for all derived classes.
+  // The event properties are set for all components first, as fused cell corrections
+  // are executed together when the first component of the group is reached.
   for (auto component : fCorrectionComponents)
   {
     component->SetInputEvent(InputEvent());
@@ -1313,6 +1391,17 @@ Bool_t AliEmcalCorrectionTask::Run()
     component->SetCentralityBin(fCentBin);
     component->SetCentrality(fCent);
     component->SetVertex(fVertex);
+  }
+
+  for (auto component : fCorrectionComponents)
+  {
+    AliEmcalCorrectionCellCalibrationTable * table = GetCellCalibrationTable(component);
+    if (table) {
+      if (component == table->GetComponents().front()) {
+        table->Run();
+      }
+      continue;
+    }
 
     component->Run();
   }
@@ -2,6 +2,7 @@
 #define ALIEMCALCORRECTIONTASK_H
 
 class AliEmcalCorrectionCellContainer;
+class AliEmcalCorrectionCellCalibrationTable;
 class AliEmcalCorrectionComponent;
 class AliEMCALGeometry;
 class AliVEvent;
@@ -100,6 +101,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Set
   void                        SetForceBeamType(BeamType f)                          { fForceBeamType     = f                              ; }
   void                        SetNeedEmcalGeometry(Bool_t b)                        { fNeedEmcalGeom     = b                              ; }
+  void                        SetFuseCellCorrections(Bool_t b)                      { fFuseCellCorrections = b                            ; }
   // Centrality options
   void                        SetUseNewCentralityEstimation(Bool_t b)               { fUseNewCentralityEstimation = b                     ; }
   void                        SetCentralityEstimator(const char * c)                { fCentEst           = c                              ; }
@@ -191,6 +193,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   // Execute component functions
   void UserCreateOutputObjectsComponents();
   void ExecOnceComponents();
+  void SetupFusedCellCorrections();
+  AliEmcalCorrectionCellCalibrationTable * GetCellCalibrationTable(const AliEmcalCorrectionComponent * component) const;
 
   // Initialization functions
   void InitializeConfiguration();
@@ -225,6 +229,8 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   std::vector <std::string>   fOrderedComponentsToExecute; ///< Ordered set of components to execute
   std::vector <AliEmcalCorrectionComponent *> fCorrectionComponents; ///< Contains the correction components
   bool                        fConfigurationInitialized;   ///< True if the %YAML configuration files are initialized
+  Bool_t                      fFuseCellCorrections;        ///< Fuse compatible consecutive cell corrections into a single pass over the cells
+  std::vector <AliEmcalCorrectionCellCalibrationTable *> fCellCalibrationTables; //!<! Calibration tables of the fused cell corrections
 
   bool                        fIsEsd;                      ///< File type
   bool                        fEventInitialized;           ///< If the event is initialized properly
@@ -249,7 +255,7 @@ class AliEmcalCorrectionTask : public AliAnalysisTaskSE {
   TList *                     fOutput;                     //!<! Output for histograms
 
   /// \cond CLASSIMP
-  ClassDef(AliEmcalCorrectionTask, 9); // EMCal correction task
+  ClassDef(AliEmcalCorrectionTask, 10); // EMCal correction task
   /// \endcond
 };
 
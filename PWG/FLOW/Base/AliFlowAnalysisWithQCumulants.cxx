@@ -42,6 +42,7 @@
 #include "TCanvas.h"
 #include "AliFlowEventSimple.h"
 #include "AliFlowTrackSimple.h"
+#include "AliFlowQVectorBundle.h"
 #include "AliFlowAnalysisWithQCumulants.h"
 #include "TArrayD.h"
 #include "TRandom.h"
@@ -131,6 +132,7 @@ AliFlowAnalysisWithQCumulants::AliFlowAnalysisWithQCumulants():
  fForgetAboutCovariances(kFALSE), 
  fStorePhiDistributionForOneEvent(kFALSE),
  fExactNoRPs(0),
+ fUseQVectorBundle(kFALSE),
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
@@ -379,6 +381,32 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
  Int_t nPrim = anEvent->NumberOfTracks();  // nPrim = total number of primary tracks
  AliFlowTrackSimple *aftsTrack = NULL;
  Int_t n = fHarmonic; // shortcut for the harmonic 
+ // Q_{m*n,k} and S_{p,k} from the bundle shared with the other methods, same sums in the same order:
+ const AliFlowQVectorBundle *qBundle = NULL;
+ if(fUseQVectorBundle && fExactNoRPs <= 0)
+ {
+  AliFlowQVectorBundle qSetup(n,12,9);
+  if(fUsePhiWeights && fPhiWeights && fnBinsPhi){qSetup.SetPhiWeights(fPhiWeights,fnBinsPhi);}
+  if(fUsePtWeights && fPtWeights && fnBinsPt){qSetup.SetPtWeights(fPtWeights,fPtMin,fPtBinWidth);}
+  if(fUseEtaWeights && fEtaWeights && fEtaBinWidth){qSetup.SetEtaWeights(fEtaWeights,fEtaMin,fEtaBinWidth);}
+  qSetup.SetUseTrackWeights(fUseTrackWeights);
+  qBundle = anEvent->GetQVectorBundle(qSetup);
+  for(Int_t m=0;m<12;m++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fReQ)(m,k) = qBundle->ReQ(m,k);
+    (*fImQ)(m,k) = qBundle->ImQ(m,k);
+   }
+  }
+  for(Int_t p=0;p<8;p++)
+  {
+   for(Int_t k=0;k<9;k++)
+   {
+    (*fSpk)(p,k) = qBundle->S(k);
+   }
+  }
+ } // end of if(fUseQVectorBundle && fExactNoRPs <= 0)
  for(Int_t i=0;i<nPrim;i++) 
  { 
   if(fExactNoRPs > 0 && nCounterNoRPs>fExactNoRPs){continue;}
@@ -410,7 +438,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      wTrack = aftsTrack->Weight(); 
     }
     // Calculate Re[Q_{m*n,k}] and Im[Q_{m*n,k}] for this event (m = 1,2,...,12, k = 0,1,...,8):
-    for(Int_t m=0;m<12;m++) // to be improved - hardwired 6 
+    for(Int_t m=0;m<12 && !qBundle;m++) // to be improved - hardwired 6 
     {
      for(Int_t k=0;k<9;k++) // to be improved - hardwired 9
      {
@@ -419,7 +447,7 @@ void AliFlowAnalysisWithQCumulants::Make(AliFlowEventSimple* anEvent)
      } 
     }
     // Calculate S_{p,k} for this event (Remark: final calculation of S_{p,k} follows after the loop over data bellow):
-    for(Int_t p=0;p<8;p++)
+    for(Int_t p=0;p<8 && !qBundle;p++)
     {
      for(Int_t k=0;k<9;k++)
      {     
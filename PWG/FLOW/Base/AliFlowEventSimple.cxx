@@ -42,6 +42,7 @@
 #include "AliFlowTrackSimple.h"
 #include "AliFlowTrackSimpleCuts.h"
 #include "AliFlowEventSimple.h"
+#include "AliFlowQVectorBundle.h"
 #include "TRandom.h"
 #include <random>
 
@@ -88,6 +89,13 @@ AliFlowEventSimple::AliFlowEventSimple():
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fPackedPhi(),
+  fPackedPt(),
+  fPackedEta(),
+  fPackedWeight(),
+  fPackedFlags(),
+  fPackedTracksValid(kFALSE),
+  fQVectorBundles(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(NULL)
 {
@@ -147,6 +155,13 @@ AliFlowEventSimple::AliFlowEventSimple( Int_t n,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fPackedPhi(),
+  fPackedPt(),
+  fPackedEta(),
+  fPackedWeight(),
+  fPackedFlags(),
+  fPackedTracksValid(kFALSE),
+  fQVectorBundles(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -210,6 +225,13 @@ AliFlowEventSimple::AliFlowEventSimple(const AliFlowEventSimple& anEvent):
   fZPCM(anEvent.fZPCM),
   fZPAM(anEvent.fZPAM),
   fAbsOrbit(anEvent.fAbsOrbit),
+  fPackedPhi(),
+  fPackedPt(),
+  fPackedEta(),
+  fPackedWeight(),
+  fPackedFlags(),
+  fPackedTracksValid(kFALSE),
+  fQVectorBundles(NULL),
   fNumberOfPOItypes(anEvent.fNumberOfPOItypes),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -306,7 +328,8 @@ AliFlowEventSimple& AliFlowEventSimple::operator=(const AliFlowEventSimple& anEv
     fV0C[i] = anEvent.fV0C[i];
     fV0A[i] = anEvent.fV0A[i];
   }
-  delete [] fShuffledIndexes;
+  delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateCache();
   return *this;
 }
 
@@ -323,6 +346,8 @@ AliFlowEventSimple::~AliFlowEventSimple()
   delete fShuffledIndexes;
   delete fMothersCollection;
   delete [] fNumberOfPOIs;
+  if (fQVectorBundles) fQVectorBundles->Delete();
+  delete fQVectorBundles;
 }
 
 //-----------------------------------------------------------------------
@@ -444,6 +469,7 @@ void AliFlowEventSimple::ShuffleTracks()
   std::random_device rd;
   std::default_random_engine engine{rd()};
   std::shuffle(&fShuffledIndexes[0], &fShuffledIndexes[fNumberOfTracks],engine);
+  InvalidateCache();
   Printf("Tracks shuffled! tracks: %i",fNumberOfTracks);
 }
 
@@ -475,6 +501,74 @@ void AliFlowEventSimple::TrackAdded()
     delete [] fShuffledIndexes;
     fShuffledIndexes=NULL;
   }
+  InvalidateCache();
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::InvalidateCache()
+{
+  //drop the packed tracks and the cached Q-vector bundles,
+  //to be called whenever tracks or their tags are changed
+  fPackedTracksValid = kFALSE;
+  if (fQVectorBundles) fQVectorBundles->Delete();
+}
+
+//-----------------------------------------------------------------------
+void AliFlowEventSimple::FillPackedTracks()
+{
+  //copy kinematics, weights and tags of all tracks into flat arrays,
+  //in the order given by GetTrack(); nothing to do if still valid
+  if (fPackedTracksValid && (Int_t)fPackedPhi.size()==fNumberOfTracks) return;
+  if (fShuffleTracks && !fShuffledIndexes) ShuffleTracks();
+  fPackedPhi.resize(fNumberOfTracks);
+  fPackedPt.resize(fNumberOfTracks);
+  fPackedEta.resize(fNumberOfTracks);
+  fPackedWeight.resize(fNumberOfTracks);
+  fPackedFlags.resize(fNumberOfTracks);
+  for (Int_t i=0; i<fNumberOfTracks; i++)
+  {
+    AliFlowTrackSimple* track = GetTrack(i);
+    if (!track)
+    {
+      fPackedPhi[i] = fPackedPt[i] = fPackedEta[i] = fPackedWeight[i] = 0.;
+      fPackedFlags[i] = 0;
+      continue;
+    }
+    fPackedPhi[i] = track->Phi();
+    fPackedPt[i] = track->Pt();
+    fPackedEta[i] = track->Eta();
+    fPackedWeight[i] = track->Weight();
+    UChar_t flags = 0;
+    if (track->InRPSelection()) flags |= kPackedRP;
+    if (track->InPOISelection()) flags |= kPackedPOI;
+    if (track->InSubevent(0)) flags |= kPackedSubevent0;
+    if (track->InSubevent(1)) flags |= kPackedSubevent1;
+    fPackedFlags[i] = flags;
+  }
+  fPackedTracksValid = kTRUE;
+}
+
+//-----------------------------------------------------------------------
+const AliFlowQVectorBundle* AliFlowEventSimple::GetQVectorBundle(const AliFlowQVectorBundle& setup)
+{
+  //return the Q-vectors for the given setup, calculated once per event:
+  //a cached bundle is reused by every method asking for the same
+  //(or a smaller) set of harmonics and powers with the same weights
+  if (!fPackedTracksValid || (Int_t)fPackedPhi.size()!=fNumberOfTracks) InvalidateCache();
+  if (!fQVectorBundles)
+  {
+    fQVectorBundles = new TObjArray();
+    fQVectorBundles->SetOwner(kTRUE);
+  }
+  for (Int_t i=0; i<fQVectorBundles->GetEntriesFast(); i++)
+  {
+    AliFlowQVectorBundle* bundle = static_cast<AliFlowQVectorBundle*>(fQVectorBundles->At(i));
+    if (bundle && bundle->Covers(setup)) return bundle;
+  }
+  AliFlowQVectorBundle* bundle = new AliFlowQVectorBundle(setup);
+  bundle->Fill(this);
+  fQVectorBundles->Add(bundle);
+  return bundle;
 }
 
 //-----------------------------------------------------------------------
@@ -896,6 +990,13 @@ AliFlowEventSimple::AliFlowEventSimple( TTree* inputTree,
   fZPCM(0.),
   fZPAM(0.),
   fAbsOrbit(0),
+  fPackedPhi(),
+  fPackedPt(),
+  fPackedEta(),
+  fPackedWeight(),
+  fPackedFlags(),
+  fPackedTracksValid(kFALSE),
+  fQVectorBundles(NULL),
   fNumberOfPOItypes(2),
   fNumberOfPOIs(new Int_t[fNumberOfPOItypes])
 {
@@ -1001,6 +1102,7 @@ void AliFlowEventSimple::TagSubeventsInEta( Double_t etaMinA,
     if (eta >= etaMinA && eta <= etaMaxA) track->SetForSubevent(0);
     if (eta >= etaMinB && eta <= etaMaxB) track->SetForSubevent(1);
   }
+  InvalidateCache();
 }
 
 //_____________________________________________________________________________
@@ -1016,6 +1118,7 @@ void AliFlowEventSimple::TagSubeventsByCharge()
     if (charge<0) track->SetForSubevent(0);
     if (charge>0) track->SetForSubevent(1);
   }
+  InvalidateCache();
 }
 
 //_____________________________________________________________________________
@@ -1176,6 +1279,7 @@ void AliFlowEventSimple::TagRP( const AliFlowTrackSimpleCuts* cuts )
     }
     track->SetForRPSelection(pass);
   }
+  InvalidateCache();
 }
 
 //_____________________________________________________________________________
@@ -1198,6 +1302,7 @@ void AliFlowEventSimple::TagPOI( const AliFlowTrackSimpleCuts* cuts, Int_t poiTy
     }
     track->Tag(poiType,pass);
   }
+  InvalidateCache();
 }
 
 //_____________________________________________________________________________
@@ -1230,6 +1335,7 @@ void AliFlowEventSimple::DefineDeadZone( Double_t etaMin,
       track->ResetPOItype();
     }
   }
+  InvalidateCache();
 }
 
 //_____________________________________________________________________________
@@ -1247,6 +1353,7 @@ Int_t AliFlowEventSimple::CleanUpDeadTracks()
   fTrackCollection->Compress(); //clean up empty slots
   fNumberOfTracks-=ncleaned; //update number of tracks
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateCache();
   return ncleaned;
 }
 
@@ -1286,4 +1393,5 @@ void AliFlowEventSimple::ClearFast()
   fAfterBurnerPrecision = 0.001;
   fUserModified = kFALSE;
   delete [] fShuffledIndexes; fShuffledIndexes=NULL;
+  InvalidateCache();
 }
@@ -20,17 +20,20 @@
 #include "TParameter.h"
 #include "TMath.h"
 #include "AliFlowVector.h"
+#include <vector>
 class TTree;
 class TF1;
 class TF2;
 class AliFlowTrackSimple;
 class AliFlowTrackSimpleCuts;
+class AliFlowQVectorBundle;
 
 class AliFlowEventSimple: public TObject {
 
  public:
 
   enum ConstructionMethod {kEmpty,kGenerate};
+  enum PackedTrackFlag {kPackedRP=BIT(0),kPackedPOI=BIT(1),kPackedSubevent0=BIT(2),kPackedSubevent1=BIT(3)};
 
   AliFlowEventSimple();
   AliFlowEventSimple( Int_t nParticles,
@@ -82,7 +85,7 @@ class AliFlowEventSimple: public TObject {
   Bool_t   IsSetMCReactionPlaneAngle() const        { return fMCReactionPlaneAngleIsSet; }
   void     SetAfterBurnerPrecision(Double_t p)      { fAfterBurnerPrecision=p; }
   Double_t GetAfterBurnerPrecision() const          { return fAfterBurnerPrecision; }
-  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; }
+  void     SetUserModified(Bool_t s=kTRUE)          { fUserModified=s; InvalidateCache(); }
   Bool_t   IsUserModified() const                   { return fUserModified; }
   void     SetShuffleTracks(Bool_t b)               {fShuffleTracks=b;}
   void     ShuffleTracks();
@@ -117,6 +120,18 @@ class AliFlowEventSimple: public TObject {
   void TrackAdded();
   AliFlowTrackSimple* MakeNewTrack();
 
+  // packed (structure of arrays) copy of the tracks in GetTrack() order, filled on demand:
+  void            FillPackedTracks();
+  Int_t           GetNumberOfPackedTracks() const { return fPackedPhi.size(); }
+  const Double_t* GetPackedPhi() const            { return fPackedPhi.data(); }
+  const Double_t* GetPackedPt() const             { return fPackedPt.data(); }
+  const Double_t* GetPackedEta() const            { return fPackedEta.data(); }
+  const Double_t* GetPackedWeight() const         { return fPackedWeight.data(); }
+  const UChar_t*  GetPackedFlags() const          { return fPackedFlags.data(); }
+  // Q-vectors for several harmonics and powers, shared between the analysis methods:
+  const AliFlowQVectorBundle* GetQVectorBundle(const AliFlowQVectorBundle& setup);
+  void            InvalidateCache();
+
   virtual AliFlowVector GetQ(Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void Get2Qsub(AliFlowVector* Qarray, Int_t n=2, TList *weightsList=NULL, Bool_t usePhiWeights=kFALSE, Bool_t usePtWeights=kFALSE, Bool_t useEtaWeights=kFALSE);
   virtual void GetZDC2Qsub(AliFlowVector* Qarray);
@@ -204,12 +219,19 @@ class AliFlowEventSimple: public TObject {
   Double_t                fZPAM;                      // total energy from ZPC-A
   Double_t                fVtxPos[3];                 // Primary vertex position (x,y,z)
   UInt_t                  fAbsOrbit;                  // Absolute orbit number
+  std::vector<Double_t>   fPackedPhi;                 //! packed track phi
+  std::vector<Double_t>   fPackedPt;                  //! packed track pt
+  std::vector<Double_t>   fPackedEta;                 //! packed track eta
+  std::vector<Double_t>   fPackedWeight;              //! packed track weight
+  std::vector<UChar_t>    fPackedFlags;               //! packed track PackedTrackFlag bits
+  Bool_t                  fPackedTracksValid;         //! packed tracks are up to date
+  TObjArray*              fQVectorBundles;            //! cached AliFlowQVectorBundle's of this event
 
  private:
   Int_t                   fNumberOfPOItypes;    // how many different flow particle types do we have? (RP,POI,POI_2,...)
   Int_t*                  fNumberOfPOIs;          //[fNumberOfPOItypes] number of tracks that have passed the POI selection
 
-  ClassDef(AliFlowEventSimple,7)
+  ClassDef(AliFlowEventSimple,8)
 };
 
 #endif
@@ -0,0 +1,299 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+/*****************************************************************
+  AliFlowQVectorBundle: Q-vectors and weight sums of one event
+  for several harmonics and powers of the weights, calculated
+  in a single pass over the packed tracks of AliFlowEventSimple.
+
+  The sums are the ones of AliFlowAnalysisWithQCumulants::Make():
+    Re[Q_{m*n,k}] = sum_RP w^k cos(m*n*phi)
+    Im[Q_{m*n,k}] = sum_RP w^k sin(m*n*phi)
+    S_k           = sum_RP w^k
+  with w = wPhi*wPt*wEta*wTrack, evaluated with the same
+  expressions, so results do not change when switching.
+  For the differential sums POIs which are not RPs get w = 1.
+*****************************************************************/
+
+#include "TH1.h"
+#include "TMath.h"
+#include "AliFlowEventSimple.h"
+#include "AliFlowQVectorBundle.h"
+
+ClassImp(AliFlowQVectorBundle)
+
+//-----------------------------------------------------------------------
+AliFlowQVectorBundle::AliFlowQVectorBundle(Int_t harmonic, Int_t nHarmonics, Int_t nPowers):
+  TObject(),
+  fHarmonic(harmonic),
+  fNHarmonics(nHarmonics),
+  fNPowers(nPowers),
+  fPhiWeights(NULL),
+  fNBinsPhi(0),
+  fPtWeights(NULL),
+  fPtMin(0.),
+  fPtBinWidth(0.),
+  fEtaWeights(NULL),
+  fEtaMin(0.),
+  fEtaBinWidth(0.),
+  fUseTrackWeights(kFALSE),
+  fNDiffHarmonics(0),
+  fNMaxBins(0),
+  fNRPs(0),
+  fReQ(),
+  fImQ(),
+  fS(),
+  fDiffReQ(),
+  fDiffImQ(),
+  fDiffS(),
+  fDiffEntries()
+{
+  //ctor
+  for (Int_t pe=0; pe<2; pe++)
+  {
+    fNBins[pe] = 0;
+    fMin[pe] = 0.;
+    fMax[pe] = 0.;
+  }
+}
+
+//-----------------------------------------------------------------------
+AliFlowQVectorBundle::AliFlowQVectorBundle(const AliFlowQVectorBundle& bundle):
+  TObject(bundle),
+  fHarmonic(bundle.fHarmonic),
+  fNHarmonics(bundle.fNHarmonics),
+  fNPowers(bundle.fNPowers),
+  fPhiWeights(bundle.fPhiWeights),
+  fNBinsPhi(bundle.fNBinsPhi),
+  fPtWeights(bundle.fPtWeights),
+  fPtMin(bundle.fPtMin),
+  fPtBinWidth(bundle.fPtBinWidth),
+  fEtaWeights(bundle.fEtaWeights),
+  fEtaMin(bundle.fEtaMin),
+  fEtaBinWidth(bundle.fEtaBinWidth),
+  fUseTrackWeights(bundle.fUseTrackWeights),
+  fNDiffHarmonics(bundle.fNDiffHarmonics),
+  fNMaxBins(bundle.fNMaxBins),
+  fNRPs(bundle.fNRPs),
+  fReQ(bundle.fReQ),
+  fImQ(bundle.fImQ),
+  fS(bundle.fS),
+  fDiffReQ(bundle.fDiffReQ),
+  fDiffImQ(bundle.fDiffImQ),
+  fDiffS(bundle.fDiffS),
+  fDiffEntries(bundle.fDiffEntries)
+{
+  //copy constructor
+  for (Int_t pe=0; pe<2; pe++)
+  {
+    fNBins[pe] = bundle.fNBins[pe];
+    fMin[pe] = bundle.fMin[pe];
+    fMax[pe] = bundle.fMax[pe];
+  }
+}
+
+//-----------------------------------------------------------------------
+AliFlowQVectorBundle& AliFlowQVectorBundle::operator=(const AliFlowQVectorBundle& bundle)
+{
+  //assignment operator
+  if (&bundle==this) return *this;
+  TObject::operator=(bundle);
+  fHarmonic = bundle.fHarmonic;
+  fNHarmonics = bundle.fNHarmonics;
+  fNPowers = bundle.fNPowers;
+  fPhiWeights = bundle.fPhiWeights;
+  fNBinsPhi = bundle.fNBinsPhi;
+  fPtWeights = bundle.fPtWeights;
+  fPtMin = bundle.fPtMin;
+  fPtBinWidth = bundle.fPtBinWidth;
+  fEtaWeights = bundle.fEtaWeights;
+  fEtaMin = bundle.fEtaMin;
+  fEtaBinWidth = bundle.fEtaBinWidth;
+  fUseTrackWeights = bundle.fUseTrackWeights;
+  fNDiffHarmonics = bundle.fNDiffHarmonics;
+  for (Int_t pe=0; pe<2; pe++)
+  {
+    fNBins[pe] = bundle.fNBins[pe];
+    fMin[pe] = bundle.fMin[pe];
+    fMax[pe] = bundle.fMax[pe];
+  }
+  fNMaxBins = bundle.fNMaxBins;
+  fNRPs = bundle.fNRPs;
+  fReQ = bundle.fReQ;
+  fImQ = bundle.fImQ;
+  fS = bundle.fS;
+  fDiffReQ = bundle.fDiffReQ;
+  fDiffImQ = bundle.fDiffImQ;
+  fDiffS = bundle.fDiffS;
+  fDiffEntries = bundle.fDiffEntries;
+  return *this;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorBundle::SetDifferential(Int_t nHarmonics, Int_t nBinsPt, Double_t ptMin, Double_t ptMax,
+                                           Int_t nBinsEta, Double_t etaMin, Double_t etaMax)
+{
+  //request the pt and eta differential sums for harmonics m*n, m = 1,...,nHarmonics,
+  //nHarmonics = 0 switches them off
+  if (nHarmonics>0 && (nBinsPt<1 || ptMax<=ptMin || nBinsEta<1 || etaMax<=etaMin))
+  {
+    printf("\n WARNING (AliFlowQVectorBundle::SetDifferential): wrong binning, differential sums switched off !!!!\n\n");
+    nHarmonics = 0;
+  }
+  fNDiffHarmonics = nHarmonics>0 ? nHarmonics : 0;
+  fNBins[0] = fNDiffHarmonics ? nBinsPt : 0;
+  fMin[0] = ptMin;
+  fMax[0] = ptMax;
+  fNBins[1] = fNDiffHarmonics ? nBinsEta : 0;
+  fMin[1] = etaMin;
+  fMax[1] = etaMax;
+  fNMaxBins = TMath::Max(fNBins[0],fNBins[1]);
+}
+
+//-----------------------------------------------------------------------
+Bool_t AliFlowQVectorBundle::Covers(const AliFlowQVectorBundle& setup) const
+{
+  //can the sums of this bundle be used for the given setup:
+  //same harmonic and weights, at least as many harmonics and powers
+  if (fHarmonic!=setup.fHarmonic) return kFALSE;
+  if (fNHarmonics<setup.fNHarmonics || fNPowers<setup.fNPowers) return kFALSE;
+  if (fPhiWeights!=setup.fPhiWeights || fNBinsPhi!=setup.fNBinsPhi) return kFALSE;
+  if (fPtWeights!=setup.fPtWeights || fPtMin!=setup.fPtMin || fPtBinWidth!=setup.fPtBinWidth) return kFALSE;
+  if (fEtaWeights!=setup.fEtaWeights || fEtaMin!=setup.fEtaMin || fEtaBinWidth!=setup.fEtaBinWidth) return kFALSE;
+  if (fUseTrackWeights!=setup.fUseTrackWeights) return kFALSE;
+  if (setup.fNDiffHarmonics>0)
+  {
+    if (fNDiffHarmonics<setup.fNDiffHarmonics) return kFALSE;
+    for (Int_t pe=0; pe<2; pe++)
+    {
+      if (fNBins[pe]!=setup.fNBins[pe] || fMin[pe]!=setup.fMin[pe] || fMax[pe]!=setup.fMax[pe]) return kFALSE;
+    }
+  }
+  return kTRUE;
+}
+
+//-----------------------------------------------------------------------
+Double_t AliFlowQVectorBundle::Weight(Double_t phi, Double_t pt, Double_t eta, Double_t trackWeight) const
+{
+  //product of the phi, pt, eta and track weights of a RP
+  Double_t wPhi = 1.;
+  Double_t wPt  = 1.;
+  Double_t wEta = 1.;
+  Double_t wTrack = 1.;
+  if (fPhiWeights && fNBinsPhi)
+  {
+    wPhi = fPhiWeights->GetBinContent(1+(Int_t)(TMath::Floor(phi*fNBinsPhi/TMath::TwoPi())));
+  }
+  if (fPtWeights && fPtBinWidth)
+  {
+    wPt = fPtWeights->GetBinContent(1+(Int_t)(TMath::Floor((pt-fPtMin)/fPtBinWidth)));
+  }
+  if (fEtaWeights && fEtaBinWidth)
+  {
+    wEta = fEtaWeights->GetBinContent(1+(Int_t)(TMath::Floor((eta-fEtaMin)/fEtaBinWidth)));
+  }
+  if (fUseTrackWeights)
+  {
+    wTrack = trackWeight;
+  }
+  return wPhi*wPt*wEta*wTrack;
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorBundle::Fill(AliFlowEventSimple* event)
+{
+  //calculate all sums in one pass over the packed tracks of the event,
+  //in the same order as AliFlowEventSimple::GetTrack()
+  fNRPs = 0;
+  fReQ.assign(fNHarmonics*fNPowers,0.);
+  fImQ.assign(fNHarmonics*fNPowers,0.);
+  fS.assign(fNPowers,0.);
+  Int_t nDiff = kNParticleTypes*2*fNMaxBins*fNDiffHarmonics*fNPowers;
+  fDiffReQ.assign(nDiff,0.);
+  fDiffImQ.assign(nDiff,0.);
+  fDiffS.assign(nDiff,0.);
+  fDiffEntries.assign(kNParticleTypes*2*fNMaxBins,0);
+  if (!event) return;
+
+  event->FillPackedTracks();
+  const Int_t nTracks = event->GetNumberOfPackedTracks();
+  const Double_t* phi = event->GetPackedPhi();
+  const Double_t* pt  = event->GetPackedPt();
+  const Double_t* eta = event->GetPackedEta();
+  const Double_t* weight = event->GetPackedWeight();
+  const UChar_t* flags = event->GetPackedFlags();
+
+  const Int_t n = fHarmonic;
+  const Int_t nCosSin = TMath::Max(fNHarmonics,fNDiffHarmonics);
+  std::vector<Double_t> cosm(nCosSin), sinm(nCosSin), wk(fNPowers), one(fNPowers,1.);
+
+  for (Int_t i=0; i<nTracks; i++)
+  {
+    const Bool_t isRP  = flags[i] & AliFlowEventSimple::kPackedRP;
+    const Bool_t isPOI = flags[i] & AliFlowEventSimple::kPackedPOI;
+    if (!(isRP || isPOI)) continue;
+    for (Int_t m=0; m<nCosSin; m++)
+    {
+      cosm[m] = TMath::Cos((m+1)*n*phi[i]);
+      sinm[m] = TMath::Sin((m+1)*n*phi[i]);
+    }
+    if (isRP)
+    {
+      fNRPs++;
+      const Double_t w = Weight(phi[i],pt[i],eta[i],weight[i]);
+      for (Int_t k=0; k<fNPowers; k++) wk[k] = pow(w,k);
+      for (Int_t m=0; m<fNHarmonics; m++)
+      {
+        Double_t* reQ = &fReQ[m*fNPowers];
+        Double_t* imQ = &fImQ[m*fNPowers];
+        for (Int_t k=0; k<fNPowers; k++)
+        {
+          reQ[k] += wk[k]*cosm[m];
+          imQ[k] += wk[k]*sinm[m];
+        }
+      }
+      for (Int_t k=0; k<fNPowers; k++) fS[k] += wk[k];
+    }
+    if (!fNDiffHarmonics) continue;
+    const Double_t ptEta[2] = {pt[i],eta[i]};
+    for (Int_t pe=0; pe<2; pe++)
+    {
+      if (isRP) FillDiff(kRP,pe,ptEta[pe],&cosm[0],&sinm[0],&wk[0]);
+      if (isRP && isPOI) FillDiff(kRPandPOI,pe,ptEta[pe],&cosm[0],&sinm[0],&wk[0]);
+      if (isPOI) FillDiff(kPOI,pe,ptEta[pe],&cosm[0],&sinm[0],isRP ? &wk[0] : &one[0]);
+    }
+  }
+}
+
+//-----------------------------------------------------------------------
+void AliFlowQVectorBundle::FillDiff(Int_t t, Int_t pe, Double_t x, const Double_t* cosm, const Double_t* sinm, const Double_t* wk)
+{
+  //add one track to the differential sums of particle type t
+  if (x<fMin[pe] || x>=fMax[pe]) return;
+  Int_t bin = (Int_t)(TMath::Floor((x-fMin[pe])*fNBins[pe]/(fMax[pe]-fMin[pe])));
+  if (bin>=fNBins[pe]) bin = fNBins[pe]-1;
+  fDiffEntries[(t*2+pe)*fNMaxBins+bin]++;
+  for (Int_t m=0; m<fNDiffHarmonics; m++)
+  {
+    const Int_t index = DiffIndex(t,pe,bin,m,0);
+    for (Int_t k=0; k<fNPowers; k++)
+    {
+      fDiffReQ[index+k] += wk[k]*cosm[m];
+      fDiffImQ[index+k] += wk[k]*sinm[m];
+    }
+  }
+  const Int_t index = DiffIndex(t,pe,bin,0,0);
+  for (Int_t k=0; k<fNPowers; k++) fDiffS[index+k] += wk[k];
+}
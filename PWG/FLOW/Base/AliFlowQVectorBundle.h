@@ -0,0 +1,98 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+* See cxx source for full Copyright notice */
+/* $Id$ */
+
+#ifndef ALIFLOWQVECTORBUNDLE_H
+#define ALIFLOWQVECTORBUNDLE_H
+
+#include "TObject.h"
+#include <vector>
+class TH1;
+class AliFlowEventSimple;
+
+//********************************************************************
+// AliFlowQVectorBundle:                                             *
+// Q-vectors Q_{m*n,k} = sum_i w_i^k exp(i*m*n*phi_i) and weight     *
+// sums S_k = sum_i w_i^k of one event for a set of harmonics        *
+// m = 1,...,nHarmonics and powers k = 0,...,nPowers-1, calculated   *
+// in one pass over the tracks. Optionally also the pt and eta       *
+// differential sums for RPs, POIs and RP&&POIs (p- and q-vectors).  *
+// Bundles are cached in AliFlowEventSimple, so that all methods     *
+// asking for the same setup share the same sums, see                *
+// AliFlowEventSimple::GetQVectorBundle().                           *
+//********************************************************************
+class AliFlowQVectorBundle: public TObject {
+ public:
+  enum ParticleType {kRP, kPOI, kRPandPOI, kNParticleTypes};
+
+  AliFlowQVectorBundle(Int_t harmonic=2, Int_t nHarmonics=12, Int_t nPowers=9);
+  AliFlowQVectorBundle(const AliFlowQVectorBundle& bundle);
+  AliFlowQVectorBundle& operator=(const AliFlowQVectorBundle& bundle);
+  virtual ~AliFlowQVectorBundle() {}
+
+  // setup, the weight histograms are not owned:
+  void SetPhiWeights(TH1* h, Int_t nBinsPhi)                    { fPhiWeights=h; fNBinsPhi=nBinsPhi; }
+  void SetPtWeights(TH1* h, Double_t ptMin, Double_t binWidth)   { fPtWeights=h; fPtMin=ptMin; fPtBinWidth=binWidth; }
+  void SetEtaWeights(TH1* h, Double_t etaMin, Double_t binWidth) { fEtaWeights=h; fEtaMin=etaMin; fEtaBinWidth=binWidth; }
+  void SetUseTrackWeights(Bool_t b=kTRUE)                        { fUseTrackWeights=b; }
+  void SetDifferential(Int_t nHarmonics, Int_t nBinsPt, Double_t ptMin, Double_t ptMax,
+                       Int_t nBinsEta, Double_t etaMin, Double_t etaMax);
+
+  Int_t    GetHarmonic() const                    { return fHarmonic; }
+  Int_t    GetNHarmonics() const                  { return fNHarmonics; }
+  Int_t    GetNPowers() const                     { return fNPowers; }
+  Int_t    GetNDiffHarmonics() const              { return fNDiffHarmonics; }
+  Int_t    GetNBins(Int_t pe) const               { return fNBins[pe]; }
+  Bool_t   Covers(const AliFlowQVectorBundle& setup) const;
+
+  void     Fill(AliFlowEventSimple* event);
+  Double_t Weight(Double_t phi, Double_t pt, Double_t eta, Double_t trackWeight) const;
+
+  // integrated sums over RPs, m = 0 is harmonic n, m = 1 is 2n, ...:
+  Double_t ReQ(Int_t m, Int_t k) const            { return fReQ[m*fNPowers+k]; }
+  Double_t ImQ(Int_t m, Int_t k) const            { return fImQ[m*fNPowers+k]; }
+  Double_t S(Int_t k) const                       { return fS[k]; }
+  Int_t    GetNumberOfRPs() const                 { return fNRPs; }
+
+  // differential sums, pe = 0 for pt and 1 for eta, bin = 0,...,GetNBins(pe)-1:
+  Double_t ReQ(Int_t t, Int_t pe, Int_t bin, Int_t m, Int_t k) const { return fDiffReQ[DiffIndex(t,pe,bin,m,k)]; }
+  Double_t ImQ(Int_t t, Int_t pe, Int_t bin, Int_t m, Int_t k) const { return fDiffImQ[DiffIndex(t,pe,bin,m,k)]; }
+  Double_t S(Int_t t, Int_t pe, Int_t bin, Int_t k) const            { return fDiffS[DiffIndex(t,pe,bin,0,k)]; }
+  Int_t    Entries(Int_t t, Int_t pe, Int_t bin) const               { return fDiffEntries[(t*2+pe)*fNMaxBins+bin]; }
+
+ private:
+  Int_t DiffIndex(Int_t t, Int_t pe, Int_t bin, Int_t m, Int_t k) const
+    { return ((((t*2+pe)*fNMaxBins+bin)*fNDiffHarmonics+m)*fNPowers+k); }
+  void  FillDiff(Int_t t, Int_t pe, Double_t x, const Double_t* cosm, const Double_t* sinm, const Double_t* wk);
+
+  Int_t     fHarmonic;         // harmonic n
+  Int_t     fNHarmonics;       // number of harmonics m*n, m = 1,...,fNHarmonics
+  Int_t     fNPowers;          // number of powers k = 0,...,fNPowers-1 of the weights
+  TH1*      fPhiWeights;       // phi weights (not owned)
+  Int_t     fNBinsPhi;         // number of phi bins of the phi weights
+  TH1*      fPtWeights;        // pt weights (not owned)
+  Double_t  fPtMin;            // lower edge of the pt weights
+  Double_t  fPtBinWidth;       // bin width of the pt weights
+  TH1*      fEtaWeights;       // eta weights (not owned)
+  Double_t  fEtaMin;           // lower edge of the eta weights
+  Double_t  fEtaBinWidth;      // bin width of the eta weights
+  Bool_t    fUseTrackWeights;  // use AliFlowTrackSimple::Weight()
+  Int_t     fNDiffHarmonics;   // number of harmonics of the differential sums, 0 = none
+  Int_t     fNBins[2];         // number of pt and eta bins
+  Double_t  fMin[2];           // lower edge of pt and eta binning
+  Double_t  fMax[2];           // upper edge of pt and eta binning
+  Int_t     fNMaxBins;         // max(fNBins[0],fNBins[1])
+
+  Int_t                 fNRPs;         //! number of RPs in the sums
+  std::vector<Double_t> fReQ;          //! Re[Q_{m*n,k}]
+  std::vector<Double_t> fImQ;          //! Im[Q_{m*n,k}]
+  std::vector<Double_t> fS;            //! S_k = sum w^k
+  std::vector<Double_t> fDiffReQ;      //! differential Re[p_{m*n,k}], Re[q_{m*n,k}]
+  std::vector<Double_t> fDiffImQ;      //! differential Im[p_{m*n,k}], Im[q_{m*n,k}]
+  std::vector<Double_t> fDiffS;        //! differential s_k
+  std::vector<Int_t>    fDiffEntries;  //! tracks per differential bin
+
+  ClassDef(AliFlowQVectorBundle,1)
+};
+
+#endif
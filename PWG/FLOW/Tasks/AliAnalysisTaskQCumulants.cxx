@@ -67,6 +67,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants(const char *name, Bool_t us
  fForgetAboutCovariances(kFALSE),  
  fStorePhiDistributionForOneEvent(kFALSE),
  fExactNoRPs(0),
+ fUseQVectorBundle(kFALSE),
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
@@ -165,6 +166,7 @@ AliAnalysisTaskQCumulants::AliAnalysisTaskQCumulants():
  fForgetAboutCovariances(kFALSE), 
  fStorePhiDistributionForOneEvent(kFALSE), 
  fExactNoRPs(0),
+ fUseQVectorBundle(kFALSE),
  fUse2DHistograms(kFALSE),
  fFillProfilesVsMUsingWeights(kTRUE),
  fUseQvectorTerms(kFALSE),
@@ -252,6 +254,7 @@ void AliAnalysisTaskQCumulants::UserCreateOutputObjects()
  fQC->SetMinimumBiasReferenceFlow(fMinimumBiasReferenceFlow); 
  fQC->SetForgetAboutCovariances(fForgetAboutCovariances); 
  fQC->SetExactNoRPs(fExactNoRPs);
+ fQC->SetUseQVectorBundle(fUseQVectorBundle);
  // Multiparticle correlations vs multiplicity:
  fQC->SetnBinsMult(fnBinsMult);
  fQC->SetMinMult(fMinMult);
@@ -81,6 +81,8 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Double_t GetPhiDistributionForOneEventSettings(Int_t const i) const {return this->fPhiDistributionForOneEventSettings[i];};  
   void SetExactNoRPs(Int_t const enr) {this->fExactNoRPs = enr;};
   Int_t GetExactNoRPs() const {return this->fExactNoRPs;}; 
+  void SetUseQVectorBundle(Bool_t const uqvb) {this->fUseQVectorBundle = uqvb;};
+  Bool_t GetUseQVectorBundle() const {return this->fUseQVectorBundle;};
   void SetUse2DHistograms(Bool_t const u2dh){this->fUse2DHistograms = u2dh;if(u2dh){this->fStoreControlHistograms = kTRUE;}};
   Bool_t GetUse2DHistograms() const {return this->fUse2DHistograms;};
   void SetFillProfilesVsMUsingWeights(Bool_t const fpvmuw){this->fFillProfilesVsMUsingWeights = fpvmuw;};
@@ -162,6 +164,7 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fStorePhiDistributionForOneEvent; // store phi distribution for one event to illustrate flow
   Double_t fPhiDistributionForOneEventSettings[4]; // [v_min,v_max,refMult_min,refMult_max]
   Int_t fExactNoRPs;                     // when shuffled, select only this number of RPs for the analysis 
+  Bool_t fUseQVectorBundle;              // take Q_{n,k} and S_{p,k} from the Q-vector bundle cached in the flow event
   Bool_t fUse2DHistograms;               // use TH2D instead of TProfile to improve numerical stability in reference flow calculation   
   Bool_t fFillProfilesVsMUsingWeights;   // if the width of multiplicity bin is 1, weights are not needed   
   Bool_t fUseQvectorTerms; // use TH2D with separate Q-vector terms instead of TProfile to improve numerical stability in reference flow calculation    
@@ -192,7 +195,7 @@ class AliAnalysisTaskQCumulants : public AliAnalysisTaskSE{
   Bool_t fUseBootstrapVsM; // use bootstrap to estimate statistical spread for results vs M
   Int_t fnSubsamples; // number of subsamples (SS), by default 10
   
-  ClassDef(AliAnalysisTaskQCumulants, 2); 
+  ClassDef(AliAnalysisTaskQCumulants, 3); 
 };
 
 //================================================================================================================
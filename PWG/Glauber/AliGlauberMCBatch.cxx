@@ -0,0 +1,608 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  AliGlauberMCBatch implementation
+//  batched, multithreaded event generation for the Glauber MC
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include <Riostream.h>
+#include <TMath.h>
+#include <TRandom3.h>
+#include <TNtuple.h>
+#include <TFile.h>
+#include <TF1.h>
+#include <TString.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "AliGlauberNucleus.h"
+#include "AliGlauberMCBatch.h"
+
+using std::cout;
+using std::endl;
+using std::flush;
+ClassImp(AliGlauberMCBatch)
+
+namespace {
+
+// Columns of the output ntuple, same names as in AliGlauberMC::Run
+const char *kNtupleColumns = "Npart:Ncoll:B:VarE:Stoa:VarEColl:VarECom:VarEPart:VarEPartColl:VarEPartCom:xsect:tAA:Epsl2:Epsl3:Epsl4:Epsl5:E2Coll:E3Coll:E4Coll:E5Coll:E2Com:E3Com:E4Com:E5Com:Psi2:Psi3:Psi4:Psi5:BNN:Ncollw";
+const Int_t kNColumns = 30;
+
+// Weight of a participant in the combined (two component) source, as in AliGlauberMC
+const Double_t kComSoft = 1-0.150;
+const Double_t kComHard = 0.150;
+
+//______________________________________________________________________________
+// Tabulated radial distribution of a nucleus, shared (read only) by all threads:
+// TF1::GetRandom uses gRandom and caches its integral, it cannot be called concurrently
+struct GlauberNucleusTable {
+  Int_t    fN;                 //Number of nucleons
+  Double_t fMinDist;           //Minimum separation distance
+  Bool_t   fHulthen;           //Special treatment of "dh" (see AliGlauberNucleus::ThrowNucleons)
+  std::vector<Double_t> fR;    //Grid of radii
+  std::vector<Double_t> fCdf;  //Normalised integral of rho(r) up to the grid points
+};
+
+//______________________________________________________________________________
+void FillNucleusTable(AliGlauberNucleus &nucleus, Int_t npx, GlauberNucleusTable &table)
+{
+  // tabulate the cumulative radial distribution of the nucleus (trapezoidal integration)
+  TF1 *f = nucleus.GetFunction();
+  table.fN       = nucleus.GetN();
+  table.fMinDist = nucleus.GetMinDist();
+  table.fHulthen = (TString(nucleus.GetName())=="dh");
+  table.fR.resize(npx+1);
+  table.fCdf.resize(npx+1);
+
+  Double_t xmin = f->GetXmin();
+  Double_t dx   = (f->GetXmax()-xmin)/npx;
+  Double_t fprev = f->Eval(xmin);
+  if (!(fprev>0)) fprev = 0; // also catches 0/0 at the origin (Hulthen)
+  table.fR[0]   = xmin;
+  table.fCdf[0] = 0;
+  for (Int_t i = 1; i<=npx; i++) {
+    Double_t x = xmin + i*dx;
+    Double_t fcur = f->Eval(x);
+    if (!(fcur>0)) fcur = 0;
+    table.fR[i]   = x;
+    table.fCdf[i] = table.fCdf[i-1] + 0.5*(fprev+fcur)*dx;
+    fprev = fcur;
+  }
+  Double_t norm = table.fCdf[npx];
+  if (norm>0) {
+    for (Int_t i = 1; i<=npx; i++) table.fCdf[i] /= norm;
+  }
+}
+
+//______________________________________________________________________________
+// Moments of one weighting of the sources (participants, binary collisions or
+// combined) around its centroid. r^2 cos(n phi) and r^2 sin(n phi) are taken
+// from (x+iy)^n/r^(n-2), without atan2/sin/cos
+struct GlauberMoments {
+  Double_t fW, fX, fY, fX2, fY2, fXY, fR2;
+  Double_t fCos[4], fSin[4];    //n=2..5
+
+  void Clear() {
+    fW = fX = fY = fX2 = fY2 = fXY = fR2 = 0;
+    for (Int_t n = 0; n<4; n++) fCos[n] = fSin[n] = 0;
+  }
+
+  void Add(Double_t x, Double_t y, Double_t w) {
+    if (w==0) return;
+    Double_t x2 = x*x;
+    Double_t y2 = y*y;
+    Double_t r2 = x2+y2;
+    fW   += w;
+    fX   += w*x;
+    fY   += w*y;
+    fX2  += w*x2;
+    fY2  += w*y2;
+    fXY  += w*x*y;
+    fR2  += w*r2;
+    if (r2<=0) return;
+    Double_t c2 = x2-y2,       s2 = 2*x*y;
+    Double_t c3 = c2*x-s2*y,   s3 = c2*y+s2*x;
+    Double_t c4 = c3*x-s3*y,   s4 = c3*y+s3*x;
+    Double_t c5 = c4*x-s4*y,   s5 = c4*y+s4*x;
+    Double_t ir = 1./TMath::Sqrt(r2);
+    Double_t ir2 = ir*ir;
+    fCos[0] += w*c2;       fSin[0] += w*s2;
+    fCos[1] += w*c3*ir;    fSin[1] += w*s3*ir;
+    fCos[2] += w*c4*ir2;   fSin[2] += w*s4*ir2;
+    fCos[3] += w*c5*ir2*ir; fSin[3] += w*s5*ir2*ir;
+  }
+
+  // <x^2>-<x>^2 etc., as fSx2Parts/fSy2Parts/fSxyParts of AliGlauberMC
+  Double_t Sx2() const { return fW>0 ? fX2/fW-(fX/fW)*(fX/fW) : 0; }
+  Double_t Sy2() const { return fW>0 ? fY2/fW-(fY/fW)*(fY/fW) : 0; }
+  Double_t Sxy() const { return fW>0 ? fXY/fW-(fX/fW)*(fY/fW) : 0; }
+  Double_t Epsilon(Int_t n) const { return TMath::Sqrt(fCos[n-2]*fCos[n-2]+fSin[n-2]*fSin[n-2])/fR2; }
+  Double_t Psi(Int_t n) const { return (TMath::ATan2(fSin[n-2],fCos[n-2])+TMath::Pi())/n; }
+};
+
+//______________________________________________________________________________
+// Event generation of one thread, with its own random number stream and buffers
+class GlauberBatchWorker {
+public:
+  GlauberBatchWorker(const GlauberNucleusTable &a, const GlauberNucleusTable &b,
+                     Double_t xsect, Double_t bmin, Double_t bmax, UInt_t seed);
+
+  void Generate(Int_t nevents);
+
+  std::vector<Float_t> fRows;   //Ntuple rows of the accepted events
+  Long64_t fTotalEvents;        //All events within selected impact parameter range
+  Long64_t fEvents;             //Number of events with at least one collision
+  Long64_t fDiscarded;          //Events without participants after all attempts
+  Int_t    fMaxNpartFound;      //Largest value of Npart obtained
+
+private:
+  Double_t SampleRadius(const GlauberNucleusTable &t);
+  void     ThrowNucleons(const GlauberNucleusTable &t, Double_t xshift,
+                         std::vector<Double_t> &x, std::vector<Double_t> &y, std::vector<Double_t> &z);
+  void     Collide(Double_t &bNN, Int_t &nco, Int_t &ncohc);
+  Bool_t   CalcEvent(Double_t bgen);
+
+  const GlauberNucleusTable &fA;
+  const GlauberNucleusTable &fB;
+  TRandom3 fRandom;
+  Double_t fXSect;
+  Double_t fD2;                 //"ball" diameter squared
+  Double_t fCell;               //grid cell size, slightly larger than the ball diameter
+  Double_t fBMin;
+  Double_t fBMax;
+  std::vector<Double_t> fXA, fYA, fZA, fXB, fYB, fZB;
+  std::vector<Int_t>    fNcollA, fNcollB;
+  std::vector<Int_t>    fCellStart;      //first entry of each cell in fCellNucleons
+  std::vector<Int_t>    fCellFill;
+  std::vector<Int_t>    fCellOf;         //cell of each B nucleon
+  std::vector<Int_t>    fCellNucleons;   //B nucleons sorted by cell
+  std::vector<Double_t> fPartX, fPartY, fPartWColl, fPartWCom;
+};
+
+//______________________________________________________________________________
+GlauberBatchWorker::GlauberBatchWorker(const GlauberNucleusTable &a, const GlauberNucleusTable &b,
+                                       Double_t xsect, Double_t bmin, Double_t bmax, UInt_t seed) :
+  fRows(),
+  fTotalEvents(0),
+  fEvents(0),
+  fDiscarded(0),
+  fMaxNpartFound(0),
+  fA(a),
+  fB(b),
+  fRandom(seed),
+  fXSect(xsect),
+  fD2(xsect/(TMath::Pi()*10)),
+  fCell(TMath::Sqrt(xsect/(TMath::Pi()*10))*(1+1e-9)),
+  fBMin(bmin),
+  fBMax(bmax),
+  fXA(a.fN), fYA(a.fN), fZA(a.fN), fXB(b.fN), fYB(b.fN), fZB(b.fN),
+  fNcollA(a.fN), fNcollB(b.fN),
+  fCellStart(), fCellFill(), fCellOf(b.fN), fCellNucleons(b.fN),
+  fPartX(a.fN+b.fN), fPartY(a.fN+b.fN), fPartWColl(a.fN+b.fN), fPartWCom(a.fN+b.fN)
+{
+}
+
+//______________________________________________________________________________
+Double_t GlauberBatchWorker::SampleRadius(const GlauberNucleusTable &t)
+{
+  // inverse of the tabulated cumulative distribution, linear within a grid interval
+  Double_t u = fRandom.Rndm();
+  Int_t npx = t.fCdf.size()-1;
+  Int_t i = std::upper_bound(t.fCdf.begin(), t.fCdf.end(), u) - t.fCdf.begin() - 1;
+  if (i<0) i = 0;
+  if (i>=npx) i = npx-1;
+  Double_t dc = t.fCdf[i+1]-t.fCdf[i];
+  Double_t frac = dc>0 ? (u-t.fCdf[i])/dc : 0;
+  return t.fR[i] + frac*(t.fR[i+1]-t.fR[i]);
+}
+
+//______________________________________________________________________________
+void GlauberBatchWorker::ThrowNucleons(const GlauberNucleusTable &t, Double_t xshift,
+                                       std::vector<Double_t> &x, std::vector<Double_t> &y, std::vector<Double_t> &z)
+{
+  // same as AliGlauberNucleus::ThrowNucleons, on flat arrays
+
+  if (t.fN==2 && t.fHulthen) { //special treatmeant for Hulten
+    Double_t r = SampleRadius(t)/2;
+    Double_t phi = fRandom.Rndm() * 2 * TMath::Pi() ;
+    Double_t ctheta = 2*fRandom.Rndm() - 1 ;
+    Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
+    x[0] = r * stheta * TMath::Cos(phi) + xshift;
+    y[0] = r * stheta * TMath::Sin(phi);
+    z[0] = r * ctheta;
+    x[1] = -x[0] + 2*xshift;
+    y[1] = -y[0];
+    z[1] = -z[0];
+    return;
+  }
+
+  Double_t minDist2 = t.fMinDist*t.fMinDist;
+  Double_t sumx=0;
+  Double_t sumy=0;
+  Double_t sumz=0;
+  for (Int_t i = 0; i<t.fN; i++) {
+    while(1) {
+      Double_t r = SampleRadius(t);
+      Double_t phi = fRandom.Rndm() * 2 * TMath::Pi() ;
+      Double_t ctheta = 2*fRandom.Rndm() - 1 ;
+      Double_t stheta = TMath::Sqrt(1-ctheta*ctheta);
+      x[i] = r * stheta * TMath::Cos(phi) + xshift;
+      y[i] = r * stheta * TMath::Sin(phi);
+      z[i] = r * ctheta;
+      if (t.fMinDist<0) break;
+      Bool_t test=1;
+      for (Int_t j = 0; j<i; j++) {
+        Double_t dx = x[i]-x[j];
+        Double_t dy = y[i]-y[j];
+        Double_t dz = z[i]-z[j];
+        if (dx*dx+dy*dy+dz*dz<minDist2) {
+          test=0;
+          break;
+        }
+      }
+      if (test) break; //found nucleuon outside of mindist
+    }
+    sumx += x[i];
+    sumy += y[i];
+    sumz += z[i];
+  }
+
+  // set the centre-of-mass to be at zero (+xshift)
+  sumx = sumx/t.fN;
+  sumy = sumy/t.fN;
+  sumz = sumz/t.fN;
+  for (Int_t i = 0; i<t.fN; i++) {
+    x[i] -= sumx+xshift;
+    y[i] -= sumy;
+    z[i] -= sumz;
+  }
+}
+
+//______________________________________________________________________________
+void GlauberBatchWorker::Collide(Double_t &bNN, Int_t &nco, Int_t &ncohc)
+{
+  // find all colliding A-B pairs: the B nucleons are sorted into a transverse grid
+  // with cells larger than the ball diameter, so only the 3x3 cells around an A
+  // nucleon can contain collision partners
+
+  Double_t xmin = fXB[0], xmax = fXB[0], ymin = fYB[0], ymax = fYB[0];
+  for (Int_t i = 1; i<fB.fN; i++) {
+    xmin = TMath::Min(xmin,fXB[i]);
+    xmax = TMath::Max(xmax,fXB[i]);
+    ymin = TMath::Min(ymin,fYB[i]);
+    ymax = TMath::Max(ymax,fYB[i]);
+  }
+  Int_t nx = Int_t((xmax-xmin)/fCell)+1;
+  Int_t ny = Int_t((ymax-ymin)/fCell)+1;
+
+  fCellStart.assign(nx*ny+1,0);
+  for (Int_t i = 0; i<fB.fN; i++) {
+    Int_t cell = Int_t((fYB[i]-ymin)/fCell)*nx + Int_t((fXB[i]-xmin)/fCell);
+    fCellOf[i] = cell;
+    fCellStart[cell+1]++;
+  }
+  for (Int_t c = 0; c<nx*ny; c++) fCellStart[c+1] += fCellStart[c];
+  fCellFill.assign(fCellStart.begin(),fCellStart.end()-1);
+  for (Int_t i = 0; i<fB.fN; i++) fCellNucleons[fCellFill[fCellOf[i]]++] = i;
+
+  for (Int_t j = 0; j<fA.fN; j++) {
+    Double_t xa = fXA[j];
+    Double_t ya = fYA[j];
+    Int_t ix = Int_t(TMath::Floor((xa-xmin)/fCell));
+    Int_t iy = Int_t(TMath::Floor((ya-ymin)/fCell));
+    if (ix<-1 || ix>nx || iy<-1 || iy>ny) continue;
+    Int_t cxmin = TMath::Max(ix-1,0), cxmax = TMath::Min(ix+1,nx-1);
+    Int_t cymin = TMath::Max(iy-1,0), cymax = TMath::Min(iy+1,ny-1);
+    for (Int_t cy = cymin; cy<=cymax; cy++) {
+      for (Int_t cx = cxmin; cx<=cxmax; cx++) {
+        Int_t cell = cy*nx+cx;
+        for (Int_t k = fCellStart[cell]; k<fCellStart[cell+1]; k++) {
+          Int_t i = fCellNucleons[k];
+          Double_t dx = fXB[i]-xa;
+          Double_t dy = fYB[i]-ya;
+          Double_t dij = dx*dx+dy*dy;
+          if (dij < fD2) {
+            bNN += dij;
+            ++nco;
+            ++fNcollB[i];
+            ++fNcollA[j];
+            if (dij<fD2/4)
+              ++ncohc;
+          }
+        }
+      }
+    }
+  }
+}
+
+//______________________________________________________________________________
+Bool_t GlauberBatchWorker::CalcEvent(Double_t bgen)
+{
+  // generate one event and append its ntuple row, same quantities as
+  // AliGlauberMC::CalcEvent/CalcResults. Returns kFALSE if there are no participants
+
+  ThrowNucleons(fA,-bgen/2.,fXA,fYA,fZA);
+  ThrowNucleons(fB,bgen/2.,fXB,fYB,fZB);
+  std::fill(fNcollA.begin(),fNcollA.end(),0);
+  std::fill(fNcollB.begin(),fNcollB.end(),0);
+
+  Double_t bNN = 0;
+  Int_t nco = 0;
+  Int_t ncohc = 0; // hard core
+  Collide(bNN,nco,ncohc);
+
+  // participants and the centroids of the three weightings
+  Int_t npart = 0;
+  Int_t ncoll = 0;
+  Double_t ncom = 0;
+  Double_t oxPart = 0, oyPart = 0, oxColl = 0, oyColl = 0, oxCom = 0, oyCom = 0;
+  for (Int_t i = 0; i<fA.fN; i++) {
+    if (fNcollA[i]==0) continue;
+    Double_t x = fXA[i];
+    Double_t y = fYA[i];
+    fPartX[npart] = x;
+    fPartY[npart] = y;
+    fPartWColl[npart] = 0; // binary collisions are counted on the B side
+    fPartWCom[npart] = kComSoft;
+    npart++;
+    oxPart += x;
+    oyPart += y;
+    ncom += kComSoft;
+    oxCom += x*kComSoft;
+    oyCom += x*kComSoft; // sic, keeps the centroid definition of AliGlauberMC::CalcResults
+  }
+  for (Int_t i = 0; i<fB.fN; i++) {
+    Int_t n = fNcollB[i];
+    if (n==0) continue;
+    Double_t x = fXB[i];
+    Double_t y = fYB[i];
+    Double_t wCom = kComSoft+kComHard*n;
+    fPartX[npart] = x;
+    fPartY[npart] = y;
+    fPartWColl[npart] = n;
+    fPartWCom[npart] = wCom;
+    npart++;
+    oxPart += x;
+    oyPart += y;
+    oxColl += x*n;
+    oyColl += y*n;
+    oxCom += x*wCom;
+    oyCom += y*wCom;
+    ncoll += n;
+    ncom += wCom;
+  }
+
+  fTotalEvents++;
+  if (npart==0) return kFALSE;
+  fEvents++;
+  if (npart > fMaxNpartFound) fMaxNpartFound = npart;
+
+  oxPart /= npart;
+  oyPart /= npart;
+  if (ncoll>0) {
+    oxColl /= ncoll;
+    oyColl /= ncoll;
+  }
+  oxCom /= ncom;
+  oyCom /= ncom;
+
+  // all moments in one pass over the participants
+  GlauberMoments part, coll, com;
+  part.Clear();
+  coll.Clear();
+  com.Clear();
+  for (Int_t i = 0; i<npart; i++) {
+    part.Add(fPartX[i]-oxPart,fPartY[i]-oyPart,1);
+    coll.Add(fPartX[i]-oxColl,fPartY[i]-oyColl,fPartWColl[i]);
+    com.Add(fPartX[i]-oxCom,fPartY[i]-oyCom,fPartWCom[i]);
+  }
+
+  Double_t sx2Part = part.Sx2(), sy2Part = part.Sy2(), sxyPart = part.Sxy();
+  Double_t sx2Coll = coll.Sx2(), sy2Coll = coll.Sy2(), sxyColl = coll.Sxy();
+  Double_t sx2Com  = com.Sx2(),  sy2Com  = com.Sy2(),  sxyCom  = com.Sxy();
+  Bool_t hasPart = (npart>=2);
+  Bool_t hasColl = (sy2Coll!=0.0);
+  Bool_t hasCom  = (sy2Com+sx2Com!=0.0);
+
+  std::size_t offset = fRows.size();
+  fRows.resize(offset+kNColumns);
+  Float_t *v = &fRows[offset];
+  v[0]  = npart;
+  v[1]  = ncoll;
+  v[2]  = bgen;
+  v[3]  = hasPart ? (sy2Part-sx2Part)/(sy2Part+sx2Part) : 0;
+  v[4]  = hasPart ? TMath::Pi()*TMath::Sqrt(sx2Part)*TMath::Sqrt(sy2Part) : 0;
+  v[5]  = hasColl ? (sy2Coll-sx2Coll)/(sy2Coll+sx2Coll) : 0;
+  v[6]  = hasCom  ? (sy2Com-sx2Com)/(sy2Com+sx2Com) : 0;
+  v[7]  = hasPart ? TMath::Sqrt((sy2Part-sx2Part)*(sy2Part-sx2Part)+4*sxyPart*sxyPart)/(sy2Part+sx2Part) : 0;
+  v[8]  = hasColl ? TMath::Sqrt((sy2Coll-sx2Coll)*(sy2Coll-sx2Coll)+4*sxyColl*sxyColl)/(sy2Coll+sx2Coll) : 0;
+  v[9]  = hasCom  ? TMath::Sqrt((sy2Com-sx2Com)*(sy2Com-sx2Com)+4*sxyCom*sxyCom)/(sy2Com+sx2Com) : 0;
+  v[10] = fXSect;
+  v[11] = ncoll>0 ? ncoll/fXSect : -999;
+  for (Int_t n = 2; n<=5; n++) {
+    v[10+n] = hasPart ? part.Epsilon(n) : 0;
+    v[14+n] = coll.fR2!=0.0 ? coll.Epsilon(n) : 0;
+    v[18+n] = com.fR2!=0.0 ? com.Epsilon(n) : 0;
+    v[22+n] = part.Psi(n);
+  }
+  v[28] = nco>0 ? bNN/nco : 0.;
+  v[29] = ncohc;
+  return kTRUE;
+}
+
+//______________________________________________________________________________
+void GlauberBatchWorker::Generate(Int_t nevents)
+{
+  // generate nevents events, as AliGlauberMC::NextEvent with up to 10 attempts per event
+  Int_t nAttempts = 10;
+  for (Int_t i = 0; i<nevents; i++) {
+    Bool_t succes = kFALSE;
+    for (Int_t j = 0; j<nAttempts; j++) {
+      Double_t bgen = TMath::Sqrt((fBMax*fBMax-fBMin*fBMin)*fRandom.Rndm()+fBMin*fBMin);
+      if ( (succes=CalcEvent(bgen)) ) break; //ends if we have particparts
+    }
+    if (!succes) fDiscarded++;
+  }
+}
+
+} // namespace
+
+//______________________________________________________________________________
+AliGlauberMCBatch::AliGlauberMCBatch(Option_t* NA, Option_t* NB, Double_t xsect) :
+  TNamed(),
+  fANucleus(NA),
+  fBNucleus(NB),
+  fXSect(xsect),
+  fBMin(0.),
+  fBMax(20.),
+  fBatchSize(10000),
+  fNpx(10000),
+  fnt(0),
+  fEvents(0),
+  fTotalEvents(0),
+  fMaxNpartFound(0)
+{
+  //ctor
+  TString name(Form("Glauber_%s_%s_batch",fANucleus.GetName(),fBNucleus.GetName()));
+  SetName(name);
+  SetTitle(name);
+}
+
+//______________________________________________________________________________
+AliGlauberMCBatch::~AliGlauberMCBatch()
+{
+  //dtor
+}
+
+//______________________________________________________________________________
+void AliGlauberMCBatch::Run(Int_t nevents, Int_t nthreads, UInt_t seed)
+{
+  // generate nevents events with nthreads threads (0: number of cores).
+  // Thread i uses TRandom3(seed+i), or a unique seed per thread if seed is 0.
+  // The output is reproducible for a given seed and number of threads.
+
+  if (!fANucleus.GetFunction() || !fBNucleus.GetFunction()) {
+    cout << "Unknown nucleus " << fANucleus.GetName() << " or " << fBNucleus.GetName() << ", nothing generated" << endl;
+    return;
+  }
+  if (nthreads<=0) nthreads = std::thread::hardware_concurrency();
+  if (nthreads<=0) nthreads = 1;
+  Int_t batchSize = TMath::Max(fBatchSize,1);
+
+  cout << "Generating " << nevents << " events with " << nthreads << " threads..." << endl;
+  TString name(Form("nt_%s_%s",fANucleus.GetName(),fBNucleus.GetName()));
+  TString title(Form("%s + %s (x-sect = %d mb)",fANucleus.GetName(),fBNucleus.GetName(),(Int_t) fXSect));
+  if (fnt == 0)
+  {
+    fnt = new TNtuple(name,title,kNtupleColumns);
+    fnt->SetDirectory(0);
+  }
+
+  GlauberNucleusTable tableA, tableB;
+  FillNucleusTable(fANucleus,fNpx,tableA);
+  FillNucleusTable(fBNucleus,fNpx,tableB);
+
+  std::vector<GlauberBatchWorker*> workers;
+  for (Int_t i = 0; i<nthreads; i++)
+    workers.push_back(new GlauberBatchWorker(tableA,tableB,fXSect,fBMin,fBMax,seed ? seed+i : 0));
+
+  Int_t done = 0;
+  while (done<nevents) {
+    Int_t nbatch = TMath::Min(nevents-done,nthreads*batchSize);
+    std::vector<std::thread> threads;
+    for (Int_t i = 0; i<nthreads; i++) {
+      Int_t n = nbatch/nthreads + (i < nbatch%nthreads ? 1 : 0);
+      threads.push_back(std::thread(&GlauberBatchWorker::Generate,workers[i],n));
+    }
+    for (Int_t i = 0; i<nthreads; i++) threads[i].join();
+
+    // the ntuple is filled sequentially, in thread order
+    for (Int_t i = 0; i<nthreads; i++) {
+      std::vector<Float_t> &rows = workers[i]->fRows;
+      for (std::size_t offset = 0; offset<rows.size(); offset += kNColumns)
+        fnt->Fill(&rows[offset]);
+      rows.clear();
+    }
+    done += nbatch;
+    cout << "Generating Event # " << done << "... \r" << flush;
+  }
+
+  Long64_t q = 0;
+  Long64_t u = 0;
+  for (Int_t i = 0; i<nthreads; i++) {
+    fTotalEvents += workers[i]->fTotalEvents;
+    fEvents += workers[i]->fEvents;
+    q += workers[i]->fEvents;
+    u += workers[i]->fDiscarded;
+    if (workers[i]->fMaxNpartFound > fMaxNpartFound) fMaxNpartFound = workers[i]->fMaxNpartFound;
+    delete workers[i];
+  }
+  cout << endl << "Done! Succesfull events:  " << q << "  discarded events:  " << u <<"."<< endl;
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMCBatch::GetTotXSect() const
+{
+  //total xsection
+  if (fTotalEvents==0) return 0;
+  return (1.*fEvents/fTotalEvents)*TMath::Pi()*fBMax*fBMax/100;
+}
+
+//______________________________________________________________________________
+Double_t AliGlauberMCBatch::GetTotXSectErr() const
+{
+  //total xsection error
+  if (fEvents==0) return 0;
+  return GetTotXSect()/TMath::Sqrt((Double_t)fEvents) *
+         TMath::Sqrt(1.-1.*fEvents/fTotalEvents);
+}
+
+//---------------------------------------------------------------------------------
+void AliGlauberMCBatch::RunAndSaveNtuple( Int_t n,
+                                          const Option_t *sysA,
+                                          const Option_t *sysB,
+                                          Double_t signn,
+                                          Double_t mind,
+                                          Double_t r,
+                                          Double_t a,
+                                          Int_t nthreads,
+                                          const char *fname)
+{
+  //example run
+  AliGlauberMCBatch mcg(sysA,sysB,signn);
+  mcg.SetMinDistance(mind);
+  mcg.Setr(r);
+  mcg.Seta(a);
+  mcg.Run(n,nthreads);
+  TNtuple  *nt=mcg.GetNtuple();
+  TFile out(fname,"recreate",fname,9);
+  if(nt) nt->Write();
+  printf("total cross section with a nucleon-nucleon cross section \t%f is \t%f",signn,mcg.GetTotXSect());
+  out.Close();
+}
+
+//---------------------------------------------------------------------------------
+void AliGlauberMCBatch::Reset()
+{
+  //delete the ntuple
+  delete fnt;
+  fnt=NULL;
+}
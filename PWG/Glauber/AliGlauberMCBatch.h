@@ -0,0 +1,85 @@
+#ifndef ALIGLAUBERMCBATCH_H
+#define ALIGLAUBERMCBATCH_H
+
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+////////////////////////////////////////////////////////////////////////////////
+//
+//  AliGlauberMCBatch
+//  batched, multithreaded event generation for the Glauber MC
+//
+//  Generates the same events as AliGlauberMC (nucleon sampling, collision
+//  criterion and participant/binary/combined weighting of the moments), but
+//  events are processed in batches by several threads, each on its own random
+//  number stream. Nucleons are kept in flat coordinate arrays, collisions are
+//  found with a transverse grid of cell size d = sqrt(sigNN/pi) and all moments
+//  of an event are accumulated in one loop over the participants.
+//  The output ntuple only keeps the event-wise quantities used for centrality
+//  and eccentricity studies (same column names as in AliGlauberMC).
+//
+//  Fluctuating sigNN (AliGlauberMC::SetDoFluc) and particle production are
+//  not supported in this mode, use AliGlauberMC for them.
+//
+////////////////////////////////////////////////////////////////////////////////
+
+#include "AliGlauberNucleus.h"
+#include <TNamed.h>
+
+class TNtuple;
+
+class AliGlauberMCBatch : public TNamed {
+public:
+   AliGlauberMCBatch(Option_t* NA = "Pb", Option_t* NB = "Pb", Double_t xsect = 64);
+   virtual     ~AliGlauberMCBatch();
+
+   void         Run(Int_t nevents, Int_t nthreads = 0, UInt_t seed = 0);
+
+   Double_t     GetBMin()            const {return fBMin;}
+   Double_t     GetBMax()            const {return fBMax;}
+   Int_t        GetNpartFound()      const {return fMaxNpartFound;}
+   TNtuple*     GetNtuple()          const {return fnt;}
+   Double_t     GetTotXSect()        const;
+   Double_t     GetTotXSectErr()     const;
+   void         Reset();
+   AliGlauberNucleus &GetNucA()            {return fANucleus;}
+   AliGlauberNucleus &GetNucB()            {return fBNucleus;}
+
+   void   SetBmin(Double_t bmin)      {fBMin = bmin;}
+   void   SetBmax(Double_t bmax)      {fBMax = bmax;}
+   void   SetMinDistance(Double_t d)  {fANucleus.SetMinDist(d); fBNucleus.SetMinDist(d);}
+   void   Setr(Double_t r)  {fANucleus.SetR(r); fBNucleus.SetR(r);}
+   void   Seta(Double_t a)  {fANucleus.SetA(a); fBNucleus.SetA(a);}
+   void   SetBatchSize(Int_t n)       {fBatchSize = n;}
+   void   SetNpx(Int_t n)             {fNpx = n;}
+
+   static void       RunAndSaveNtuple( Int_t n,
+                                       const Option_t *sysA="Pb",
+                                       const Option_t *sysB="Pb",
+                                       Double_t signn=64,
+                                       Double_t mind=0.4,
+                                       Double_t r=6.62,
+                                       Double_t a=0.546,
+                                       Int_t nthreads=0,
+                                       const char *fname="glau_pbpb_ntuple.root");
+
+private:
+   AliGlauberMCBatch(const AliGlauberMCBatch& in);
+   AliGlauberMCBatch& operator=(const AliGlauberMCBatch& in);
+
+   AliGlauberNucleus fANucleus;       //Nucleus A
+   AliGlauberNucleus fBNucleus;       //Nucleus B
+   Double_t     fXSect;          //Nucleon-nucleon cross section
+   Double_t     fBMin;           //Minimum impact parameter to be generated
+   Double_t     fBMax;           //Maximum impact parameter to be generated
+   Int_t        fBatchSize;      //Events generated per thread before the ntuple is filled
+   Int_t        fNpx;            //Number of points of the tabulated radial distributions
+   TNtuple*     fnt;             //Ntuple for results (created, but not deleted)
+   Long64_t     fEvents;         //Number of events with at least one collision
+   Long64_t     fTotalEvents;    //All events within selected impact parameter range
+   Int_t        fMaxNpartFound;  //Largest value of Npart obtained
+
+   ClassDef(AliGlauberMCBatch,1)
+};
+
+#endif
@@ -45,6 +45,8 @@ public:
    Double_t   GetR()             const {return fR;}
    Double_t   GetA()             const {return fA;}
    Double_t   GetW()             const {return fW;}
+   Double_t   GetMinDist()       const {return fMinDist;}
+   TF1       *GetFunction()      const {return fFunction;}
    TObjArray *GetNucleons()      const {return fNucleons;}
    Int_t      GetTrials()        const {return fTrials;}
    void       SetN(Int_t in)           {fN=in;}
@@ -5,6 +5,7 @@
 #pragma link off all functions;
 
 #pragma link C++ class AliGlauberMC+;
+#pragma link C++ class AliGlauberMCBatch+;
 #pragma link C++ class AliGlauberNucleus+;
 #pragma link C++ class AliGlauberNucleon+;
 
@@ -25,14 +25,14 @@ ClassImp(AliAnalysisTaskHMTFMCMultEst)
 
 //________________________________________________________________________
 AliAnalysisTaskHMTFMCMultEst::AliAnalysisTaskHMTFMCMultEst()
-: AliAnalysisTaskSE(), fMyOut(0), fClassifiers(0), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
+: AliAnalysisTaskSE(), fMyOut(0), fClassifiers(0), fObservables(0), fParticleView(0), fGlobalTrigger(0), fGlobalSystem(0),
   fGlobalTriggerClassifiers(0)
 {
 }
 
 //________________________________________________________________________
 AliAnalysisTaskHMTFMCMultEst::AliAnalysisTaskHMTFMCMultEst(const char *name)
-  : AliAnalysisTaskSE(name), fMyOut(0), fClassifiers(0), fObservables(0), fGlobalTrigger(0), fGlobalSystem(0),
+  : AliAnalysisTaskSE(name), fMyOut(0), fClassifiers(0), fObservables(0), fParticleView(0), fGlobalTrigger(0), fGlobalSystem(0),
     fGlobalTriggerClassifiers(0)
 {
   DefineOutput(1, TList::Class());
@@ -129,6 +129,11 @@ void AliAnalysisTaskHMTFMCMultEst::UserCreateOutputObjects()
      //fObservables.push_back(new AliObservableCorrelationsOfClassifiers(fClassifiers.at(i), refClassifierSpherocity));
      fObservables.push_back(new AliObservableCorrelationsOfClassifiers(fClassifiers.at(i), refClassifierSphericity));
   }
+  // All classifiers (and their observables) use the same packed primaries, filled once per event
+  fParticleView = new AliPrimaryParticleView();
+  for (Int_t i = 0; i < fClassifiers.size(); i++) {
+    fClassifiers[i]->SetParticleView(fParticleView);
+  }
   AliLog::SetGlobalLogLevel(AliLog::kError);
   PostData(1, fMyOut);
 }
@@ -141,6 +146,7 @@ void AliAnalysisTaskHMTFMCMultEst::UserExec(Option_t *)
   for (Int_t i = 0; i < fClassifiers.size(); i++) {
     fClassifiers[i]->ResetClassifier();
   }
+  if (fParticleView) fParticleView->Reset();
 
   // Load event
   AliMCEvent* mcEvent = MCEvent();
@@ -149,6 +155,8 @@ void AliAnalysisTaskHMTFMCMultEst::UserExec(Option_t *)
      return;
   }
   AliStack  *stack = mcEvent->Stack();
+  // Single pass over the stack for all classifiers and observables
+  if (fParticleView) fParticleView->Fill(mcEvent, stack);
 
   // do we have the right trigger?
   if (((fGlobalTrigger == kINEL) && IsInel(mcEvent, stack)) ||
@@ -5,6 +5,7 @@
 
 #include "AliEventClassifierBase.h"
 #include "AliObservableBase.h"
+#include "AliPrimaryParticleView.h"
 
 class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
  public:
@@ -23,6 +24,7 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
   TList *fMyOut;                          // Output list
   std::vector<AliEventClassifierBase*> fClassifiers;
   std::vector<AliObservableBase*> fObservables;
+  AliPrimaryParticleView *fParticleView;  //! Packed primaries of the current event, shared by all classifiers
 
   Int_t fGlobalTrigger;
   enum {kINEL, kINELGT0, kV0AND};
@@ -43,7 +45,7 @@ class AliAnalysisTaskHMTFMCMultEst : public AliAnalysisTaskSE {
   AliAnalysisTaskHMTFMCMultEst(const AliAnalysisTaskHMTFMCMultEst&); // not implemented
   AliAnalysisTaskHMTFMCMultEst& operator=(const AliAnalysisTaskHMTFMCMultEst&); // not implemented
 
-  ClassDef(AliAnalysisTaskHMTFMCMultEst, 2); // example of analysis
+  ClassDef(AliAnalysisTaskHMTFMCMultEst, 3); // example of analysis
 };
 
 #endif
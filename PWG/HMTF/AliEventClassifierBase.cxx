@@ -6,6 +6,7 @@
 #include "AliStack.h"
 
 #include "AliEventClassifierBase.h"
+#include "AliPrimaryParticleView.h"
 
 using namespace std;
 
@@ -19,7 +20,8 @@ AliEventClassifierBase::AliEventClassifierBase()
   fCollisionSystem(0),
   fClassifierValueIsCached(false),
   fClassifierOutputList(0),
-  fTaskOutputList(0)
+  fTaskOutputList(0),
+  fParticleView(0)
 {
   
 }
@@ -31,7 +33,8 @@ AliEventClassifierBase::AliEventClassifierBase(const char* name, const char* tit
     fCollisionSystem(collisionSystem),
     fClassifierValueIsCached(false),
     fClassifierOutputList(0),
-    fTaskOutputList(taskOutputList)
+    fTaskOutputList(taskOutputList),
+    fParticleView(0)
 {
   fClassifierOutputList = new TList();
   fClassifierOutputList->SetName(name);
@@ -41,7 +44,9 @@ AliEventClassifierBase::AliEventClassifierBase(const char* name, const char* tit
 
 Float_t AliEventClassifierBase::GetClassifierValue(AliMCEvent *event, AliStack *stack) {
   if(!fClassifierValueIsCached) {
-    CalculateClassifierValue(event, stack);
+    if (!(fParticleView && fParticleView->IsFilled() &&
+          CalculateClassifierValueFromView(*fParticleView, event)))
+      CalculateClassifierValue(event, stack);
     fClassifierValueIsCached = true;
   }
   return fClassifierValue;
@@ -7,6 +7,8 @@
 #include "AliMCEvent.h"
 #include "AliStack.h"
 
+class AliPrimaryParticleView;
+
 class AliEventClassifierBase : public TNamed {
  public:
   AliEventClassifierBase();
@@ -18,9 +20,14 @@ class AliEventClassifierBase : public TNamed {
   TList* GetClassifierOutputList() {return fClassifierOutputList;}
   Int_t GetExpectedMinValue() {return fExpectedMinValue;}
   Int_t GetExpectedMaxValue() {return fExpectedMaxValue;}
+  // If set and filled for the current event, the value is computed from the view instead of the stack
+  void SetParticleView(AliPrimaryParticleView *view) {fParticleView = view;}
+  AliPrimaryParticleView* GetParticleView() const {return fParticleView;}
 
  protected:
   virtual void CalculateClassifierValue(AliMCEvent *event, AliStack *stack) = 0;
+  // Return false if the classifier can not be computed from the view (the stack is used then)
+  virtual Bool_t CalculateClassifierValueFromView(const AliPrimaryParticleView &/*view*/, AliMCEvent */*event*/) {return false;}
   Bool_t fClassifierValueIsCached;    // Is the classifier value already computed?
   Float_t fClassifierValue;           // The value for this classifier for the current event
   Int_t fExpectedMinValue;            // The expected min value produced by this estimator, used for hists
@@ -29,8 +36,9 @@ class AliEventClassifierBase : public TNamed {
   
   TList *fClassifierOutputList;  // The "folder" in which the hists binned in this classifier a saved
   TList *fTaskOutputList;        // The list for the entire task
+  AliPrimaryParticleView *fParticleView; //! Packed primaries of the current event (not owned)
 
-  ClassDef(AliEventClassifierBase, 2);
+  ClassDef(AliEventClassifierBase, 3);
 };
 
 #endif
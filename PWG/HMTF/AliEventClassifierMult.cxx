@@ -5,6 +5,7 @@
 #include "AliStack.h"
 
 #include "AliEventClassifierMult.h"
+#include "AliPrimaryParticleView.h"
 
 
 using namespace std;
@@ -61,16 +62,31 @@ void AliEventClassifierMult::CalculateClassifierValue(AliMCEvent *event, AliStac
     if (track->Charge() == 0 && fCountCharged) continue;
 
     // does this track fall into any of the defined regions?
-    Double_t eta = track->Eta();
-    Bool_t trackIsInRegion = false;
-    for(Int_t i = 0; i != fRegions.size(); i++) {
-      if(eta >= fRegions[i][0] && eta <=fRegions[i][1]) {
-	trackIsInRegion = true;
-      }
-    }
+    Bool_t trackIsInRegion = IsInRegions(track->Eta());
     // Are we counting tracks inside or outside of the region?
     // increment counter accordingly
     if (trackIsInRegion && fRegionsAreInclusive) fClassifierValue += 1.0;
     else if (!trackIsInRegion && !fRegionsAreInclusive) fClassifierValue += 1.0;   
   }
 }
+
+Bool_t AliEventClassifierMult::IsInRegions(Double_t eta) const {
+  for(UInt_t i = 0; i != fRegions.size(); i++) {
+    if(eta >= fRegions[i][0] && eta <=fRegions[i][1]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+Bool_t AliEventClassifierMult::CalculateClassifierValueFromView(const AliPrimaryParticleView &view, AliMCEvent */*event*/) {
+  // Same selection as CalculateClassifierValue, using the packed primaries of the event
+  fClassifierValue = 0.0;
+  for (Int_t i = 0; i < view.GetNParticles(); i++) {
+    if (!view.IsPhysicalPrimary(i)) continue;
+    if (!view.IsCharged(i) && fCountCharged) continue;
+    Bool_t trackIsInRegion = IsInRegions(view.Eta(i));
+    if (trackIsInRegion == fRegionsAreInclusive) fClassifierValue += 1.0;
+  }
+  return true;
+}
@@ -22,7 +22,9 @@ class AliEventClassifierMult : public AliEventClassifierBase {
   std::vector< std::vector<Float_t> > fRegions;
   Bool_t fRegionsAreInclusive;
   Bool_t fCountCharged;
+  Bool_t IsInRegions(Double_t eta) const;
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+  Bool_t CalculateClassifierValueFromView(const AliPrimaryParticleView &view, AliMCEvent *event);
 
   ClassDef(AliEventClassifierMult, 1);
 };
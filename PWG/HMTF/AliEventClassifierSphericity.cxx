@@ -9,6 +9,7 @@
 #include "AliGenPythiaEventHeader.h"
 
 #include "AliEventClassifierSphericity.h"
+#include "AliPrimaryParticleView.h"
 #include "AliIsPi0PhysicalPrimary.h"
 
 using namespace std;
@@ -27,7 +28,6 @@ void AliEventClassifierSphericity::CalculateClassifierValue(AliMCEvent *event, A
   // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
   fClassifierValue = -1.0;
 
-  Float_t sphericity = -1.0;
   Float_t s00=0;
   Float_t s01=0;
   Float_t s11=0;
@@ -52,6 +52,31 @@ void AliEventClassifierSphericity::CalculateClassifierValue(AliMCEvent *event, A
     s11 += (py * py) / track->Pt();
     totalpt += track->Pt();
   }
+  SetSphericity(s00, s01, s11, totalpt);
+}
+
+Bool_t AliEventClassifierSphericity::CalculateClassifierValueFromView(const AliPrimaryParticleView &view, AliMCEvent */*event*/) {
+  // Same sums as CalculateClassifierValue, using the packed primaries of the event
+  Float_t s00=0;
+  Float_t s01=0;
+  Float_t s11=0;
+  Float_t totalpt=0;
+  for (Int_t i = 0; i < view.GetNParticles(); i++) {
+    if (!view.IsPhysicalPrimary(i)) continue;
+    Double_t pt = view.Pt(i);
+    Float_t px = pt * TMath::Cos( view.Phi(i) );
+    Float_t py = pt * TMath::Sin( view.Phi(i) );
+    s00 += (px * px) / pt;
+    s01 += (py * px) / pt;
+    s11 += (py * py) / pt;
+    totalpt += pt;
+  }
+  SetSphericity(s00, s01, s11, totalpt);
+  return true;
+}
+
+void AliEventClassifierSphericity::SetSphericity(Float_t s00, Float_t s01, Float_t s11, Float_t totalpt) {
+  Float_t sphericity = -1.0;
   // did we have valid tracks or did we never reach the bottom of the for loop?
   if (!(totalpt > 0)) {
     fClassifierValue = -1;
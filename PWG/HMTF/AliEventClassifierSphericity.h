@@ -13,6 +13,8 @@ class AliEventClassifierSphericity : public AliEventClassifierBase {
 
  private:
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+  Bool_t CalculateClassifierValueFromView(const AliPrimaryParticleView &view, AliMCEvent *event);
+  void SetSphericity(Float_t s00, Float_t s01, Float_t s11, Float_t totalpt);
   
   ClassDef(AliEventClassifierSphericity, 1);
 };
@@ -9,6 +9,7 @@
 #include "AliGenPythiaEventHeader.h"
 
 #include "AliEventClassifierSpherocity.h"
+#include "AliPrimaryParticleView.h"
 #include "AliIsPi0PhysicalPrimary.h"
 
 using namespace std;
@@ -43,47 +44,80 @@ Bool_t AliEventClassifierSpherocity::TrackPassesSelection(AliMCParticle* track,
 
 void AliEventClassifierSpherocity::CalculateClassifierValue(AliMCEvent *event, AliStack *stack) {
   // This implementation is adapted from PWGLF/SPECTRA/Spherocity/AliTransverseEventShape.cxx
-  fClassifierValue = 0.0;
-
-  Float_t sumRatioSquare = 0;
-  Float_t minimalSumRatioSquare = 2;
-  
-  // Step size in phi unit vector used to find m spherocity
-  Float_t phiStepSize = 0.1;
-
-  // Computing total pt
+  fPx.clear();
+  fPy.clear();
   Float_t sumapt = 0;
   Int_t ntracks = event->GetNumberOfTracks();
   for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
     AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
     if (!TrackPassesSelection(track, stack, iTrack)) continue;
     sumapt += track->Pt();
+    fPx.push_back(track->Pt() * TMath::Cos(track->Phi()));
+    fPy.push_back(track->Pt() * TMath::Sin(track->Phi()));
+  }
+  SetSpherocity(sumapt);
+}
+
+Bool_t AliEventClassifierSpherocity::CalculateClassifierValueFromView(const AliPrimaryParticleView &view, AliMCEvent */*event*/) {
+  // Same selection as TrackPassesSelection, using the packed primaries of the event
+  fPx.clear();
+  fPy.clear();
+  Float_t sumapt = 0;
+  for (Int_t i = 0; i < view.GetNParticles(); i++) {
+    if (!view.IsPhysicalPrimary(i)) continue;
+    if (TMath::Abs(view.Eta(i)) > 0.8) continue;
+    sumapt += view.Pt(i);
+    fPx.push_back(view.Pt(i) * TMath::Cos(view.Phi(i)));
+    fPy.push_back(view.Pt(i) * TMath::Sin(view.Phi(i)));
+  }
+  SetSpherocity(sumapt);
+  return true;
+}
+
+static inline Double_t TrackSign(Double_t px, Double_t py) {
+  // sign of sin(phi + epsilon), phi being the track azimuth
+  if (py != 0) return (py > 0) ? 1. : -1.;
+  return (px > 0) ? 1. : -1.;
+}
+
+void AliEventClassifierSpherocity::SetSpherocity(Float_t sumapt) {
+  // Spherocity S0 = pi^2/4 * min_n (sum |p_T,i x n| / sum p_T,i)^2 of the tracks in fPx, fPy.
+  // The sum is a sum of |sin| arcs in the axis angle, i.e. concave between the angles where
+  // one of the terms vanishes, so the minimum is found at an axis along one of the tracks.
+  // These axes are visited in increasing angle in [0, pi), updating the signed momentum
+  // sum D = sum sign(p_T,i x n) p_T,i when the axis passes a track: sum |p_T,i x n| = |D x n|.
+  // This is exact and replaces the scan over axes in steps of 0.1 degree.
+  Float_t minimalSumRatioSquare = 2;
+  Int_t ntracks = fPx.size();
+  fAngle.resize(ntracks);
+  fOrder.resize(ntracks);
+  Double_t dx = 0;
+  Double_t dy = 0;
+  for (Int_t i = 0; i < ntracks; i++) {
+    Double_t angle = TMath::ATan2(fPy[i], fPx[i]);
+    if (angle < 0) angle += TMath::Pi();
+    if (angle >= TMath::Pi()) angle -= TMath::Pi();
+    fAngle[i] = angle;
+    // sign of the track in D for an axis just below angle 0, it flips when the axis passes fAngle[i]
+    Double_t sign = TrackSign(fPx[i], fPy[i]);
+    dx += sign * fPx[i];
+    dy += sign * fPy[i];
   }
-  
-  // Getting thrust
-  for(Int_t i = 0; i < 360/(phiStepSize); ++i){
-    Float_t numerator = 0;
-    Float_t phiparam  = 0;
-    Float_t nx = 0;
-    Float_t ny = 0;
-    phiparam=((TMath::Pi()) * i * phiStepSize) / 180; // parametrization of the angle
-    nx = TMath::Cos(phiparam);            // x component of an unitary vector n
-    ny = TMath::Sin(phiparam);            // y component of an unitary vector n
-    for(Int_t iTrack = 0; iTrack < ntracks; ++iTrack){
-      AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
-      if (!TrackPassesSelection(track, stack, iTrack)) continue;
-      
-      Float_t pxA = track->Pt() * TMath::Cos(track->Phi());
-      Float_t pyA = track->Pt() * TMath::Sin(track->Phi());
-      //product between p projection in XY plane and the unitary vector
-      numerator += TMath::Abs( ny * pxA - nx * pyA );
+  if (ntracks > 0 && sumapt > 0) {
+    TMath::Sort(ntracks, fAngle.data(), fOrder.data(), kFALSE);
+    for (Int_t k = 0; k < ntracks; k++) {
+      Int_t i = fOrder[k];
+      Double_t nx = TMath::Cos(fAngle[i]);
+      Double_t ny = TMath::Sin(fAngle[i]);
+      // track i (and tracks with the same angle) are along the axis and do not contribute
+      Double_t numerator = TMath::Abs(ny * dx - nx * dy);
+      Float_t sumRatioSquare = TMath::Power(numerator / sumapt, 2);
+      if (sumRatioSquare < minimalSumRatioSquare) minimalSumRatioSquare = sumRatioSquare;
+      // flip the sign of track i for the following axes
+      Double_t sign = TrackSign(fPx[i], fPy[i]);
+      dx -= 2 * sign * fPx[i];
+      dy -= 2 * sign * fPy[i];
     }
-    
-    sumRatioSquare = TMath::Power((numerator / sumapt), 2);
-    if(sumRatioSquare < minimalSumRatioSquare)  //minimization of pFull
-      {
-	minimalSumRatioSquare = sumRatioSquare;
-      }
   }
 
   // Compute the final spherocity:
@@ -1,6 +1,8 @@
 #ifndef AliEventClassifierSpherocity_cxx
 #define AliEventClassifierSpherocity_cxx
 
+#include <vector>
+
 #include "AliEventClassifierBase.h"
 
 class AliEventClassifierSpherocity : public AliEventClassifierBase {
@@ -14,8 +16,15 @@ class AliEventClassifierSpherocity : public AliEventClassifierBase {
  private:
   Bool_t TrackPassesSelection(AliMCParticle* track, AliStack *stack, Int_t iTrack);
   void CalculateClassifierValue(AliMCEvent *event, AliStack *stack);
+  Bool_t CalculateClassifierValueFromView(const AliPrimaryParticleView &view, AliMCEvent *event);
+  void SetSpherocity(Float_t sumapt);
+
+  std::vector<Double_t> fPx;      //! px of the selected tracks of the current event
+  std::vector<Double_t> fPy;      //! py of the selected tracks of the current event
+  std::vector<Double_t> fAngle;   //! azimuth of the selected tracks in [0, pi)
+  std::vector<Int_t> fOrder;      //! tracks sorted in fAngle
   
-  ClassDef(AliEventClassifierSpherocity, 1);
+  ClassDef(AliEventClassifierSpherocity, 2);
 };
 
 #endif
@@ -12,6 +12,7 @@
 #include "AliEventClassifierBase.h"
 
 #include "AliIsPi0PhysicalPrimary.h"
+#include "AliPrimaryParticleView.h"
 
 using namespace std;
 
@@ -83,6 +84,16 @@ void AliObservableClassifierpTPID::Fill(AliMCEvent *event, AliStack *stack) {
   Double_t classifier_value = fclassifier->GetClassifierValue(event, stack);
   Double_t event_weight = event->GenEventHeader()->EventWeight();
 
+  // Use the packed primaries (and primary pi0's) of the event if available
+  const AliPrimaryParticleView *view = fclassifier->GetParticleView();
+  if (view && view->IsFilled()) {
+    for (Int_t i = 0; i < view->GetNParticles(); i++) {
+      if (!(TMath::Abs(view->Y(i)) < 0.5)) continue;
+      FillParticle(classifier_value, view->Pt(i), view->PdgCode(i), view->IsCharged(i), event_weight);
+    }
+    return;
+  }
+
   for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++) {
     AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
     // load track
@@ -101,28 +112,31 @@ void AliObservableClassifierpTPID::Fill(AliMCEvent *event, AliStack *stack) {
     }
 
     // Ok, lets fill!
-    Int_t pdgCode = track->PdgCode();
     if(((TMath::Abs(track->Y()) < 0.5))) {  //y since this is for identified particles. Region is TPC+ITS
-      for (Int_t ipid = 0; ipid < kNPID; ipid++) {
-	if (pdgCode == this->Pid_enum_to_pdg(ipid)){
-	  fhistogram->Fill(classifier_value,
-			   track->Pt(),
-			   ipid,
-			   event_weight);
-	  break;
-	}
-      }
-      // Fill the "allcharged" bin of the 3d histogram. Note that this is still restricted to the y<.5 region
-      if (track->Charge() != 0) {
-      	fhistogram->Fill(classifier_value,
-			 track->Pt(),
-			 this->kALLCHARGED,
-			 event_weight);
-      }
+      FillParticle(classifier_value, track->Pt(), track->PdgCode(), track->Charge() != 0, event_weight);
     }
   }
 }
 
+void AliObservableClassifierpTPID::FillParticle(Double_t classifier_value, Double_t pt, Int_t pdgCode, Bool_t isCharged, Double_t event_weight) {
+  for (Int_t ipid = 0; ipid < kNPID; ipid++) {
+    if (pdgCode == this->Pid_enum_to_pdg(ipid)){
+      fhistogram->Fill(classifier_value,
+		       pt,
+		       ipid,
+		       event_weight);
+      break;
+    }
+  }
+  // Fill the "allcharged" bin of the 3d histogram. Note that this is still restricted to the y<.5 region
+  if (isCharged) {
+    fhistogram->Fill(classifier_value,
+		     pt,
+		     this->kALLCHARGED,
+		     event_weight);
+  }
+}
+
 Int_t AliObservableClassifierpTPID::Pid_enum_to_pdg(Int_t pid_enum) {
   if (pid_enum == kPROTON) return 2212;
   else if (pid_enum == kANTIPROTON) return -2212;
@@ -37,6 +37,7 @@ class AliObservableClassifierpTPID : public AliObservableBase {
   TH3F *fhistogram;
   AliEventClassifierBase *fclassifier;
   Int_t Pid_enum_to_pdg(Int_t pid_enum);
+  void FillParticle(Double_t classifier_value, Double_t pt, Int_t pdgCode, Bool_t isCharged, Double_t event_weight);
 
   ClassDef(AliObservableClassifierpTPID, 1);
 };
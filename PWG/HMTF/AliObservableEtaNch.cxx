@@ -9,6 +9,7 @@
 #include "AliObservableBase.h"
 #include "AliObservableEtaNch.h"
 #include "AliEventClassifierBase.h"
+#include "AliPrimaryParticleView.h"
 
 #include "AliIsPi0PhysicalPrimary.h"
 
@@ -48,6 +49,16 @@ void AliObservableEtaNch::Fill(AliMCEvent *event, AliStack *stack) {
   Double_t classifier_value = fclassifier->GetClassifierValue(event, stack);
   Double_t event_weight = event->GenEventHeader()->EventWeight();
 
+  // Use the packed primaries of the event if available
+  const AliPrimaryParticleView *view = fclassifier->GetParticleView();
+  if (view && view->IsFilled()) {
+    for (Int_t i = 0; i < view->GetNParticles(); i++) {
+      if (!view->IsPhysicalPrimary(i) || !view->IsCharged(i)) continue;
+      fhistogram->Fill(view->Eta(i), classifier_value, event_weight);
+    }
+    return;
+  }
+
   for (Int_t iTrack = 0; iTrack < event->GetNumberOfTracks(); iTrack++) {
     AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
     // load track
@@ -0,0 +1,64 @@
+#include <vector>
+#include <iostream>
+
+#include "AliMCEvent.h"
+#include "AliMCParticle.h"
+#include "AliStack.h"
+
+#include "AliPrimaryParticleView.h"
+#include "AliIsPi0PhysicalPrimary.h"
+
+using namespace std;
+
+ClassImp(AliPrimaryParticleView)
+
+AliPrimaryParticleView::AliPrimaryParticleView()
+  : TObject(),
+    fIsFilled(false),
+    fPt(),
+    fEta(),
+    fPhi(),
+    fY(),
+    fPdgCode(),
+    fCharge(),
+    fFlags()
+{
+}
+
+void AliPrimaryParticleView::Fill(AliMCEvent *event, AliStack *stack) {
+  fPt.clear();
+  fEta.clear();
+  fPhi.clear();
+  fY.clear();
+  fPdgCode.clear();
+  fCharge.clear();
+  fFlags.clear();
+
+  Int_t ntracks = event->GetNumberOfTracks();
+  for (Int_t iTrack = 0; iTrack < ntracks; iTrack++) {
+    AliMCParticle *track = static_cast<AliMCParticle*>(event->GetTrack(iTrack));
+    // load track
+    if (!track) {
+      Printf("ERROR: Could not receive track %d", iTrack);
+      continue;
+    }
+    // discard unphysical particles from some generators
+    if (track->Pt() == 0 || track->E() <= 0)
+      continue;
+
+    // Keep primaries (Aliroot definition excluding Pi0) and primary pi0's
+    UChar_t flags = 0;
+    if (stack->IsPhysicalPrimary(iTrack)) flags |= kPhysicalPrimary;
+    else if (AliIsPi0PhysicalPrimary(iTrack, stack)) flags |= kPi0Primary;
+    if (!flags) continue;
+
+    fPt.push_back(track->Pt());
+    fEta.push_back(track->Eta());
+    fPhi.push_back(track->Phi());
+    fY.push_back(track->Y());
+    fPdgCode.push_back(track->PdgCode());
+    fCharge.push_back(track->Charge());
+    fFlags.push_back(flags);
+  }
+  fIsFilled = true;
+}
@@ -0,0 +1,54 @@
+#ifndef AliPrimaryParticleView_cxx
+#define AliPrimaryParticleView_cxx
+
+#include <vector>
+
+#include "TObject.h"
+
+class AliMCEvent;
+class AliStack;
+
+// Packed kinematics of the primary particles of one MC event.
+// Filled once per event in a single pass over the stack; the classifiers and
+// observables then loop over these arrays instead of the stack.
+// Particles are kept in stack order if they are physical primaries or primary
+// pi0's (see AliIsPi0PhysicalPrimary) and pass the "physical" check
+// (pt != 0 and E > 0) applied by all classifiers and observables.
+class AliPrimaryParticleView : public TObject {
+ public:
+  enum {kPhysicalPrimary = 0x1, kPi0Primary = 0x2};
+
+  AliPrimaryParticleView();
+  virtual ~AliPrimaryParticleView() {}
+
+  void Fill(AliMCEvent *event, AliStack *stack);
+  void Reset() {fIsFilled = false;}
+  Bool_t IsFilled() const {return fIsFilled;}
+
+  Int_t GetNParticles() const {return fPt.size();}
+  Double_t Pt(Int_t i) const {return fPt[i];}
+  Double_t Eta(Int_t i) const {return fEta[i];}
+  Double_t Phi(Int_t i) const {return fPhi[i];}
+  Double_t Y(Int_t i) const {return fY[i];}
+  Int_t PdgCode(Int_t i) const {return fPdgCode[i];}
+  Bool_t IsCharged(Int_t i) const {return fCharge[i] != 0;}
+  Bool_t IsPhysicalPrimary(Int_t i) const {return fFlags[i] & kPhysicalPrimary;}
+  Bool_t IsPi0Primary(Int_t i) const {return fFlags[i] & kPi0Primary;}
+
+ private:
+  Bool_t fIsFilled;                  //! Is the view filled for the current event?
+  std::vector<Double_t> fPt;         //! transverse momentum
+  std::vector<Double_t> fEta;        //! pseudorapidity
+  std::vector<Double_t> fPhi;        //! azimuthal angle
+  std::vector<Double_t> fY;          //! rapidity
+  std::vector<Int_t> fPdgCode;       //! pdg code
+  std::vector<Short_t> fCharge;      //! charge as given by AliMCParticle::Charge()
+  std::vector<UChar_t> fFlags;       //! kPhysicalPrimary, kPi0Primary
+
+  AliPrimaryParticleView(const AliPrimaryParticleView&); // not implemented
+  AliPrimaryParticleView& operator=(const AliPrimaryParticleView&); // not implemented
+
+  ClassDef(AliPrimaryParticleView, 1);
+};
+
+#endif
@@ -16,6 +16,7 @@
 #pragma link C++ class AliEventClassifierSphericity+;
 #pragma link C++ class AliEventClassifierSpherocity+;
 #pragma link C++ class AliEventClassifierQ2+;
+#pragma link C++ class AliPrimaryParticleView+;
 #pragma link C++ class AliAnalysisTaskHMTFMC+;
 #pragma link C++ class AliAnalysisTaskHMTFMCMultEst+;
 #pragma link C++ class AliAnalysisTrackingUncertaintiesHMTF+;
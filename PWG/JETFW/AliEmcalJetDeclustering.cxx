@@ -0,0 +1,109 @@
+/**************************************************************************
+ * Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include <TMath.h>
+
+#include "AliEmcalJetDeclustering.h"
+
+/**
+ * Default constructor
+ */
+AliEmcalJetDeclustering::AliEmcalJetDeclustering():
+  fAvailable(kFALSE),
+  fRadius(0),
+  fRecombinationScheme(-1),
+  fTrackConstituentsOnly(kFALSE),
+  fZ(),
+  fDeltaR(),
+  fKt(),
+  fMass(),
+  fPtParent(),
+  fPtHarder(),
+  fPtSofter(),
+  fHarderBranch(),
+  fSofterBranch(),
+  fPrimary()
+{
+}
+
+/**
+ * Remove all splittings and mark the history as filled with the given reclustering settings.
+ * @param radius Radius used for the reclustering
+ * @param recombinationScheme Recombination scheme used for the reclustering
+ * @param trackConstituentsOnly Whether only the track constituents were used in the reclustering
+ */
+void AliEmcalJetDeclustering::Reset(Double_t radius, Int_t recombinationScheme, Bool_t trackConstituentsOnly)
+{
+  fAvailable = radius > 0;
+  fRadius = radius;
+  fRecombinationScheme = recombinationScheme;
+  fTrackConstituentsOnly = trackConstituentsOnly;
+  fZ.clear();
+  fDeltaR.clear();
+  fKt.clear();
+  fMass.clear();
+  fPtParent.clear();
+  fPtHarder.clear();
+  fPtSofter.clear();
+  fHarderBranch.clear();
+  fSofterBranch.clear();
+  fPrimary.clear();
+}
+
+/**
+ * Add a splitting to the declustering tree. The branches are set to single constituents,
+ * use SetBranches() once the splittings of the branches are known.
+ * @param ptParent Transverse momentum of the parent
+ * @param mParent Mass of the parent
+ * @param ptHarder Transverse momentum of the harder branch
+ * @param ptSofter Transverse momentum of the softer branch
+ * @param deltaR Opening angle between the branches
+ * @return Index of the splitting
+ */
+Int_t AliEmcalJetDeclustering::AddSplitting(Double_t ptParent, Double_t mParent, Double_t ptHarder, Double_t ptSofter, Double_t deltaR)
+{
+  fZ.push_back(ptHarder + ptSofter > 0 ? ptSofter / (ptHarder + ptSofter) : 0);
+  fDeltaR.push_back(deltaR);
+  fKt.push_back(ptSofter * TMath::Sin(deltaR));
+  fMass.push_back(mParent);
+  fPtParent.push_back(ptParent);
+  fPtHarder.push_back(ptHarder);
+  fPtSofter.push_back(ptSofter);
+  fHarderBranch.push_back(-1);
+  fSofterBranch.push_back(-1);
+  return fZ.size() - 1;
+}
+
+/**
+ * Set the splittings of the two branches of a splitting
+ * @param splitting Index of the splitting
+ * @param harder Index of the splitting of the harder branch (-1 for a single constituent)
+ * @param softer Index of the splitting of the softer branch (-1 for a single constituent)
+ */
+void AliEmcalJetDeclustering::SetBranches(Int_t splitting, Int_t harder, Int_t softer)
+{
+  fHarderBranch[splitting] = harder;
+  fSofterBranch[splitting] = softer;
+}
+
+/**
+ * Build the primary declustering sequence by following the harder
+ * branch starting from the splitting of the full jet.
+ */
+void AliEmcalJetDeclustering::BuildPrimarySequence()
+{
+  fPrimary.clear();
+  for (Int_t i = fZ.empty() ? -1 : 0; i >= 0; i = fHarderBranch[i]) fPrimary.push_back(i);
+}
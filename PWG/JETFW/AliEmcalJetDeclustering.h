@@ -0,0 +1,85 @@
+#ifndef ALIEMCALJETDECLUSTERING_H
+#define ALIEMCALJETDECLUSTERING_H
+
+/* Copyright(c) 1998-2016, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <vector>
+#include <Rtypes.h>
+
+/// \class AliEmcalJetDeclustering
+/// \brief Cambridge/Aachen declustering history of a jet
+///
+/// This class stores the full declustering tree of a jet, obtained by reclustering
+/// its constituents with the Cambridge/Aachen algorithm, as an extension of the
+/// AliEmcalJet class (see AliEmcalJetShapeProperties::GetDeclustering()). It is
+/// filled once per jet by the jet finder (AliEmcalJetUtilityDeclustering), so that
+/// substructure tasks running on the same jet collection do not need to recluster
+/// the jet constituents themselves.
+///
+/// Each splitting of a parent into a harder (higher \f$ p_{t} \f$) and a softer branch
+/// is stored in flat arrays with
+/// - \f$ z = p_{t,2} / (p_{t,1} + p_{t,2}) \f$,
+/// - \f$ \Delta R \f$ between the two branches,
+/// - \f$ k_{t} = p_{t,2} \sin(\Delta R) \f$,
+/// - the mass and \f$ p_{t} \f$ of the parent and the \f$ p_{t} \f$ of both branches.
+///
+/// The splittings are stored in pre-order: the first splitting is the one of the
+/// full jet, followed by the splittings of its harder branch and then of its softer
+/// branch. Indices of the splittings of the two branches are available, -1 meaning that
+/// the branch is a single constituent. The primary declustering sequence (following
+/// the harder branch, as used for the primary Lund plane and Soft Drop) is available
+/// separately.
+class AliEmcalJetDeclustering {
+
+public:
+
+  AliEmcalJetDeclustering();
+
+  void              Reset(Double_t radius = 0, Int_t recombinationScheme = -1, Bool_t trackConstituentsOnly = kFALSE);
+  Int_t             AddSplitting(Double_t ptParent, Double_t mParent, Double_t ptHarder, Double_t ptSofter, Double_t deltaR);
+  void              SetBranches(Int_t splitting, Int_t harder, Int_t softer);
+  void              BuildPrimarySequence();
+
+  /// Whether the declustering history was filled for this jet
+  Bool_t            IsAvailable()                                        const { return fAvailable                              ; }
+  /// Radius used for the reclustering
+  Double_t          GetRadius()                                          const { return fRadius                                 ; }
+  /// Recombination scheme used for the reclustering (fastjet::RecombinationScheme)
+  Int_t             GetRecombinationScheme()                             const { return fRecombinationScheme                    ; }
+  /// Whether only the track constituents (no clusters) were used in the reclustering
+  Bool_t            IsTrackConstituentsOnly()                            const { return fTrackConstituentsOnly                  ; }
+
+  // Full declustering tree
+  Int_t             GetNumberOfSplittings()                              const { return fZ.size()                               ; }
+  Float_t           GetZ(Int_t i)                                        const { return fZ[i]                                   ; }
+  Float_t           GetDeltaR(Int_t i)                                   const { return fDeltaR[i]                              ; }
+  Float_t           GetKt(Int_t i)                                       const { return fKt[i]                                  ; }
+  Float_t           GetMass(Int_t i)                                     const { return fMass[i]                                ; }
+  Float_t           GetPtParent(Int_t i)                                 const { return fPtParent[i]                            ; }
+  Float_t           GetPtHarder(Int_t i)                                 const { return fPtHarder[i]                            ; }
+  Float_t           GetPtSofter(Int_t i)                                 const { return fPtSofter[i]                            ; }
+  Int_t             GetHarderBranch(Int_t i)                             const { return fHarderBranch[i]                        ; }
+  Int_t             GetSofterBranch(Int_t i)                             const { return fSofterBranch[i]                        ; }
+
+  // Primary declustering sequence
+  Int_t             GetNumberOfPrimarySplittings()                       const { return fPrimary.size()                         ; }
+  Int_t             GetPrimarySplitting(Int_t i)                         const { return fPrimary[i]                             ; }
+
+protected:
+  Bool_t                fAvailable;                //!<! Declustering history filled
+  Double_t              fRadius;                   //!<! Radius used for the reclustering
+  Int_t                 fRecombinationScheme;      //!<! Recombination scheme used for the reclustering
+  Bool_t                fTrackConstituentsOnly;    //!<! Only track constituents used in the reclustering
+  std::vector<Float_t>  fZ;                        //!<! Momentum fraction of the softer branch
+  std::vector<Float_t>  fDeltaR;                   //!<! Opening angle between the branches
+  std::vector<Float_t>  fKt;                       //!<! Relative transverse momentum of the softer branch
+  std::vector<Float_t>  fMass;                     //!<! Mass of the parent
+  std::vector<Float_t>  fPtParent;                 //!<! Transverse momentum of the parent
+  std::vector<Float_t>  fPtHarder;                 //!<! Transverse momentum of the harder branch
+  std::vector<Float_t>  fPtSofter;                 //!<! Transverse momentum of the softer branch
+  std::vector<Int_t>    fHarderBranch;             //!<! Splitting of the harder branch (-1 for a single constituent)
+  std::vector<Int_t>    fSofterBranch;             //!<! Splitting of the softer branch (-1 for a single constituent)
+  std::vector<Int_t>    fPrimary;                  //!<! Splittings along the harder branch, starting from the full jet
+};
+#endif
@@ -106,7 +106,8 @@ AliEmcalJetShapeProperties::AliEmcalJetShapeProperties():
   fSoftDropZg(0),
   fSoftDropdR(0),
   fSoftDropPtfrac(0),
-  fSoftDropDropCount(0)
+  fSoftDropDropCount(0),
+  fDeclustering()
 {
 }
 
@@ -203,7 +204,8 @@ AliEmcalJetShapeProperties::AliEmcalJetShapeProperties(const AliEmcalJetShapePro
   fSoftDropZg(jet.fSoftDropZg),
   fSoftDropdR(jet.fSoftDropdR),
   fSoftDropPtfrac(jet.fSoftDropPtfrac),
-  fSoftDropDropCount(jet.fSoftDropDropCount)
+  fSoftDropDropCount(jet.fSoftDropDropCount),
+  fDeclustering(jet.fDeclustering)
 
 {
 }
@@ -304,6 +306,7 @@ AliEmcalJetShapeProperties& AliEmcalJetShapeProperties::operator=(const AliEmcal
   fSoftDropdR = jet.fSoftDropdR;
   fSoftDropPtfrac = jet.fSoftDropPtfrac;
   fSoftDropDropCount = jet.fSoftDropDropCount;
+  fDeclustering = jet.fDeclustering;
 
   return *this;
 }
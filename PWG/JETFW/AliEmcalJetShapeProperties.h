@@ -8,6 +8,8 @@
 #include <Rtypes.h>
 #include <TString.h>
 
+#include "AliEmcalJetDeclustering.h"
+
 /// \class AliEmcalJetShapeProperties
 /// \brief This class contains the derivative subtraction operators for jet shapes
 ///
@@ -253,6 +255,10 @@ public:
   Double_t          GetSoftDropPtfrac()                                 const { return fSoftDropPtfrac               ; }
   Int_t             GetSoftDropDropCount()                              const { return fSoftDropDropCount;           ; }
 
+  //Cambridge/Aachen declustering history
+  AliEmcalJetDeclustering&       GetDeclustering()                             { return fDeclustering                 ; }
+  const AliEmcalJetDeclustering& GetDeclustering()                       const { return fDeclustering                 ; }
+
   void              PrintGR() const;
 
 protected:
@@ -366,6 +372,7 @@ protected:
   Double_t          fSoftDropdR;                             //!<!   SoftDrop deltaR
   Double_t          fSoftDropPtfrac;                         //!<!   SoftDrop pt fraction after grooming
   Int_t             fSoftDropDropCount;                      //!<!   SoftDrop number of dropped branches [requires set_verbose_structure(bool enable=true)]
+  AliEmcalJetDeclustering fDeclustering;                     //!<!   Cambridge/Aachen declustering history
 };
 
 #endif
@@ -0,0 +1,63 @@
+/**************************************************************************
+ * Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include "AliInputEventHandler.h"
+#include "AliLog.h"
+#include "AliPIDResponse.h"
+#include "AliVEvent.h"
+
+#include "AliAnalysisTaskPIDNSigmaTable.h"
+
+ClassImp(AliAnalysisTaskPIDNSigmaTable)
+
+//________________________________________________________________________
+AliAnalysisTaskPIDNSigmaTable::AliAnalysisTaskPIDNSigmaTable():
+  AliAnalysisTaskSE(),
+  fTable(nullptr)
+{
+  // Dummy constructor for ROOT I/O
+}
+
+//________________________________________________________________________
+AliAnalysisTaskPIDNSigmaTable::AliAnalysisTaskPIDNSigmaTable(const char *name, const char *tableName):
+  AliAnalysisTaskSE(name),
+  fTable(new AliPIDNSigmaTable(tableName))
+{
+}
+
+//________________________________________________________________________
+AliAnalysisTaskPIDNSigmaTable::~AliAnalysisTaskPIDNSigmaTable(){
+  delete fTable;
+}
+
+//________________________________________________________________________
+void AliAnalysisTaskPIDNSigmaTable::UserExec(Option_t *){
+  AliVEvent *event = InputEvent();
+  if(!event || !fTable) return;
+
+  // the table in the event may have been deleted together with the event content
+  // (e.g. for a new input tree), look it up in every event and recreate it if missing
+  AliPIDNSigmaTable *table = AliPIDNSigmaTable::AttachToEvent(event, *fTable);
+
+  AliPIDResponse *pidResponse = fInputHandler ? fInputHandler->GetPIDResponse() : nullptr;
+  if(!pidResponse) {
+    AliErrorStream() << GetName() << ": PID response not available, table will be empty" << std::endl;
+    table->Reset();
+    return;
+  }
+  Int_t treeNumber = -1;
+  Long64_t entry = -1;
+  AliPIDNSigmaTable::GetCurrentEventId(treeNumber, entry);
+  table->Fill(event, pidResponse, treeNumber, entry);
+}
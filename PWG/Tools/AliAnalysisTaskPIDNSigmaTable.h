@@ -0,0 +1,42 @@
+#ifndef ALIANALYSISTASKPIDNSIGMATABLE_H
+#define ALIANALYSISTASKPIDNSIGMATABLE_H
+/* Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include "AliAnalysisTaskSE.h"
+#include "AliPIDNSigmaTable.h"
+
+/**
+ * \class AliAnalysisTaskPIDNSigmaTable
+ * \brief Computes the PID n-sigma table once per event and attaches it to the input event.
+ *
+ * The task has to be added to the train after the PID response task and before all tasks
+ * reading the table. Downstream tasks retrieve the table via AliPIDNSigmaTable::FindInEvent,
+ * using the name of the table (default: "PIDNSigmaTable").
+ *
+ * The task keeps the configuration of the table. The table in the event is owned by the event
+ * and is recreated from the configuration whenever the event does not contain it (anymore).
+ */
+class AliAnalysisTaskPIDNSigmaTable : public AliAnalysisTaskSE {
+public:
+  AliAnalysisTaskPIDNSigmaTable();
+  AliAnalysisTaskPIDNSigmaTable(const char *name, const char *tableName = "PIDNSigmaTable");
+  virtual ~AliAnalysisTaskPIDNSigmaTable();
+
+  virtual void UserCreateOutputObjects() {}
+  virtual void UserExec(Option_t *);
+  virtual void Terminate(Option_t *) {}
+
+  /// Access to the configuration of the table, e.g. to configure detectors and species
+  AliPIDNSigmaTable *GetTable() const { return fTable; }
+
+private:
+  AliPIDNSigmaTable    *fTable;        ///< Configuration of the table published to the input event (owned, never attached to the event)
+
+  AliAnalysisTaskPIDNSigmaTable(const AliAnalysisTaskPIDNSigmaTable &);
+  AliAnalysisTaskPIDNSigmaTable &operator=(const AliAnalysisTaskPIDNSigmaTable &);
+
+  ClassDef(AliAnalysisTaskPIDNSigmaTable, 2);
+};
+
+#endif /* ALIANALYSISTASKPIDNSIGMATABLE_H */
@@ -32,6 +32,7 @@
 #include "AliAODMCParticle.h" 
 #include "AliPIDResponse.h"   
 #include "AliPIDCombined.h"   
+#include "AliPIDNSigmaTable.h"
 #include "AliAnalysisManager.h"
 #include "AliInputEventHandler.h"
 
@@ -44,7 +45,7 @@ const char * kParticleSpeciesName[]={"Pions","Kaons","Protons","Undefined"} ;
 
 ClassImp(AliHelperPID)
 
-AliHelperPID::AliHelperPID() : TNamed("HelperPID", "PID object"),fisMC(0), fPIDType(kNSigmaTPCTOF), fNSigmaPID(3), fBayesCut(0.8), fPIDResponse(0x0), fPIDCombined(0x0),fOutputList(0x0),fRequestTOFPID(1),fRemoveTracksT0Fill(0),fUseExclusiveNSigma(0),fPtTOFPID(.6),fHasTOFPID(0){
+AliHelperPID::AliHelperPID() : TNamed("HelperPID", "PID object"),fisMC(0), fPIDType(kNSigmaTPCTOF), fNSigmaPID(3), fBayesCut(0.8), fPIDResponse(0x0), fPIDCombined(0x0),fOutputList(0x0),fRequestTOFPID(1),fRemoveTracksT0Fill(0),fUseExclusiveNSigma(0),fPtTOFPID(.6),fHasTOFPID(0),fNSigmaTableName(""),fNSigmaTable(0x0),fNSigmaTableEvent(0x0),fNSigmaTableTreeNumber(-1),fNSigmaTableEntry(-1){
 
   // Fixing Leaks 
   Bool_t oldStatus = TH1::AddDirectoryStatus();
@@ -315,9 +316,12 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
   // Compute nsigma for each hypthesis
   AliVParticle *inEvHMain = dynamic_cast<AliVParticle *>(trk);
   // --- TPC
-  Double_t nsigmaTPCkProton = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kProton);
-  Double_t nsigmaTPCkKaon   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kKaon); 
-  Double_t nsigmaTPCkPion   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kPion); 
+  Double_t nsigmaTPCkProton=999.,nsigmaTPCkKaon=999.,nsigmaTPCkPion=999.;
+  if(!GetNSigmasFromTable(AliPIDResponse::kTPC, inEvHMain, nsigmaTPCkPion, nsigmaTPCkKaon, nsigmaTPCkProton)){
+    nsigmaTPCkProton = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kProton);
+    nsigmaTPCkKaon   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kKaon); 
+    nsigmaTPCkPion   = fPIDResponse->NumberOfSigmasTPC(inEvHMain, AliPID::kPion); 
+  }
   // --- TOF
   Double_t nsigmaTOFkProton=999.,nsigmaTOFkKaon=999.,nsigmaTOFkPion=999.;
   Double_t nsigmaTPCTOFkProton=999.,nsigmaTPCTOFkKaon=999.,nsigmaTPCTOFkPion=999.;
@@ -325,9 +329,11 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
   CheckTOF(trk);
   
   if(fHasTOFPID && trk->Pt()>fPtTOFPID){//use TOF information
-    nsigmaTOFkProton = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kProton);
-    nsigmaTOFkKaon   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kKaon); 
-    nsigmaTOFkPion   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kPion); 
+    if(!GetNSigmasFromTable(AliPIDResponse::kTOF, inEvHMain, nsigmaTOFkPion, nsigmaTOFkKaon, nsigmaTOFkProton)){
+      nsigmaTOFkProton = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kProton);
+      nsigmaTOFkKaon   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kKaon); 
+      nsigmaTOFkPion   = fPIDResponse->NumberOfSigmasTOF(inEvHMain, AliPID::kPion); 
+    }
     Double_t d2Proton=nsigmaTPCkProton * nsigmaTPCkProton + nsigmaTOFkProton * nsigmaTOFkProton;
     Double_t d2Kaon=nsigmaTPCkKaon * nsigmaTPCkKaon + nsigmaTOFkKaon * nsigmaTOFkKaon;
     Double_t d2Pion=nsigmaTPCkPion * nsigmaTPCkPion + nsigmaTOFkPion * nsigmaTOFkPion;
@@ -385,6 +391,43 @@ void AliHelperPID::CalculateNSigmas(AliVTrack * trk, Bool_t FIllQAHistos){
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 
+Bool_t AliHelperPID::GetNSigmasFromTable(Int_t detector, const AliVParticle *trk, Double_t &nsigmaPion, Double_t &nsigmaKaon, Double_t &nsigmaProton){
+  //
+  // Read the nsigmas from the per-event PID table filled by AliAnalysisTaskPIDNSigmaTable
+  // Returns false if the table is not used, was not filled for the current event or does
+  // not contain the track, detector or species
+  //
+  if(fNSigmaTableName.IsNull()) return kFALSE;
+  AliAnalysisManager *man = AliAnalysisManager::GetAnalysisManager();
+  if(!man) return kFALSE;
+  AliInputEventHandler* inputHandler = (AliInputEventHandler*)(man->GetInputEventHandler());
+  if(!inputHandler) return kFALSE;
+  AliVEvent *event = inputHandler->GetEvent();
+  Int_t treeNumber = -1;
+  Long64_t entry = -1;
+  AliPIDNSigmaTable::GetCurrentEventId(treeNumber, entry);
+  // the table belongs to the event and may be deleted with it: look it up again in every event
+  if(event != fNSigmaTableEvent || treeNumber != fNSigmaTableTreeNumber || entry != fNSigmaTableEntry) {
+    fNSigmaTable = AliPIDNSigmaTable::FindInEvent(event, fNSigmaTableName.Data());
+    fNSigmaTableEvent = event;
+    fNSigmaTableTreeNumber = treeNumber;
+    fNSigmaTableEntry = entry;
+  }
+  if(!fNSigmaTable) return kFALSE;
+  // tracks are looked up by pointer and track objects are reused between events
+  if(!fNSigmaTable->IsFilledFor(event, treeNumber, entry)) return kFALSE;
+  AliPIDResponse::EDetector det = static_cast<AliPIDResponse::EDetector>(detector);
+  if(!fNSigmaTable->HasDetector(det) || !fNSigmaTable->HasSpecies(AliPID::kPion) || !fNSigmaTable->HasSpecies(AliPID::kKaon) || !fNSigmaTable->HasSpecies(AliPID::kProton)) return kFALSE;
+  Int_t itrack = fNSigmaTable->GetTrackIndex(trk);
+  if(itrack < 0) return kFALSE;
+  nsigmaPion   = fNSigmaTable->GetNumberOfSigmas(det, AliPID::kPion, itrack);
+  nsigmaKaon   = fNSigmaTable->GetNumberOfSigmas(det, AliPID::kKaon, itrack);
+  nsigmaProton = fNSigmaTable->GetNumberOfSigmas(det, AliPID::kProton, itrack);
+  return kTRUE;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////////////
+
 Int_t AliHelperPID::FindMinNSigma(AliVTrack * trk,Bool_t FillQAHistos){ 
   
   CheckTOF(trk);  
@@ -12,8 +12,10 @@ class AliStack;
 class TParticle;
 class AliPIDResponse;  
 class AliPIDCombined;  
+class AliPIDNSigmaTable;
 
 #include "TNamed.h"
+#include "TString.h"
 
 namespace AliHelperPIDNameSpace {
   
@@ -90,6 +92,9 @@ class AliHelperPID : public TNamed
   //set cut on beyesian probability
   void SetBayesCut(Double_t cut){fBayesCut=cut;}
   Double_t GetBayesCut(){return fBayesCut;}
+  //use the n-sigma values from the per-event PID table (AliAnalysisTaskPIDNSigmaTable) if available
+  void SetNSigmaTableName(const char *name){fNSigmaTableName=name;}
+  const char *GetNSigmaTableName() const {return fNSigmaTableName.Data();}
   
   //getters of the other data members
   TList * GetOutputList() {return fOutputList;}//get the TList with histos
@@ -113,6 +118,7 @@ class AliHelperPID : public TNamed
   void CheckTOF(AliVTrack * trk);//check the TOF matching and set fHasTOFPID
   Double_t TOFBetaCalc(AliVTrack *track) const;
   Double_t GetMass(AliHelperParticleSpecies_t id) const;
+  Bool_t GetNSigmasFromTable(Int_t detector, const AliVParticle *trk, Double_t &nsigmaPion, Double_t &nsigmaKaon, Double_t &nsigmaProton);//look up the nsigmas in the PID table, false if not available
   Long64_t Merge(TCollection* list);
   
  private:
@@ -131,11 +137,16 @@ class AliHelperPID : public TNamed
   Bool_t fUseExclusiveNSigma;//if true returns the identity only if no double counting
   Double_t fPtTOFPID; //lower pt bound for the TOF pid
   Bool_t fHasTOFPID;
+  TString fNSigmaTableName;//name of the PID n-sigma table in the input event, empty if not used
+  AliPIDNSigmaTable *fNSigmaTable;//! PID n-sigma table of the current event
+  const AliVEvent *fNSigmaTableEvent;//! event in which fNSigmaTable was looked up
+  Int_t fNSigmaTableTreeNumber;//! tree number of the event in which fNSigmaTable was looked up
+  Long64_t fNSigmaTableEntry;//! entry number of the event in which fNSigmaTable was looked up
   
   AliHelperPID(const AliHelperPID&);
   AliHelperPID& operator=(const AliHelperPID&);
   
-  ClassDef(AliHelperPID, 8);
+  ClassDef(AliHelperPID, 10);
   
 };
 #endif
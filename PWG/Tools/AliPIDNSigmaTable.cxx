@@ -0,0 +1,313 @@
+/**************************************************************************
+ * Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+#include <algorithm>
+
+#include <TTree.h>
+
+#include "AliAnalysisManager.h"
+#include "AliESDEvent.h"
+#include "AliESDpid.h"
+#include "AliLog.h"
+#include "AliVEvent.h"
+#include "AliVParticle.h"
+#include "AliVTrack.h"
+
+#include "AliPIDNSigmaTable.h"
+
+ClassImp(AliPIDNSigmaTable)
+
+//________________________________________________________________________
+AliPIDNSigmaTable::AliPIDNSigmaTable():
+  TNamed(),
+  fDetectors(),
+  fSpecies(),
+  fFillSignalDelta(kTRUE),
+  fNTracks(0),
+  fEvent(nullptr),
+  fTreeNumber(-1),
+  fEntry(-1),
+  fNSigma(),
+  fSignalDelta(),
+  fStatus(),
+  fTrackIndex()
+{
+  // Dummy constructor for ROOT I/O
+}
+
+//________________________________________________________________________
+AliPIDNSigmaTable::AliPIDNSigmaTable(const char *name):
+  TNamed(name, "PID n-sigma table"),
+  fDetectors(),
+  fSpecies(),
+  fFillSignalDelta(kTRUE),
+  fNTracks(0),
+  fEvent(nullptr),
+  fTreeNumber(-1),
+  fEntry(-1),
+  fNSigma(),
+  fSignalDelta(),
+  fStatus(),
+  fTrackIndex()
+{
+  // Default configuration: ITS, TPC and TOF for electrons, muons, pions, kaons and protons
+  AddDetector(AliPIDResponse::kITS);
+  AddDetector(AliPIDResponse::kTPC);
+  AddDetector(AliPIDResponse::kTOF);
+  for(Int_t ispec = 0; ispec < AliPID::kSPECIES; ispec++) AddSpecies(static_cast<AliPID::EParticleType>(ispec));
+}
+
+//________________________________________________________________________
+void AliPIDNSigmaTable::AddDetector(AliPIDResponse::EDetector detector){
+  if(HasDetector(detector)) return;
+  fDetectors.push_back(detector);
+  Reset();
+}
+
+//________________________________________________________________________
+void AliPIDNSigmaTable::AddSpecies(AliPID::EParticleType species){
+  if(HasSpecies(species)) return;
+  fSpecies.push_back(species);
+  Reset();
+}
+
+//________________________________________________________________________
+void AliPIDNSigmaTable::ClearConfiguration(){
+  fDetectors.clear();
+  fSpecies.clear();
+  Reset();
+}
+
+//________________________________________________________________________
+Int_t AliPIDNSigmaTable::GetDetectorSlot(AliPIDResponse::EDetector detector) const {
+  std::vector<Int_t>::const_iterator found = std::find(fDetectors.begin(), fDetectors.end(), static_cast<Int_t>(detector));
+  return found == fDetectors.end() ? -1 : found - fDetectors.begin();
+}
+
+//________________________________________________________________________
+Int_t AliPIDNSigmaTable::GetSpeciesSlot(AliPID::EParticleType species) const {
+  std::vector<Int_t>::const_iterator found = std::find(fSpecies.begin(), fSpecies.end(), static_cast<Int_t>(species));
+  return found == fSpecies.end() ? -1 : found - fSpecies.begin();
+}
+
+//________________________________________________________________________
+void AliPIDNSigmaTable::Reset(){
+  // Remove the entries of the previous event, keeping the configuration
+  fNTracks = 0;
+  fEvent = nullptr;
+  fTreeNumber = -1;
+  fEntry = -1;
+  fNSigma.clear();
+  fSignalDelta.clear();
+  fStatus.clear();
+  fTrackIndex.clear();
+}
+
+//________________________________________________________________________
+void AliPIDNSigmaTable::Fill(const AliVEvent *event, const AliPIDResponse *pidResponse, Int_t treeNumber, Long64_t entry){
+  //
+  // Compute the table for all tracks in the event. The PID status is checked once per
+  // track and detector, the n-sigma values are only calculated for tracks with a valid
+  // PID signal in the detector. The event pointer, the tree number and the entry number
+  // are stored to identify the event the table belongs to.
+  //
+  Reset();
+  if(!event || !pidResponse) return;
+  fEvent = event;
+  fTreeNumber = treeNumber;
+  fEntry = entry;
+
+  fNTracks = event->GetNumberOfTracks();
+  const Int_t ndet = fDetectors.size(), nspec = fSpecies.size();
+  fNSigma.assign(ndet * nspec * fNTracks, kUndefined);
+  if(fFillSignalDelta) fSignalDelta.assign(ndet * nspec * fNTracks, kUndefined);
+  fStatus.assign(ndet * fNTracks, AliPIDResponse::kDetNoSignal);
+  fTrackIndex.reserve(fNTracks);
+
+  std::vector<const AliVTrack *> tracks(fNTracks, nullptr);
+  for(Int_t itrk = 0; itrk < fNTracks; itrk++) {
+    const AliVParticle *part = const_cast<AliVEvent *>(event)->GetTrack(itrk);
+    if(!part) continue;
+    fTrackIndex[part] = itrk;
+    tracks[itrk] = dynamic_cast<const AliVTrack *>(part);
+  }
+
+  Double_t value = 0.;
+  for(Int_t idet = 0; idet < ndet; idet++) {
+    AliPIDResponse::EDetector detector = static_cast<AliPIDResponse::EDetector>(fDetectors[idet]);
+    for(Int_t itrk = 0; itrk < fNTracks; itrk++) {
+      if(!tracks[itrk]) continue;
+      AliPIDResponse::EDetPidStatus status = pidResponse->CheckPIDStatus(detector, tracks[itrk]);
+      fStatus[idet * fNTracks + itrk] = status;
+      if(status != AliPIDResponse::kDetPidOk) continue;
+      for(Int_t ispec = 0; ispec < nspec; ispec++) {
+        AliPID::EParticleType species = static_cast<AliPID::EParticleType>(fSpecies[ispec]);
+        Int_t index = GetOffset(idet, ispec) + itrk;
+        if(pidResponse->NumberOfSigmas(detector, tracks[itrk], species, value) == AliPIDResponse::kDetPidOk) fNSigma[index] = value;
+        if(fFillSignalDelta && pidResponse->GetSignalDelta(detector, tracks[itrk], species, value) == AliPIDResponse::kDetPidOk) fSignalDelta[index] = value;
+      }
+    }
+  }
+}
+
+//________________________________________________________________________
+Int_t AliPIDNSigmaTable::GetTrackIndex(const AliVParticle *track) const {
+  std::unordered_map<const AliVParticle *, Int_t>::const_iterator found = fTrackIndex.find(track);
+  return found == fTrackIndex.end() ? -1 : found->second;
+}
+
+//________________________________________________________________________
+Float_t AliPIDNSigmaTable::GetNumberOfSigmas(AliPIDResponse::EDetector detector, AliPID::EParticleType species, Int_t itrack) const {
+  Int_t idet = GetDetectorSlot(detector), ispec = GetSpeciesSlot(species);
+  if(idet < 0 || ispec < 0 || itrack < 0 || itrack >= fNTracks) return kUndefined;
+  return fNSigma[GetOffset(idet, ispec) + itrack];
+}
+
+//________________________________________________________________________
+Float_t AliPIDNSigmaTable::GetSignalDelta(AliPIDResponse::EDetector detector, AliPID::EParticleType species, Int_t itrack) const {
+  Int_t idet = GetDetectorSlot(detector), ispec = GetSpeciesSlot(species);
+  if(!fFillSignalDelta || idet < 0 || ispec < 0 || itrack < 0 || itrack >= fNTracks) return kUndefined;
+  return fSignalDelta[GetOffset(idet, ispec) + itrack];
+}
+
+//________________________________________________________________________
+AliPIDResponse::EDetPidStatus AliPIDNSigmaTable::GetPIDStatus(AliPIDResponse::EDetector detector, Int_t itrack) const {
+  Int_t idet = GetDetectorSlot(detector);
+  if(idet < 0 || itrack < 0 || itrack >= fNTracks) return AliPIDResponse::kDetNoSignal;
+  return static_cast<AliPIDResponse::EDetPidStatus>(fStatus[idet * fNTracks + itrack]);
+}
+
+//________________________________________________________________________
+Bool_t AliPIDNSigmaTable::GetNumberOfSigmas(AliPIDResponse::EDetector detector, const AliVParticle *track, AliPID::EParticleType species, Double_t &nsigma) const {
+  //
+  // Look up the n-sigma value for a track. Returns false if the track, the detector or the
+  // species is not in the table, in which case the caller has to use the PID response.
+  //
+  if(!HasDetector(detector) || !HasSpecies(species)) return kFALSE;
+  Int_t itrack = GetTrackIndex(track);
+  if(itrack < 0) return kFALSE;
+  nsigma = GetNumberOfSigmas(detector, species, itrack);
+  return kTRUE;
+}
+
+//________________________________________________________________________
+const Float_t *AliPIDNSigmaTable::GetNumberOfSigmasArray(AliPIDResponse::EDetector detector, AliPID::EParticleType species) const {
+  //
+  // Contiguous n-sigma values of all tracks for a given detector and species,
+  // nullptr if not configured or if the table is empty
+  //
+  Int_t idet = GetDetectorSlot(detector), ispec = GetSpeciesSlot(species);
+  if(idet < 0 || ispec < 0 || !fNTracks) return nullptr;
+  return fNSigma.data() + GetOffset(idet, ispec);
+}
+
+//________________________________________________________________________
+AliPIDNSigmaTable *AliPIDNSigmaTable::FindInEvent(const AliVEvent *event, const char *name){
+  if(!event) return nullptr;
+  return dynamic_cast<AliPIDNSigmaTable *>(event->FindListObject(name));
+}
+
+//________________________________________________________________________
+AliPIDNSigmaTable *AliPIDNSigmaTable::AttachToEvent(AliVEvent *event, const AliPIDNSigmaTable &configuration){
+  //
+  // Table with the name of the configuration in the event. If not present, a table with the
+  // detectors and species of the configuration is created and attached to the event, which
+  // takes it over. The configuration object itself is never attached.
+  //
+  if(!event) return nullptr;
+  AliPIDNSigmaTable *table = FindInEvent(event, configuration.GetName());
+  if(table) return table;
+  table = new AliPIDNSigmaTable();
+  table->SetNameTitle(configuration.GetName(), configuration.GetTitle());
+  table->fDetectors = configuration.fDetectors;
+  table->fSpecies = configuration.fSpecies;
+  table->fFillSignalDelta = configuration.fFillSignalDelta;
+  event->AddObject(table);
+  return table;
+}
+
+//________________________________________________________________________
+void AliPIDNSigmaTable::GetCurrentEventId(Int_t &treeNumber, Long64_t &entry){
+  //
+  // Identify the current event of the analysis manager by the number of the tree in the
+  // input chain and the entry in that tree. The entry number restarts with every tree,
+  // therefore it is not sufficient on its own. -1 if there is no analysis manager.
+  //
+  treeNumber = -1;
+  entry = -1;
+  AliAnalysisManager *man = AliAnalysisManager::GetAnalysisManager();
+  if(!man) return;
+  TTree *tree = man->GetTree();
+  treeNumber = tree ? tree->GetTreeNumber() : -1;
+  entry = man->GetCurrentEntry();
+}
+
+namespace TestAliPIDNSigmaTable {
+
+  int PIDNSigmaTableTestSuite::TestEventStamp(){
+    AliESDEvent esd, other;
+    esd.CreateStdContent();
+    other.CreateStdContent();
+    AliESDpid pid;
+    AliPIDNSigmaTable table("PIDNSigmaTable");
+    if(table.IsFilledFor(&esd, -1, -1)) return 1;
+    table.Fill(&esd, &pid, 0, 5);
+    if(!table.IsFilledFor(&esd, 0, 5)) return 1;
+    if(table.IsFilledFor(&esd, 1, 5)) return 1;     // same entry in the next tree
+    if(table.IsFilledFor(&esd, 0, 6)) return 1;
+    if(table.IsFilledFor(&other, 0, 5)) return 1;
+    if(table.IsFilledFor(nullptr, 0, 5)) return 1;
+    table.Fill(&esd, &pid);                         // no event identification
+    if(table.IsFilledFor(&esd, -1, -1)) return 1;
+    return 0;
+  }
+
+  int PIDNSigmaTableTestSuite::TestAttachSurvivesReset(){
+    AliPIDNSigmaTable configuration("PIDNSigmaTable");
+    configuration.ClearConfiguration();
+    configuration.AddDetector(AliPIDResponse::kTPC);
+    configuration.AddSpecies(AliPID::kPion);
+    AliESDpid pid;
+
+    AliESDEvent *esd = new AliESDEvent;
+    esd->CreateStdContent();
+    Int_t nobjects = esd->GetList()->GetEntries();
+    AliPIDNSigmaTable *attached = AliPIDNSigmaTable::AttachToEvent(esd, configuration);
+    if(!attached || attached == &configuration) return 1;
+    if(AliPIDNSigmaTable::FindInEvent(esd, "PIDNSigmaTable") != attached) return 1;
+    if(!attached->HasDetector(AliPIDResponse::kTPC) || attached->HasDetector(AliPIDResponse::kTOF)) return 1;
+
+    for(Long64_t ientry = 0; ientry < 3; ientry++){
+      esd->Reset();
+      AliPIDNSigmaTable *table = AliPIDNSigmaTable::AttachToEvent(esd, configuration);
+      if(table != attached) return 1;
+      if(esd->GetList()->GetEntries() != nobjects + 1) return 1;
+      table->Fill(esd, &pid, 0, ientry);
+      if(!table->IsFilledFor(esd, 0, ientry)) return 1;
+    }
+
+    delete esd;
+    if(!configuration.HasSpecies(AliPID::kPion) || configuration.GetNumberOfTracks()) return 1;
+    return 0;
+  }
+
+  int TestRunAll(){
+    int testresult(0);
+    PIDNSigmaTableTestSuite testsuite;
+    testresult += testsuite.TestEventStamp();
+    testresult += testsuite.TestAttachSurvivesReset();
+    return testresult;
+  }
+
+}
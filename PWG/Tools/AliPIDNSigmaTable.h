@@ -0,0 +1,162 @@
+#ifndef ALIPIDNSIGMATABLE_H
+#define ALIPIDNSIGMATABLE_H
+/* Copyright(c) 1998-2026, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+#include <unordered_map>
+#include <vector>
+
+#include <TNamed.h>
+
+#include "AliPID.h"
+#include "AliPIDResponse.h"
+
+class AliVEvent;
+class AliVParticle;
+
+/**
+ * @class AliPIDNSigmaTable
+ * @brief Per-event table of PID n-sigma values for all tracks, species and detectors
+ *
+ * The table is filled once per event by AliAnalysisTaskPIDNSigmaTable and attached
+ * to the input event, so that all tasks of a train can look up the n-sigma values
+ * (and the difference to the expected signal) instead of recomputing them with
+ * AliPIDResponse. Values are stored per detector and species in contiguous arrays
+ * indexed by the position of the track in the event:
+ *
+ * ~~~{.cxx}
+ * AliPIDNSigmaTable *table = AliPIDNSigmaTable::FindInEvent(InputEvent(), "PIDNSigmaTable");
+ * for(Int_t itrk = 0; itrk < InputEvent()->GetNumberOfTracks(); itrk++) {
+ *   Float_t nsigma = table->GetNumberOfSigmas(AliPIDResponse::kTPC, AliPID::kPion, itrk);
+ *   ...
+ * }
+ * ~~~
+ *
+ * Values which are not available (detector without PID signal, species or detector not
+ * configured) are set to kUndefined (-999, as returned by AliPIDResponse).
+ *
+ * Tracks are looked up by pointer, and track objects are reused between events. Users
+ * caching the table have to check with IsFilledFor() that it belongs to the current event,
+ * identified by the event pointer, the number of the tree in the input chain and the entry
+ * in that tree (see GetCurrentEventId()).
+ *
+ * The table attached to the event belongs to the event, which may delete it (e.g. when the
+ * event is connected to the next input tree). It is therefore created from a configuration
+ * with AttachToEvent() whenever it is missing, and pointers to it must not be kept across events.
+ */
+class AliPIDNSigmaTable : public TNamed {
+public:
+  /// Value for missing entries, same as AliPIDResponse
+  static const Int_t kUndefined = -999;
+
+  AliPIDNSigmaTable();
+  AliPIDNSigmaTable(const char *name);
+  virtual ~AliPIDNSigmaTable() {}
+
+  // Configuration
+  void AddDetector(AliPIDResponse::EDetector detector);
+  void AddSpecies(AliPID::EParticleType species);
+  void ClearConfiguration();
+  /// Fill also the difference between measured and expected signal
+  void SetFillSignalDelta(Bool_t doFill) { fFillSignalDelta = doFill; }
+  Bool_t HasDetector(AliPIDResponse::EDetector detector) const { return GetDetectorSlot(detector) >= 0; }
+  Bool_t HasSpecies(AliPID::EParticleType species) const { return GetSpeciesSlot(species) >= 0; }
+
+  // Filling
+  void Fill(const AliVEvent *event, const AliPIDResponse *pidResponse, Int_t treeNumber = -1, Long64_t entry = -1);
+  void Reset();
+  /// Check that the table was filled for the given event (event pointer, tree number and entry number)
+  Bool_t IsFilledFor(const AliVEvent *event, Int_t treeNumber, Long64_t entry) const {
+    return event && entry >= 0 && event == fEvent && treeNumber == fTreeNumber && entry == fEntry;
+  }
+
+  // Access
+  /// Number of tracks in the table (number of tracks in the event)
+  Int_t GetNumberOfTracks() const { return fNTracks; }
+  Int_t GetTrackIndex(const AliVParticle *track) const;
+  Float_t GetNumberOfSigmas(AliPIDResponse::EDetector detector, AliPID::EParticleType species, Int_t itrack) const;
+  Float_t GetSignalDelta(AliPIDResponse::EDetector detector, AliPID::EParticleType species, Int_t itrack) const;
+  AliPIDResponse::EDetPidStatus GetPIDStatus(AliPIDResponse::EDetector detector, Int_t itrack) const;
+  Bool_t GetNumberOfSigmas(AliPIDResponse::EDetector detector, const AliVParticle *track, AliPID::EParticleType species, Double_t &nsigma) const;
+  const Float_t *GetNumberOfSigmasArray(AliPIDResponse::EDetector detector, AliPID::EParticleType species) const;
+
+  static AliPIDNSigmaTable *FindInEvent(const AliVEvent *event, const char *name);
+  static AliPIDNSigmaTable *AttachToEvent(AliVEvent *event, const AliPIDNSigmaTable &configuration);
+  static void GetCurrentEventId(Int_t &treeNumber, Long64_t &entry);
+
+protected:
+  Int_t GetDetectorSlot(AliPIDResponse::EDetector detector) const;
+  Int_t GetSpeciesSlot(AliPID::EParticleType species) const;
+  /// Position of the first entry of a detector-species combination in the flat arrays
+  Int_t GetOffset(Int_t detectorSlot, Int_t speciesSlot) const { return (detectorSlot * fSpecies.size() + speciesSlot) * fNTracks; }
+
+  std::vector<Int_t>                              fDetectors;       ///< Detectors for which the n-sigma values are calculated (AliPIDResponse::EDetector)
+  std::vector<Int_t>                              fSpecies;         ///< Species for which the n-sigma values are calculated (AliPID::EParticleType)
+  Bool_t                                          fFillSignalDelta; ///< Fill difference between measured and expected signal
+  Int_t                                           fNTracks;         //!<! Number of tracks in the current event
+  const AliVEvent                                *fEvent;           //!<! Event the table was filled for
+  Int_t                                           fTreeNumber;      //!<! Number of the input tree of the event the table was filled for
+  Long64_t                                        fEntry;           //!<! Entry number (in the input tree) of the event the table was filled for
+  std::vector<Float_t>                            fNSigma;          //!<! n-sigma values, [detector][species][track]
+  std::vector<Float_t>                            fSignalDelta;     //!<! Difference to the expected signal, [detector][species][track]
+  std::vector<UChar_t>                            fStatus;          //!<! PID status, [detector][track]
+  std::unordered_map<const AliVParticle *, Int_t> fTrackIndex;      //!<! Position of the track in the event
+
+  ClassDef(AliPIDNSigmaTable, 3);
+};
+
+/**
+ * @namespace TestAliPIDNSigmaTable
+ * @brief Simple tests for the AliPIDNSigmaTable
+ */
+namespace TestAliPIDNSigmaTable {
+
+/**
+ * @class PIDNSigmaTableTestSuite
+ * @brief Collection of tests for the AliPIDNSigmaTable
+ *
+ * Currently implemented tests:
+ * - Identification of the event the table was filled for
+ * - Table attached to an ESD event across events
+ */
+class PIDNSigmaTableTestSuite {
+public:
+  PIDNSigmaTableTestSuite() {}
+  virtual ~PIDNSigmaTableTestSuite() {}
+
+  /**
+   * Purpose of the test: Check that the table is only accepted for the event it was filled for
+   *
+   * Fill the table for an (empty) ESD event, entry 5 of tree 0
+   *
+   * Test passed: IsFilledFor() is true for the same event, tree and entry, and false for
+   * the same entry in another tree, another entry, another event and unknown entries
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestEventStamp();
+
+  /**
+   * Purpose of the test: Check that the table attached to an ESD event survives AliESDEvent::Reset()
+   *
+   * Attach the table to an ESD event, then for several events reset the ESD event, attach
+   * the table again and fill it. Finally delete the ESD event, which deletes the attached table.
+   *
+   * Test passed:
+   * - the configuration object is not attached to the event, a copy is
+   * - the same table is found in the event after each reset, and it is not attached twice
+   * - the table is accepted for each new event
+   * - the configuration is still valid after the event (and the attached table) is deleted
+   * @return 0 if test is passed, 1 if it failed
+   */
+  int TestAttachSurvivesReset();
+};
+
+/**
+ * Runs all tests for AliPIDNSigmaTable. See @ref PIDNSigmaTableTestSuite for details.
+ * @return 0 if all tests are passed, 1 if tests fail
+ */
+int TestRunAll();
+
+}
+
+#endif /* ALIPIDNSIGMATABLE_H */
@@ -360,6 +360,39 @@ void AliTHnT<TemplateArray, TemplateType>::Fill(const Double_t *var, Int_t istep
 //   AliCFContainer::Fill(var, istep, weight);
 }
 
+template <class TemplateArray, typename TemplateType>
+void AliTHnT<TemplateArray, TemplateType>::FillBins(Int_t n, const Long64_t* bins, const Double_t* weights, Int_t istep)
+{
+  // fills n entries with precalculated global bin indices (see GetGlobalBinIndex, bins start at 0)
+  // entries with bin < 0 are skipped (under/overflow)
+  // equivalent to n calls of Fill(), for callers which calculate the bins of several entries at once
+
+  if (!fValues[istep])
+  {
+    fValues[istep] = new TemplateArray(fNBins);
+    AliInfo(Form("Created values container for step %d", istep));
+  }
+
+  TemplateType* values = fValues[istep]->GetArray();
+  for (Int_t i=0; i<n; i++)
+  {
+    if (bins[i] < 0 || bins[i] >= fNBins)
+      continue;
+
+    Double_t weight = weights[i];
+    if (weight != 1 && !fSumw2[istep])
+    {
+      // initialize with already filled entries (which have been filled with weight == 1), in this case fSumw2 := fValues
+      fSumw2[istep] = new TemplateArray(*fValues[istep]);
+      AliInfo(Form("Created sumw2 container for step %d", istep));
+    }
+
+    values[bins[i]] += weight;
+    if (fSumw2[istep])
+      fSumw2[istep]->GetArray()[bins[i]] += weight * weight;
+  }
+}
+
 template <class TemplateArray, typename TemplateType>
 Long64_t AliTHnT<TemplateArray, TemplateType>::GetGlobalBinIndex(const Int_t* binIdx)
 {
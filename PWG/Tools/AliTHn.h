@@ -48,6 +48,7 @@ class AliTHnT : public AliTHnBase
   virtual ~AliTHnT();
   
   virtual void Fill(const Double_t *var, Int_t istep, Double_t weight=1.) ;
+  void FillBins(Int_t n, const Long64_t* bins, const Double_t* weights, Int_t istep);
   virtual void FillParent();
   virtual void FillContainer(AliCFContainer* cont);
   
@@ -9,6 +9,8 @@
 #pragma link C++ class AliFigure+;
 #pragma link C++ class AliCanvas+;
 #pragma link C++ class AliHelperPID+;
+#pragma link C++ class AliPIDNSigmaTable+;
+#pragma link C++ class AliAnalysisTaskPIDNSigmaTable+;
 #pragma link C++ class AliLatexTable+;
 #pragma link C++ class AliNamedArrayI+;
 #pragma link C++ class AliNamedString+;
@@ -51,4 +53,7 @@
 #pragma link C++ function TestTHistManager::TestRunBuildGrouped();
 #pragma link C++ function TestTHistManager::TestRunFillSimple();
 #pragma link C++ function TestTHistManager::TestRunFillGrouped();
+#pragma link C++ namespace TestAliPIDNSigmaTable;
+#pragma link C++ class TestAliPIDNSigmaTable::PIDNSigmaTableTestSuite;
+#pragma link C++ function TestAliPIDNSigmaTable::TestRunAll();
 #endif
@@ -34,6 +34,14 @@
  * A few trivial cut methods (\ref AlwaysTrue and \ref AlwaysFalse) are defined as well and
  * can be used to register some control cut combinations (see \ref AliAnalysisMuMuCutCombination)
  *
+ * For the histograms filled for each track or pair, daughter classes should avoid building
+ * the histogram path and looking it up in the AliMergeableCollection at each fill. Instead they can
+ * register the (sub path, histogram name) once with \ref RegisterHandle and fill the object
+ * returned by \ref Handle. The handles are resolved once per eventSelection/trigger/centrality
+ * combination (set by the task with \ref SetCurrentCombination) and kept in a dense table.
+ * \ref CutCombinationIndex gives the position of a cut combination in the cut registry, to
+ * index per cut combination tables of handles.
+ *
  */
 
 #include "AliMergeableCollection.h"
@@ -69,7 +77,15 @@ fCutRegistry(0x0),
 fEvent(0x0),
 fMCEvent(0x0),
 fHistogramToDisable(0x0),
-fHasMC(kFALSE)
+fHasMC(kFALSE),
+fCurrentCombination(-1),
+fCombinationIds(),
+fCombinationPaths(),
+fHandleWhat(),
+fHandleNames(),
+fHandleMC(),
+fHandles(),
+fHandleResolved()
 {
  /// default ctor
 }
@@ -420,6 +436,28 @@ Bool_t AliAnalysisMuMuBase::ExistSemaphoreHistogram(const char* eventSelection,
   return ( HistogramCollection()->Histo(Form("/%s/%s/%s/%s",eventSelection,triggerClassName,centrality,ClassName())) != 0x0 );
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::CutCombinationIndex(AliAnalysisMuMuCutElement::ECutType type, const char* cutName) const
+{
+  /// Position of the cut combination cutName in the list of cut combinations of the given type
+  /// of the cut registry, -1 if not found.
+  /// The names handed over by AliAnalysisTaskMuMu are the ones of the registry, so they are
+  /// first compared by address.
+
+  const TObjArray* cuts = fCutRegistry ? fCutRegistry->GetCutCombinations(type) : 0x0;
+  if ( !cuts || !cutName ) return -1;
+
+  for ( Int_t i = 0; i <= cuts->GetLast(); ++i )
+  {
+    if ( cuts->UncheckedAt(i) && cuts->UncheckedAt(i)->GetName() == cutName ) return i;
+  }
+  for ( Int_t i = 0; i <= cuts->GetLast(); ++i )
+  {
+    if ( cuts->UncheckedAt(i) && strcmp(cuts->UncheckedAt(i)->GetName(),cutName) == 0 ) return i;
+  }
+  return -1;
+}
+
 //_____________________________________________________________________________
 Int_t AliAnalysisMuMuBase::GetNbins(Double_t xmin, Double_t xmax, Double_t xstep)
 {
@@ -429,6 +467,48 @@ Int_t AliAnalysisMuMuBase::GetNbins(Double_t xmin, Double_t xmax, Double_t xstep
   return TMath::Nint(TMath::Abs((xmax-xmin)/xstep));
 }
 
+//_____________________________________________________________________________
+TObject* AliAnalysisMuMuBase::Handle(Int_t handleId)
+{
+  /// Get the object of a registered handle for the current eventSelection/trigger/centrality
+  /// combination. The object is looked up in the histogram collection only the first time.
+
+  if ( fCurrentCombination < 0 || handleId < 0 || !fHistogramCollection ) return 0x0;
+
+  std::vector<TObject*>& handles = fHandles[fCurrentCombination];
+  std::vector<Bool_t>& resolved = fHandleResolved[fCurrentCombination];
+
+  if ( handleId >= static_cast<Int_t>(handles.size()) )
+  {
+    handles.resize(fHandleNames.size(),0x0);
+    resolved.resize(fHandleNames.size(),kFALSE);
+  }
+
+  if ( !resolved[handleId] )
+  {
+    TString identifier;
+    if ( fHandleMC[handleId] ) identifier.Form("/%s%s",MCInputPrefix(),fCombinationPaths[fCurrentCombination].Data());
+    else identifier = fCombinationPaths[fCurrentCombination];
+    if ( fHandleWhat[handleId].Length() > 0 )
+    {
+      identifier += "/";
+      identifier += fHandleWhat[handleId];
+    }
+    handles[handleId] = fHistogramCollection->GetObject(identifier.Data(),fHandleNames[handleId].Data());
+    resolved[handleId] = kTRUE;
+  }
+
+  return handles[handleId];
+}
+
+//_____________________________________________________________________________
+const char* AliAnalysisMuMuBase::HandleName(Int_t handleId) const
+{
+  /// Name of the object of a registered handle
+  if ( handleId < 0 || handleId >= static_cast<Int_t>(fHandleNames.size()) ) return "";
+  return fHandleNames[handleId].Data();
+}
+
 //_____________________________________________________________________________
 TH1* AliAnalysisMuMuBase::Histo(const char* eventSelection, const char* triggerClassName, const char* histoname)
 {
@@ -518,6 +598,8 @@ void AliAnalysisMuMuBase::Init(AliCounterCollection& cc,
   fHistogramCollection = &hc;
   fBinning             = &binning;
   fCutRegistry         = &registry;
+
+  ResetHandles();
 }
 
 //_____________________________________________________________________________
@@ -638,6 +720,64 @@ TProfile* AliAnalysisMuMuBase::MCProf(const char* eventSelection,
 	return fHistogramCollection ? static_cast<TProfile*>(fHistogramCollection->GetObject(Form("/%s/%s/%s/%s/%s",MCInputPrefix(),eventSelection,triggerClassName,cent,what),histoname)) : 0x0;
 }
 
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuBase::RegisterHandle(const char* what, const char* histoname, Bool_t mc)
+{
+  /// Register the object histoname in the sub path what (relative to the
+  /// /eventSelection/trigger/centrality path, or to its MCINPUT counterpart if mc is true)
+  /// and return its handle, to be used with Handle().
+  /// Meant to be called once per histogram (e.g. at the first fill), not for every fill.
+
+  for ( std::size_t i = 0; i < fHandleNames.size(); ++i )
+  {
+    if ( fHandleMC[i] == mc && fHandleNames[i] == histoname && fHandleWhat[i] == what ) return i;
+  }
+
+  fHandleWhat.push_back(what);
+  fHandleNames.push_back(histoname);
+  fHandleMC.push_back(mc);
+
+  return fHandleNames.size()-1;
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::ResetHandles()
+{
+  /// Forget the resolved handles (e.g. when the histogram collection changes).
+  /// The registered handles themselves are kept.
+
+  fCurrentCombination = -1;
+  fCombinationIds.clear();
+  fCombinationPaths.clear();
+  fHandles.clear();
+  fHandleResolved.clear();
+}
+
+//_____________________________________________________________________________
+void AliAnalysisMuMuBase::SetCurrentCombination(const char* eventSelection, const char* triggerClassName, const char* centrality)
+{
+  /// Select (and create the first time) the entry of the handle table for this combination
+
+  std::string key(eventSelection);
+  key += "/";
+  key += triggerClassName;
+  key += "/";
+  key += centrality;
+
+  std::map<std::string,Int_t>::const_iterator it = fCombinationIds.find(key);
+  if ( it != fCombinationIds.end() )
+  {
+    fCurrentCombination = it->second;
+    return;
+  }
+
+  fCurrentCombination = fCombinationPaths.size();
+  fCombinationIds[key] = fCurrentCombination;
+  fCombinationPaths.push_back(TString::Format("/%s/%s/%s",eventSelection,triggerClassName,centrality));
+  fHandles.push_back(std::vector<TObject*>(fHandleNames.size(),0x0));
+  fHandleResolved.push_back(std::vector<Bool_t>(fHandleNames.size(),kFALSE));
+}
+
 //_____________________________________________________________________________
 void AliAnalysisMuMuBase::SetEvent(AliVEvent* event, AliMCEvent* mcEvent)
 {
@@ -13,6 +13,10 @@
 #include "TObject.h"
 #include "TString.h"
 #include "TProfile.h"
+#include "AliAnalysisMuMuCutElement.h"
+#include <map>
+#include <string>
+#include <vector>
 
 class AliCounterCollection;
 class AliAnalysisMuMuBinning;
@@ -101,7 +105,12 @@ public:
   Bool_t AlwaysFalse(const AliVParticle& /*particle*/, const AliVParticle& /*particle*/) const { return kFALSE; }
   void NameOfAlwaysFalse(TString& name) const { name = "NONE"; }
 
-  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; }
+  void SetHistogramCollection(AliMergeableCollection* h) { fHistogramCollection = h; ResetHandles(); }
+
+  /** Set the eventSelection/triggerClassName/centrality combination the next FillHistosForXXX calls refer to.
+   * Called by AliAnalysisTaskMuMu once per combination and event, after DefineHistogramCollection.
+   */
+  virtual void SetCurrentCombination(const char* eventSelection, const char* triggerClassName, const char* centrality);
 
 protected:
 
@@ -194,6 +203,16 @@ protected:
 
   Int_t GetNbins(Double_t xmin, Double_t xmax, Double_t xstep);
 
+  Int_t RegisterHandle(const char* what, const char* histoname, Bool_t mc=kFALSE);
+
+  Bool_t HasCurrentCombination() const { return fCurrentCombination >= 0; }
+
+  TObject* Handle(Int_t handleId);
+
+  const char* HandleName(Int_t handleId) const;
+
+  Int_t CutCombinationIndex(AliAnalysisMuMuCutElement::ECutType type, const char* cutName) const;
+
   AliCounterCollection* CounterCollection() const { return fEventCounters; }
   AliMergeableCollection* HistogramCollection() const { return fHistogramCollection; }
   const AliAnalysisMuMuBinning* Binning() const { return fBinning; }
@@ -206,6 +225,8 @@ private:
   /// not implemented on purpose
   AliAnalysisMuMuBase(const AliAnalysisMuMuBase& rhs);
 
+  void ResetHandles();
+
   AliCounterCollection* fEventCounters; //! event counters
   AliMergeableCollection* fHistogramCollection; //! collection of histograms
   const AliAnalysisMuMuBinning* fBinning; //! binning for particles
@@ -214,8 +235,16 @@ private:
   AliMCEvent* fMCEvent; //! current MC event
   TList* fHistogramToDisable; // list of regexp of histo name to disable
   Bool_t fHasMC; // whether or not we're dealing with MC data
-
-  ClassDef(AliAnalysisMuMuBase,1) // base class for a companion class to AliAnalysisMuMu
+  Int_t fCurrentCombination; //! index of the current eventSelection/trigger/centrality combination
+  std::map<std::string,Int_t> fCombinationIds; //! index of each eventSelection/trigger/centrality combination seen so far
+  std::vector<TString> fCombinationPaths; //! /eventSelection/trigger/centrality path of each combination
+  std::vector<TString> fHandleWhat; //! sub path (e.g. cut combination) of each registered handle
+  std::vector<TString> fHandleNames; //! object name of each registered handle
+  std::vector<Bool_t> fHandleMC; //! whether each registered handle refers to the MCINPUT tree
+  std::vector<std::vector<TObject*> > fHandles; //! resolved objects, per combination and handle
+  std::vector<std::vector<Bool_t> > fHandleResolved; //! whether the objects have been looked up already
+
+  ClassDef(AliAnalysisMuMuBase,2) // base class for a companion class to AliAnalysisMuMu
 };
 
 #endif
@@ -27,6 +27,7 @@
 #include "AliMCEvent.h"
 #include "AliMergeableCollection.h"
 #include "AliAnalysisMuonUtility.h"
+#include "AliAnalysisMuMuCutRegistry.h"
 #include "TParameter.h"
 #include <cassert>
 
@@ -49,7 +50,8 @@ fMinvBinSize(0.025),
 fMinvMin(0.0),
 fMinvMax(16.0),
 fmcptcutmin(0.0),
-fmcptcutmax(12.0)
+fmcptcutmax(12.0),
+fMinvHandles()
 {
   // FIXME ? find the AccxEff histogram from HistogramCollection()->Histo("/EXCHANGE/JpsiAccEff")
 
@@ -485,9 +487,15 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
   nextBin.Reset();
   AliAnalysisMuMuBinning::Range* r;
 
+  // Position of the pair cut in the registry, to index the Minv histogram handles
+  Int_t pairCutIndex = HasCurrentCombination() ? CutCombinationIndex(AliAnalysisMuMuCutElement::kTrackPair,pairCutName) : -1;
+  Int_t binIndex(-1);
+
   // Loop over all bin ranges
   while ( ( r = static_cast<AliAnalysisMuMuBinning::Range*>(nextBin()) ) ){
 
+    ++binIndex;
+
     // --- In this loop we first check if the pairs pass some tests and we fill histo accordingly. ---
 
     // Flag for cuts and ranges
@@ -500,13 +508,8 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
     // Check if pair pass all conditions, either MC or not, and fill Minv Histogrames
     if ( ok )
     {
-      // Get Minv histo name associated to the bin
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(eventSelection,triggerClassName,centrality,pairCutName,pairCutIndex,binIndex,*r,
+                    kFALSE,PairCharge,IsMixedHisto,kFALSE,proxy,&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() )
@@ -519,23 +522,15 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4Momentum.Pt(),pair4Momentum.Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,proxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(eventSelection,triggerClassName,centrality,pairCutName,pairCutIndex,binIndex,*r,
+                                     kTRUE,PairCharge,IsMixedHisto,kFALSE,proxy,&pair4Momentum,inputWeight/AccxEff);
       }
     }
 
     if ( okMC ) {
 
-      TString minvName       = GetMinvHistoName(*r,kFALSE,PairCharge,IsMixedHisto);
-      TString hprofName      = Form("MeanPtVs%s",minvName.Data());
-      TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
-      TProfile* hprof        = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-      TProfile* hprofsquare  = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-      FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight);
+      FillMinvHisto(eventSelection,triggerClassName,centrality,pairCutName,pairCutIndex,binIndex,*r,
+                    kFALSE,PairCharge,IsMixedHisto,kTRUE,mcProxy,&pair4Momentum,inputWeight);
 
       // Create, fill and store Minv histo already corrected with accxeff
       if ( ShouldCorrectDimuonForAccEff() ){
@@ -548,12 +543,8 @@ void AliAnalysisMuMuMinv::FillHistosForPair(const char* eventSelection,
         if ( AccxEff <= 0.0 ) AliError(Form("AccxEff < 0 for pt = %f & y = %f ",pair4MomentumMC->Pt(),pair4MomentumMC->Rapidity()));
         else okAccEff = kTRUE;
 
-        minvName        = GetMinvHistoName(*r,kTRUE,PairCharge,IsMixedHisto);
-        hprofName       = Form("MeanPtVs%s",minvName.Data());
-        hprofNameSquare = Form("MeanPtSquareVs%s",minvName.Data());
-        hprof           = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
-        hprofsquare     = MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
-        if( okAccEff ) FillMinvHisto(&minvName,hprof,hprofsquare,mcProxy,&pair4Momentum,inputWeight/AccxEff);
+        if( okAccEff ) FillMinvHisto(eventSelection,triggerClassName,centrality,pairCutName,pairCutIndex,binIndex,*r,
+                                     kTRUE,PairCharge,IsMixedHisto,kTRUE,mcProxy,&pair4Momentum,inputWeight/AccxEff);
 
       }
     }
@@ -707,6 +698,87 @@ void AliAnalysisMuMuMinv::FillMinvHisto(TString* minvName,TProfile* hprof,TProfi
   }
 }
 
+//_____________________________________________________________________________
+void AliAnalysisMuMuMinv::FillMinvHisto(const char* eventSelection, const char* triggerClassName, const char* centrality, const char* pairCutName,
+                                        Int_t pairCutIndex, Int_t binIndex, const AliAnalysisMuMuBinning::Range& r,
+                                        Bool_t accEffCorrected, Double_t PairCharge, Bool_t mix, Bool_t mc,
+                                        AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight)
+{
+  /// Fill the Minv (and mean pt) histograms of one bin.
+  /// The histograms are taken from the precomputed handles, so that no histogram name is built
+  /// and no lookup in the histogram collection is done per pair. Without handles (the task did not
+  /// set the current combination) the histograms are looked up by name.
+
+  Int_t index = MinvHandleIndex(pairCutIndex,binIndex,accEffCorrected,PairCharge,mix,mc);
+
+  if ( index < 0 )
+  {
+    TString minvName       = GetMinvHistoName(r,accEffCorrected,PairCharge,mix);
+    TString hprofName      = Form("MeanPtVs%s",minvName.Data());
+    TString hprofNameSquare= Form("MeanPtSquareVs%s",minvName.Data());
+    TProfile* hprof        = mc ? MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data()) :
+                                  Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofName.Data());
+    TProfile* hprofsquare  = mc ? MCProf(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data()) :
+                                  Prof(eventSelection,triggerClassName,centrality,pairCutName,hprofNameSquare.Data());
+    FillMinvHisto(&minvName,hprof,hprofsquare,proxy,pair4Momentum,inputWeight);
+    return;
+  }
+
+  if ( fMinvHandles[index] == -1 )
+  {
+    // first time this histogram is needed: register the handles
+    TString minvName = GetMinvHistoName(r,accEffCorrected,PairCharge,mix);
+    if ( IsHistogramDisabled(minvName.Data()) )
+    {
+      fMinvHandles[index] = -2;
+    }
+    else
+    {
+      fMinvHandles[index]   = RegisterHandle(pairCutName,minvName.Data(),mc);
+      fMinvHandles[index+1] = RegisterHandle(pairCutName,Form("MeanPtVs%s",minvName.Data()),mc);
+      fMinvHandles[index+2] = RegisterHandle(pairCutName,Form("MeanPtSquareVs%s",minvName.Data()),mc);
+    }
+  }
+
+  if ( fMinvHandles[index] == -2 ) return;
+
+  TH1* h = static_cast<TH1*>(Handle(fMinvHandles[index]));
+  if (h) h->Fill(pair4Momentum->M(),inputWeight);
+
+  // Fill Mean pT
+  if ( fComputeMeanPt ){
+    TProfile* hprof  = static_cast<TProfile*>(Handle(fMinvHandles[index+1]));
+    TProfile* hprof2 = static_cast<TProfile*>(Handle(fMinvHandles[index+2]));
+    if ( !hprof ) AliError(Form("Could not get hprofile for %s",HandleName(fMinvHandles[index])));
+    else hprof->Fill(pair4Momentum->M(),pair4Momentum->Pt(),inputWeight);
+    if ( !hprof2 ) AliError(Form("Could not get hprofile for %s",HandleName(fMinvHandles[index])));
+    else hprof2->Fill(pair4Momentum->M(),pair4Momentum->Pt()*pair4Momentum->Pt(),inputWeight);
+  }
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuMinv::MinvHandleIndex(Int_t pairCutIndex, Int_t binIndex, Bool_t accEffCorrected, Double_t PairCharge, Bool_t mix, Bool_t mc)
+{
+  /// Position of the Minv histogram handle of one (pair cut, bin, acc x eff correction, pair charge, mix, MC) combination
+  /// in fMinvHandles, followed by the mean pt and mean pt^2 ones. -1 if the handles cannot be used.
+
+  if ( pairCutIndex < 0 || binIndex < 0 || !fBinsToFill || !HasCurrentCombination() ) return -1;
+
+  const TObjArray* pairCuts = CutRegistry() ? CutRegistry()->GetCutCombinations(AliAnalysisMuMuCutElement::kTrackPair) : 0x0;
+  if ( !pairCuts ) return -1;
+
+  Int_t nCuts = pairCuts->GetLast()+1;
+  Int_t nBins = fBinsToFill->GetLast()+1;
+  if ( pairCutIndex >= nCuts || binIndex >= nBins ) return -1;
+
+  std::size_t size = nCuts*nBins*2*3*2*2*3;
+  if ( fMinvHandles.size() != size ) fMinvHandles.assign(size,-1);
+
+  Int_t charge = ( PairCharge == 0 ) ? 0 : ( PairCharge > 0 ? 1 : 2 );
+
+  return (((((pairCutIndex*nBins + binIndex)*2 + (accEffCorrected ? 1 : 0))*3 + charge)*2 + (mix ? 1 : 0))*2 + (mc ? 1 : 0))*3;
+}
+
 //_____________________________________________________________________________
 TString AliAnalysisMuMuMinv::GetMinvHistoName(const AliAnalysisMuMuBinning::Range& r, Bool_t accEffCorrected, Double_t PairCharge, Bool_t mix) const
 {
@@ -74,6 +74,13 @@ protected:
 
   void FillMinvHisto(TString* minvName,TProfile* hprof,TProfile* hprof2,AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
 
+  void FillMinvHisto(const char* eventSelection, const char* triggerClassName, const char* centrality, const char* pairCutName,
+                     Int_t pairCutIndex, Int_t binIndex, const AliAnalysisMuMuBinning::Range& r,
+                     Bool_t accEffCorrected, Double_t PairCharge, Bool_t mix, Bool_t mc,
+                     AliMergeableCollectionProxy* proxy, TLorentzVector* pair4Momentum, Double_t inputWeight);
+
+  Int_t MinvHandleIndex(Int_t pairCutIndex, Int_t binIndex, Bool_t accEffCorrected, Double_t PairCharge, Bool_t mix, Bool_t mc);
+
 private:
 
   void CreateMinvHistograms(const char* eventSelection, const char* triggerClassName, const char* centrality);
@@ -111,8 +118,9 @@ private:
   Double_t fMinvMax;
   Double_t fmcptcutmin;
   Double_t fmcptcutmax;
+  std::vector<Int_t> fMinvHandles; //!<! handles of the Minv, mean pt and mean pt^2 histograms (see MinvHandleIndex), -1 if not registered yet, -2 if disabled
 
-  ClassDef(AliAnalysisMuMuMinv,8) // implementation of AliAnalysisMuMuBase for muon pairs
+  ClassDef(AliAnalysisMuMuMinv,9) // implementation of AliAnalysisMuMuBase for muon pairs
 };
 
 #endif
@@ -394,6 +394,8 @@ void AliAnalysisTaskMuMu::FillHistos(const char* eventSelection,
 
       // Create proxy for the Histogram collections
       analysis->DefineHistogramCollection(eventSelection,triggerClassName,centrality,fMix);
+      // Select the histogram handles of this combination
+      analysis->SetCurrentCombination(eventSelection,triggerClassName,centrality);
 
       if ( MCEvent() != 0x0 )
       {
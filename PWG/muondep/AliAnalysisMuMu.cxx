@@ -91,7 +91,8 @@ fCorrectionPerRun(0x0),
 fAssociatedSimulation(0x0),
 fAssociatedSimulation2(0x0),
 fParticleName(""),
-fConfig(new AliAnalysisMuMuConfig(config))
+fConfig(new AliAnalysisMuMuConfig(config)),
+fNofFitWorkers(1)
 {
   GetFileNameAndDirectory(filename);
 
@@ -113,7 +114,8 @@ fCorrectionPerRun(0x0),
 fAssociatedSimulation(0x0),
 fAssociatedSimulation2(0x0),
 fParticleName(""),
-fConfig(0x0)
+fConfig(0x0),
+fNofFitWorkers(1)
 {
   /// ctor
 
@@ -1700,13 +1702,17 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
     TIter nextFitType(fitTypeArray);  // Iterater for every fit types, i.e fitting functions and their config.
     nextFitType.Reset();
 
+    // Fit types for this bin, fitted all at once after the loop
+    TObjArray fitTypesToAdd;
+    fitTypesToAdd.SetOwner(kTRUE);
+
     // Loop on every fittype and create a subresult inside the spectra.
     while ( ( fitType = static_cast<TObjString*>(nextFitType())) )
     {
       AliDebug(1,Form("<<<<<< fitType=%s bin=%s",fitType->String().Data(),bin->Flavour().Data()));
 
       std::cout << "" << std::endl;
-      std::cout << "---------------" << "Fit " << added + 1 << "------------------" << std::endl;
+      std::cout << "---------------" << "Fit " << fitTypesToAdd.GetEntriesFast() + 1 << "------------------" << std::endl;
       if(!mix) std::cout << "Fitting " << hname.Data() << " with " << fitType->String().Data() << std::endl;
       else     std::cout << "Fitting " << hname.Data() << " with " << fitType->String().Data() << " and after remmoving backround from mixing " << std::endl;
       std::cout << "" << std::endl;
@@ -1784,7 +1790,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
         if(!okMCtails) continue;
 
-        added += ( r->AddFit(fitType->String().Data()) == kTRUE );
+        fitTypesToAdd.Add(new TObjString(fitType->String()));
       }
 
       // Config. for mpt (see function type)
@@ -1828,7 +1834,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
           GetParametersFromResult(sMinvfitType,fitMinv);//FIXME: Think about if this is necessary
 
-          added += ( r->AddFit(sMinvfitType.Data()) == kTRUE );
+          fitTypesToAdd.Add(new TObjString(sMinvfitType));
 
           nSubFit++;
         }
@@ -1875,7 +1881,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
 
           GetParametersFromResult(sMinvfitType,fitMinv);//FIXME: Think about if this is necessary
 
-          added += ( r->AddFit(sMinvfitType.Data()) == kTRUE );
+          fitTypesToAdd.Add(new TObjString(sMinvfitType));
 
           nSubFit++;
         }
@@ -1931,7 +1937,7 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
             continue; //return 0x0;
           }
 
-          added += ( r->AddFit(sMinvFitType.Data()) == kTRUE );
+          fitTypesToAdd.Add(new TObjString(sMinvFitType));
 
           nSubFit++;
         }
@@ -1957,12 +1963,16 @@ AliAnalysisMuMuSpectra* AliAnalysisMuMu::FitParticle(const char* particle,const
           continue;
         }
         // Here we call  FINALLY the fit functions
-        added += ( r->AddFit(fitType->String().Data()) == kTRUE );
+        fitTypesToAdd.Add(new TObjString(fitType->String()));
       }
 
       std::cout << "-------------------------------------" << std::endl;
       std::cout << "" << std::endl;
     }
+
+    // Here we call FINALLY the fit functions, possibly in several worker processes
+    added += r->AddFits(fitTypesToAdd,fNofFitWorkers);
+
     if ( !added )
     {
       delete fitTypeArray;
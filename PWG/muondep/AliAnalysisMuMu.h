@@ -316,6 +316,9 @@ public:
     void SetParticleName(const char* particleName) { fParticleName = particleName; }
     void SetConfig(const AliAnalysisMuMuConfig& config);
 
+    /// Number of worker processes among which the fits of a bin are distributed (1 = serial fits)
+    void SetNofFitWorkers(Int_t n) { fNofFitWorkers = n; }
+
     static TFile* FileOpen(const char* file);
     static TString ExpandPathName(const char* file);
 
@@ -380,7 +383,9 @@ private:
 
     AliAnalysisMuMuConfig* fConfig; // configuration
 
-    ClassDef(AliAnalysisMuMu,12) // class to analysis results from AliAnalysisTaskMuMuXXX tasks
+    Int_t fNofFitWorkers; // number of worker processes used for the fits
+
+    ClassDef(AliAnalysisMuMu,13) // class to analysis results from AliAnalysisTaskMuMuXXX tasks
 };
 
 #endif
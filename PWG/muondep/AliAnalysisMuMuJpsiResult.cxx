@@ -44,6 +44,13 @@ ClassImp(AliAnalysisMuMuJpsiResult)
 #include "TMinuit.h"
 #include "TCanvas.h"
 #include "TStyle.h"
+#include <RVersion.h>
+#include <vector>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0) && !defined(_WIN32)
+#define MUMU_FIT_PROCESSEXECUTOR
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#endif
 
 namespace {
 
@@ -12510,7 +12517,86 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
 {
   // Add a fit to this result
 
-  if ( !fHisto ) return kFALSE;
+  return AdoptFit(CreateFit(fitType));
+}
+
+//_____________________________________________________________________________
+Int_t AliAnalysisMuMuJpsiResult::AddFits(const TObjArray& fitTypes, Int_t nWorkers)
+{
+  /// Add several fits (array of TObjString) to this result.
+  ///
+  /// If nWorkers > 1 the fits are distributed among nWorkers forked processes
+  /// (the fit methods use TMinuit and named TF1s, so threads cannot be used).
+  /// The sub results are streamed back together with the index of their fit type
+  /// and adopted in the order of fitTypes, whatever the number of workers. Fits
+  /// not returned by the workers (e.g. crashed worker) are redone serially.
+  /// Note that the functions attached to the histograms of sub results fitted
+  /// in a worker are only kept as sampled points.
+  ///
+  /// Returns the number of added fits
+
+  const Int_t nFits = fitTypes.GetEntriesFast();
+  Int_t added(0);
+
+#ifdef MUMU_FIT_PROCESSEXECUTOR
+  if ( nWorkers > 1 && nFits > 1 && fHisto )
+  {
+    // the results come back in arrival order: each one is paired with the index of its fit type
+    ROOT::TProcessExecutor pool(TMath::Min(nWorkers,nFits));
+    auto fitOne = [&](Int_t i) {
+      TObjArray* out = new TObjArray(2);
+      out->SetOwner(kTRUE);
+      out->AddAt(new TParameter<Int_t>("index",i),0);
+      out->AddAt(CreateFit(static_cast<TObjString*>(fitTypes.At(i))->String().Data()),1);
+      return out;
+    };
+    std::vector<TObjArray*> workerResults = pool.Map(fitOne,ROOT::TSeqI(nFits));
+
+    std::vector<AliAnalysisMuMuJpsiResult*> results(nFits,0x0);
+    std::vector<Bool_t> fitted(nFits,kFALSE);
+    for ( UInt_t iRes = 0; iRes < workerResults.size(); ++iRes )
+    {
+      TObjArray* out = workerResults[iRes];
+      if ( !out ) continue;
+      TParameter<Int_t>* index = dynamic_cast<TParameter<Int_t>*>(out->At(0));
+      Int_t i = index ? index->GetVal() : -1;
+      if ( i >= 0 && i < nFits && !fitted[i] )
+      {
+        results[i] = static_cast<AliAnalysisMuMuJpsiResult*>(out->RemoveAt(1));
+        fitted[i] = kTRUE;
+      }
+      delete out;
+    }
+
+    for ( Int_t i = 0; i < nFits; ++i )
+    {
+      if ( !fitted[i] )
+      {
+        AliWarning(Form("Fit %s not returned by the workers, fitting serially",static_cast<TObjString*>(fitTypes.At(i))->String().Data()));
+        results[i] = CreateFit(static_cast<TObjString*>(fitTypes.At(i))->String().Data());
+      }
+      added += ( AdoptFit(results[i]) == kTRUE );
+    }
+    return added;
+  }
+#else
+  if ( nWorkers > 1 ) AliWarning("Fits in worker processes not supported with this ROOT version, fitting serially");
+#endif
+
+  for ( Int_t i = 0; i < nFits; ++i )
+  {
+    added += ( AddFit(static_cast<TObjString*>(fitTypes.At(i))->String().Data()) == kTRUE );
+  }
+  return added;
+}
+
+//_____________________________________________________________________________
+AliAnalysisMuMuJpsiResult* AliAnalysisMuMuJpsiResult::CreateFit(const char* fitType)
+{
+  /// Create a sub result for fitType and perform the fit.
+  /// Returns 0x0 if the fit type is invalid or the fit could not be done
+
+  if ( !fHisto ) return 0x0;
 
   TH1* histo = static_cast<TH1*>(fHisto->Clone(fitType));
 
@@ -12519,7 +12605,7 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
   if ( !r->IsValid() )
   {
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
   TMethodCall callEnv;
@@ -12539,32 +12625,40 @@ Bool_t AliAnalysisMuMuJpsiResult::AddFit(const char* fitType)
   {
     AliError(Form("Could not get the method %s",fittingMethod.Data()));
     delete r;
-    return kFALSE;
+    return 0x0;
   }
 
-  if ( r->IsValid() )
+  if ( !r->IsValid() )
   {
-    StdoutToAliDebug(1,r->Print(););
-    r->SetBin(Bin());
-    r->SetNofTriggers(NofTriggers());
-    r->SetNofRuns(NofRuns());
+    delete r;
+    return 0x0;
+  }
 
-    Bool_t adoptOK = AdoptSubResult(r);
-    if ( adoptOK ) {
+  return r;
+}
 
-      std::cout << "Subresult " << r->GetName() << " adopted in " << GetName() <<  std::endl;
-      if(IsValidValue(r->Weight()))  SetWeight(Weight()+r->Weight());
-      else SetWeight(Weight()+1);
-    }
-    else AliError(Form("Could not adopt subresult %s",r->GetName()));
-  }
-  else
-  {
-    delete r;
-    r=0x0;
+//_____________________________________________________________________________
+Bool_t AliAnalysisMuMuJpsiResult::AdoptFit(AliAnalysisMuMuJpsiResult* r)
+{
+  /// Adopt a sub result created by CreateFit. Returns kFALSE for a null result
+
+  if ( !r ) return kFALSE;
+
+  StdoutToAliDebug(1,r->Print(););
+  r->SetBin(Bin());
+  r->SetNofTriggers(NofTriggers());
+  r->SetNofRuns(NofRuns());
+
+  Bool_t adoptOK = AdoptSubResult(r);
+  if ( adoptOK ) {
+
+    std::cout << "Subresult " << r->GetName() << " adopted in " << GetName() <<  std::endl;
+    if(IsValidValue(r->Weight()))  SetWeight(Weight()+r->Weight());
+    else SetWeight(Weight()+1);
   }
+  else AliError(Form("Could not adopt subresult %s",r->GetName()));
 
-  return (r!=0x0);
+  return kTRUE;
 }
 
 //_____________________________________________________________________________
@@ -39,6 +39,7 @@ class THashList;
 class TF1;
 class TMap;
 class TFitResultPtr;
+class TObjArray;
 
 class AliAnalysisMuMuJpsiResult : public AliAnalysisMuMuResult
 {
@@ -80,6 +81,8 @@ public:
 
   Bool_t AddFit(const char* fitType);
 
+  Int_t AddFits(const TObjArray& fitTypes, Int_t nWorkers=1);
+
   /** All the fit functions should have a prototype starting like :
 
    AliAnalysisMuMuJpsiResult* FitXXX();
@@ -193,6 +196,10 @@ public:
 
   TString GetFitFunctionMethodName() const;
 
+  AliAnalysisMuMuJpsiResult* CreateFit(const char* fitType);
+
+  Bool_t AdoptFit(AliAnalysisMuMuJpsiResult* r);
+
   void Draw(Option_t* opt="");
 
   const char* GetParticle() { return fParticle; }
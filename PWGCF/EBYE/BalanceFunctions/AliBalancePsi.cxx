@@ -33,6 +33,10 @@
 #include <TString.h>
 #include <TSpline.h>
 #include <TRandom3.h>
+#include <TMap.h>
+#include <TObjString.h>
+#include <THnSparse.h>
+#include <algorithm>
 
 #include "AliVParticle.h"
 #include "AliMCParticle.h"
@@ -97,7 +101,12 @@ AliBalancePsi::AliBalancePsi() :
   fVertexBinning(kFALSE),
   fCustomBinning(""),
   fBinningString(""),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fUsePairKernel(kFALSE),
+  fUseProjectionCache(kTRUE),
+  fPairBins(),
+  fPairWeights(),
+  fProjectionCache(0){
   // Default constructor
 }
 
@@ -150,7 +159,12 @@ AliBalancePsi::AliBalancePsi(const AliBalancePsi& balance):
   fVertexBinning(balance.fVertexBinning),
   fCustomBinning(balance.fCustomBinning),
   fBinningString(balance.fBinningString),
-  fEventClass("EventPlane"){
+  fEventClass("EventPlane"),
+  fUsePairKernel(balance.fUsePairKernel),
+  fUseProjectionCache(balance.fUseProjectionCache),
+  fPairBins(),
+  fPairWeights(),
+  fProjectionCache(0){
   //copy constructor
 }
 
@@ -182,7 +196,9 @@ AliBalancePsi::~AliBalancePsi() {
   delete fHistResonancesPhi;
   delete fHistQbefore;
   delete fHistQafter;
-    
+
+  ClearProjectionCache();
+  delete fProjectionCache;
 }
 
 //____________________________________________________________________//
@@ -484,6 +500,15 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     if (fSameLabelMCCut) secondLabel[i]  = (Int_t)((AliBFBasicParticle*) particlesSecond->At(i))->GetLabel(); 
     if (fResonancesLabelCut) secondMotherLabel[i] = (Int_t)((AliBFBasicParticle*) particlesSecond->At(i))->GetMotherLabel();
   }
+
+  // the pair kernel can only be used if no pair cut (with QA histograms) is active
+  Bool_t usePairKernel = fUsePairKernel && !fResonancesCut && !fResonancePhiCut && !fHBTCut && !fConversionCut && !fQCut;
+  if(!particlesMixed && (fSameLabelMCCut || fResonancesLabelCut)) usePairKernel = kFALSE;
+  if(usePairKernel)
+    PackAssociatedParticles(secondEta,secondPhi,secondPt,secondCharge,secondCorrection,secondTrigOrAssoc);
+
+  // new entries: projections have to be redone
+  ClearProjectionCache();
   
   //TLorenzVector implementation for resonances
   TLorentzVector vectorMother, vectorDaughter[2];
@@ -560,6 +585,12 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
     //fill single particle histograms
     if(charge1 > 0)      fHistP->Fill(trackVariablesSingle,0,firstCorrection); //==========================correction
     else if(charge1 < 0) fHistN->Fill(trackVariablesSingle,0,firstCorrection);  //==========================correction
+
+    // 2nd particle loop over the packed associated particles
+    if(usePairKernel){
+      FillPairsPacked(i,charge1,firstEta,firstPhi,firstPt,firstCorrection,trackVariablesSingle[0],vertexZ,!particlesMixed);
+      continue;
+    }
     
     // 2nd particle loop
     for(Int_t j = 0; j < jMax; j++) {   
@@ -806,6 +837,129 @@ void AliBalancePsi::CalculateBalance(Double_t gReactionPlane,
   }//end of 1st particle loop
 }  
 
+//____________________________________________________________________//
+void AliBalancePsi::PackAssociatedParticles(const TArrayF &eta,
+					    const TArrayF &phi,
+					    const TArrayF &pt,
+					    const TArrayS &charge,
+					    const TArrayD &correction,
+					    const TArrayI &trigOrAssoc) {
+  // Fills the lists of associated particles for FillPairsPacked():
+  // separated by charge (0: positive, 1: negative) and sorted by pT,
+  // so that the momentum ordering is a binary search per trigger particle.
+  // Particles outside the pT,assoc axis are dropped (they would not be filled anyway)
+  // and the pT,assoc part of the global bin index of the pair AliTHn is stored.
+  // All pair AliTHn have the same binning (see InitHistograms()).
+
+  // strides of the global bin index (see AliTHnT::GetGlobalBinIndex)
+  fPairStride[kTrackVariablesPair-1] = 1;
+  for(Int_t iVar = kTrackVariablesPair-2; iVar >= 0; iVar--)
+    fPairStride[iVar] = fPairStride[iVar+1] * fHistPN->GetAxis(iVar+1,0)->GetNbins();
+
+  for(Int_t iList = 0; iList < 2; iList++){
+    fPackedEta[iList].clear();
+    fPackedPhi[iList].clear();
+    fPackedPt[iList].clear();
+    fPackedCorrection[iList].clear();
+    fPackedIndex[iList].clear();
+    fPackedPtBin[iList].clear();
+  }
+
+  Int_t nParticles = pt.GetSize();
+  if(nParticles == 0) return;
+
+  TArrayI order(nParticles);
+  TMath::Sort(nParticles,pt.GetArray(),order.GetArray(),kFALSE);
+
+  TAxis *axisPtAssoc = fHistPN->GetAxis(4,0);
+  for(Int_t k = 0; k < nParticles; k++){
+    Int_t j = order[k];
+    if(trigOrAssoc[j] == 0) continue;
+    if(charge[j] == 0) continue;
+
+    Int_t binPtAssoc = axisPtAssoc->FindBin(pt[j]);
+    if(binPtAssoc < 1 || binPtAssoc > axisPtAssoc->GetNbins()) continue;
+
+    Int_t iList = (charge[j] > 0) ? 0 : 1;
+    fPackedEta[iList].push_back(eta[j]);
+    fPackedPhi[iList].push_back(phi[j]);
+    fPackedPt[iList].push_back(pt[j]);
+    fPackedCorrection[iList].push_back(correction[j]);
+    fPackedIndex[iList].push_back(j);
+    fPackedPtBin[iList].push_back((binPtAssoc-1)*fPairStride[4]);
+  }
+}
+
+//____________________________________________________________________//
+void AliBalancePsi::FillPairsPacked(Int_t iFirst,
+				    Short_t charge1,
+				    Float_t firstEta,
+				    Float_t firstPhi,
+				    Float_t firstPt,
+				    Float_t firstCorrection,
+				    Double_t eventClass,
+				    Double_t vertexZ,
+				    Bool_t sameEvent) {
+  // Pair loop of one trigger particle over the packed associated particles
+  // (see PackAssociatedParticles()), same pairs and weights as the 2nd particle
+  // loop in CalculateBalance() without pair cuts. The global bins are calculated
+  // here and each charge combination is filled in one go (AliTHnT::FillBins).
+
+  if(charge1 == 0) return;
+
+  // bins of the trigger particle (under/overflow is not filled)
+  Int_t binClass   = fHistPN->GetAxis(0,0)->FindBin(eventClass);
+  Int_t binPtTrig  = fHistPN->GetAxis(3,0)->FindBin(firstPt);
+  Int_t binVertexZ = fHistPN->GetAxis(5,0)->FindBin(vertexZ);
+  if(binClass < 1 || binClass > fHistPN->GetAxis(0,0)->GetNbins()) return;
+  if(binPtTrig < 1 || binPtTrig > fHistPN->GetAxis(3,0)->GetNbins()) return;
+  if(binVertexZ < 1 || binVertexZ > fHistPN->GetAxis(5,0)->GetNbins()) return;
+  Long64_t binTrigger = (binClass-1)*fPairStride[0] + (binPtTrig-1)*fPairStride[3] + (binVertexZ-1)*fPairStride[5];
+
+  TAxis *axisDeltaEta = fHistPN->GetAxis(1,0);
+  TAxis *axisDeltaPhi = fHistPN->GetAxis(2,0);
+  Int_t nBinsDeltaEta = axisDeltaEta->GetNbins();
+  Int_t nBinsDeltaPhi = axisDeltaPhi->GetNbins();
+
+  for(Int_t iList = 0; iList < 2; iList++){
+    // list 0: positive, list 1: negative associated particles
+    AliTHn *gHist = NULL;
+    if(charge1 > 0) gHist = (iList == 0) ? fHistPP : fHistPN;
+    else            gHist = (iList == 0) ? fHistNP : fHistNN;
+
+    // pT,Assoc <= pT,Trig (if momentum ordering is switched ON)
+    Int_t nAssociated = fPackedPt[iList].size();
+    if(fMomentumOrdering)
+      nAssociated = std::upper_bound(fPackedPt[iList].begin(),fPackedPt[iList].end(),firstPt) - fPackedPt[iList].begin();
+
+    fPairBins.clear();
+    fPairWeights.clear();
+    for(Int_t j = 0; j < nAssociated; j++){
+      if(sameEvent && fPackedIndex[iList][j] == iFirst) continue; // no auto correlations
+
+      Double_t deltaEta = firstEta - fPackedEta[iList][j];
+      Double_t deltaPhi = firstPhi - fPackedPhi[iList][j];
+      if (deltaPhi > TMath::Pi()) // delta phi between -pi/2 and 3pi/2
+	deltaPhi -= 2.*TMath::Pi();
+      if (deltaPhi <  - TMath::Pi()) 
+	deltaPhi += 2.*TMath::Pi();
+      if (deltaPhi <  - TMath::Pi()/2.) 
+	deltaPhi += 2.*TMath::Pi();
+
+      Int_t binDeltaEta = axisDeltaEta->FindBin(deltaEta);
+      if(binDeltaEta < 1 || binDeltaEta > nBinsDeltaEta) continue;
+      Int_t binDeltaPhi = axisDeltaPhi->FindBin(deltaPhi);
+      if(binDeltaPhi < 1 || binDeltaPhi > nBinsDeltaPhi) continue;
+
+      fPairBins.push_back(binTrigger + fPackedPtBin[iList][j] + (binDeltaEta-1)*fPairStride[1] + (binDeltaPhi-1)*fPairStride[2]);
+      fPairWeights.push_back(firstCorrection*fPackedCorrection[iList][j]);
+    }
+
+    if(!fPairBins.empty())
+      gHist->FillBins(fPairBins.size(),&fPairBins[0],&fPairWeights[0],0);
+  }
+}
+
 //____________________________________________________________________//
 TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
 						 Int_t iVariablePair,
@@ -879,12 +1033,12 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram(Int_t iVariableSingle,
   //Printf("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0));
 
   // Project into the wanted space (1st: analysis step, 2nd: axis)
-  TH1D* hTemp1 = (TH1D*)fHistPN->Project(0,iVariablePair); //
-  TH1D* hTemp2 = (TH1D*)fHistNP->Project(0,iVariablePair); //
-  TH1D* hTemp3 = (TH1D*)fHistPP->Project(0,iVariablePair); //
-  TH1D* hTemp4 = (TH1D*)fHistNN->Project(0,iVariablePair); //
-  TH1D* hTemp5 = (TH1D*)fHistP->Project(0,iVariableSingle); //
-  TH1D* hTemp6 = (TH1D*)fHistN->Project(0,iVariableSingle); //
+  TH1D* hTemp1 = (TH1D*)GetProjection(fHistPN,iVariablePair); //
+  TH1D* hTemp2 = (TH1D*)GetProjection(fHistNP,iVariablePair); //
+  TH1D* hTemp3 = (TH1D*)GetProjection(fHistPP,iVariablePair); //
+  TH1D* hTemp4 = (TH1D*)GetProjection(fHistNN,iVariablePair); //
+  TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,iVariableSingle); //
+  TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,iVariableSingle); //
 
   TH1D *gHistBalanceFunctionHistogram = 0x0;
   if((hTemp1)&&(hTemp2)&&(hTemp3)&&(hTemp4)&&(hTemp5)&&(hTemp6)) {
@@ -1082,21 +1236,21 @@ TH1D *AliBalancePsi::GetBalanceFunctionHistogram2pMethod(Int_t iVariableSingle,
       //Printf("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0));
       
       // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH1D* hTempHelper1 = (TH1D*)fHistPN->Project(0,iVariablePair);
-      TH1D* hTempHelper2 = (TH1D*)fHistNP->Project(0,iVariablePair);
-      TH1D* hTempHelper3 = (TH1D*)fHistPP->Project(0,iVariablePair);
-      TH1D* hTempHelper4 = (TH1D*)fHistNN->Project(0,iVariablePair);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,iVariableSingle);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,iVariableSingle);
+      TH1D* hTempHelper1 = (TH1D*)GetProjection(fHistPN,iVariablePair);
+      TH1D* hTempHelper2 = (TH1D*)GetProjection(fHistNP,iVariablePair);
+      TH1D* hTempHelper3 = (TH1D*)GetProjection(fHistPP,iVariablePair);
+      TH1D* hTempHelper4 = (TH1D*)GetProjection(fHistNN,iVariablePair);
+      TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,iVariableSingle);
+      TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,iVariableSingle);
       
       // ============================================================================================
       // the same for event mixing
-      TH1D* hTempHelper1Mix = (TH1D*)fHistPNMix->Project(0,iVariablePair);
-      TH1D* hTempHelper2Mix = (TH1D*)fHistNPMix->Project(0,iVariablePair);
-      TH1D* hTempHelper3Mix = (TH1D*)fHistPPMix->Project(0,iVariablePair);
-      TH1D* hTempHelper4Mix = (TH1D*)fHistNNMix->Project(0,iVariablePair);
-      TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,iVariableSingle);
-      TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,iVariableSingle);
+      TH1D* hTempHelper1Mix = (TH1D*)GetProjection(fHistPNMix,iVariablePair);
+      TH1D* hTempHelper2Mix = (TH1D*)GetProjection(fHistNPMix,iVariablePair);
+      TH1D* hTempHelper3Mix = (TH1D*)GetProjection(fHistPPMix,iVariablePair);
+      TH1D* hTempHelper4Mix = (TH1D*)GetProjection(fHistNNMix,iVariablePair);
+      TH1D* hTemp5Mix = (TH1D*)GetProjection(fHistPMix,iVariableSingle);
+      TH1D* hTemp6Mix = (TH1D*)GetProjection(fHistNMix,iVariableSingle);
       // ============================================================================================
 
       hTempHelper1->Sumw2();
@@ -1448,12 +1602,12 @@ TH2D *AliBalancePsi::GetBalanceFunctionDeltaEtaDeltaPhi(Double_t psiMin,
   //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
 
   // Project into the wanted space (1st: analysis step, 2nd: axis)
-  TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-  TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-  TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-  TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-  TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-  TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+  TH2D* hTemp1 = (TH2D*)GetProjection(fHistPN,1,2);
+  TH2D* hTemp2 = (TH2D*)GetProjection(fHistNP,1,2);
+  TH2D* hTemp3 = (TH2D*)GetProjection(fHistPP,1,2);
+  TH2D* hTemp4 = (TH2D*)GetProjection(fHistNN,1,2);
+  TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,1);
+  TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,1);
 
   TH2D *gHistBalanceFunctionHistogram = 0x0;
   if((hTemp1)&&(hTemp2)&&(hTemp3)&&(hTemp4)&&(hTemp5)&&(hTemp6)) {
@@ -1648,19 +1802,19 @@ TH2D *AliBalancePsi::GetBalanceFunctionDeltaEtaDeltaPhi2pMethod(Double_t psiMin,
       //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
 
       // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-      TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-      TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-      TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+      TH2D* hTemp1 = (TH2D*)GetProjection(fHistPN,1,2);
+      TH2D* hTemp2 = (TH2D*)GetProjection(fHistNP,1,2);
+      TH2D* hTemp3 = (TH2D*)GetProjection(fHistPP,1,2);
+      TH2D* hTemp4 = (TH2D*)GetProjection(fHistNN,1,2);
+      TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,1);
+      TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,1);
       
       // ============================================================================================
       // the same for event mixing
-      TH2D* hTemp1Mix = (TH2D*)fHistPNMix->Project(0,1,2);
-      TH2D* hTemp2Mix = (TH2D*)fHistNPMix->Project(0,1,2);
-      TH2D* hTemp3Mix = (TH2D*)fHistPPMix->Project(0,1,2);
-      TH2D* hTemp4Mix = (TH2D*)fHistNNMix->Project(0,1,2);
+      TH2D* hTemp1Mix = (TH2D*)GetProjection(fHistPNMix,1,2);
+      TH2D* hTemp2Mix = (TH2D*)GetProjection(fHistNPMix,1,2);
+      TH2D* hTemp3Mix = (TH2D*)GetProjection(fHistPPMix,1,2);
+      TH2D* hTemp4Mix = (TH2D*)GetProjection(fHistNNMix,1,2);
       // TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,1);
       // TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,1);
       // ============================================================================================
@@ -1895,19 +2049,19 @@ TH1D *AliBalancePsi::GetBalanceFunction1DFrom2D2pMethod(Bool_t bPhi,
       //AliInfo(Form("P:%lf - N:%lf - PN:%lf - NP:%lf - PP:%lf - NN:%lf",fHistP->GetEntries(0),fHistN->GetEntries(0),fHistPN->GetEntries(0),fHistNP->GetEntries(0),fHistPP->GetEntries(0),fHistNN->GetEntries(0)));
       
       // Project into the wanted space (1st: analysis step, 2nd: axis)
-      TH2D* hTemp1 = (TH2D*)fHistPN->Project(0,1,2);
-      TH2D* hTemp2 = (TH2D*)fHistNP->Project(0,1,2);
-      TH2D* hTemp3 = (TH2D*)fHistPP->Project(0,1,2);
-      TH2D* hTemp4 = (TH2D*)fHistNN->Project(0,1,2);
-      TH1D* hTemp5 = (TH1D*)fHistP->Project(0,1);
-      TH1D* hTemp6 = (TH1D*)fHistN->Project(0,1);
+      TH2D* hTemp1 = (TH2D*)GetProjection(fHistPN,1,2);
+      TH2D* hTemp2 = (TH2D*)GetProjection(fHistNP,1,2);
+      TH2D* hTemp3 = (TH2D*)GetProjection(fHistPP,1,2);
+      TH2D* hTemp4 = (TH2D*)GetProjection(fHistNN,1,2);
+      TH1D* hTemp5 = (TH1D*)GetProjection(fHistP,1);
+      TH1D* hTemp6 = (TH1D*)GetProjection(fHistN,1);
 
       // ============================================================================================
       // the same for event mixing
-      TH2D* hTemp1Mix = (TH2D*)fHistPNMix->Project(0,1,2);
-      TH2D* hTemp2Mix = (TH2D*)fHistNPMix->Project(0,1,2);
-      TH2D* hTemp3Mix = (TH2D*)fHistPPMix->Project(0,1,2);
-      TH2D* hTemp4Mix = (TH2D*)fHistNNMix->Project(0,1,2);
+      TH2D* hTemp1Mix = (TH2D*)GetProjection(fHistPNMix,1,2);
+      TH2D* hTemp2Mix = (TH2D*)GetProjection(fHistNPMix,1,2);
+      TH2D* hTemp3Mix = (TH2D*)GetProjection(fHistPPMix,1,2);
+      TH2D* hTemp4Mix = (TH2D*)GetProjection(fHistNNMix,1,2);
       // TH1D* hTemp5Mix = (TH1D*)fHistPMix->Project(0,1);
       // TH1D* hTemp6Mix = (TH1D*)fHistNMix->Project(0,1);
       // ============================================================================================
@@ -2055,13 +2209,13 @@ TH1D *AliBalancePsi::GetTriggers(TString type,
     fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-    gHist = (TH1D*)fHistP->Project(0,1);
+    gHist = (TH1D*)GetProjection(fHistP,1);
   }
   else if(type=="NP" || type=="NN"){
     fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
     fHistN->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
     fHistN->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-    gHist = (TH1D*)fHistN->Project(0,1);
+    gHist = (TH1D*)GetProjection(fHistN,1);
   }
   else if(type=="ALL"){
     fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
@@ -2070,8 +2224,8 @@ TH1D *AliBalancePsi::GetTriggers(TString type,
     fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
     fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-    gHist = (TH1D*)fHistN->Project(0,1);
-    gHist->Add((TH1D*)fHistP->Project(0,1));
+    gHist = (TH1D*)GetProjection(fHistN,1);
+    gHist->Add((TH1D*)GetProjection(fHistP,1));
   }
 
   return gHist;
@@ -2223,11 +2377,11 @@ TH2D *AliBalancePsi::GetCorrelationFunction(TString type,
 	// average over number of triggers in each sub-bin
 	Double_t NTrigSubBin = 0;
 	if(type=="PN" || type=="PP")
-	  NTrigSubBin = (Double_t)(fHistP->Project(0,1)->Integral());
+	  NTrigSubBin = (Double_t)GetProjectionIntegral(fHistP,1);
 	else if(type=="NP" || type=="NN")
-	  NTrigSubBin = (Double_t)(fHistN->Project(0,1)->Integral());
+	  NTrigSubBin = (Double_t)GetProjectionIntegral(fHistN,1);
 	else if(type=="ALL")
-	  NTrigSubBin = (Double_t)(fHistN->Project(0,1)->Integral() + fHistP->Project(0,1)->Integral());
+	  NTrigSubBin = (Double_t)(GetProjectionIntegral(fHistN,1) + GetProjectionIntegral(fHistP,1));
 	fSame->Scale(NTrigSubBin);
 	
 	// only if event mixing has enough statistics
@@ -2260,13 +2414,13 @@ TH2D *AliBalancePsi::GetCorrelationFunction(TString type,
       fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-      NTrigAll = (Double_t)(fHistP->Project(0,1)->Integral());
+      NTrigAll = (Double_t)GetProjectionIntegral(fHistP,1);
     }
     else if(type=="NP" || type=="NN"){
       fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
       fHistN->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
       fHistN->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-      NTrigAll = (Double_t)(fHistN->Project(0,1)->Integral());
+      NTrigAll = (Double_t)GetProjectionIntegral(fHistN,1);
     }
     else if(type=="ALL"){
       fHistN->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
@@ -2275,7 +2429,7 @@ TH2D *AliBalancePsi::GetCorrelationFunction(TString type,
       fHistP->GetGrid(0)->GetGrid()->GetAxis(0)->SetRangeUser(psiMin,psiMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(2)->SetRangeUser(vertexZMin,vertexZMax-0.00001); 
       fHistP->GetGrid(0)->GetGrid()->GetAxis(1)->SetRangeUser(ptTriggerMin,ptTriggerMax-0.00001);
-      NTrigAll = (Double_t)(fHistN->Project(0,1)->Integral() + fHistP->Project(0,1)->Integral());
+      NTrigAll = (Double_t)(GetProjectionIntegral(fHistN,1) + GetProjectionIntegral(fHistP,1));
     }
 
     // subtract number of triggers with empty sub bins for correct normalization
@@ -2353,7 +2507,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPN(Double_t psiMin,
   //}
 
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistPN->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistPN,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2369,8 +2523,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPN(Double_t psiMin,
   //c2->cd();
   //fHistPN->Project(0,1,2)->DrawCopy("colz");
 
-  if((Double_t)(fHistP->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistP->Project(0,1)->Integral()));
+  if((Double_t)GetProjectionIntegral(fHistP,1)>0)
+    gHist->Scale(1./(Double_t)GetProjectionIntegral(fHistP,1));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2428,7 +2582,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNP(Double_t psiMin,
     fHistNP->GetGrid(0)->GetGrid()->GetAxis(4)->SetRangeUser(ptAssociatedMin,ptAssociatedMax-0.00001);
 
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistNP->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistNP,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2436,8 +2590,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNP(Double_t psiMin,
 
   //Printf("Entries (1D): %lf",(Double_t)(fHistN->Project(0,2)->GetEntries()));
   //Printf("Entries (2D): %lf",(Double_t)(fHistNP->Project(0,2,3)->GetEntries()));
-  if((Double_t)(fHistN->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistN->Project(0,1)->Integral()));
+  if((Double_t)GetProjectionIntegral(fHistN,1)>0)
+    gHist->Scale(1./(Double_t)GetProjectionIntegral(fHistN,1));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2495,7 +2649,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPP(Double_t psiMin,
     fHistPP->GetGrid(0)->GetGrid()->GetAxis(4)->SetRangeUser(ptAssociatedMin,ptAssociatedMax-0.00001);
       
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistPP->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistPP,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2503,8 +2657,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionPP(Double_t psiMin,
 
   //Printf("Entries (1D): %lf",(Double_t)(fHistP->Project(0,2)->GetEntries()));
   //Printf("Entries (2D): %lf",(Double_t)(fHistPP->Project(0,2,3)->GetEntries()));
-  if((Double_t)(fHistP->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistP->Project(0,1)->Integral()));
+  if((Double_t)GetProjectionIntegral(fHistP,1)>0)
+    gHist->Scale(1./(Double_t)GetProjectionIntegral(fHistP,1));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2562,7 +2716,7 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNN(Double_t psiMin,
     fHistNN->GetGrid(0)->GetGrid()->GetAxis(4)->SetRangeUser(ptAssociatedMin,ptAssociatedMax-0.00001);
     
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHist = dynamic_cast<TH2D *>(fHistNN->Project(0,1,2));
+  TH2D *gHist = dynamic_cast<TH2D *>(GetProjection(fHistNN,1,2));
   if(!gHist){
     AliError("Projection of fHistPN = NULL");
     return gHist;
@@ -2570,8 +2724,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionNN(Double_t psiMin,
 
   //Printf("Entries (1D): %lf",(Double_t)(fHistN->Project(0,2)->GetEntries()));
   //Printf("Entries (2D): %lf",(Double_t)(fHistNN->Project(0,2,3)->GetEntries()));
-  if((Double_t)(fHistN->Project(0,1)->Integral())>0)
-    gHist->Scale(1./(Double_t)(fHistN->Project(0,1)->Integral()));
+  if((Double_t)GetProjectionIntegral(fHistN,1)>0)
+    gHist->Scale(1./(Double_t)GetProjectionIntegral(fHistN,1));
 
   //normalize to bin width
   gHist->Scale(1./((Double_t)gHist->GetXaxis()->GetBinWidth(1)*(Double_t)gHist->GetYaxis()->GetBinWidth(1)));
@@ -2645,22 +2799,22 @@ TH2D *AliBalancePsi::GetCorrelationFunctionChargeIndependent(Double_t psiMin,
   }
 
   //0:step, 1: Delta eta, 2: Delta phi
-  TH2D *gHistNN = dynamic_cast<TH2D *>(fHistNN->Project(0,1,2));
+  TH2D *gHistNN = dynamic_cast<TH2D *>(GetProjection(fHistNN,1,2));
   if(!gHistNN){
     AliError("Projection of fHistNN = NULL");
     return gHistNN;
   }
-  TH2D *gHistPP = dynamic_cast<TH2D *>(fHistPP->Project(0,1,2));
+  TH2D *gHistPP = dynamic_cast<TH2D *>(GetProjection(fHistPP,1,2));
   if(!gHistPP){
     AliError("Projection of fHistPP = NULL");
     return gHistPP;
   }
-  TH2D *gHistNP = dynamic_cast<TH2D *>(fHistNP->Project(0,1,2));
+  TH2D *gHistNP = dynamic_cast<TH2D *>(GetProjection(fHistNP,1,2));
   if(!gHistNP){
     AliError("Projection of fHistNP = NULL");
     return gHistNP;
   }
-  TH2D *gHistPN = dynamic_cast<TH2D *>(fHistPN->Project(0,1,2));
+  TH2D *gHistPN = dynamic_cast<TH2D *>(GetProjection(fHistPN,1,2));
   if(!gHistPN){
     AliError("Projection of fHistPN = NULL");
     return gHistPN;
@@ -2672,8 +2826,8 @@ TH2D *AliBalancePsi::GetCorrelationFunctionChargeIndependent(Double_t psiMin,
   gHistNN->Add(gHistPN);
 
   // divide by sum of + and - triggers
-  if((Double_t)(fHistN->Project(0,1)->Integral())>0 && (Double_t)(fHistP->Project(0,1)->Integral())>0)
-    gHistNN->Scale(1./(Double_t)(fHistN->Project(0,1)->Integral() + fHistP->Project(0,1)->Integral()));
+  if((Double_t)GetProjectionIntegral(fHistN,1)>0 && (Double_t)GetProjectionIntegral(fHistP,1)>0)
+    gHistNN->Scale(1./(Double_t)(GetProjectionIntegral(fHistN,1) + GetProjectionIntegral(fHistP,1)));
 
   //normalize to bin width
   gHistNN->Scale(1./((Double_t)gHistNN->GetXaxis()->GetBinWidth(1)*(Double_t)gHistNN->GetYaxis()->GetBinWidth(1)));
@@ -2681,6 +2835,80 @@ TH2D *AliBalancePsi::GetCorrelationFunctionChargeIndependent(Double_t psiMin,
   return gHistNN;
 }
 
+//____________________________________________________________________//
+void AliBalancePsi::ClearProjectionCache() {
+  // Deletes the cached projections of the AliTHn
+  if(fProjectionCache) fProjectionCache->DeleteAll();
+}
+
+//____________________________________________________________________//
+TH1 *AliBalancePsi::FindProjection(AliTHn *gHist,
+				   Int_t iVar1,
+				   Int_t iVar2) {
+  // Returns the projection of step 0 of gHist on iVar1 (and iVar2)
+  // for the axis ranges set at the moment.
+  // The projection is done only once for each histogram and set of ranges,
+  // the returned histogram is owned by the cache and must not be modified.
+  if(!gHist) return NULL;
+
+  THnSparse *grid = gHist->GetGrid(0)->GetGrid();
+  TString key = Form("%s_%p_%d_%d_%.0f_%lld",gHist->GetName(),(void*)gHist,iVar1,iVar2,grid->GetEntries(),grid->GetNbins());
+  for(Int_t iVar = 0; iVar < grid->GetNdimensions(); iVar++){
+    TAxis *axis = grid->GetAxis(iVar);
+    if(axis->TestBit(TAxis::kAxisRange)) key += Form("_%d_%d",axis->GetFirst(),axis->GetLast());
+    else key += "_all";
+  }
+
+  if(!fProjectionCache){
+    fProjectionCache = new TMap();
+    fProjectionCache->SetOwnerKeyValue(kTRUE,kTRUE);
+  }
+
+  TH1 *gProjection = (TH1*)fProjectionCache->GetValue(key.Data());
+  if(!gProjection){
+    gProjection = gHist->Project(0,iVar1,iVar2);
+    if(!gProjection) return NULL;
+    gProjection->SetDirectory(0);
+    fProjectionCache->Add(new TObjString(key.Data()),gProjection);
+  }
+
+  return gProjection;
+}
+
+//____________________________________________________________________//
+TH1 *AliBalancePsi::GetProjection(AliTHn *gHist,
+				  Int_t iVar1,
+				  Int_t iVar2) {
+  // Returns the projection of step 0 of gHist on iVar1 (and iVar2)
+  // for the axis ranges set at the moment, owned by the caller.
+  // Same as gHist->Project(0,iVar1,iVar2), but taken from the cache if enabled.
+  if(!gHist) return NULL;
+  if(!fUseProjectionCache) return gHist->Project(0,iVar1,iVar2);
+
+  TH1 *gProjection = FindProjection(gHist,iVar1,iVar2);
+  if(!gProjection) return NULL;
+  return (TH1*)gProjection->Clone();
+}
+
+//____________________________________________________________________//
+Double_t AliBalancePsi::GetProjectionIntegral(AliTHn *gHist,
+					      Int_t iVar) {
+  // Returns the integral of the projection of step 0 of gHist on iVar
+  // for the axis ranges set at the moment (e.g. the number of triggers)
+  if(!gHist) return 0.;
+
+  if(fUseProjectionCache){
+    TH1 *gProjection = FindProjection(gHist,iVar);
+    return gProjection ? gProjection->Integral() : 0.;
+  }
+
+  TH1 *gProjection = gHist->Project(0,iVar);
+  if(!gProjection) return 0.;
+  Double_t integral = gProjection->Integral();
+  delete gProjection;
+  return integral;
+}
+
 //____________________________________________________________________//
 Bool_t AliBalancePsi::GetMomentsAnalytical(Int_t fVariable, TH1D* gHist, Bool_t kUseZYAM,
 					   Double_t &mean, Double_t &meanError,
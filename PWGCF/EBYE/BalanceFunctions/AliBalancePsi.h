@@ -25,9 +25,15 @@ using std::vector;
 #define MAXIMUM_NUMBER_OF_STEPS	1024
 #define MAXIMUM_STEPS_IN_PSI 360
 
+class TH1;
 class TH1D;
 class TH2D;
 class TH3D;
+class TArrayF;
+class TArrayS;
+class TArrayD;
+class TArrayI;
+class TMap;
 
 const Int_t kTrackVariablesSingle = 3;       // track variables in histogram (event class, pTtrig, vertexZ)
 const Int_t kTrackVariablesPair   = 6;       // track variables in histogram (event class, dEta, dPhi, pTtrig, ptAssociated, vertexZ)
@@ -137,17 +143,17 @@ class AliBalancePsi : public TObject {
   AliTHn *GetHistNnn() {return fHistNN;}
 
   void SetHistNp(AliTHn *gHist) {
-    fHistP = gHist; }//fHistP->FillParent(); fHistP->DeleteContainers();}
+    fHistP = gHist; ClearProjectionCache(); }//fHistP->FillParent(); fHistP->DeleteContainers();}
   void SetHistNn(AliTHn *gHist) {
-    fHistN = gHist; }//fHistN->FillParent(); fHistN->DeleteContainers();}
+    fHistN = gHist; ClearProjectionCache(); }//fHistN->FillParent(); fHistN->DeleteContainers();}
   void SetHistNpn(AliTHn *gHist) {
-    fHistPN = gHist; }//fHistPN->FillParent(); fHistPN->DeleteContainers();}
+    fHistPN = gHist; ClearProjectionCache(); }//fHistPN->FillParent(); fHistPN->DeleteContainers();}
   void SetHistNnp(AliTHn *gHist) {
-    fHistNP = gHist; }//fHistNP->FillParent(); fHistNP->DeleteContainers();}
+    fHistNP = gHist; ClearProjectionCache(); }//fHistNP->FillParent(); fHistNP->DeleteContainers();}
   void SetHistNpp(AliTHn *gHist) {
-    fHistPP = gHist; }//fHistPP->FillParent(); fHistPP->DeleteContainers();}
+    fHistPP = gHist; ClearProjectionCache(); }//fHistPP->FillParent(); fHistPP->DeleteContainers();}
   void SetHistNnn(AliTHn *gHist) {
-    fHistNN = gHist; }//fHistNN->FillParent(); fHistNN->DeleteContainers();}
+    fHistNN = gHist; ClearProjectionCache(); }//fHistNN->FillParent(); fHistNN->DeleteContainers();}
 
   TH1D *GetBalanceFunctionHistogram(Int_t iVariableSingle,
 				    Int_t iVariablePair,
@@ -241,6 +247,14 @@ class AliBalancePsi : public TObject {
   void UseMomentumDifferenceCut(Double_t gDeltaPtCutMin) {
     fQCut = kTRUE; fDeltaPtMin = gDeltaPtCutMin;}
 
+  // pair loop over packed, sign separated and pT sorted associated particles
+  // with batched AliTHn filling, used only if no pair cut with QA histograms is active
+  void UsePairKernel(Bool_t usePairKernel = kTRUE) {fUsePairKernel = usePairKernel;}
+  // cache the projections of the AliTHn in the post-processing (default = kTRUE)
+  void UseProjectionCache(Bool_t useProjectionCache = kTRUE) {
+    fUseProjectionCache = useProjectionCache; if(!useProjectionCache) ClearProjectionCache();}
+  void ClearProjectionCache();
+
   // related to customized binning of output AliTHn
   Bool_t    IsUseVertexBinning() { return fVertexBinning; }
   TString   GetBinningString()   { return fBinningString; }
@@ -249,6 +263,15 @@ class AliBalancePsi : public TObject {
  private:
   Float_t   GetDPhiStar(Float_t phi1, Float_t pt1, Float_t charge1, Float_t phi2, Float_t pt2, Float_t charge2, Float_t radius, Float_t bSign); 
 
+  void      PackAssociatedParticles(const TArrayF &eta, const TArrayF &phi, const TArrayF &pt,
+				    const TArrayS &charge, const TArrayD &correction, const TArrayI &trigOrAssoc);
+  void      FillPairsPacked(Int_t iFirst, Short_t charge1, Float_t firstEta, Float_t firstPhi, Float_t firstPt,
+			    Float_t firstCorrection, Double_t eventClass, Double_t vertexZ, Bool_t sameEvent);
+
+  TH1      *FindProjection(AliTHn *gHist, Int_t iVar1, Int_t iVar2 = -1);
+  TH1      *GetProjection(AliTHn *gHist, Int_t iVar1, Int_t iVar2 = -1);
+  Double_t  GetProjectionIntegral(AliTHn *gHist, Int_t iVar);
+
   Bool_t fShuffle; //shuffled balance function object
   TString fAnalysisLevel; //ESD, AOD or MC
   Int_t fAnalyzedEvents; //number of events that have been analyzed
@@ -307,9 +330,23 @@ class AliBalancePsi : public TObject {
 
   TString fEventClass;
 
+  Bool_t fUsePairKernel;//use the packed pair loop (FillPairsPacked) if no pair cuts are active
+  Bool_t fUseProjectionCache;//cache the AliTHn projections in the post-processing
+
+  vector<Float_t>  fPackedEta[2];//! associated particles (0: positive, 1: negative), sorted by pT
+  vector<Float_t>  fPackedPhi[2];//! phi of the packed associated particles
+  vector<Float_t>  fPackedPt[2];//! pT of the packed associated particles
+  vector<Double_t> fPackedCorrection[2];//! correction of the packed associated particles
+  vector<Int_t>    fPackedIndex[2];//! index in the list of second particles
+  vector<Long64_t> fPackedPtBin[2];//! pT,assoc contribution to the global bin of the pair AliTHn
+  Long64_t         fPairStride[kTrackVariablesPair];//! strides of the global bin of the pair AliTHn
+  vector<Long64_t> fPairBins;//! global bins of the pairs of one trigger particle
+  vector<Double_t> fPairWeights;//! weights of the pairs of one trigger particle
+  TMap            *fProjectionCache;//! projections of the AliTHn, keyed by histogram and axis ranges
+
   AliBalancePsi & operator=(const AliBalancePsi & ) {return *this;}
 
-  ClassDef(AliBalancePsi, 5)
+  ClassDef(AliBalancePsi, 6)
 };
 
 #endif
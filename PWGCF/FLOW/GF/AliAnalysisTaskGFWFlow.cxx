@@ -269,6 +269,7 @@ void AliAnalysisTaskGFWFlow::UserCreateOutputObjects(){
     fFC->SetName(Form("FC%s",fSelections[fCurrSystFlag]->GetSystPF()));
     fFC->SetXAxis(fPtAxis);
     fFC->Initialize(OAforPt,7,multibins,10); //Statistics only required for nominal profiles, so do not create randomized profiles for systematics
+    fFC->SetBufferFills(kTRUE); //Profiles are only updated in FinishTaskOutput()
     //Powers per harmonic:
     Int_t NoGap[] = {9,0,8,4,7,2,6,0,5};
     Int_t WithGap[] = {5,0,2,2,3,2,4,0,5};
@@ -377,7 +378,7 @@ void AliAnalysisTaskGFWFlow::UserExec(Option_t*) {
     };
     Bool_t filled;
     for(Int_t l_ind=0; l_ind<corrconfigs.size(); l_ind++) {
-      filled = FillFCs(corrconfigs.at(l_ind),l_Cent,0);//,DisableOL);
+      filled = FillFCs(corrconfigs.at(l_ind),l_Cent,0,kFALSE,l_ind);//,DisableOL);
     };
     PostData(1,fFC);
     PostData(2,fMultiDist);
@@ -510,13 +511,16 @@ void AliAnalysisTaskGFWFlow::UserExec(Option_t*) {
     Double_t rndmn=rndm.Rndm();
     Bool_t filled;
     for(Int_t l_ind=0; l_ind<corrconfigs.size(); l_ind++) {
-      filled = FillFCs(corrconfigs.at(l_ind),cent,rndmn);//,DisableOL);
+      filled = FillFCs(corrconfigs.at(l_ind),cent,rndmn,kFALSE,l_ind);//,DisableOL);
     };
     PostData(1,fFC);
     PostData(2,fMultiDist);
     if(fAddQA) PostData(3,fQAList);
   };
 };
+void AliAnalysisTaskGFWFlow::FinishTaskOutput() {
+  if(fFC) fFC->FlushBuffer();
+};
 void AliAnalysisTaskGFWFlow::Terminate(Option_t*) {
   // printf("\n********* Time: %f\n**********",mywatch.RealTime());
   // printf("Filling time: %f\n",mywatchFill.RealTime());
@@ -714,14 +718,17 @@ Bool_t AliAnalysisTaskGFWFlow::FillFCs(TString head, TString hn, Double_t cent,
   };
   return kTRUE;
 };
-Bool_t AliAnalysisTaskGFWFlow::FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndmn, Bool_t DisableOverlap) {
+Bool_t AliAnalysisTaskGFWFlow::FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndmn, Bool_t DisableOverlap, Int_t confIndex) {
   Double_t dnx, val;
   dnx = fGFW->Calculate(corconf,0,kTRUE).Re();
   if(dnx==0) return kFALSE;
+  const vector<Int_t> *fcInd = (confIndex>=0 && confIndex<(Int_t)fCorrIndices.size())?&fCorrIndices.at(confIndex):0;
   if(!corconf.pTDif) {
     val = fGFW->Calculate(corconf,0,kFALSE).Re()/dnx;
-    if(TMath::Abs(val)<1)
-      fFC->FillProfile(corconf.Head.Data(),cent,val,dnx,rndmn);
+    if(TMath::Abs(val)<1) {
+      if(fcInd) fFC->FillProfile(fcInd->at(0),cent,val,dnx,rndmn);
+      else fFC->FillProfile(corconf.Head.Data(),cent,val,dnx,rndmn);
+    };
     return kTRUE;
   };
   /*Int_t binDisableOLFrom = fPtAxis->GetNbins()+1;
@@ -733,8 +740,10 @@ Bool_t AliAnalysisTaskGFWFlow::FillFCs(AliGFW::CorrConfig corconf, Double_t cent
     dnx = fGFW->Calculate(corconf,i-1,kTRUE,NeedToDisable).Re();
     if(dnx==0) continue;
     val = fGFW->Calculate(corconf,i-1,kFALSE,NeedToDisable).Re()/dnx;
-    if(TMath::Abs(val)<1)
-      fFC->FillProfile(Form("%s_pt_%i",corconf.Head.Data(),i),cent,val,dnx,rndmn);
+    if(TMath::Abs(val)<1) {
+      if(fcInd) fFC->FillProfile(fcInd->at(i),cent,val,dnx,rndmn);
+      else fFC->FillProfile(Form("%s_pt_%i",corconf.Head.Data(),i),cent,val,dnx,rndmn);
+    };
   };
   return kTRUE;
 };
@@ -812,5 +821,14 @@ void AliAnalysisTaskGFWFlow::CreateCorrConfigs() {
   corrconfigs.push_back(GetConf("MidGapNV52","poiGapNeg refGapNeg | olGapNeg {5} refGapPos {-5}", kTRUE));
   corrconfigs.push_back(GetConf("MidGapPV52","refGapPos {5} refGapNeg {-5}", kFALSE));
   corrconfigs.push_back(GetConf("MidGapPV52","poiGapPos refGapPos | olGapPos {5} refGapNeg {-5}", kTRUE));
-
+  //Resolve the flow container bins once, instead of a label lookup per fill:
+  fCorrIndices.clear();
+  for(Int_t l_ind=0; l_ind<(Int_t)corrconfigs.size(); l_ind++) {
+    vector<Int_t> l_fcInd;
+    l_fcInd.push_back(corrconfigs.at(l_ind).pTDif?-1:fFC->GetCorrelatorIndex(corrconfigs.at(l_ind).Head.Data()));
+    if(corrconfigs.at(l_ind).pTDif)
+      for(Int_t i=1;i<=fPtAxis->GetNbins();i++)
+        l_fcInd.push_back(fFC->GetCorrelatorIndex(Form("%s_pt_%i",corrconfigs.at(l_ind).Head.Data(),i)));
+    fCorrIndices.push_back(l_fcInd);
+  };
 }
@@ -47,6 +47,7 @@ class AliAnalysisTaskGFWFlow : public AliAnalysisTaskSE {
   virtual void UserCreateOutputObjects();
   virtual void UserExec(Option_t *option);
   virtual void NotifyRun();
+  virtual void FinishTaskOutput();
   virtual void Terminate(Option_t *);
   Bool_t AcceptEvent();
   Bool_t AcceptAODVertex(AliAODEvent*);
@@ -55,6 +56,7 @@ class AliAnalysisTaskGFWFlow : public AliAnalysisTaskSE {
   void SetWeightDir(const char *newval) { fWeightDir.Clear(); fWeightDir.Append(newval); };
   Bool_t SetInputWeightList(TList *inList);
   vector<AliGFW::CorrConfig> corrconfigs; //! do not store
+  vector<vector<Int_t> > fCorrIndices; //! flow container indices of corrconfigs (pT-integrated, then per pT bin)
   AliGFW::CorrConfig GetConf(TString head, TString desc, Bool_t ptdif) { return fGFW->GetCorrelatorConfig(desc,head,ptdif);};
   void CreateCorrConfigs();
   void SetTriggerType(AliVEvent::EOfflineTriggerTypes newval) { fTriggerType = newval; };
@@ -104,14 +106,14 @@ class AliAnalysisTaskGFWFlow : public AliAnalysisTaskSE {
   Bool_t AcceptParticle(AliVParticle *mPa);
   Bool_t InitRun();
   Bool_t LoadWeights(Int_t runno);
-  Bool_t FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndm, Bool_t DisableOverlap=kFALSE);
+  Bool_t FillFCs(AliGFW::CorrConfig corconf, Double_t cent, Double_t rndm, Bool_t DisableOverlap=kFALSE, Int_t confIndex=-1);
   Bool_t FillFCs(TString head, TString hn, Double_t cent, Bool_t diff, Double_t rndmn);
   AliMCEvent *FetchMCEvent(Double_t &impactParameter);
   Double_t GetCentFromIP(Double_t impactParameter) { return fCentMap->GetBinContent(fCentMap->FindBin(impactParameter)); };
  // TStopwatch mywatch;
  // TStopwatch mywatchFill;
  // TStopwatch mywatchStore;
-  ClassDef(AliAnalysisTaskGFWFlow,1);
+  ClassDef(AliAnalysisTaskGFWFlow,2);
 };
 
 #endif
@@ -15,7 +15,12 @@ AliGFWFlowContainer::AliGFWFlowContainer():
   fXAxis(0),
   fNbinsPt(0),
   fbinsPt(0),
-  fPropagateErrors(kFALSE)
+  fPropagateErrors(kFALSE),
+  fBufferFills(kFALSE),
+  fFillBuffer(),
+  fBufferStats(),
+  fBufferedBins(),
+  fBufferNCells(0)
 {
 };
 AliGFWFlowContainer::AliGFWFlowContainer(const char *name):
@@ -29,10 +34,16 @@ AliGFWFlowContainer::AliGFWFlowContainer(const char *name):
   fXAxis(0),
   fNbinsPt(0),
   fbinsPt(0),
-  fPropagateErrors(kFALSE)
+  fPropagateErrors(kFALSE),
+  fBufferFills(kFALSE),
+  fFillBuffer(),
+  fBufferStats(),
+  fBufferedBins(),
+  fBufferNCells(0)
 {
 };
 AliGFWFlowContainer::~AliGFWFlowContainer() {
+  fBufferedBins.clear(); //Nothing to flush when deleting
   delete fProf;
   delete fProfRand;
 };
@@ -124,7 +135,101 @@ Int_t AliGFWFlowContainer::FillProfile(const char *hname, Double_t multi, Double
   };
   return 0;
 };
+Int_t AliGFWFlowContainer::GetCorrelatorIndex(const char *hname) {
+  if(!fProf) return -1;
+  Int_t yin = fProf->GetYaxis()->FindBin(hname);
+  if(!yin) {
+    printf("Could not find bin %s\n",hname);
+    return -1;
+  };
+  return yin;
+};
+Int_t AliGFWFlowContainer::FillProfile(Int_t corrIndex, Double_t multi, Double_t corr, Double_t w, Double_t rn) {
+  if(!fProf) return -1;
+  if(corrIndex<1 || corrIndex>fProf->GetNbinsY()) return -1;
+  Int_t randInd = fNRandom?((Int_t)(rn*fNRandom)+1):0;
+  if(randInd>fNRandom) randInd=fNRandom; //rn==1
+  if(!fBufferFills) {
+    //y-axis is [0.5, N+0.5] with unit bins, so bin center is the index itself
+    fProf->Fill(multi,corrIndex,corr,w);
+    if(randInd) ((TProfile2D*)fProfRand->At(randInd-1))->Fill(multi,corrIndex,corr,w);
+    return 0;
+  };
+  Int_t nSamples = fNRandom+1;
+  if(fFillBuffer.empty()) {
+    fBufferNCells = (fProf->GetNbinsX()+2)*(fProf->GetNbinsY()+2);
+    fFillBuffer.assign(4*nSamples*fBufferNCells,0.);
+    fBufferStats.assign(10*nSamples,0.);
+  };
+  Int_t xbin = fProf->GetXaxis()->FindBin(multi);
+  Int_t bin = fProf->GetBin(xbin,corrIndex);
+  Bool_t inRange = (xbin>0 && xbin<=fProf->GetNbinsX());
+  for(Int_t l_s=0; l_s<2; l_s++) {
+    Int_t sample = l_s?randInd:0;
+    if(l_s && !randInd) break;
+    Int_t cell = sample*fBufferNCells+bin;
+    Double_t *sums = &fFillBuffer[4*cell];
+    if(sums[0]==0 && sums[1]==0 && sums[2]==0 && sums[3]==0) fBufferedBins.push_back(cell);
+    sums[0]+=w*corr;
+    sums[1]+=w;
+    sums[2]+=w*w;
+    sums[3]+=w*corr*corr;
+    //Statistics as in TProfile2D::Fill; under/overflows in multiplicity are not counted
+    Double_t *stats = &fBufferStats[10*sample];
+    if(inRange) {
+      stats[0]+=w;
+      stats[1]+=w*w;
+      stats[2]+=w*multi;
+      stats[3]+=w*multi*multi;
+      stats[4]+=w*corrIndex;
+      stats[5]+=w*corrIndex*corrIndex;
+      stats[6]+=w*multi*corrIndex;
+      stats[7]+=w*corr;
+      stats[8]+=w*corr*corr;
+    };
+    stats[9]+=1;
+  };
+  return 0;
+};
+void AliGFWFlowContainer::FlushBuffer() {
+  if(fBufferedBins.empty()) return;
+  Int_t nSamples = fNRandom+1;
+  for(Int_t sample=0; sample<nSamples; sample++) {
+    Double_t *stats = &fBufferStats[10*sample];
+    if(stats[9]==0) continue;
+    TProfile2D *tpro = sample?(TProfile2D*)fProfRand->At(sample-1):fProf;
+    Double_t profStats[TH1::kNstat];
+    tpro->GetStats(profStats);
+    for(Int_t i=0;i<9;i++) profStats[i]+=stats[i];
+    Double_t nEntries = tpro->GetEntries()+stats[9];
+    for(Int_t i=0;i<10;i++) stats[i]=0;
+    tpro->PutStats(profStats);
+    tpro->SetEntries(nEntries);
+  };
+  for(Int_t i=0;i<(Int_t)fBufferedBins.size();i++) {
+    Int_t cell = fBufferedBins[i];
+    Int_t sample = cell/fBufferNCells;
+    Int_t bin = cell%fBufferNCells;
+    TProfile2D *tpro = sample?(TProfile2D*)fProfRand->At(sample-1):fProf;
+    Double_t *sums = &fFillBuffer[4*cell];
+    tpro->fArray[bin] += sums[0];
+    tpro->SetBinEntries(bin,tpro->GetBinEntries(bin)+sums[1]);
+    if(tpro->GetBinSumw2()->fN) tpro->GetBinSumw2()->fArray[bin] += sums[2];
+    tpro->GetSumw2()->fArray[bin] += sums[3];
+    sums[0]=sums[1]=sums[2]=sums[3]=0;
+  };
+  fBufferedBins.clear();
+};
+Int_t AliGFWFlowContainer::Write(const char *name, Int_t option, Int_t bufsize) {
+  FlushBuffer();
+  return TNamed::Write(name,option,bufsize);
+};
+Int_t AliGFWFlowContainer::Write(const char *name, Int_t option, Int_t bufsize) const {
+  const_cast<AliGFWFlowContainer*>(this)->FlushBuffer();
+  return TNamed::Write(name,option,bufsize);
+};
 void AliGFWFlowContainer::OverrideProfileErrors(TProfile2D *inpf) {
+  FlushBuffer();
   Int_t nBinsX = fProf->GetNbinsX();
   Int_t nBinsY = fProf->GetNbinsY();
   if((inpf->GetNbinsX()!= nBinsX) || (inpf->GetNbinsY() != nBinsY)) {
@@ -166,6 +271,7 @@ Long64_t AliGFWFlowContainer::Merge(TCollection *collist) {
   Long64_t nmerged=0;
   AliGFWFlowContainer *l_FC = 0;
   TIter all_FC(collist);
+  FlushBuffer();
   //TProfile2D *spro = lfc->GetProfile();
   while (l_FC = ((AliGFWFlowContainer*) all_FC())) {
     TProfile2D *tpro = GetProfile();
@@ -217,6 +323,7 @@ void AliGFWFlowContainer::ReadAndMerge(const char *filelist) {
   };
 };
 void AliGFWFlowContainer::PickAndMerge(TFile *tfi) {
+  FlushBuffer();
   AliGFWFlowContainer *lfc = (AliGFWFlowContainer*)tfi->Get(this->GetName());
   if(!lfc) {
     printf("Could not pick up the %s from %s\n",this->GetName(),tfi->GetName());
@@ -250,6 +357,7 @@ void AliGFWFlowContainer::PickAndMerge(TFile *tfi) {
   //printf("After merge: %i in target, %i in source\n",fProfRand->GetEntries(),tarr->GetEntries());
 };
 Bool_t AliGFWFlowContainer::OverrideBinsWithZero(Int_t xb1, Int_t yb1, Int_t xb2, Int_t yb2) {
+  FlushBuffer();
   AliProfileSubset *t_apf = new AliProfileSubset(*fProf);
   if(!t_apf->OverrideBinsWithZero(xb1,yb1,xb2,yb2)) {
     delete t_apf;
@@ -260,6 +368,7 @@ Bool_t AliGFWFlowContainer::OverrideBinsWithZero(Int_t xb1, Int_t yb1, Int_t xb2
   return kTRUE;
 }
 Bool_t AliGFWFlowContainer::OverrideMainWithSub(Int_t ind, Bool_t ExcludeChosen) {
+  FlushBuffer();
   if(!fProfRand) {
     printf("Cannot override main profile with a randomized one. Random profile array does not exist.\n");
     return kFALSE;
@@ -290,6 +399,7 @@ Bool_t AliGFWFlowContainer::OverrideMainWithSub(Int_t ind, Bool_t ExcludeChosen)
   };
 };
 Bool_t AliGFWFlowContainer::RandomizeProfile(Int_t nSubsets) {
+  FlushBuffer();
   if(!fProfRand) {
     printf("Cannot randomize profile, random array does not exist.\n");
     return kFALSE;
@@ -328,6 +438,7 @@ void AliGFWFlowContainer::SetIDName(TString newname) {
   fIDName = newname;
 };
 TProfile *AliGFWFlowContainer::GetCorrXXVsMulti(const char *order, Int_t l_pti) {
+  FlushBuffer();
   TProfile *retSubset=0;
   TString l_name("");
   Ssiz_t l_pos=0;
@@ -349,6 +460,7 @@ TProfile *AliGFWFlowContainer::GetCorrXXVsMulti(const char *order, Int_t l_pti)
   return retSubset;
 };
 TProfile *AliGFWFlowContainer::GetCorrXXVsPt(const char *order, Double_t lminmulti, Double_t lmaxmulti) {
+  FlushBuffer();
   Int_t minm = 1;
   Int_t maxm = fProf->GetXaxis()->GetNbins();
   if(!fbinsPt) SetXAxis();
@@ -811,6 +923,7 @@ TH1D *AliGFWFlowContainer::GetVNN(Int_t n, Int_t c, Bool_t onPt, Double_t arg1,
   return GetVN2VsX(n,onPt,arg1,arg2);
 };
 TProfile *AliGFWFlowContainer::GetRefFlowProfile(const char *order, Double_t m1, Double_t m2) {
+  FlushBuffer();
   Int_t nStartBin = fProf->GetXaxis()->FindBin(m1+0.001);
   Int_t nStopBin = fProf->GetXaxis()->FindBin(m2-0.001);
   if(nStartBin==0) nStartBin=1;
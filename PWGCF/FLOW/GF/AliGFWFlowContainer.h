@@ -19,6 +19,7 @@ Extention of Generic Flow (https://arxiv.org/abs/1312.3572)
 #include "TString.h"
 #include "TCollection.h"
 #include "TAxis.h"
+#include <vector>
 
 class AliGFWFlowContainer:public TNamed {
  public:
@@ -31,11 +32,20 @@ class AliGFWFlowContainer:public TNamed {
   Bool_t CreateBinsFromAxis(TAxis *inax);
   void SetXAxis(TAxis *inax);
   void SetXAxis();
-  void RebinMulti(Int_t rN) { if(fProf) fProf->RebinX(rN); };
+  void RebinMulti(Int_t rN) { FlushBuffer(); if(fProf) fProf->RebinX(rN); };
   Int_t GetNMultiBins() { return fProf->GetNbinsX(); };
   Double_t GetMultiAtBin(Int_t bin) { return fProf->GetXaxis()->GetBinCenter(bin); };
   Int_t FillProfile(const char *hname, Double_t multi, Double_t y, Double_t w, Double_t rn);
-  TProfile2D *GetProfile() { return fProf; };
+  //Faster filling: correlator index (y-bin) is resolved once at setup
+  Int_t GetCorrelatorIndex(const char *hname);
+  Int_t FillProfile(Int_t corrIndex, Double_t multi, Double_t y, Double_t w, Double_t rn);
+  //Buffered fills: sums are kept in a flat array and only added to the profiles by FlushBuffer()
+  void SetBufferFills(Bool_t newval) { if(!newval) FlushBuffer(); fBufferFills = newval; };
+  Bool_t GetBufferFills() { return fBufferFills; };
+  void FlushBuffer();
+  virtual Int_t Write(const char *name=0, Int_t option=0, Int_t bufsize=0);
+  virtual Int_t Write(const char *name=0, Int_t option=0, Int_t bufsize=0) const;
+  TProfile2D *GetProfile() { FlushBuffer(); return fProf; };
   void OverrideProfileErrors(TProfile2D *inpf);
   void ReadAndMerge(const char *infile);
   void PickAndMerge(TFile *tfi);
@@ -43,7 +53,7 @@ class AliGFWFlowContainer:public TNamed {
   Bool_t OverrideMainWithSub(Int_t subind, Bool_t ExcludeChosen);
   Bool_t RandomizeProfile(Int_t nSubsets=0);
   Bool_t CreateStatisticsProfile(StatisticsType StatType, Int_t arg);
-  TObjArray *GetSubProfiles() { return fProfRand; };
+  TObjArray *GetSubProfiles() { FlushBuffer(); return fProfRand; };
   Long64_t Merge(TCollection *collist);
   void SetIDName(TString newname); //! do not store
   void SetPtRebin(Int_t newval) { fPtRebin=newval; };
@@ -145,7 +155,12 @@ class AliGFWFlowContainer:public TNamed {
   Double_t *fbinsPt; //! Do not store; stored in fXAxis
   Bool_t fPropagateErrors; //! do not store
   TProfile *GetRefFlowProfile(const char *order, Double_t m1=-1, Double_t m2=-1);
-  ClassDef(AliGFWFlowContainer, 2);
+  Bool_t fBufferFills; //! do not store
+  std::vector<Double_t> fFillBuffer; //! sum(w*y), sum(w), sum(w^2), sum(w*y^2) per (sample, profile bin); sample 0 is fProf, i+1 is fProfRand->At(i)
+  std::vector<Double_t> fBufferStats; //! per sample: TProfile2D statistics (9 values) and number of entries
+  std::vector<Int_t> fBufferedBins; //! (sample, profile bin) cells with buffered fills
+  Int_t fBufferNCells; //! number of bins of fProf, including under/overflows
+  ClassDef(AliGFWFlowContainer, 3);
 };
 
 
@@ -47,7 +47,9 @@ AliMixingHandler::AliMixingHandler(Int_t mixingSetup /* = kMixResonanceLegs*/) :
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fUseFlatPools(kFALSE),
+  fFlatPools()
 {
   // 
   // default constructor
@@ -87,7 +89,9 @@ AliMixingHandler::AliMixingHandler(const Char_t* name, const Char_t* title, Int_
   fHistos(0x0),
   fCrossPairsCuts(),
   fLikePairsLeg1Cuts(),
-  fLikePairsLeg2Cuts()
+  fLikePairsLeg2Cuts(),
+  fUseFlatPools(kFALSE),
+  fFlatPools()
 {
   //
   // Named constructor
@@ -113,6 +117,7 @@ AliMixingHandler::~AliMixingHandler() {
    fCrossPairsCuts.Clear("C");
    fLikePairsLeg1Cuts.Clear("C");
    fLikePairsLeg2Cuts.Clear("C");
+   ClearFlatPools();
 }
 
 
@@ -185,6 +190,15 @@ void AliMixingHandler::Init() {
   fPoolSize.Set(fNParallelCuts*size);
   for(Int_t i=0;i<fNParallelCuts*size;++i) fPoolSize[i] = 0;
   
+  ClearFlatPools();
+  fFlatPools.resize(size);
+  if(fUseFlatPools) {
+    for(Int_t i=0;i<size;++i) {
+      fFlatPools[i].fLeg1Offsets.reserve(fPoolDepth+1);
+      fFlatPools[i].fLeg2Offsets.reserve(fPoolDepth+1);
+    }
+  }
+  
   fIsInitialized = kTRUE;
 }
 
@@ -221,6 +235,17 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   Int_t category = FindEventCategory(values);
   if(category<0) return;   // event characteristics outside the defined ranges
   
+  // flat pools: add the legs, increment the pool sizes and mix the full pools
+  if(fUseFlatPools) {
+    AddToFlatPool(leg1List, leg2List, values, category);
+    ULong_t mixingMask = IncrementPoolSizes(leg1List,leg2List,category);
+    if(mixingMask) {
+      RunFlatEventMixing(category,mixingMask,type,values);
+      ResetPoolSizes(mixingMask,category);
+    }
+    return;
+  }
+  
   TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(category));
   if(!leg1PoolP) leg1PoolP = new(fPoolsLeg1[category]) TClonesArray("TList",1);
   leg1PoolP->SetOwner(kTRUE);
@@ -234,38 +259,11 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
   TList *list1 = new(leg1Pool[leg1Pool.GetEntries()]) TList();
   TList *list2 = new(leg2Pool[leg2Pool.GetEntries()]) TList();
   list1->SetOwner(kTRUE); list2->SetOwner(kTRUE);
-  AliReducedTrackInfo* track = 0x0;
   if (leg1List) {
-    for(Int_t it=0; it<entries1; ++it) {
-      // HACK: to transmit the VZERO and TPC event plane Q vector to event mixing
-      if(fMixingSetup==kMixResonanceLegs && leg1List->At(it)->IsA()==AliReducedTrackInfo::Class()) {  
-         track = (AliReducedTrackInfo*)leg1List->At(it)->Clone();  
-         track->SetCovMatrix(0, values[AliReducedVarManager::kVZEROQvecX+0*6+1]);
-         track->SetCovMatrix(1, values[AliReducedVarManager::kVZEROQvecY+0*6+1]);
-         track->SetCovMatrix(2, values[AliReducedVarManager::kVZEROQvecX+1*6+1]);
-         track->SetCovMatrix(3, values[AliReducedVarManager::kVZEROQvecY+1*6+1]);
-         track->SetCovMatrix(4, values[AliReducedVarManager::kTPCQvecXtree+1]);
-         track->SetCovMatrix(5, values[AliReducedVarManager::kTPCQvecYtree+1]);
-         list1->Add(track);
-      }
-      else list1->Add(leg1List->At(it)->Clone());
-    }
+    for(Int_t it=0; it<entries1; ++it) list1->Add(CloneLeg(leg1List->At(it), values));
   }
   if (leg2List) {
-    for(Int_t it=0; it<entries2; ++it) {
-      // HACK: to transmit the VZERO and TPC event plane Q vector to event mixing
-      if(fMixingSetup==kMixResonanceLegs && leg2List->At(it)->IsA()==AliReducedTrackInfo::Class()) {  
-        track = (AliReducedTrackInfo*)leg2List->At(it)->Clone();  
-        track->SetCovMatrix(0, values[AliReducedVarManager::kVZEROQvecX+0*6+1]);
-        track->SetCovMatrix(1, values[AliReducedVarManager::kVZEROQvecY+0*6+1]);
-        track->SetCovMatrix(2, values[AliReducedVarManager::kVZEROQvecX+1*6+1]);
-        track->SetCovMatrix(3, values[AliReducedVarManager::kVZEROQvecY+1*6+1]);
-        track->SetCovMatrix(4, values[AliReducedVarManager::kTPCQvecXtree+1]);
-        track->SetCovMatrix(5, values[AliReducedVarManager::kTPCQvecYtree+1]);
-        list2->Add(track);  
-      }
-      else list2->Add(leg2List->At(it)->Clone());
-    }
+    for(Int_t it=0; it<entries2; ++it) list2->Add(CloneLeg(leg2List->At(it), values));
   }
     
   // increment the size of the pools in this category
@@ -279,6 +277,66 @@ void AliMixingHandler::FillEvent(TList* leg1List, TList* leg2List, Float_t* valu
 }
 
 
+//_________________________________________________________________________
+AliReducedBaseTrack* AliMixingHandler::CloneLeg(TObject* leg, Float_t* values) const {
+  //
+  // Clone a leg for storage in the mixing pools
+  //
+  // HACK: to transmit the VZERO and TPC event plane Q vector to event mixing
+  if(fMixingSetup==kMixResonanceLegs && leg->IsA()==AliReducedTrackInfo::Class()) {
+    AliReducedTrackInfo* track = (AliReducedTrackInfo*)leg->Clone();
+    track->SetCovMatrix(0, values[AliReducedVarManager::kVZEROQvecX+0*6+1]);
+    track->SetCovMatrix(1, values[AliReducedVarManager::kVZEROQvecY+0*6+1]);
+    track->SetCovMatrix(2, values[AliReducedVarManager::kVZEROQvecX+1*6+1]);
+    track->SetCovMatrix(3, values[AliReducedVarManager::kVZEROQvecY+1*6+1]);
+    track->SetCovMatrix(4, values[AliReducedVarManager::kTPCQvecXtree+1]);
+    track->SetCovMatrix(5, values[AliReducedVarManager::kTPCQvecYtree+1]);
+    return track;
+  }
+  return (AliReducedBaseTrack*)leg->Clone();
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::AddToFlatPool(TList* leg1List, TList* leg2List, Float_t* values, Int_t category) {
+  //
+  // Append the legs of this event to the flat pool of the given category
+  //
+  FlatPool& pool = fFlatPools[category];
+  AliReducedBaseTrack* track = 0x0;
+  if (leg1List) {
+    for(Int_t it=0; it<leg1List->GetEntries(); ++it) {
+      track = CloneLeg(leg1List->At(it), values);
+      pool.fLeg1Tracks.push_back(track);
+      pool.fLeg1Flags.push_back(track->GetFlags());
+    }
+  }
+  if (leg2List) {
+    for(Int_t it=0; it<leg2List->GetEntries(); ++it) {
+      track = CloneLeg(leg2List->At(it), values);
+      pool.fLeg2Tracks.push_back(track);
+      pool.fLeg2Flags.push_back(track->GetFlags());
+    }
+  }
+  pool.fLeg1Offsets.push_back(Int_t(pool.fLeg1Tracks.size()));
+  pool.fLeg2Offsets.push_back(Int_t(pool.fLeg2Tracks.size()));
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::ClearFlatPools() {
+  //
+  // Delete the tracks held in the flat pools and empty the pools
+  //
+  for(UInt_t icateg=0; icateg<fFlatPools.size(); ++icateg) {
+    FlatPool& pool = fFlatPools[icateg];
+    for(UInt_t i=0; i<pool.fLeg1Tracks.size(); ++i) delete pool.fLeg1Tracks[i];
+    for(UInt_t i=0; i<pool.fLeg2Tracks.size(); ++i) delete pool.fLeg2Tracks[i];
+    pool = FlatPool();
+  }
+}
+
+
 //_________________________________________________________________________
 Int_t AliMixingHandler::FindEventCategory(Float_t* values) {
    //
@@ -425,6 +483,19 @@ void AliMixingHandler::RunLeftoverMixing(Int_t type) {
   for(Int_t i=0; i<fNParallelCuts; ++i) mixingMask |= (ULong_t(1)<<i);
   Float_t values[AliReducedVarManager::kNVars];
   
+  if(fUseFlatPools) {
+    for(Int_t icateg=0; icateg<Int_t(fFlatPools.size()); ++icateg) {
+      if(!fFlatPools[icateg].GetNEvents()) continue;
+      for(Int_t iVar=0; iVar<fNMixingVariables; ++iVar) {
+        Int_t bin = GetBinFromCategory(iVar, icateg);
+        values[fVariables[iVar]] = 0.5*(fVariableLimits[iVar][bin] + fVariableLimits[iVar][bin+1]);
+      }
+      RunFlatEventMixing(icateg,mixingMask,type,values);
+      ResetPoolSizes(mixingMask,icateg);
+    }
+    return;
+  }
+  
   for(Int_t icateg=0; icateg<fPoolsLeg1.GetEntries(); ++icateg) {
     TClonesArray *leg1Pool = static_cast<TClonesArray*>(fPoolsLeg1.At(icateg));
     TClonesArray *leg2Pool = static_cast<TClonesArray*>(fPoolsLeg2.At(icateg));
@@ -659,6 +730,147 @@ void AliMixingHandler::RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2
 }
 
 
+//_________________________________________________________________________
+void AliMixingHandler::RunFlatEventMixing(Int_t category, ULong_t mixingMask, Int_t type, Float_t* values) {
+  //
+  // Run event mixing on the flat pool of the given category
+  // NOTE: Same pairs and histogram fills as RunEventMixing(). The cut masks are tested on the flat arrays,
+  //       the track objects are used only for the pairs which have common bits with the mixing mask
+  //
+  FlatPool& pool = fFlatPools[category];
+  Int_t nEvents = pool.GetNEvents();
+  if(nEvents<2) return;
+  
+  TObjArray* histClassArr = fHistClassNames.Tokenize(";");
+  
+  const Int_t* offsets1 = pool.fLeg1Offsets.data();
+  const Int_t* offsets2 = pool.fLeg2Offsets.data();
+  ULong_t* flags1 = pool.fLeg1Flags.data();
+  ULong_t* flags2 = pool.fLeg2Flags.data();
+  AliReducedBaseTrack** tracks1 = pool.fLeg1Tracks.data();
+  AliReducedBaseTrack** tracks2 = pool.fLeg2Tracks.data();
+  ULong_t testFlags1 = 0;
+  ULong_t testFlags2 = 0;
+  for(Int_t iev1=0; iev1<nEvents; ++iev1) {                            // first event loop
+    for(Int_t iev2=0; iev2<nEvents; ++iev2) {                          // second event loop
+      if(iev1==iev2) continue;
+      
+      // loop over the ev1-leg1 tracks
+      for(Int_t i1=offsets1[iev1]; i1<offsets1[iev1+1]; ++i1) {
+        testFlags1 = mixingMask & flags1[i1];
+        if(!testFlags1) continue;
+        
+        // cross-pairs with the ev2-leg2 tracks
+        for(Int_t i2=offsets2[iev2]; i2<offsets2[iev2+1]; ++i2) {
+          testFlags2 = testFlags1 & flags2[i2];
+          if(!testFlags2) continue;
+          if(fMixingSetup==kMixResonanceLegs) AliReducedVarManager::FillPairInfoME(tracks1[i1], tracks2[i2], type, values);
+          if(fMixingSetup==kMixCorrelation)   AliReducedVarManager::FillCorrelationInfo(tracks1[i1], tracks2[i2], values);
+          ULong_t pairCutMask = IsPairSelected(values, 1);
+          if(!pairCutMask) continue;
+          FillMixedPairHistograms(testFlags2, pairCutMask, 1, tracks1[i1], histClassArr, values);
+        }
+        
+        if(fMixingSetup==kMixCorrelation) continue;
+        if(!fMixLikeSign) continue;
+        // like-pairs with the ev2-leg1 tracks
+        for(Int_t i2=offsets1[iev2]; i2<offsets1[iev2+1]; ++i2) {
+          testFlags2 = testFlags1 & flags1[i2];
+          if(!testFlags2) continue;
+          AliReducedVarManager::FillPairInfoME(tracks1[i1], tracks1[i2], type, values);
+          ULong_t pairCutMask = IsPairSelected(values, 0);
+          if(!pairCutMask) continue;
+          FillMixedPairHistograms(testFlags2, pairCutMask, 0, tracks1[i1], histClassArr, values);
+        }
+      }  // end loop over the ev1-leg1 tracks
+      
+      if(fMixingSetup==kMixCorrelation) continue;
+      if(!fMixLikeSign) continue;
+      // like-pairs of the ev1-leg2 tracks with the ev2-leg2 tracks
+      for(Int_t i1=offsets2[iev1]; i1<offsets2[iev1+1]; ++i1) {
+        testFlags1 = mixingMask & flags2[i1];
+        if(!testFlags1) continue;
+        for(Int_t i2=offsets2[iev2]; i2<offsets2[iev2+1]; ++i2) {
+          testFlags2 = testFlags1 & flags2[i2];
+          if(!testFlags2) continue;
+          AliReducedVarManager::FillPairInfoME(tracks2[i1], tracks2[i2], type, values);
+          ULong_t pairCutMask = IsPairSelected(values, 2);
+          if(!pairCutMask) continue;
+          FillMixedPairHistograms(testFlags2, pairCutMask, 2, tracks2[i1], histClassArr, values);
+        }
+      }  // end loop over the ev1-leg2 tracks
+    }  // end second event loop
+  }  // end first event loop
+  delete histClassArr;
+  
+  // unset the mixing flags and remove the tracks without enabled mixing flags
+  // the events are kept in the same order, the events without any tracks left are removed
+  Int_t nTracks1 = 0, nTracks2 = 0, nEventsLeft = 0;
+  Int_t begin1 = 0, begin2 = 0;
+  for(Int_t iev=0; iev<nEvents; ++iev) {
+    Int_t end1 = offsets1[iev+1];
+    Int_t end2 = offsets2[iev+1];
+    Int_t first1 = nTracks1, first2 = nTracks2;
+    for(Int_t i=begin1; i<end1; ++i) {
+      flags1[i] &= ~mixingMask;
+      if(!flags1[i]) {delete tracks1[i]; continue;}
+      flags1[nTracks1] = flags1[i]; tracks1[nTracks1] = tracks1[i]; ++nTracks1;
+    }
+    for(Int_t i=begin2; i<end2; ++i) {
+      flags2[i] &= ~mixingMask;
+      if(!flags2[i]) {delete tracks2[i]; continue;}
+      flags2[nTracks2] = flags2[i]; tracks2[nTracks2] = tracks2[i]; ++nTracks2;
+    }
+    begin1 = end1; begin2 = end2;
+    if(nTracks1==first1 && nTracks2==first2) continue;
+    ++nEventsLeft;
+    pool.fLeg1Offsets[nEventsLeft] = nTracks1;
+    pool.fLeg2Offsets[nEventsLeft] = nTracks2;
+  }
+  pool.fLeg1Offsets.resize(nEventsLeft+1);
+  pool.fLeg2Offsets.resize(nEventsLeft+1);
+  pool.fLeg1Flags.resize(nTracks1); pool.fLeg1Tracks.resize(nTracks1);
+  pool.fLeg2Flags.resize(nTracks2); pool.fLeg2Tracks.resize(nTracks2);
+}
+
+
+//_________________________________________________________________________
+void AliMixingHandler::FillMixedPairHistograms(ULong_t testFlags, ULong_t pairCutMask, Int_t pairType, 
+                                               AliReducedBaseTrack* leg1, TObjArray* histClassArr, Float_t* values) {
+  //
+  // Fill the histograms of a mixed pair for the enabled cut bits
+  // pairType: 0 - leg1-leg1, 1 - leg1-leg2, 2 - leg2-leg2 pairs (as in IsPairSelected())
+  //
+  for(Int_t ibit=0; ibit<fNParallelCuts; ++ibit) {
+    if(!(testFlags&(ULong_t(1)<<ibit))) continue;
+    if(fMixingSetup==kMixResonanceLegs) {
+      if (fNParallelPairCuts>1) {
+        for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
+          if (!((pairCutMask)&(ULong_t(1)<<jbit))) continue;
+          fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*3*fNParallelCuts+pairType)->GetName(), values);
+        }
+      } else {
+        fHistos->FillHistClass(histClassArr->At(ibit*3+pairType)->GetName(), values);
+      }
+    }
+    if(fMixingSetup==kMixCorrelation) {
+      Int_t corrPairType = (reinterpret_cast<AliReducedPairInfo*>(leg1))->PairType();
+      if (fNParallelPairCuts>1) {
+        ULong_t pairCutMaskCorr = (reinterpret_cast<AliReducedPairInfo*>(leg1))->GetQualityFlags();
+        for (Int_t jbit=0; jbit<fNParallelPairCuts; jbit++) {
+          if (!((pairCutMaskCorr)&(ULong_t(1)<<jbit))) continue;
+          if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+jbit*fNParallelCuts+corrPairType)->GetName(), values);
+          else              fHistos->FillHistClass(histClassArr->At(ibit+jbit*fNParallelCuts)->GetName(), values);
+        }
+      } else {
+        if (fMixLikeSign) fHistos->FillHistClass(histClassArr->At(ibit*3+corrPairType)->GetName(), values);
+        else              fHistos->FillHistClass(histClassArr->At(ibit)->GetName(), values);
+      }
+    }
+  }
+}
+
+
 //_________________________________________________________________________
 ULong_t AliMixingHandler::IsPairSelected(Float_t* values, Int_t pairType) {
    //
@@ -713,6 +925,7 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
    cout << "Track downscale :: " << fDownscaleTracks << endl;
    cout << "No. parallel cuts :: " << fNParallelCuts << endl;
    cout << "Histogram class names :: " << fHistClassNames.Data() << endl;
+   cout << "Use flat pools :: " << fUseFlatPools << endl;
   
    if(debugLevel<1) return;
   
@@ -736,6 +949,37 @@ void AliMixingHandler::PrintMixingLists(Int_t debugLevel) {
       cout << endl;
       if(debugLevel<2) continue;
       
+      if(fUseFlatPools) {
+         if(iCateg>=Int_t(fFlatPools.size())) continue;
+         const FlatPool& pool = fFlatPools[iCateg];
+         for(Int_t iev=0; iev<pool.GetNEvents(); ++iev) {
+            cout << "	Event #" << iev << ";  No. of tracks (leg1/leg2) :: " 
+            << pool.fLeg1Offsets[iev+1]-pool.fLeg1Offsets[iev] << " / " << pool.fLeg2Offsets[iev+1]-pool.fLeg2Offsets[iev] << endl;
+            if(debugLevel<3) continue;
+            
+            cout << "		Leg1 list" << endl;
+            for(Int_t itrack=pool.fLeg1Offsets[iev]; itrack<pool.fLeg1Offsets[iev+1]; ++itrack) {
+               track = pool.fLeg1Tracks[itrack];
+               cout << "		track #" << itrack-pool.fLeg1Offsets[iev] << " (p/px/py/pz/charge/flags) :: "
+               << track->P() << " / " << track->Px() << " / " 
+               << track->Py() << " / " << track->Pz() << "/" << track->Charge() << " / " << flush;
+               AliReducedVarManager::PrintBits(pool.fLeg1Flags[itrack], fNParallelCuts);
+               cout << endl;
+            }  // end loop over tracks
+            
+            cout << "		Leg2 list" << endl;
+            for(Int_t itrack=pool.fLeg2Offsets[iev]; itrack<pool.fLeg2Offsets[iev+1]; ++itrack) {
+               track = pool.fLeg2Tracks[itrack];
+               cout << "		track #" << itrack-pool.fLeg2Offsets[iev] << " (p/px/py/pz/charge/flags) :: "
+               << track->P() << " / " << track->Px() << " / " 
+               << track->Py() << " / " << track->Pz() << "/" << track->Charge() << " / " << flush;
+               AliReducedVarManager::PrintBits(pool.fLeg2Flags[itrack], fNParallelCuts);
+               cout << endl;
+            }  // end loop over tracks
+         }  // end loop over events
+         continue;
+      }
+      
       TClonesArray *leg1PoolP = static_cast<TClonesArray*>(fPoolsLeg1.At(iCateg));
       if(!leg1PoolP) continue;
       TClonesArray &leg1Pool=*leg1PoolP;
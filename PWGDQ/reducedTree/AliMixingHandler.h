@@ -14,10 +14,14 @@
 #include <TList.h>
 #include <TString.h>
 
+#include <vector>
+
 #include "AliHistogramManager.h"
 #include "AliReducedVarManager.h"
 #include "AliReducedInfoCut.h"
 
+class AliReducedBaseTrack;
+
 class AliMixingHandler : public TNamed {
    
 public:
@@ -45,6 +49,7 @@ public:
   void SetNParallelPairCuts(Int_t n) {fNParallelPairCuts = n;}
   void SetHistogramManager(AliHistogramManager* histos) {fHistos = histos;}
   void SetHistClassNames(const Char_t* names) {fHistClassNames = names;}
+  void SetUseFlatPools(Bool_t flag) {fUseFlatPools = flag;}
   void AddCrossPairsCut(AliReducedInfoCut* cut) {fCrossPairsCuts.Add(cut);}
   void AddOppositeSignPairsCut(AliReducedInfoCut* cut) {fCrossPairsCuts.Add(cut);}    // synonim function to AddCrossPairsCut() used for charged legs
   void AddLikePairsLeg1Cut(AliReducedInfoCut* cut) {fLikePairsLeg1Cuts.Add(cut);}
@@ -69,6 +74,7 @@ public:
   TString GetHistClassNames() const {return fHistClassNames;};
   Int_t GetNMixingVariables() const {return fNMixingVariables;}
   Int_t GetMixingSetup() const {return fMixingSetup;}
+  Bool_t GetUseFlatPools() const {return fUseFlatPools;}
   
   void Init();
   Int_t FindEventCategory(Float_t* values);
@@ -80,6 +86,22 @@ public:
   ULong_t IsPairSelected(Float_t* values, Int_t pairType);
   
 private:
+   // Event pool of one event category, used if fUseFlatPools is set.
+   // The cut masks of the legs are kept in contiguous arrays which are scanned by the mixing loops;
+   // the track clones (owned by the pool) are dereferenced only for pairs with common cut bits.
+   // Tracks of event i are in the range [fLegXOffsets[i], fLegXOffsets[i+1]) of the leg arrays.
+   struct FlatPool {
+      std::vector<Int_t>                fLeg1Offsets;    // event offsets in the leg1 arrays (nEvents+1 entries)
+      std::vector<Int_t>                fLeg2Offsets;    // event offsets in the leg2 arrays (nEvents+1 entries)
+      std::vector<ULong_t>              fLeg1Flags;      // cut masks of the leg1 tracks
+      std::vector<ULong_t>              fLeg2Flags;      // cut masks of the leg2 tracks
+      std::vector<AliReducedBaseTrack*> fLeg1Tracks;     // leg1 track clones
+      std::vector<AliReducedBaseTrack*> fLeg2Tracks;     // leg2 track clones
+      
+      FlatPool() : fLeg1Offsets(1,0), fLeg2Offsets(1,0), fLeg1Flags(), fLeg2Flags(), fLeg1Tracks(), fLeg2Tracks() {}
+      Int_t GetNEvents() const {return Int_t(fLeg1Offsets.size())-1;}
+   };
+   
    AliMixingHandler(const AliMixingHandler& handler);             
    AliMixingHandler& operator=(const AliMixingHandler& handler);      
    
@@ -111,11 +133,19 @@ private:
   TList fLikePairsLeg1Cuts;    // cut object for LEG1 like pairs
   TList fLikePairsLeg2Cuts;    // cut object for LEG2 like pairs
   
+  Bool_t fUseFlatPools;              // keep the pools in flat arrays (FlatPool) instead of TClonesArray's of TList's
+  std::vector<FlatPool> fFlatPools;  //! flat pools, one per event category
+  
+  AliReducedBaseTrack* CloneLeg(TObject* leg, Float_t* values) const;
+  void AddToFlatPool(TList* leg1List, TList* leg2List, Float_t* values, Int_t category);
+  void RunFlatEventMixing(Int_t category, ULong_t mixingMask, Int_t type, Float_t* values);
+  void FillMixedPairHistograms(ULong_t testFlags, ULong_t pairCutMask, Int_t pairType, AliReducedBaseTrack* leg1, TObjArray* histClassArr, Float_t* values);
+  void ClearFlatPools();
   void RunEventMixing(TClonesArray* leg1Pool, TClonesArray* leg2Pool, ULong_t mixingMask, Int_t type, Float_t* values);
   ULong_t IncrementPoolSizes(TList* list1, TList* list2, Int_t eventCategory);
   void ResetPoolSizes(ULong_t mixingMask, Int_t category);  
   
-  ClassDef(AliMixingHandler,4);
+  ClassDef(AliMixingHandler,5);
 };
 
 #endif
@@ -28,6 +28,7 @@ using std::ifstream;
 #include <TGraphErrors.h>
 #include <TFile.h>
 #include <THashList.h>
+#include <TCollection.h>
 
 #include "AliReducedBaseEvent.h"
 #include "AliReducedEventInfo.h"
@@ -145,6 +146,10 @@ TString                         AliReducedVarManager::fgVariableUnits[AliReduced
 AliReducedBaseEvent*            AliReducedVarManager::fgEvent = 0x0;
 AliReducedEventPlaneInfo*       AliReducedVarManager::fgEventPlane = 0x0;
 Bool_t                          AliReducedVarManager::fgUsedVars[AliReducedVarManager::kNVars] = {kFALSE};
+Bool_t                          AliReducedVarManager::fgUseEvaluationPlan = kFALSE;
+UInt_t                          AliReducedVarManager::fgTrackPlan = 0;
+Int_t                           AliReducedVarManager::fgNUsedTrackVars = 0;
+Int_t                           AliReducedVarManager::fgUsedTrackVarList[AliReducedVarManager::kNTrackVars-AliReducedVarManager::kNEventVars] = {0};
 TH2F*                           AliReducedVarManager::fgTPCelectronCentroidMap = 0x0;
 TH2F*                           AliReducedVarManager::fgTPCelectronWidthMap = 0x0;
 AliReducedVarManager::Variables AliReducedVarManager::fgVarDependencyX = kNothing;
@@ -386,6 +391,112 @@ void AliReducedVarManager::SetVariableDependencies() {
     fgUsedVars[kNTracksTPCoutBeforeClean] = kTRUE;
     fgUsedVars[kVZEROTotalMultFromChannels] = kTRUE;
   }
+  
+  BuildEvaluationPlan();
+}
+
+//__________________________________________________________________
+Bool_t AliReducedVarManager::IsAnyVarUsed(Int_t first, Int_t n) {
+  //
+  // check whether any of the variables in [first, first+n) is used
+  //
+  for(Int_t i=first; i<first+n; ++i) 
+    if(fgUsedVars[i]) return kTRUE;
+  return kFALSE;
+}
+
+//__________________________________________________________________
+void AliReducedVarManager::BuildEvaluationPlan() {
+  //
+  // Build the evaluation plan from the used variables:
+  //   - the list of used track variables (reset by ResetTrackValues() and exported by FillTrackColumns())
+  //   - the groups of track variables computed in FillTrackInfo()
+  // NOTE: called at the end of SetVariableDependencies(), so the plan follows any change of the used variables
+  //
+  fgNUsedTrackVars = 0;
+  for(Int_t i=kNEventVars; i<kNTrackVars; ++i)
+    if(fgUsedVars[i]) fgUsedTrackVarList[fgNUsedTrackVars++] = i;
+  
+  fgTrackPlan = 0;
+  if(IsAnyVarUsed(kCosNPhi, 6) || IsAnyVarUsed(kSinNPhi, 6)) fgTrackPlan |= kPlanHarmonics;
+  if(fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq]) fgTrackPlan |= kPlanPairEff;
+  if(IsAnyVarUsed(kVZEROFlowVn, 18) || IsAnyVarUsed(kVZEROFlowSine, 18) || IsAnyVarUsed(kVZERODeltaPhiPsiN, 18) ||
+     IsAnyVarUsed(kVZEROuQ, 12) || IsAnyVarUsed(kVZEROuQsine, 12)) fgTrackPlan |= kPlanVZEROFlow;
+  if(IsAnyVarUsed(kTPCFlowVn, 6) || IsAnyVarUsed(kTPCFlowSine, 6) || IsAnyVarUsed(kTPCuQ, 6) ||
+     IsAnyVarUsed(kTPCuQsine, 6) || IsAnyVarUsed(kTPCDeltaPhiPsiN, 6)) fgTrackPlan |= kPlanTPCFlow;
+  if(IsAnyVarUsed(kTPCdEdxQmax, 12)) fgTrackPlan |= kPlanTPCdEdxInfo;
+  if(IsAnyVarUsed(kTOFbeta, kTOFdeltaBC-kTOFbeta+1)) fgTrackPlan |= kPlanTOF;
+  if(IsAnyVarUsed(kITSnSig, 4) || IsAnyVarUsed(kTPCnSig, 8) || IsAnyVarUsed(kTOFnSig, 4) || IsAnyVarUsed(kBayes, 4)) 
+    fgTrackPlan |= kPlanPID;
+  if(IsAnyVarUsed(kTRDntracklets, kTRDpidProbabilitiesLQ2D+2-kTRDntracklets) || IsAnyVarUsed(kTRDGTUtracklets, kTRDGTUPID-kTRDGTUtracklets+1)) 
+    fgTrackPlan |= kPlanTRD;
+  if(fgUsedVars[kPxMC] || fgUsedVars[kPyMC] || fgUsedVars[kPzMC] || IsAnyVarUsed(kPdgMC, 4)) fgTrackPlan |= kPlanMC;
+}
+
+//__________________________________________________________________
+void AliReducedVarManager::ResetTrackValues(Float_t* values) {
+  //
+  // reset the track variables to -9999.
+  // with the evaluation plan, only the used track variables are reset
+  //
+  if(!fgUseEvaluationPlan) {
+    for(Int_t i=kNEventVars; i<kNTrackVars; ++i) values[i] = -9999.;
+    return;
+  }
+  for(Int_t i=0; i<fgNUsedTrackVars; ++i) values[fgUsedTrackVarList[i]] = -9999.;
+}
+
+//__________________________________________________________________
+Int_t AliReducedVarManager::FillTrackColumns(TCollection* tracks, Float_t* values, Float_t* columns, Int_t maxTracks) {
+  //
+  // Batched filling: fill the track information for all the tracks in the collection (at most maxTracks)
+  //   and copy the used track variables into column arrays:
+  //   columns[i*maxTracks + it] = value of the variable GetUsedTrackVar(i) for track #it
+  // The columns array must hold at least GetNUsedTrackVars()*maxTracks elements.
+  // Returns the number of tracks filled.
+  //
+  if(!tracks) return 0;
+  TIter nextTrack(tracks);
+  BASETRACK* track = 0x0;
+  Int_t nTracks = 0;
+  while((track=(BASETRACK*)nextTrack()) && nTracks<maxTracks) {
+    ResetTrackValues(values);
+    FillTrackInfo(track, values);
+    for(Int_t i=0; i<fgNUsedTrackVars; ++i) columns[i*maxTracks+nTracks] = values[fgUsedTrackVarList[i]];
+    ++nTracks;
+  }
+  return nTracks;
+}
+
+//__________________________________________________________________
+Int_t AliReducedVarManager::FillPairColumns(TCollection* legs1, TCollection* legs2, Int_t type, Float_t* values, Float_t* columns, Int_t maxPairs) {
+  //
+  // Batched filling: fill the pair information for all the pairs of legs1 x legs2 (at most maxPairs)
+  //   and copy the used track variables into column arrays, as in FillTrackColumns().
+  //   If legs1 and legs2 are the same collection, every pair is filled only once.
+  // Returns the number of pairs filled.
+  //
+  if(!legs1 || !legs2) return 0;
+  Bool_t sameLegs = (legs1==legs2);
+  TIter nextLeg1(legs1);
+  BASETRACK* leg1 = 0x0;
+  BASETRACK* leg2 = 0x0;
+  Int_t nPairs = 0;
+  Int_t i1 = 0;
+  while((leg1=(BASETRACK*)nextLeg1())) {
+    TIter nextLeg2(legs2);
+    Int_t i2 = 0;
+    while((leg2=(BASETRACK*)nextLeg2())) {
+      if(sameLegs && i2++<=i1) continue;
+      if(nPairs>=maxPairs) return nPairs;
+      ResetTrackValues(values);
+      FillPairInfo(leg1, leg2, type, values);
+      for(Int_t i=0; i<fgNUsedTrackVars; ++i) columns[i*maxPairs+nPairs] = values[fgUsedTrackVarList[i]];
+      ++nPairs;
+    }
+    ++i1;
+  }
+  return nPairs;
 }
 
 //__________________________________________________________________
@@ -1572,14 +1683,16 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   if(fgUsedVars[kTheta])     values[kTheta]     = p->Theta();
   if(fgUsedVars[kPhi])       values[kPhi]       = p->Phi();
   if(fgUsedVars[kEta])       values[kEta]       = p->Eta();
-  for(Int_t ih=1; ih<=6; ++ih) {
-     if(fgUsedVars[kCosNPhi+ih-1]) values[kCosNPhi+ih-1] = TMath::Cos(p->Phi()*ih);
-     if(fgUsedVars[kSinNPhi+ih-1]) values[kSinNPhi+ih-1] = TMath::Sin(p->Phi()*ih);
+  if(IsPlanned(kPlanHarmonics)) {
+    for(Int_t ih=1; ih<=6; ++ih) {
+       if(fgUsedVars[kCosNPhi+ih-1]) values[kCosNPhi+ih-1] = TMath::Cos(p->Phi()*ih);
+       if(fgUsedVars[kSinNPhi+ih-1]) values[kSinNPhi+ih-1] = TMath::Sin(p->Phi()*ih);
+    }
   }
   values[kCharge] = p->Charge();
   
   //pair efficiency variables
-  if((fgUsedVars[kPairEff] || fgUsedVars[kOneOverPairEff] || fgUsedVars[kOneOverPairEffSq]) && fgPairEffMap) {
+  if(IsPlanned(kPlanPairEff) && fgPairEffMap) {
     Int_t binX = 0;
     if (fgEffMapVarDependencyX!=kNothing) {
       binX = fgPairEffMap->GetXaxis()->FindBin(values[fgEffMapVarDependencyX]);
@@ -1613,7 +1726,8 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   }
 
   // Fill VZERO flow variables
-  for(Int_t iVZEROside=0; iVZEROside<3; ++iVZEROside) {
+  Int_t nVZEROsides = (IsPlanned(kPlanVZEROFlow) ? 3 : 0);
+  for(Int_t iVZEROside=0; iVZEROside<nVZEROsides; ++iVZEROside) {
      for(Int_t ih=0; ih<6; ++ih) {
         if(fgUsedVars[kVZEROFlowVn+iVZEROside*6+ih])
            values[kVZEROFlowVn+iVZEROside*6+ih] = TMath::Cos((values[kPhi]-values[kVZERORP+iVZEROside*6+ih])*(ih+1));
@@ -1646,14 +1760,7 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   
   // Fill TPC flow variables
   // Subtract the q vector of the track or of the pair legs from the event q-vector 
-  Bool_t tpcEPUsed = kFALSE;
-  for(Int_t ih=0; ih<6; ++ih) {
-     if(fgUsedVars[kTPCFlowVn+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCFlowSine+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCuQ+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCuQsine+ih]) {tpcEPUsed = kTRUE; break;}
-     if(fgUsedVars[kTPCDeltaPhiPsiN+ih]) {tpcEPUsed = kTRUE; break;}
-  }
+  Bool_t tpcEPUsed = IsPlanned(kPlanTPCFlow);
 
   if(tpcEPUsed) {
 //      Float_t tpcEPsubtracted[6] = {0.0};
@@ -1775,10 +1882,12 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
   values[kTPCsignalN]     = pinfo->TPCsignalN();
   values[kTPCActiveLength] = pinfo->TPCActiveLength();
   values[kTPCGeomLength] = pinfo->TPCGeomLength();
-  for(Int_t i=0; i<4; ++i) {
-     values[kTPCdEdxQmax+i] = pinfo->TPCdEdxInfoQmax(i);
-     values[kTPCdEdxQtot+i] = pinfo->TPCdEdxInfoQtot(i);
-     values[kTPCdEdxQmaxOverQtot+i] = ( values[kTPCdEdxQtot+i]>1.0e-7 ? values[kTPCdEdxQmax+i] / values[kTPCdEdxQtot+i] : -999. );
+  if(IsPlanned(kPlanTPCdEdxInfo)) {
+    for(Int_t i=0; i<4; ++i) {
+       values[kTPCdEdxQmax+i] = pinfo->TPCdEdxInfoQmax(i);
+       values[kTPCdEdxQtot+i] = pinfo->TPCdEdxInfoQtot(i);
+       values[kTPCdEdxQmaxOverQtot+i] = ( values[kTPCdEdxQtot+i]>1.0e-7 ? values[kTPCdEdxQmax+i] / values[kTPCdEdxQtot+i] : -999. );
+    }
   }
   values[kTPCchi2] = pinfo->TPCchi2();
   if(fgUsedVars[kTPCNclusBitsFired]) values[kTPCNclusBitsFired] = pinfo->TPCClusterMapBitsFired();
@@ -1787,19 +1896,23 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
     values[kTPCclustersPerBit] = (nbits>0 ? values[kTPCncls]/Float_t(nbits) : 0.0);
   }
 
-  values[kTOFbeta] = pinfo->TOFbeta();
-  values[kTOFdeltaBC] = pinfo->TOFdeltaBC();
-  values[kTOFtime] = pinfo->TOFtime();
-  values[kTOFdx] = pinfo->TOFdx();
-  values[kTOFdz] = pinfo->TOFdz();
-  values[kTOFmismatchProbability] = pinfo->TOFmismatchProbab();
-  values[kTOFchi2] = pinfo->TOFchi2();
-
-  for(Int_t specie=kElectron; specie<=kProton; ++specie) {
-    values[kITSnSig+specie] = pinfo->ITSnSig(specie);
-    values[kTPCnSig+specie] = pinfo->TPCnSig(specie);
-    values[kTOFnSig+specie] = pinfo->TOFnSig(specie);
-    values[kBayes+specie]   = pinfo->GetBayesProb(specie);
+  if(IsPlanned(kPlanTOF)) {
+    values[kTOFbeta] = pinfo->TOFbeta();
+    values[kTOFdeltaBC] = pinfo->TOFdeltaBC();
+    values[kTOFtime] = pinfo->TOFtime();
+    values[kTOFdx] = pinfo->TOFdx();
+    values[kTOFdz] = pinfo->TOFdz();
+    values[kTOFmismatchProbability] = pinfo->TOFmismatchProbab();
+    values[kTOFchi2] = pinfo->TOFchi2();
+  }
+
+  if(IsPlanned(kPlanPID)) {
+    for(Int_t specie=kElectron; specie<=kProton; ++specie) {
+      values[kITSnSig+specie] = pinfo->ITSnSig(specie);
+      values[kTPCnSig+specie] = pinfo->TPCnSig(specie);
+      values[kTOFnSig+specie] = pinfo->TOFnSig(specie);
+      values[kBayes+specie]   = pinfo->GetBayesProb(specie);
+    }
   }
   if(fgUsedVars[kTPCnSigCorrected+kElectron] && fgTPCelectronCentroidMap && fgTPCelectronWidthMap) {
      Int_t binX = fgTPCelectronCentroidMap->GetXaxis()->FindBin(values[fgVarDependencyX]);
@@ -1867,36 +1980,42 @@ void AliReducedVarManager::FillTrackInfo(BASETRACK* p, Float_t* values) {
      }        
   }
 
-  values[kTRDpidProbabilitiesLQ1D]   = pinfo->TRDpidLQ1D(0);
-  values[kTRDpidProbabilitiesLQ1D+1] = pinfo->TRDpidLQ1D(1);
-  values[kTRDpidProbabilitiesLQ2D]   = pinfo->TRDpidLQ2D(0);
-  values[kTRDpidProbabilitiesLQ2D+1] = pinfo->TRDpidLQ2D(1);
-  values[kTRDntracklets]    = pinfo->TRDntracklets(0);
-  values[kTRDntrackletsPID] = pinfo->TRDntracklets(1);
-
-  // TRD GTU online tracks
-  values[kTRDGTUtracklets]   = pinfo->TRDGTUtracklets();
-  values[kTRDGTUlayermask]   = pinfo->TRDGTUlayermask();
-  values[kTRDGTUpt]          = pinfo->TRDGTUpt();
-  values[kTRDGTUsagitta]     = pinfo->TRDGTUsagitta();
-  values[kTRDGTUPID]         = pinfo->TRDGTUPID();
+  if(IsPlanned(kPlanTRD)) {
+    values[kTRDpidProbabilitiesLQ1D]   = pinfo->TRDpidLQ1D(0);
+    values[kTRDpidProbabilitiesLQ1D+1] = pinfo->TRDpidLQ1D(1);
+    values[kTRDpidProbabilitiesLQ2D]   = pinfo->TRDpidLQ2D(0);
+    values[kTRDpidProbabilitiesLQ2D+1] = pinfo->TRDpidLQ2D(1);
+    values[kTRDntracklets]    = pinfo->TRDntracklets(0);
+    values[kTRDntrackletsPID] = pinfo->TRDntracklets(1);
+
+    // TRD GTU online tracks
+    values[kTRDGTUtracklets]   = pinfo->TRDGTUtracklets();
+    values[kTRDGTUlayermask]   = pinfo->TRDGTUlayermask();
+    values[kTRDGTUpt]          = pinfo->TRDGTUpt();
+    values[kTRDGTUsagitta]     = pinfo->TRDGTUsagitta();
+    values[kTRDGTUPID]         = pinfo->TRDGTUPID();
+  }
 
   FillTrackingStatus(pinfo,values);
   //FillTrackingFlags(pinfo,values);
 
   if(fgUsedVars[kPtMC]) values[kPtMC] = pinfo->PtMC();
   if(fgUsedVars[kPMC]) values[kPMC] = pinfo->PMC();
-  values[kPxMC] = pinfo->MCmom(0);
-  values[kPyMC] = pinfo->MCmom(1);
-  values[kPzMC] = pinfo->MCmom(2);
+  if(IsPlanned(kPlanMC)) {
+    values[kPxMC] = pinfo->MCmom(0);
+    values[kPyMC] = pinfo->MCmom(1);
+    values[kPzMC] = pinfo->MCmom(2);
+  }
   if(fgUsedVars[kThetaMC]) values[kThetaMC] = pinfo->ThetaMC();
   if(fgUsedVars[kEtaMC]) values[kEtaMC] = pinfo->EtaMC();
   if(fgUsedVars[kPhiMC]) values[kPhiMC] = pinfo->PhiMC();
   //TODO: add also the massMC and RapMC   
-  values[kPdgMC] = pinfo->MCPdg(0);
-  values[kPdgMC+1] = pinfo->MCPdg(1);
-  values[kPdgMC+2] = pinfo->MCPdg(2);
-  values[kPdgMC+3] = pinfo->MCPdg(3);
+  if(IsPlanned(kPlanMC)) {
+    values[kPdgMC] = pinfo->MCPdg(0);
+    values[kPdgMC+1] = pinfo->MCPdg(1);
+    values[kPdgMC+2] = pinfo->MCPdg(2);
+    values[kPdgMC+3] = pinfo->MCPdg(3);
+  }
   
   if(fgUsedVars[kRap] && pinfo->IsMCKineParticle())  {
      if(pinfo->MCPdg(0)==443) values[kRap] = p->Rapidity(fgkPairMass[AliReducedPairInfo::kJpsiToEE]);
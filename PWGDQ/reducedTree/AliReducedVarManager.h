@@ -27,6 +27,7 @@ class AliReducedTrackInfo;
 class AliReducedCaloClusterInfo;
 class AliReducedCaloClusterTrackMatcher;
 class AliKFParticle;
+class TCollection;
 
 //_____________________________________________________________________
 class AliReducedVarManager : public TObject {
@@ -786,6 +787,18 @@ class AliReducedVarManager : public TObject {
   }
   static Bool_t GetUsedVar(Variables var) {return fgUsedVars[var];}
   
+  // Evaluation plan: built from the used variables each time they change (see BuildEvaluationPlan()).
+  // With SetUseEvaluationPlan(kTRUE) only the used track variables are reset by ResetTrackValues() and
+  //   the groups of track variables which are not used are not filled; variables not flagged as used
+  //   (via histograms, cuts, mixing, SetUseVariable) are then not guaranteed to be filled.
+  static void SetUseEvaluationPlan(Bool_t flag) {fgUseEvaluationPlan = flag;}
+  static Bool_t GetUseEvaluationPlan() {return fgUseEvaluationPlan;}
+  static Int_t GetNUsedTrackVars() {return fgNUsedTrackVars;}
+  static Int_t GetUsedTrackVar(Int_t i) {return fgUsedTrackVarList[i];}
+  static void ResetTrackValues(Float_t* values);
+  static Int_t FillTrackColumns(TCollection* tracks, Float_t* values, Float_t* columns, Int_t maxTracks);
+  static Int_t FillPairColumns(TCollection* legs1, TCollection* legs2, Int_t type, Float_t* values, Float_t* columns, Int_t maxPairs);
+  
   static void FillEventInfo(Float_t* values);
   static void FillEventInfo(AliReducedBaseEvent* event, Float_t* values, AliReducedEventPlaneInfo* eventPlane=0x0);
   static void FillEventOnlineTriggers(AliReducedEventInfo* event, Float_t* values);
@@ -859,6 +872,25 @@ class AliReducedVarManager : public TObject {
                                                  //   when a variable is used
   static void SetVariableDependencies();       // toggle those variables on which other used variables might depend 
   
+  enum TrackPlanGroups {                        // groups of track variables computed together in FillTrackInfo()
+    kPlanHarmonics   = BIT(0),                  // cos(n*phi), sin(n*phi)
+    kPlanPairEff     = BIT(1),                  // pair efficiency
+    kPlanVZEROFlow   = BIT(2),                  // track flow w.r.t. the VZERO event plane
+    kPlanTPCFlow     = BIT(3),                  // track flow w.r.t. the TPC event plane
+    kPlanTPCdEdxInfo = BIT(4),                  // TPC Qmax/Qtot dEdx info
+    kPlanTOF         = BIT(5),                  // TOF info
+    kPlanPID         = BIT(6),                  // n-sigma's and bayesian probabilities
+    kPlanTRD         = BIT(7),                  // TRD pid and online tracks
+    kPlanMC          = BIT(8)                   // MC truth kinematics and PDG codes
+  };
+  static Bool_t fgUseEvaluationPlan;            // reset/fill only the used track variables
+  static UInt_t fgTrackPlan;                    // groups of track variables needed (TrackPlanGroups)
+  static Int_t fgNUsedTrackVars;                // number of used track variables
+  static Int_t fgUsedTrackVarList[kNTrackVars-kNEventVars];   // list of used track variables
+  static void BuildEvaluationPlan();            // build the plan from the used variables
+  static Bool_t IsAnyVarUsed(Int_t first, Int_t n);
+  static Bool_t IsPlanned(UInt_t group) {return (fgTrackPlan&group) || (!fgUseEvaluationPlan && group>=kPlanTPCdEdxInfo);}
+  
 
   static Double_t DeltaPhi(Double_t phi1, Double_t phi2);  
   static void GetThetaPhiCM(AliReducedBaseTrack* leg1, AliReducedBaseTrack* leg2,
@@ -922,7 +954,7 @@ class AliReducedVarManager : public TObject {
   AliReducedVarManager(AliReducedVarManager const&);
   AliReducedVarManager& operator=(AliReducedVarManager const&);  
   
-  ClassDef(AliReducedVarManager, 17);
+  ClassDef(AliReducedVarManager, 18);
 };
 
 #endif
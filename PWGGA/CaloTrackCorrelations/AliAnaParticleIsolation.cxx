@@ -6729,11 +6729,6 @@ void AliAnaParticleIsolation::StudyClustersUEInCone(AliCaloTrackParticleCorrelat
     return;
   }
   
-  // Get vertex for cluster momentum calculation
-  Double_t vertex[] = {0,0,0} ; //vertex ;
-  if(GetReader()->GetDataType() != AliCaloTrackReader::kMC)
-    GetReader()->GetVertex(vertex);
-  
   Float_t conesize    = GetIsolationCut()->GetConeSize();
   Float_t conesizegap = GetIsolationCut()->GetConeSizeBandGap();
   Float_t emcEtaSize  = GetIsolationCut()->GetEMCEtaSize();
@@ -6756,128 +6751,28 @@ void AliAnaParticleIsolation::StudyClustersUEInCone(AliCaloTrackParticleCorrelat
   Float_t phiBandArea = 2*(conesize+conesizegap) * emcPhiSize - coneAreaGap;
   //printf("Area band eta %f phi %f\n",etaBandArea,phiBandArea);
   
+  Float_t weightTrig= pCandidate->GetWeight();
+  
+  // Sum pT and count clusters in the eta and phi bands for all the pT cuts in one go,
+  // only the clusters in the (eta,phi) cells near the bands are visited
+  //
   if ( fStudyPtCutInCone )
   {
+    Int_t nEtaBand[20];
+    Int_t nPhiBand[20];
+    
+    GetIsolationCut()->CalculateSignalInCones(pCandidate, GetReader(), GetCalorimeter(), GetCaloPID(),
+                                              1, &conesize, fNPtCutsInCone, fMinPtCutInCone,
+                                              0x0, 0x0,
+                                              fConeptsumEtaBandClusterPerMinCut, fConeptsumPhiBandClusterPerMinCut,
+                                              0x0, nEtaBand, nPhiBand);
+    
     for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
     {
-      fConeptsumEtaBandClusterPerMinCut   [icut] = 0;
-      fConeNEtaBandClusterPerMinCut       [icut] = 0;
-      fConeptsumClusterSubEtaBandPerMinCut[icut] = 0;
-      fConeNClusterSubEtaBandPerMinCut    [icut] = 0;
-      
-      fConeptsumPhiBandClusterPerMinCut   [icut] = 0;
-      fConeNPhiBandClusterPerMinCut       [icut] = 0;
-      fConeptsumClusterSubPhiBandPerMinCut[icut] = 0;
-      fConeNClusterSubPhiBandPerMinCut    [icut] = 0;
-    }
-  }
-  
-  //Float_t ptTrig    = pCandidate->Pt() ;
-  Float_t phiTrig   = pCandidate->Phi();
-  Float_t etaTrig   = pCandidate->Eta();
-  Float_t weightTrig= pCandidate->GetWeight();
-  
-  Float_t phiBandPtSumCluster = 0;
-  Float_t etaBandPtSumCluster = 0;
-  
-  for(Int_t icalo=0; icalo < caloList->GetEntriesFast(); icalo++)
-   {
-     AliVCluster* calo = (AliVCluster *) caloList->At(icalo);
-     
-    if(!calo)
-    {
-      AliWarning("Cluster not available?");
-      continue;
+      fConeNEtaBandClusterPerMinCut[icut] = nEtaBand[icut];
+      fConeNPhiBandClusterPerMinCut[icut] = nPhiBand[icut];
     }
     
-     // Do not count the candidate (photon or pi0) or the daughters of the candidate
-     if ( calo->GetID() == pCandidate->GetCaloLabel(0) ||
-          calo->GetID() == pCandidate->GetCaloLabel(1)   ) continue ;
-     
-     // Skip matched clusters with tracks in case of neutral+charged analysis
-     if ( GetIsolationCut()->IsTrackMatchedClusterRejectionInConeOn() )
-     {
-       if( GetIsolationCut()->GetParticleTypeInCone() == AliIsolationCut::kNeutralAndCharged &&
-           IsTrackMatched(calo, GetReader()->GetInputEvent()) ) continue ;
-     }
-     
-     calo->GetMomentum(fMomentum,vertex) ; //Assume that come from vertex in straight line
-     
-     Float_t ptCluster  = fMomentum.Pt();
-     Float_t etaCluster = fMomentum.Eta();
-     Float_t phiCluster = GetPhi(fMomentum.Phi());
-
-     // Angles between trigger and track
-     Double_t dEta = etaTrig - etaCluster;
-     Double_t dPhi = phiTrig - phiCluster;
-
-     // Shift phi angle when trigger is close to 0 or 360
-     if ( dPhi >=  TMath::Pi() ) dPhi-=TMath::TwoPi();
-     if ( dPhi <= -TMath::Pi() ) dPhi+=TMath::TwoPi();
-     
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    // Eta or phi band with respect the trigger cone
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    Float_t rad = GetIsolationCut()->Radius(etaTrig, phiTrig, etaCluster, phiCluster);
-
-     if ( rad > conesize+conesizegap )
-    {
-      // Phi band
-      //
-      Bool_t takeIt = kTRUE;
-
-      // Look only half TPC with respect candidate, avoid opposite side jet 
-      if ( TMath::Abs(phiTrig-phiCluster) > TMath::PiOver2() )  takeIt = kFALSE;
-      
-      // Within eta cone size
-      if ( TMath::Abs(dEta) < conesize+conesizegap &&  takeIt ) 
-      {
-        phiBandPtSumCluster += ptCluster;
-        //printf("cluster %d, pT %f in phi band\n",icalo,ptCluster);
-
-        if ( fStudyPtCutInCone )
-        {
-          for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
-          {
-            if ( ptCluster > fMinPtCutInCone[icut] ) 
-            {
-              fConeptsumPhiBandClusterPerMinCut[icut]+=ptCluster;
-              fConeNPhiBandClusterPerMinCut    [icut]++;
-            }          
-          }
-        } // min pt
-      } // phi band
-      
-      // Eta band
-      //
-      //takeIt = kTRUE;
-      
-      // Within phi cone size
-      if ( TMath::Abs(dPhi) < conesize+conesizegap )// && takeIt )
-      {
-        etaBandPtSumCluster += ptCluster;
-        //printf("cluster %d, pT %f in phi band\n",icalo,ptCluster);
-
-        if ( fStudyPtCutInCone )
-        {
-          for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
-          {
-            if ( ptCluster > fMinPtCutInCone[icut] ) 
-            {
-              fConeptsumEtaBandClusterPerMinCut[icut]+=ptCluster;
-              fConeNEtaBandClusterPerMinCut    [icut]++;
-            }          
-          }
-        } // min pt
-       
-      } // eta band
-      
-    } // out of cone
-   
-  } // track loop
-  
-  if ( fStudyPtCutInCone )
-  {    
     for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
     {
       // Normalize to cone area
@@ -7464,24 +7359,28 @@ void AliAnaParticleIsolation::StudyTracksUEInCone(AliCaloTrackParticleCorrelatio
   Double_t sumptPerpITSSPD = 0. ;
   Double_t sumptPerpBC0ITSSPD = 0.;
   
+  // Sum pT and count tracks in the perpendicular cones and in the eta and phi bands
+  // for all the pT cuts in one go, only the tracks in the (eta,phi) cells near
+  // these regions are visited
+  //
   if ( fStudyPtCutInCone )
   {
+    Int_t nPerpCone[20];
+    Int_t nEtaBand [20];
+    Int_t nPhiBand [20];
+    
+    GetIsolationCut()->CalculateSignalInCones(pCandidate, GetReader(), kCTS, GetCaloPID(),
+                                              1, &conesize, fNPtCutsInCone, fMinPtCutInCone,
+                                              0x0, 0x0,
+                                              fConeptsumEtaBandTrackPerMinCut, fConeptsumPhiBandTrackPerMinCut,
+                                              fConeptsumPerpTrackPerMinCut,
+                                              nEtaBand, nPhiBand, nPerpCone);
+    
     for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
     {
-      fConeptsumPerpTrackPerMinCut   [icut] = 0;
-      fConeNPerpTrackPerMinCut       [icut] = 0;
-      fConeptsumTrackSubPerpPerMinCut[icut] = 0;
-      fConeNTrackSubPerpPerMinCut    [icut] = 0;
-      
-      fConeptsumEtaBandTrackPerMinCut   [icut] = 0;
-      fConeNEtaBandTrackPerMinCut       [icut] = 0;
-      fConeptsumTrackSubEtaBandPerMinCut[icut] = 0;
-      fConeNTrackSubEtaBandPerMinCut    [icut] = 0;
-      
-      fConeptsumPhiBandTrackPerMinCut   [icut] = 0;
-      fConeNPhiBandTrackPerMinCut       [icut] = 0;
-      fConeptsumTrackSubPhiBandPerMinCut[icut] = 0;
-      fConeNTrackSubPhiBandPerMinCut    [icut] = 0;
+      fConeNPerpTrackPerMinCut   [icut] = nPerpCone[icut];
+      fConeNEtaBandTrackPerMinCut[icut] = nEtaBand [icut];
+      fConeNPhiBandTrackPerMinCut[icut] = nPhiBand [icut];
     }
   }
   
@@ -7492,8 +7391,12 @@ void AliAnaParticleIsolation::StudyTracksUEInCone(AliCaloTrackParticleCorrelatio
 
   Double_t bz = GetReader()->GetInputEvent()->GetMagneticField();
   
+  // Track quality checks in the perpendicular cones,
+  // the pT sums per pT cut are obtained above
+  //
   TObjArray * trackList = GetCTSTracks() ;
-  for(Int_t itrack=0; itrack < trackList->GetEntriesFast(); itrack++)
+  Int_t nTracks = fStudyTracksInCone ? trackList->GetEntriesFast() : 0;
+  for(Int_t itrack=0; itrack < nTracks; itrack++)
   {
     AliVTrack* track = (AliVTrack *) trackList->At(itrack);
     
@@ -7523,11 +7426,6 @@ void AliAnaParticleIsolation::StudyTracksUEInCone(AliCaloTrackParticleCorrelatio
     Float_t etaTrack= track->Eta();
     Float_t phiTrack= track->Phi();
     
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    // Eta or phi band with respect the trigger cone
-    //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
-    Float_t rad = GetIsolationCut()->Radius(etaTrig, phiTrig, etaTrack, phiTrack);
-
     // Angles between trigger and track
     Double_t dEta = etaTrig - etaTrack;
     Double_t dPhi = phiTrig - phiTrack;
@@ -7536,57 +7434,6 @@ void AliAnaParticleIsolation::StudyTracksUEInCone(AliCaloTrackParticleCorrelatio
     if ( dPhi >=  TMath::Pi() ) dPhi-=TMath::TwoPi();
     if ( dPhi <= -TMath::Pi() ) dPhi+=TMath::TwoPi();
     
-    if ( rad > conesize+conesizegap )
-    {
-      // Phi band
-      //
-      Bool_t takeIt = kTRUE;
-
-      // Look only half TPC with respect candidate, avoid opposite side jet 
-      if ( TMath::Abs(dPhi) > TMath::PiOver2() )  takeIt = kFALSE;
-      
-      // Within eta cone size
-      if ( TMath::Abs(dEta) < conesize+conesizegap &&  takeIt ) 
-      {
-        //phiBandPtSumTrack += ptTrack;
-        
-        if ( fStudyPtCutInCone )
-        {
-          for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
-          {
-            if ( ptTrack > fMinPtCutInCone[icut] ) 
-            {
-              fConeptsumPhiBandTrackPerMinCut[icut]+=ptTrack;
-              fConeNPhiBandTrackPerMinCut    [icut]++;
-            }          
-          }
-        } // min pt
-      } // phi band
-      
-      // Eta band
-      //
-      //takeIt = kTRUE;
-      
-      // Within phi cone size
-      if ( TMath::Abs(dPhi) < conesize+conesizegap ) //&& takeIt )
-      {
-        //etaBandPtSumTrack += ptTrack;
-        if ( fStudyPtCutInCone )
-        {
-          for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
-          {
-            if ( ptTrack > fMinPtCutInCone[icut] ) 
-            {
-              fConeptsumEtaBandTrackPerMinCut[icut]+=ptTrack;
-              fConeNEtaBandTrackPerMinCut    [icut]++;
-            }          
-          }
-        } // min pt
-       
-      } // eta band
-      
-    } // out of cone
-    
     //+++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     // Fill the histograms at +-45 degrees in phi from trigger particle, 
     // perpedicular to trigger axis in phi
@@ -7605,18 +7452,6 @@ void AliAnaParticleIsolation::StudyTracksUEInCone(AliCaloTrackParticleCorrelatio
     {
       //sumptPerp+=track->Pt();
       
-      if ( fStudyPtCutInCone )
-      {
-        for(Int_t icut = 0; icut < fNPtCutsInCone; icut++) 
-        {
-          if ( ptTrack > fMinPtCutInCone[icut] ) 
-          {
-            fConeptsumPerpTrackPerMinCut[icut]+=ptTrack;
-            fConeNPerpTrackPerMinCut    [icut]++;
-          }          
-        }
-      }
-      
       if ( fStudyTracksInCone )
       {
         ULong_t status = track->GetStatus();
@@ -489,7 +489,9 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(): AliAnalysisTaskSE(),
   fAllowOverlapHeaders(kTRUE),
   fNCurrentClusterBasic(0),
   fTrackMatcherRunningMode(0),
-  fDoPi0Only(kFALSE)
+  fDoPi0Only(kFALSE),
+  fDoPhotonPairPrefilter(kFALSE),
+  fPhotonPairKernel()
 {
 
 }
@@ -921,7 +923,9 @@ AliAnalysisTaskGammaCalo::AliAnalysisTaskGammaCalo(const char *name):
   fAllowOverlapHeaders(kTRUE),
   fNCurrentClusterBasic(0),
   fTrackMatcherRunningMode(0),
-  fDoPi0Only(kFALSE)
+  fDoPi0Only(kFALSE),
+  fDoPhotonPairPrefilter(kFALSE),
+  fPhotonPairKernel()
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -5666,6 +5670,14 @@ void AliAnalysisTaskGammaCalo::CalculatePi0Candidates(){
   // Conversion Gammas
   if(fClusterCandidates->GetEntries()>0){
 
+    // evaluate rapidity, opening angle and alpha cuts for all pairs at once, only possible
+    // if rejected pairs do not need to be passed to the cluster or meson cut objects
+    Bool_t doPairPrefilter = kFALSE;
+    if (fDoPhotonPairPrefilter && !((AliCaloPhotonCuts*)fClusterCutArray->At(fiCut))->GetDoSecondaryTrackMatching()){
+      doPairPrefilter = fPhotonPairKernel.Init((AliConversionMesonCuts*)fMesonCutArray->At(fiCut),((AliConvEventCuts*)fEventCutArray->At(fiCut))->GetEtaShift());
+      if (doPairPrefilter) fPhotonPairKernel.Process(fClusterCandidates);
+    }
+
     for(Int_t firstGammaIndex=0;firstGammaIndex<fClusterCandidates->GetEntries();firstGammaIndex++){
       AliAODConversionPhoton *gamma0=dynamic_cast<AliAODConversionPhoton*>(fClusterCandidates->At(firstGammaIndex));
       if (gamma0==NULL) continue;
@@ -5777,6 +5789,9 @@ void AliAnalysisTaskGammaCalo::CalculatePi0Candidates(){
           }
         }
 
+        // pair would be rejected by MesonIsSelected anyway
+        if (doPairPrefilter && !fPhotonPairKernel.IsPairAccepted(firstGammaIndex,secondGammaIndex)) continue;
+
         AliAODConversionMother *pi0cand = new AliAODConversionMother(gamma0,gamma1);
         pi0cand->SetLabels(firstGammaIndex,secondGammaIndex);
 
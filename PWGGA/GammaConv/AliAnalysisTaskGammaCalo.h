@@ -11,6 +11,7 @@
 #include "AliConvEventCuts.h"
 #include "AliConversionPhotonCuts.h"
 #include "AliConversionMesonCuts.h"
+#include "AliConversionPhotonPairKernel.h"
 #include "AliAnalysisTaskConvJet.h"
 #include "AliAnalysisTaskJetOutlierRemoval.h"
 #include "AliAnalysisManager.h"
@@ -76,6 +77,8 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     void SetPlotHistsExtQA(Bool_t flag){fSetPlotHistsExtQA = flag;}
     void SetAllowOverlapHeaders( Bool_t allowOverlapHeader ) {fAllowOverlapHeaders = allowOverlapHeader;}
     void SetDoPi0Only(Bool_t flag){fDoPi0Only = flag;}
+    // prefilter same event photon pairs with the packed pair kernel before creating the meson candidates
+    void SetDoPhotonPairPrefilter(Bool_t flag){fDoPhotonPairPrefilter = flag;}
 
     void SetInOutTimingCluster(Double_t min, Double_t max){
       fDoInOutTimingCluster = kTRUE; fMinTimingCluster = min; fMaxTimingCluster = max;
@@ -599,11 +602,13 @@ class AliAnalysisTaskGammaCalo : public AliAnalysisTaskSE {
     Int_t                 fNCurrentClusterBasic;                                // current number of cluster without minE
     Int_t                 fTrackMatcherRunningMode;                             // CaloTrackMatcher running mode
     Bool_t                fDoPi0Only;                                           // switches ranges of histograms and binnings to pi0 specific analysis
+    Bool_t                fDoPhotonPairPrefilter;                               // switch for prefiltering photon pairs with fPhotonPairKernel
+    AliConversionPhotonPairKernel fPhotonPairKernel;                            //! packed photon pair kinematics of the current cut
   private:
     AliAnalysisTaskGammaCalo(const AliAnalysisTaskGammaCalo&);                  // Prevent copy-construction
     AliAnalysisTaskGammaCalo &operator=(const AliAnalysisTaskGammaCalo&);       // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaCalo, 86);
+    ClassDef(AliAnalysisTaskGammaCalo, 87);
 };
 
 #endif
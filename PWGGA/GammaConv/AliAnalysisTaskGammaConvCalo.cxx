@@ -58,6 +58,7 @@
 #include "AliInputEventHandler.h"
 #include "AliCaloTrackMatcher.h"
 #include "AliCaloTriggerMimicHelper.h"
+#include "AliCutHandlerPCM.h"
 #include <vector>
 #include <map>
 
@@ -471,7 +472,9 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(): AliAnalysisTaskSE(
   fFileNameBroken(NULL),
   fAllowOverlapHeaders(kTRUE),
   fTrackMatcherRunningMode(0),
-  fDoHBTHistoOutput(kFALSE)
+  fDoHBTHistoOutput(kFALSE),
+  fSharePhotonSelection(kFALSE),
+  fPhotonSelection()
 {
 
 }
@@ -885,7 +888,9 @@ AliAnalysisTaskGammaConvCalo::AliAnalysisTaskGammaConvCalo(const char *name):
   fFileNameBroken(NULL),
   fAllowOverlapHeaders(kTRUE),
   fTrackMatcherRunningMode(0),
-  fDoHBTHistoOutput(kFALSE)
+  fDoHBTHistoOutput(kFALSE),
+  fSharePhotonSelection(kFALSE),
+  fPhotonSelection()
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -1057,6 +1062,23 @@ void AliAnalysisTaskGammaConvCalo::UserCreateOutputObjects(){
   fV0Reader = (AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;}// GetV0Reader
 
+  // cut sets with identically configured photon cuts share the photon selection, which is then
+  // evaluated only once per photon candidate and event. Cut sets whose photon cuts fill QA histograms
+  // are not shared, their histograms have to see every candidate of every event.
+  // Cluster cuts are not shared.
+  if(fSharePhotonSelection){
+    std::vector<TString> photonCutKeys(fnCuts);
+    std::vector<Bool_t> photonCutShareable(fnCuts);
+    for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+      AliConversionPhotonCuts *photonCuts = (AliConversionPhotonCuts*)fCutArray->At(iCut);
+      photonCutKeys[iCut] = photonCuts->GetSelectionKey();
+      photonCutShareable[iCut] = !photonCuts->GetCutHistograms();
+    }
+    fPhotonSelection.Init(photonCutKeys, photonCutShareable);
+    AliCutHandlerPCM::PrintCutSharing("photon", photonCutKeys.data(), fnCuts);
+    printf("INFO: photon selection evaluated for %d groups of cut sets sharing it, cut sets with photon cut QA histograms are not shared\n", fPhotonSelection.GetNGroups());
+  }
+
   if(fDoMesonAnalysis){ //Same Jet Finder MUST be used within same trainconfig
     if( ((AliConversionMesonCuts*)fMesonCutArray->At(0))->DoJetAnalysis())  fDoJetAnalysis = kTRUE;
     if( ((AliConversionMesonCuts*)fMesonCutArray->At(0))->DoJetQA())        fDoJetQA       = kTRUE;
@@ -3368,6 +3390,7 @@ void AliAnalysisTaskGammaConvCalo::UserExec(Option_t *)
 //   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fSharePhotonSelection) fPhotonSelection.NextEvent();
 
   // ------------------- BeginEvent ----------------------------
   AliEventplane *EventPlane = fInputEvent->GetEventplane();
@@ -4122,7 +4145,7 @@ void AliAnalysisTaskGammaConvCalo::ProcessPhotonCandidates()
       if( (isNegFromMBHeader+isPosFromMBHeader) != 4) fIsFromDesiredHeader = kFALSE;
     }
 
-    if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent)) continue;
+    if(!fPhotonSelection.IsSelected(fiCut, i, [&]{ return ((AliConversionPhotonCuts*)fCutArray->At(fiCut))->PhotonIsSelected(PhotonCandidate,fInputEvent); })) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->InPlaneOutOfPlaneCut(PhotonCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
     if(!((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseElecSharingCut() &&
     !((AliConversionPhotonCuts*)fCutArray->At(fiCut))->UseToCloseV0sCut()){
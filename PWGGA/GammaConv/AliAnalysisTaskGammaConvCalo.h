@@ -18,6 +18,7 @@
 #include "TH3.h"
 #include "TH3F.h"
 #include "THnSparse.h"
+#include "AliCutHandlerPCM.h"
 #include <vector>
 #include <map>
 
@@ -77,6 +78,7 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     void SetDoMesonAnalysis             ( Bool_t flag )                                     { fDoMesonAnalysis = flag                     ;}
     void SetDoMesonQA                   ( Int_t flag )                                      { fDoMesonQA = flag                           ;}
     void SetDoPhotonQA                  ( Int_t flag )                                      { fDoPhotonQA = flag                          ;}
+    void SetSharePhotonSelection        ( Bool_t flag )                                     { fSharePhotonSelection = flag                ;}
     void SetDoClusterQA                 ( Int_t flag )                                      { fDoClusterQA = flag                         ;}
     void SetUseTHnSparse                ( Bool_t flag )                                     { fDoTHnSparse = flag                         ;}
     void SetPlotHistsExtQA              ( Bool_t flag )                                     { fSetPlotHistsExtQA = flag                   ;}
@@ -598,12 +600,14 @@ class AliAnalysisTaskGammaConvCalo : public AliAnalysisTaskSE {
     Bool_t                  fAllowOverlapHeaders;                               // enable overlapping headers for cluster selection
     Int_t                   fTrackMatcherRunningMode;                           // CaloTrackMatcher running mode
     Bool_t                  fDoHBTHistoOutput;                                  // switch for additional HBT output
+    Bool_t                  fSharePhotonSelection;                              // evaluate the photon selection only once per event for cut sets with identically configured photon cuts
+    AliCutHandlerPCM::SharedSelection fPhotonSelection;                         //! photon selection shared between cut sets with identically configured photon cuts
 
   private:
     AliAnalysisTaskGammaConvCalo(const AliAnalysisTaskGammaConvCalo&); // Prevent copy-construction
     AliAnalysisTaskGammaConvCalo &operator=(const AliAnalysisTaskGammaConvCalo&); // Prevent assignment
 
-    ClassDef(AliAnalysisTaskGammaConvCalo, 67);
+    ClassDef(AliAnalysisTaskGammaConvCalo, 69);
 };
 
 #endif
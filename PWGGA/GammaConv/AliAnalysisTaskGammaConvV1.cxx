@@ -54,6 +54,7 @@
 #include "AliAODMCHeader.h"
 #include "AliEventplane.h"
 #include "AliAODEvent.h"
+#include "AliCutHandlerPCM.h"
 #include <vector>
 #include <map>
 
@@ -357,7 +358,9 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(): AliAnalysisTaskSE(),
   fFileNameBroken(NULL),
   fFileWasAlreadyReported(kFALSE),
   fAODMCTrackArray(NULL),
-  fMapPhotonHeaders()
+  fMapPhotonHeaders(),
+  fSharePhotonSelection(kFALSE),
+  fPhotonSelection()
 {
 
 }
@@ -660,7 +663,9 @@ AliAnalysisTaskGammaConvV1::AliAnalysisTaskGammaConvV1(const char *name):
   fFileNameBroken(NULL),
   fFileWasAlreadyReported(kFALSE),
   fAODMCTrackArray(NULL),
-  fMapPhotonHeaders()
+  fMapPhotonHeaders(),
+  fSharePhotonSelection(kFALSE),
+  fPhotonSelection()
 {
   // Define output slots here
   DefineOutput(1, TList::Class());
@@ -787,6 +792,22 @@ void AliAnalysisTaskGammaConvV1::UserCreateOutputObjects(){
   fV0Reader=(AliV0ReaderV1*)AliAnalysisManager::GetAnalysisManager()->GetTask(fV0ReaderName.Data());
   if(!fV0Reader){printf("Error: No V0 Reader");return;} // GetV0Reader
 
+  // cut sets with identically configured photon cuts share the photon selection, which is then
+  // evaluated only once per photon candidate and event. Cut sets whose photon cuts fill QA histograms
+  // are not shared, their histograms have to see every candidate of every event.
+  if(fSharePhotonSelection){
+    std::vector<TString> photonCutKeys(fnCuts);
+    std::vector<Bool_t> photonCutShareable(fnCuts);
+    for(Int_t iCut = 0; iCut<fnCuts;iCut++){
+      AliConversionPhotonCuts *photonCuts = (AliConversionPhotonCuts*)fCutArray->At(iCut);
+      photonCutKeys[iCut] = photonCuts->GetSelectionKey();
+      photonCutShareable[iCut] = !photonCuts->GetCutHistograms();
+    }
+    fPhotonSelection.Init(photonCutKeys, photonCutShareable);
+    AliCutHandlerPCM::PrintCutSharing("photon", photonCutKeys.data(), fnCuts);
+    printf("INFO: photon selection evaluated for %d groups of cut sets sharing it, cut sets with photon cut QA histograms are not shared\n", fPhotonSelection.GetNGroups());
+  }
+
 
   if( ((AliConversionPhotonCuts*)fCutArray->At(0))->GetUseBDTPhotonCuts()){
       fEnableBDT  = kTRUE;
@@ -2343,6 +2364,7 @@ void AliAnalysisTaskGammaConvV1::UserExec(Option_t *)
   }
 
   fReaderGammas = fV0Reader->GetReconstructedGammas(); // Gammas from default Cut
+  if(fSharePhotonSelection) fPhotonSelection.NextEvent();
 
   // ------------------- BeginEvent ----------------------------
 
@@ -2626,7 +2648,9 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
   Bool_t lUseTooCloseCut  = fiPhotonCut->UseToCloseV0sCut();
 
   // Loop over Photon Candidates allocated by ReaderV1
+  Int_t iCandidateIndex = -1;
   for (TObject *iObj : *fReaderGammas){
+    iCandidateIndex++;
 
     AliAODConversionPhoton *iCandidate = dynamic_cast<AliAODConversionPhoton*>(iObj);
     if (!iCandidate) { AliWarning("Non AliAODConversionPhoton type object in fReaderGammas.\n"); continue; }
@@ -2636,7 +2660,7 @@ void AliAnalysisTaskGammaConvV1::ProcessPhotonCandidates()
       if (!fiEventCut->PhotonPassesAddedParticlesCriterion(fMCEvent, fInputEvent, *iCandidate, lIsFromSelectedHeader)) continue;
     }
 
-    if(!fiPhotonCut->PhotonIsSelected(iCandidate,fInputEvent)) continue;
+    if(!fPhotonSelection.IsSelected(fiCut, iCandidateIndex, [&]{ return fiPhotonCut->PhotonIsSelected(iCandidate,fInputEvent); })) continue;
     if(!fiPhotonCut->InPlaneOutOfPlaneCut(iCandidate->GetPhotonPhi(),fEventPlaneAngle)) continue;
 
     // if no further cuts, add to fGammaCandidates and we are done. If header criterion is fullfilled, also fill histos and tree
@@ -13,6 +13,7 @@
 #include "AliAnalysisManager.h"
 #include "AliAnalysisTaskConvJet.h"
 #include "TProfile2D.h"
+#include "AliCutHandlerPCM.h"
 #include "TH3.h"
 #include "TH3F.h"
 #include "TMVA/Tools.h"
@@ -41,6 +42,7 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     void SetDoMesonAnalysis(Bool_t flag)                          { fDoMesonAnalysis            = flag    ;}
     void SetDoMesonQA(Int_t flag)                                 { fDoMesonQA                  = flag    ;}
     void SetDoPhotonQA(Int_t flag)                                { fDoPhotonQA                 = flag    ;}
+    void SetSharePhotonSelection(Bool_t flag)                     { fSharePhotonSelection       = flag    ;}
     void SetDoClusterSelectionForTriggerNorm(Bool_t flag)         { fEnableClusterCutsForTrigger= flag    ;}
     void SetDoChargedPrimary(Bool_t flag)                         { fDoChargedPrimary           = flag    ;}
     void SetDoPlotVsCentrality(Bool_t flag)                       { fDoPlotVsCentrality         = flag    ;}
@@ -409,12 +411,14 @@ class AliAnalysisTaskGammaConvV1 : public AliAnalysisTaskSE {
     TClonesArray*                     fAODMCTrackArray;                           //! pointer to track array
 
     AliConversionPhotonCuts::TMapPhotonBool fMapPhotonHeaders;                   // map to remember if the photon tracks are from selected headers
+    Bool_t                            fSharePhotonSelection;                      // evaluate the photon selection only once per event for cut sets with identically configured photon cuts
+    AliCutHandlerPCM::SharedSelection fPhotonSelection;                           //! photon selection shared between cut sets with identically configured photon cuts
 
   private:
 
     AliAnalysisTaskGammaConvV1(const AliAnalysisTaskGammaConvV1&); // Prevent copy-construction
     AliAnalysisTaskGammaConvV1 &operator=(const AliAnalysisTaskGammaConvV1&); // Prevent assignment
-    ClassDef(AliAnalysisTaskGammaConvV1, 53);
+    ClassDef(AliAnalysisTaskGammaConvV1, 55);
 };
 
 #endif
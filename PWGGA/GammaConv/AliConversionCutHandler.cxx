@@ -27,6 +27,7 @@
 #include <iostream>
 #include <TString.h>
 #include <AliConversionCutHandler.h>
+#include "AliCutHandlerPCM.h"
 
 AliConversionCutHandler::AliConversionCutHandler(Int_t nMax) :
 fValidCuts(true),
@@ -167,3 +168,14 @@ TString AliConversionCutHandler::GetClusterCut(Int_t i) const {
     return "";
   }
 }
+
+/**
+ * Print for each cut type the number of distinct cut strings
+ * and the digits which differ between the cut sets
+ */
+void AliConversionCutHandler::PrintCutSharing() const {
+  AliCutHandlerPCM::PrintCutSharing("event",   fEventCutArray,   GetNCuts());
+  AliCutHandlerPCM::PrintCutSharing("photon",  fPhotonCutArray,  GetNCuts());
+  AliCutHandlerPCM::PrintCutSharing("meson",   fMesonCutArray,   GetNCuts());
+  AliCutHandlerPCM::PrintCutSharing("cluster", fClusterCutArray, GetNCuts());
+}
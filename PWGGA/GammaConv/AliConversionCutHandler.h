@@ -47,6 +47,8 @@ public:
 	TString GetMesonCut(Int_t i) const;
 	TString GetClusterCut(Int_t i) const;
 
+	void PrintCutSharing() const;
+
 private:
 	Bool_t fValidCuts;              ///< Test if all cuts are valid
 	Int_t fNCuts;                   ///< Number of cuts handled so far
@@ -670,3 +670,78 @@ TString AliCutHandlerPCM::GetSpecialSettingFromAddConfig (
   }
   return "";
 }
+
+//________________________________________________________________________
+Int_t AliCutHandlerPCM::FindFirstIdenticalCut(const TString* cutArray, Int_t nCuts, Int_t i){
+  // index of the first cut set with the same cut string as cut set i (i itself if there is none)
+  if(!cutArray || i<0 || i>=nCuts) return -1;
+  for(Int_t j=0; j<i; j++){
+    if(cutArray[j].EqualTo(cutArray[i])) return j;
+  }
+  return i;
+}
+
+//________________________________________________________________________
+void AliCutHandlerPCM::PrintCutSharing(const char* cutType, const TString* cutArray, Int_t nCuts){
+  // print the number of distinct cut strings and the digits (sub-selections) which differ between the cut sets
+  if(!cutArray || nCuts<=0 || cutArray[0].Length()==0) return;
+  Int_t nDistinct = 0;
+  for(Int_t i=0; i<nCuts; i++){
+    if(FindFirstIdenticalCut(cutArray, nCuts, i)==i) nDistinct++;
+  }
+  TString varyingDigits = "";
+  for(Int_t iDigit=0; iDigit<cutArray[0].Length(); iDigit++){
+    for(Int_t i=1; i<nCuts; i++){
+      if(cutArray[i].Length()!=cutArray[0].Length() || cutArray[i][iDigit]!=cutArray[0][iDigit]){
+        varyingDigits += Form(" %d",iDigit);
+        break;
+      }
+    }
+  }
+  cout << "INFO in AliCutHandlerPCM: " << cutType << " cuts: " << nDistinct << " distinct of " << nCuts
+       << ", varying digits:" << (varyingDigits.Length() ? varyingDigits.Data() : " none") << endl;
+}
+
+//________________________________________________________________________
+void AliCutHandlerPCM::PrintCutSharing(){
+  if(!fValidCuts) return;
+  PrintCutSharing("event",   fEventCutArray,   fNCuts);
+  PrintCutSharing("photon",  fPhotonCutArray,  fNCuts);
+  PrintCutSharing("cluster", fClusterCutArray, fNCuts);
+  PrintCutSharing("meson",   fMesonCutArray,   fNCuts);
+}
+
+//________________________________________________________________________
+void AliCutHandlerPCM::SharedSelection::Init(const std::vector<TString>& keys, const std::vector<Bool_t>& shareable){
+  // group the shareable cut sets by their selection key, a group is identified by its first cut set
+  Int_t nCuts = keys.size();
+  fGroup.assign(nCuts, -1);
+  for(Int_t i=0; i<nCuts; i++){
+    if(i>=(Int_t)shareable.size() || !shareable[i]) continue;
+    fGroup[i] = i;
+    for(Int_t j=0; j<i; j++){
+      if(fGroup[j]==j && keys[j].EqualTo(keys[i])){
+        fGroup[i] = j;
+        break;
+      }
+    }
+  }
+  fEvaluated.assign(nCuts, TBits());
+  fPassed.assign(nCuts, TBits());
+}
+
+//________________________________________________________________________
+void AliCutHandlerPCM::SharedSelection::NextEvent(){
+  // forget the results of the previous event, candidates are indexed per event
+  for(UInt_t i=0; i<fEvaluated.size(); i++) fEvaluated[i].ResetAllBits();
+}
+
+//________________________________________________________________________
+Int_t AliCutHandlerPCM::SharedSelection::GetNGroups() const {
+  // number of groups of cut sets sharing the selection
+  Int_t nGroups = 0;
+  for(UInt_t i=0; i<fGroup.size(); i++){
+    if(fGroup[i]==(Int_t)i) nGroups++;
+  }
+  return nGroups;
+}
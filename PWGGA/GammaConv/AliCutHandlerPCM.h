@@ -4,8 +4,10 @@
 #include "TString.h"
 #include "TObjArray.h"
 #include "TObjString.h"
+#include "TBits.h"
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 class AliCutHandlerPCM{
   public:
@@ -47,6 +49,28 @@ class AliCutHandlerPCM{
     TString GetDeuteronCut(Int_t i);
     TString GetSigmaCut(Int_t i);
 
+    // cut sets sharing identical sub-selections, which only need to be evaluated once per object
+    void PrintCutSharing();
+    static Int_t FindFirstIdenticalCut(const TString* cutArray, Int_t nCuts, Int_t i);
+    static void PrintCutSharing(const char* cutType, const TString* cutArray, Int_t nCuts);
+
+    // Result of a selection shared between the cut sets of a task: for each group of shareable cut sets
+    // with the same selection key, the selection is evaluated once per candidate and event and the
+    // result is reused by the other cut sets of the group. Cut sets which are not shareable (e.g. because
+    // their cut object fills QA histograms for every candidate) always evaluate the selection themselves.
+    class SharedSelection{
+      public:
+        SharedSelection() : fGroup(), fEvaluated(), fPassed() {}
+        void Init(const std::vector<TString>& keys, const std::vector<Bool_t>& shareable);
+        void NextEvent();
+        Int_t GetNGroups() const;
+        template<class Selector> Bool_t IsSelected(Int_t iCut, Int_t index, Selector select);
+
+      private:
+        std::vector<Int_t> fGroup;        // first cut set of the group of each cut set, -1 if not shared
+        std::vector<TBits> fEvaluated;    // per group: candidates for which the selection was evaluated in this event
+        std::vector<TBits> fPassed;       // per group: candidates passing the selection
+    };
 
   protected:
     Int_t fMode;
@@ -86,4 +110,16 @@ class AliCutHandlerPCM{
     ClassDef(AliCutHandlerPCM,6);
 };
 
+//________________________________________________________________________
+template<class Selector> Bool_t AliCutHandlerPCM::SharedSelection::IsSelected(Int_t iCut, Int_t index, Selector select){
+  // selection of candidate index for cut set iCut, select() evaluates the selection of the cut set
+  if(iCut < 0 || iCut >= (Int_t)fGroup.size() || fGroup[iCut] < 0) return select();
+  Int_t group = fGroup[iCut];
+  if(!fEvaluated[group].TestBitNumber(index)){
+    fPassed[group].SetBitNumber(index, select());
+    fEvaluated[group].SetBitNumber(index);
+  }
+  return fPassed[group].TestBitNumber(index);
+}
+
 #endif
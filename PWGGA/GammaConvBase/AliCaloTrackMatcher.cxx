@@ -35,6 +35,7 @@
 #include "TChain.h"
 #include "TH1F.h"
 #include "TF1.h"
+#include "TVector3.h"
 
 #include <vector>
 #include <map>
@@ -60,6 +61,7 @@ AliCaloTrackMatcher::AliCaloTrackMatcher(const char *name, Int_t clusterType, In
   fGeomEMCAL(NULL),
   fGeomPHOS(NULL),
   fArrClusters(NULL),
+  fClusterGrid(),
   fMapTrackToCluster(),
   fMapClusterToTrack(),
   fNEntries(1),
@@ -288,6 +290,28 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
   }
 
+  // sort clusters of the selected calorimeter into an eta-phi grid, such that for each track
+  // only the clusters in the vicinity of the extrapolated track have to be copied and propagated to
+  fClusterGrid.Clear();
+  vector<Int_t> gridToCluster;
+  Double_t minClusterR = 1e10;
+  Float_t clsPos[3] = {0.,0.,0.};
+  for(Int_t iclus=0;iclus < nClus;iclus++){
+    AliVCluster* cluster = NULL;
+    if(fArrClusters) cluster = (AliVCluster*)fArrClusters->At(iclus);
+    else cluster = event->GetCaloCluster(iclus);
+    if (!cluster) continue;
+    if ((fClusterType == 1 || fClusterType == 3 || fClusterType == 4) && !cluster->IsEMCAL()) continue;
+    if (fClusterType == 2 && !cluster->IsPHOS()) continue;
+    cluster->GetPosition(clsPos);
+    TVector3 clsPosVec(clsPos);
+    fClusterGrid.AddCluster(clsPosVec.Eta(), clsPosVec.Phi());
+    gridToCluster.push_back(iclus);
+    if (clsPosVec.Perp() < minClusterR) minClusterR = clsPosVec.Perp();
+  }
+  fClusterGrid.BuildGrid();
+  vector<Int_t> candidates;
+
   for (Int_t itr=0;itr<event->GetNumberOfTracks();itr++){
     AliExternalTrackParam *trackParam = 0;
     AliVTrack *inTrack = 0x0;
@@ -424,7 +448,6 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
     }
 
     Float_t dEta=-999, dPhi=-999;
-    Float_t clsPos[3] = {0.,0.,0.};
     Double_t exPos[3] = {0.,0.,0.};
     if (!emcParam.GetXYZ(exPos)){
       delete trackParam;
@@ -432,11 +455,27 @@ void AliCaloTrackMatcher::ProcessEvent(AliVEvent *event){
       continue;
     }
 
+    // find clusters which can be within fMatchingWindow of the extrapolated track:
+    // for points at a transverse distance of at least rMin from the beam axis the opening angle
+    // (and the difference in azimuth) is below 2*asin(fMatchingWindow/(2*rMin))
+    TVector3 exPosVec(exPos);
+    Double_t rMin = TMath::Min(exPosVec.Perp(), minClusterR);
+    if (fMatchingWindow < 2*rMin){
+      Double_t maxAngle = 2*TMath::ASin(fMatchingWindow/(2*rMin));
+      Double_t thetaMin = TMath::Max(exPosVec.Theta()-maxAngle, 1e-6);
+      Double_t thetaMax = TMath::Min(exPosVec.Theta()+maxAngle, TMath::Pi()-1e-6);
+      fClusterGrid.FindClustersInRange(-TMath::Log(TMath::Tan(thetaMax/2)), -TMath::Log(TMath::Tan(thetaMin/2)), exPosVec.Phi(), maxAngle, candidates);
+    } else {
+      candidates.resize(gridToCluster.size());
+      for(UInt_t icand=0;icand < candidates.size();icand++) candidates[icand] = icand;
+    }
+
     // cout << inTrack->GetID() << " - " << trackParam << endl;
     // cout << "eta/phi: " << eta << ", " << phi << endl;
     // cout << "nClus: " << nClus << endl;
     Int_t nClusterMatchesToTrack = 0;
-    for(Int_t iclus=0;iclus < nClus;iclus++){
+    for(UInt_t icand=0;icand < candidates.size();icand++){
+      Int_t iclus = gridToCluster[candidates[icand]];
       AliVCluster* cluster = NULL;
       if(fArrClusters){
         if(esdev){
@@ -4,6 +4,7 @@
 #include "AliAnalysisTaskSE.h"
 #include "AliEMCALGeometry.h"
 #include "AliPHOSGeometry.h"
+#include "AliEmcalTrackClusterMatchIndex.h"
 #include <vector>
 #include <map>
 #include <utility>
@@ -117,6 +118,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     AliPHOSGeometry*      fGeomPHOS;               //! pointer to PHOS geometry
 
     TClonesArray*         fArrClusters;            //! array with clusters
+    PWG::EMCAL::AliEmcalTrackClusterMatchIndex fClusterGrid; //! eta-phi grid of the clusters in the current event
 
     multimap<Int_t,Int_t> fMapTrackToCluster;      //! connects a given track ID with all associated cluster IDs
     multimap<Int_t,Int_t> fMapClusterToTrack;      //! connects a given cluster ID with all associated track IDs
@@ -142,7 +144,7 @@ class AliCaloTrackMatcher : public AliAnalysisTaskSE {
     Bool_t                fDoLightOutput;          // switch for running light output, kFALSE -> normal mode, kTRUE -> light mode
 
     Double_t              fMassHypothesis;          // mass used for track propagation to calorimeter surface
-    ClassDef(AliCaloTrackMatcher,9)
+    ClassDef(AliCaloTrackMatcher,10)
 };
 
 #endif
@@ -1479,6 +1479,28 @@ Bool_t AliConversionMesonCuts::MesonIsSelectedMCChiCAODESD(AliDalitzAODESDMC* fM
     }
     return kFALSE;
 }
+
+//________________________________________________________________________
+Bool_t AliConversionMesonCuts::GetPairPrefilterCuts(Double_t &rapidityMin, Double_t &rapidityMax, Double_t &opanMin, Double_t &opanMax, Double_t &alphaMin, Double_t &alphaMax) const
+{
+  // Cuts of MesonIsSelected which only depend on the four momenta of the two photons,
+  // used by AliConversionPhotonPairKernel to prefilter the pairs. Pt dependent cuts
+  // are returned fully open. Returns kFALSE if rejected pairs have to be passed
+  // to MesonIsSelected anyway, as they enter the selection histograms.
+  if (fHistoMesonCuts || fHistoMesonBGCuts || fHistoInvMassBefore) return kFALSE;
+
+  rapidityMin = fRapidityCutMesonMin;
+  rapidityMax = fRapidityCutMesonMax;
+
+  opanMin     = fMinOpanPtDepCut ? 0. : fMinOpanCutMeson;
+  if (fEnableMinOpeningAngleCut && fOpeningAngle > opanMin) opanMin = fOpeningAngle;
+  opanMax     = fMaxOpanPtDepCut ? TMath::Pi() : fMaxOpanCutMeson;
+
+  alphaMin    = fAlphaMinCutMeson;
+  alphaMax    = fAlphaPtDepCut ? 1. : fAlphaCutMeson;
+  return kTRUE;
+}
+
 //________________________________________________________________________
 Bool_t AliConversionMesonCuts::MesonIsSelected(AliAODConversionMother *pi0,Bool_t IsSignal, Double_t fRapidityShift, Int_t leadingCellID1, Int_t leadingCellID2, Char_t recoMeth1, Char_t recoMeth2)
 {
@@ -179,6 +179,7 @@ class AliConversionMesonCuts : public AliAnalysisCuts {
     Int_t  GetIsMergedClusterCut()                            { return fIsMergedClusterCut;}
     Double_t GetRapidityCutValueMin()                            { return fRapidityCutMesonMin; }
     Double_t GetRapidityCutValueMax()                            { return fRapidityCutMesonMax; }
+    Bool_t GetPairPrefilterCuts(Double_t &rapidityMin, Double_t &rapidityMax, Double_t &opanMin, Double_t &opanMax, Double_t &alphaMin, Double_t &alphaMax) const;
     void   SetEnableOmegaAPlikeCut(Bool_t DoOmegaAPlikeCut) {fEnableOmegaAPlikeCut = DoOmegaAPlikeCut;}
 
     Float_t FunctionMinMassCut(Float_t e);
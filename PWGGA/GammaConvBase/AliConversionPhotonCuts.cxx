@@ -4787,6 +4787,15 @@ TString AliConversionPhotonCuts::GetCutNumber(){
   return fCutStringRead;
 }
 
+///________________________________________________________________________
+TString AliConversionPhotonCuts::GetSelectionKey(){
+  // returns the cut number together with the settings outside the cut string which change
+  // the result of PhotonIsSelected; cut objects with the same key select the same photons,
+  // provided that their custom inputs (calibration files, material budget weights) are identical
+  return Form("%s_HI%d_BDT%d_LO%d_dEdx%d_K%d_PC%d_TPCCls%d_%s", fCutStringRead.Data(), fIsHeavyIon, fUseBDTPhotonCuts, fDoLightOutput,
+              fDodEdxSigmaCut, fSwitchToKappa, fDoElecDeDxPostCalibration, fUseCorrectedTPCClsInfo, fV0ReaderName.Data());
+}
+
 ///________________________________________________________________________
 void AliConversionPhotonCuts::FillElectonLabelArray(AliAODConversionPhoton* photon, Int_t nV0){
 
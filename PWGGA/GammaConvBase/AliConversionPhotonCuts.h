@@ -156,6 +156,7 @@ class AliConversionPhotonCuts : public AliAnalysisCuts {
     virtual Bool_t IsSelected(TList* /*list*/) {return kTRUE;}
 
     TString GetCutNumber();
+    TString GetSelectionKey();
 
     Float_t GetKappaTPC(AliConversionPhotonBase *gamma, AliVEvent *event);
     Bool_t GetBDTVariableValues(AliConversionPhotonBase *gamma, AliVEvent *event, Float_t* values);
@@ -0,0 +1,132 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+////////////////////////////////////////////////
+//---------------------------------------------
+// Packed photon pair kinematics used to prefilter
+// meson candidates before they are created
+//---------------------------------------------
+////////////////////////////////////////////////
+
+#include "AliConversionPhotonPairKernel.h"
+#include "AliConversionMesonCuts.h"
+#include "AliAODConversionPhoton.h"
+#include "TList.h"
+#include "TMath.h"
+
+ClassImp(AliConversionPhotonPairKernel)
+
+const Double_t AliConversionPhotonPairKernel::kTolerance = 1e-9;
+
+//________________________________________________________________________
+AliConversionPhotonPairKernel::AliConversionPhotonPairKernel():
+  fRatioMin(0),
+  fRatioMax(0),
+  fCosOpanMin(2),
+  fCosOpanMax(-2),
+  fAlphaMin(-1),
+  fAlphaMax(2),
+  fNPhotons(0),
+  fNAcceptedPairs(0),
+  fE(),
+  fPx(),
+  fPy(),
+  fPz(),
+  fP(),
+  fValid(),
+  fPairAccepted()
+{
+}
+
+//________________________________________________________________________
+Bool_t AliConversionPhotonPairKernel::Init(const AliConversionMesonCuts *mesonCuts, Double_t rapidityShift)
+{
+  // Take over the pair cuts of the meson cut object which only depend on the
+  // photon four momenta. Returns kFALSE if the kernel cannot be used for this
+  // meson cut object, in that case all pairs need to go through the full selection.
+  if (!mesonCuts) return kFALSE;
+  Double_t rapidityMin = 0, rapidityMax = 0, opanMin = 0, opanMax = 0, alphaMin = 0, alphaMax = 0;
+  if (!mesonCuts->GetPairPrefilterCuts(rapidityMin, rapidityMax, opanMin, opanMax, alphaMin, alphaMax)) return kFALSE;
+
+  // y = 0.5 ln((E+pz)/(E-pz)), the rapidity window is checked on the ratio
+  fRatioMin   = TMath::Exp(2.*(rapidityMin+rapidityShift))*(1.-kTolerance);
+  fRatioMax   = TMath::Exp(2.*(rapidityMax+rapidityShift))*(1.+kTolerance);
+  // the opening angle window is checked on cos(theta) = p1.p2/(|p1||p2|)
+  fCosOpanMin = opanMin > 0.              ? TMath::Cos(opanMin)+kTolerance : 2.;
+  fCosOpanMax = opanMax < TMath::Pi()     ? TMath::Cos(opanMax)-kTolerance : -2.;
+  fAlphaMin   = alphaMin*(1.-kTolerance);
+  fAlphaMax   = alphaMax*(1.+kTolerance);
+  return kTRUE;
+}
+
+//________________________________________________________________________
+void AliConversionPhotonPairKernel::Process(const TList *photons)
+{
+  // Pack the photon candidates and evaluate the prefilter for all pairs (i,j), i < j.
+  // Pairs involving entries which are not photon candidates are accepted and
+  // left to the caller.
+  fNPhotons       = photons ? photons->GetEntries() : 0;
+  fNAcceptedPairs = 0;
+  fE.resize(fNPhotons);
+  fPx.resize(fNPhotons);
+  fPy.resize(fNPhotons);
+  fPz.resize(fNPhotons);
+  fP.resize(fNPhotons);
+  fValid.resize(fNPhotons);
+  fPairAccepted.resize(fNPhotons > 1 ? fNPhotons*(fNPhotons-1)/2 : 0);
+
+  for (Int_t i = 0; i < fNPhotons; i++){
+    AliAODConversionPhoton *photon = dynamic_cast<AliAODConversionPhoton*>(photons->At(i));
+    fValid[i] = photon ? 1 : 0;
+    fE[i]     = photon ? photon->E()  : 0.;
+    fPx[i]    = photon ? photon->Px() : 0.;
+    fPy[i]    = photon ? photon->Py() : 0.;
+    fPz[i]    = photon ? photon->Pz() : 0.;
+    fP[i]     = TMath::Sqrt(fPx[i]*fPx[i] + fPy[i]*fPy[i] + fPz[i]*fPz[i]);
+  }
+
+  const Double_t *e  = fE.data();
+  const Double_t *px = fPx.data();
+  const Double_t *py = fPy.data();
+  const Double_t *pz = fPz.data();
+  const Double_t *p  = fP.data();
+  const UChar_t *valid = fValid.data();
+  for (Int_t i = 0; i < fNPhotons-1; i++){
+    const Double_t e0 = e[i], px0 = px[i], py0 = py[i], pz0 = pz[i], p0 = p[i];
+    const UChar_t valid0 = valid[i];
+    UChar_t *accepted = fPairAccepted.data() + PairIndex(i, i+1);
+    const Int_t nPartners = fNPhotons-i-1;
+    const Int_t offset = i+1;
+    // no early exits in the loop body, to allow the compiler to vectorize it
+    for (Int_t k = 0; k < nPartners; k++){
+      const Int_t j = offset+k;
+      const Double_t pairE  = e0 + e[j];
+      const Double_t pairPz = pz0 + pz[j];
+      const Double_t ePlus  = pairE + pairPz;
+      const Double_t eMinus = pairE - pairPz;
+      // undefined rapidity is left to the full selection
+      const Bool_t rapidityDefined = (eMinus > 0.) & (ePlus > 0.);
+      const Bool_t rapidityOut     = rapidityDefined & ((ePlus < fRatioMin*eMinus) | (ePlus > fRatioMax*eMinus));
+
+      const Double_t norm = p0*p[j];
+      const Double_t dot  = px0*px[j] + py0*py[j] + pz0*pz[j];
+      const Bool_t opanOut = (norm > 0.) & ((dot > fCosOpanMin*norm) | (dot < fCosOpanMax*norm));
+
+      const Double_t alphaNum = TMath::Abs(e0 - e[j]);
+      const Bool_t alphaOut = (pairE > 0.) & ((alphaNum > fAlphaMax*pairE) | (alphaNum < fAlphaMin*pairE));
+
+      const Bool_t bothValid = valid0 & valid[j];
+      accepted[k] = !bothValid | !(rapidityOut | opanOut | alphaOut);
+    }
+    for (Int_t k = 0; k < nPartners; k++) fNAcceptedPairs += accepted[k];
+  }
+}
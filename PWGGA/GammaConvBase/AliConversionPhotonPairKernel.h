@@ -0,0 +1,75 @@
+#ifndef ALICONVERSIONPHOTONPAIRKERNEL_H
+#define ALICONVERSIONPHOTONPAIRKERNEL_H
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice     */
+
+#include "Rtypes.h"
+#include <vector>
+
+class TList;
+class AliConversionMesonCuts;
+
+/**
+ * @class AliConversionPhotonPairKernel
+ * @brief Packed photon pair kinematics used to prefilter meson candidates
+ * @ingroup GammaConv
+ *
+ * The same event pair loops create an AliAODConversionMother for every pair
+ * of photon candidates (including the DCA and meson quality calculation)
+ * before the meson selection is applied. Most of these pairs are rejected by
+ * the rapidity, opening angle and alpha cuts, which only depend on the photon
+ * four momenta. The kernel packs the photon candidates of an event into flat
+ * arrays (E, px, py, pz, |p|) and evaluates these cuts for all pairs at once
+ * in branch free loops, storing the result as a pair mask.
+ *
+ * The prefilter is a necessary condition of AliConversionMesonCuts::MesonIsSelected:
+ * a pair is only flagged as rejected if the full selection would reject it as
+ * well. The cut values are loosened by a small relative tolerance to absorb the
+ * different rounding of the packed calculation, and pt dependent cuts are not
+ * prefiltered. Accepted pairs still need to go through the full selection.
+ * As rejected pairs are not handed to the meson cut object, the kernel can only
+ * be used if the meson cuts do not fill their selection histograms (see Init()).
+ */
+class AliConversionPhotonPairKernel {
+
+  public:
+    AliConversionPhotonPairKernel();
+    virtual ~AliConversionPhotonPairKernel() {}
+
+    Bool_t Init(const AliConversionMesonCuts *mesonCuts, Double_t rapidityShift);
+    void   Process(const TList *photons);
+
+    /// Check whether the pair (i,j) survives the prefilter. Requires i < j.
+    Bool_t IsPairAccepted(Int_t i, Int_t j) const { return fPairAccepted[PairIndex(i,j)]; }
+    /// Number of photon candidates packed in the last call of Process()
+    Int_t  GetNumberOfPhotons() const             { return fNPhotons; }
+    /// Number of pairs surviving the prefilter in the last call of Process()
+    Int_t  GetNumberOfAcceptedPairs() const       { return fNAcceptedPairs; }
+
+  protected:
+    /// Position of the pair (i,j), i < j, in the upper triangular pair mask
+    Int_t  PairIndex(Int_t i, Int_t j) const { return i*fNPhotons - i*(i+1)/2 + (j-i-1); }
+
+    Double_t              fRatioMin;          ///< lower limit on (E+pz)/(E-pz) of the pair, from the rapidity cut
+    Double_t              fRatioMax;          ///< upper limit on (E+pz)/(E-pz) of the pair, from the rapidity cut
+    Double_t              fCosOpanMin;        ///< pairs with cos(opening angle) above are rejected (min opening angle)
+    Double_t              fCosOpanMax;        ///< pairs with cos(opening angle) below are rejected (max opening angle)
+    Double_t              fAlphaMin;          ///< pairs with |alpha| below are rejected
+    Double_t              fAlphaMax;          ///< pairs with |alpha| above are rejected
+    Int_t                 fNPhotons;          //!<! number of packed photons
+    Int_t                 fNAcceptedPairs;    //!<! number of pairs accepted by the prefilter
+    std::vector<Double_t> fE;                 //!<! photon energies
+    std::vector<Double_t> fPx;                //!<! photon momenta, x component
+    std::vector<Double_t> fPy;                //!<! photon momenta, y component
+    std::vector<Double_t> fPz;                //!<! photon momenta, z component
+    std::vector<Double_t> fP;                 //!<! photon momenta, absolute value
+    std::vector<UChar_t>  fValid;             //!<! photon candidate present in the list
+    std::vector<UChar_t>  fPairAccepted;      //!<! upper triangular pair mask
+
+    /// Relative tolerance applied to all cut values
+    static const Double_t kTolerance;
+
+    ClassDef(AliConversionPhotonPairKernel,1)
+};
+
+#endif
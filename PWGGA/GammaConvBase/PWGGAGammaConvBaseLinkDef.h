@@ -20,6 +20,7 @@
 #pragma link C++ class AliConversionAODBGHandlerRP+;
 #pragma link C++ class AliConversionTrackCuts+;
 #pragma link C++ class AliConversionMesonCuts+;
+#pragma link C++ class AliConversionPhotonPairKernel+;
 #pragma link C++ class AliDalitzElectronCuts+;
 #pragma link C++ class AliDalitzElectronSelector+;
 #pragma link C++ class AliCaloTrackMatcher+;
@@ -283,6 +283,10 @@ fImpParProdOnFlyCut(9999.),
 fCosPOnFlyCut(-9999.),
 fCosPXYOnFlyCut(-9999.),
 fTreeSingleTrackVarsOpt(AliHFTreeHandler::kRedSingleTrackVars),
+fWriteNormalizedTrackTable(kFALSE),
+fPIDoptTrackTable(AliHFTreeHandler::kRawAndNsigmaPID),
+fVariablesTreeTrackTable(0x0),
+fTreeHandlerTrackTable(nullptr),
 fJetRadius(0.4),
 fSubJetRadius(0.0),
 fJetAlgorithm(JetAlgorithm::antikt),
@@ -463,6 +467,9 @@ fCdbEntry(nullptr)
     }
   }
   
+  // Output slot after the jet slots stores the track table of the normalized output
+  DefineOutput(GetTrackTableSlot(),TTree::Class());
+  
 }
 
 //________________________________________________________________________
@@ -503,6 +510,7 @@ AliAnalysisTaskSEHFTreeCreator::~AliAnalysisTaskSEHFTreeCreator()
   delete fTreeHandlerLb;
   delete fTreeHandlerParticle;
   delete fTreeHandlerTracklet;
+  delete fTreeHandlerTrackTable;
   
   for(auto& thj : fTreeHandlerJet)
     delete thj;
@@ -615,6 +623,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
   if(fWriteVariableTreeLb) nEnabledTrees++;
   if (fFillParticleTree) nEnabledTrees++;
   if (fFillTrackletTree) nEnabledTrees++;
+  if (fWriteNormalizedTrackTable) nEnabledTrees++;
   if(fReadMC && fFillMCGenTrees) {
     nEnabledTrees = (nEnabledTrees-1)*2+1;
   }
@@ -689,6 +698,18 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
   fTreeEvChar->Branch("pthard", &fpthard);
   fTreeEvChar->SetMaxVirtualSize(1.e+8/nEnabledTrees);
   
+  if(fWriteNormalizedTrackTable){
+    // daughter tracks written once per event, the candidate trees store their index (trk_idx_prong%d)
+    // in the event: to be re-joined with AliHFTreeTrackTableReader
+    OpenFile(GetTrackTableSlot());
+    TString nameoutput = "tree_track";
+    fTreeHandlerTrackTable = new AliHFTreeHandlerTrackTable(fPIDoptTrackTable);
+    fTreeHandlerTrackTable->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
+    if(fEnableNsigmaTPCDataCorr) fTreeHandlerTrackTable->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    fVariablesTreeTrackTable = (TTree*)fTreeHandlerTrackTable->BuildTree(nameoutput,nameoutput);
+    fVariablesTreeTrackTable->SetMaxVirtualSize(1.e+8/nEnabledTrees);
+  }
+  
   if(fWriteVariableTreeD0){
     OpenFile(6);
     TString nameoutput = "tree_D0";
@@ -696,6 +717,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerD0->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerD0->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerD0->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerD0->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerD0->SetFillJets(fFillJets);
     fTreeHandlerD0->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerD0->SetTrackingEfficiency(fTrackingEfficiency);
@@ -725,6 +747,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerDs->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDs->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDs->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerDs->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerDs->SetMassKKOption(fDsMassKKOpt);
     fTreeHandlerDs->SetFillJets(fFillJets);
     fTreeHandlerDs->SetDoJetSubstructure(fDoJetSubstructure);
@@ -755,6 +778,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerDplus->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDplus->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDplus->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerDplus->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerDplus->SetFillJets(fFillJets);
     fTreeHandlerDplus->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerDplus->SetTrackingEfficiency(fTrackingEfficiency);
@@ -783,6 +807,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerLctopKpi->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLctopKpi->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLctopKpi->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerLctopKpi->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerLctopKpi->SetFillJets(fFillJets);
     fTreeHandlerLctopKpi->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerLctopKpi->SetTrackingEfficiency(fTrackingEfficiency);
@@ -812,6 +837,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerBplus->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerBplus->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerBplus->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerBplus->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerBplus->SetFillJets(fFillJets);
     fTreeHandlerBplus->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerBplus->SetTrackingEfficiency(fTrackingEfficiency);
@@ -840,6 +866,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerDstar->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerDstar->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerDstar->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerDstar->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerDstar->SetFillJets(fFillJets);
     fTreeHandlerDstar->SetDoJetSubstructure(fDoJetSubstructure);
     fTreeHandlerDstar->SetTrackingEfficiency(fTrackingEfficiency);
@@ -868,6 +895,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerLc2V0bachelor->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLc2V0bachelor->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLc2V0bachelor->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerLc2V0bachelor->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerLc2V0bachelor->SetCalcSecoVtx(fLc2V0bachelorCalcSecoVtx);
     fTreeHandlerLc2V0bachelor->SetFillJets(fFillJets);
     fTreeHandlerLc2V0bachelor->SetDoJetSubstructure(fDoJetSubstructure);
@@ -897,6 +925,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerBs->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerBs->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerBs->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerBs->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerBs->SetBsSelectionValues(fInvMassOnFlyCut,fPtOnFlyCut,fImpParProdOnFlyCut,fCosPOnFlyCut,fCosPXYOnFlyCut);
     fTreeHandlerBs->SetFillJets(fFillJets);
     fTreeHandlerBs->SetDoJetSubstructure(fDoJetSubstructure);
@@ -926,6 +955,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
     fTreeHandlerLb->SetOptSingleTrackVars(fTreeSingleTrackVarsOpt);
     if(fReadMC && fWriteOnlySignal) fTreeHandlerLb->SetFillOnlySignal(fWriteOnlySignal);
     if(fEnableNsigmaTPCDataCorr) fTreeHandlerLb->EnableNsigmaTPCDataDrivenCorrection(fSystemForNsigmaTPCDataCorr);
+    if(fTreeHandlerTrackTable) fTreeHandlerLb->SetTrackTable(fTreeHandlerTrackTable);
     fTreeHandlerLb->SetLbSelectionValues(fInvMassOnFlyCut,fPtOnFlyCut,fImpParProdOnFlyCut,fCosPOnFlyCut,fCosPXYOnFlyCut);
     fTreeHandlerLb->SetFillJets(fFillJets);
     fTreeHandlerLb->SetDoJetSubstructure(fDoJetSubstructure);
@@ -1097,6 +1127,9 @@ void AliAnalysisTaskSEHFTreeCreator::UserCreateOutputObjects()
   if(fFillTrackletTree){
     PostData(28,fVariablesTreeTracklet);
   }
+  if(fWriteNormalizedTrackTable){
+    PostData(GetTrackTableSlot(),fVariablesTreeTrackTable);
+  }
   if(fWriteNJetTrees > 0){
     // Post each jet tree to a separate output slot (for simplicity, keep the jet tree in the last slots)
     const int nJetCollections = fJetCollArray.GetEntriesFast();
@@ -1592,6 +1625,7 @@ void AliAnalysisTaskSEHFTreeCreator::UserExec(Option_t */*option*/)
   //get PID response
   if(!fPIDresp) fPIDresp = ((AliInputEventHandler*)(AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler()))->GetPIDResponse();
   
+  if(fWriteNormalizedTrackTable) fTreeHandlerTrackTable->SetEvent(fRunNumber,fEventID,fEventIDExt,fEventIDLong,fPIDresp);
   if(fWriteVariableTreeD0) Process2Prong(array2prong,aod,mcArray,aod->GetMagneticField(),mcHeader);
   if(fWriteVariableTreeDs || fWriteVariableTreeDplus || fWriteVariableTreeLctopKpi) Process3Prong(array3Prong,aod,mcArray,aod->GetMagneticField(),mcHeader);
   if(fWriteVariableTreeDstar) ProcessDstar(arrayDstar,aod,mcArray,aod->GetMagneticField(),mcHeader);
@@ -1667,6 +1701,9 @@ void AliAnalysisTaskSEHFTreeCreator::UserExec(Option_t */*option*/)
   if(fFillTrackletTree){
     PostData(28,fVariablesTreeTracklet);
   }
+  if(fWriteNormalizedTrackTable){
+    PostData(GetTrackTableSlot(),fVariablesTreeTrackTable);
+  }
   if(fWriteNJetTrees > 0){
     // Post each jet tree to a separate output slot (for simplicity, keep the jet tree in the last slots)
     const int nJetCollections = fJetCollArray.GetEntriesFast();
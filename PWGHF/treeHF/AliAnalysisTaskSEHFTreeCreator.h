@@ -55,6 +55,7 @@
 #include "AliJetTreeHandler.h"
 #include "AliParticleTreeHandler.h"
 #include "AliTrackletTreeHandler.h"
+#include "AliHFTreeHandlerTrackTable.h"
 #include "AliParticleContainer.h"
 #include "AliTrackContainer.h"
 #include "AliMCParticleContainer.h"
@@ -181,6 +182,10 @@ public:
     }
 
     void SetTreeSingleTrackVarsOpt(Int_t opt) {fTreeSingleTrackVarsOpt=opt;}
+    /// write the candidate daughters once per event in a track table, candidate trees store only their index
+    void SetWriteNormalizedTrackTable(Bool_t write=kTRUE) {fWriteNormalizedTrackTable=write;}
+    void SetPIDoptTrackTable(Int_t opt) {fPIDoptTrackTable=opt;}
+    Int_t GetTrackTableSlot() const {return 29+fWriteNJetTrees*(fFillJetConstituentTrees ? 2 : 1);}
   
     Int_t  GetSystem() const {return fSys;}
     Bool_t GetWriteOnlySignalTree() const {return fWriteOnlySignal;}
@@ -435,6 +440,10 @@ private:
     Float_t                 fCosPXYOnFlyCut;                       ///Cut on cos pointing angle xy for on fly hadron selection
   
     Int_t                   fTreeSingleTrackVarsOpt;               /// option for single-track variables to be filled in the trees
+    Bool_t                  fWriteNormalizedTrackTable;            /// flag to write the candidate daughters in a separate track table (normalized output)
+    Int_t                   fPIDoptTrackTable;                     /// PID option for the track table
+    TTree*                  fVariablesTreeTrackTable;              //!<! track table
+    AliHFTreeHandlerTrackTable* fTreeHandlerTrackTable;            //!<! handler object for the track table
 
     Double_t                fJetRadius;                            /// Setting the radius for jet finding
     Double_t                fSubJetRadius;                         /// Setting the radius for subjet finding
@@ -529,7 +538,7 @@ private:
     AliCDBEntry *fCdbEntry;
 
     /// \cond CLASSIMP
-    ClassDef(AliAnalysisTaskSEHFTreeCreator,30);
+    ClassDef(AliAnalysisTaskSEHFTreeCreator,31);
     /// \endcond
 };
 
@@ -26,6 +26,7 @@
 #include "TFile.h"
 
 #include "AliHFTreeHandler.h"
+#include "AliHFTreeHandlerTrackTable.h"
 #include "AliPID.h"
 #include "AliAODRecoDecayHF.h"
 #include "AliPIDResponse.h"
@@ -57,6 +58,7 @@ AliHFTreeHandler::AliHFTreeHandler():
   fCosPXY(-9999.),
   fImpParXY(-9999.),
   fDCA(-9999.),
+  fTrackTable(nullptr),
   fPidOpt(kNsigmaPID),
   fSingleTrackOpt(kRedSingleTrackVars),
   fFillOnlySignal(false),
@@ -158,6 +160,7 @@ AliHFTreeHandler::AliHFTreeHandler():
     fITSclsMapProng[iProng] = -9999;
     fTrackIntegratedLengthProng[iProng] = -9999.;
     fStartTimeResProng[iProng] = -9999.;
+    fTrackIdxProng[iProng] = -1;
     for(unsigned int iDet=0; iDet<knMaxDet4Pid; iDet++)
       fPIDrawVector[iProng][iDet] = -999.;
     for(unsigned int iDet=0; iDet<knMaxDet4Pid+1; iDet++) {
@@ -199,6 +202,7 @@ AliHFTreeHandler::AliHFTreeHandler(int PIDopt):
   fCosPXY(-9999.),
   fImpParXY(-9999.),
   fDCA(-9999.),
+  fTrackTable(nullptr),
   fPidOpt(PIDopt),
   fSingleTrackOpt(kRedSingleTrackVars),
   fFillOnlySignal(false),
@@ -300,6 +304,7 @@ AliHFTreeHandler::AliHFTreeHandler(int PIDopt):
     fITSclsMapProng[iProng] = -9999;
     fTrackIntegratedLengthProng[iProng] = -9999.;
     fStartTimeResProng[iProng] = -9999.;
+    fTrackIdxProng[iProng] = -1;
     for(unsigned int iDet=0; iDet<knMaxDet4Pid; iDet++)
       fPIDrawVector[iProng][iDet] = -999.;
     for(unsigned int iDet=0; iDet<knMaxDet4Pid+1; iDet++) {
@@ -422,6 +427,11 @@ void AliHFTreeHandler::AddCommonDmesonVarBranches(Bool_t HasSecVtx) {
 //________________________________________________________________
 void AliHFTreeHandler::AddSingleTrackBranches() {
 
+  if(fTrackTable) { //normalized output, single-track and PID variables in the track table
+    for(unsigned int iProng=0; iProng<fNProngs; iProng++)
+      fTreeVar->Branch(Form("trk_idx_prong%d",iProng),&fTrackIdxProng[iProng]);
+    return;
+  }
   if(fSingleTrackOpt==kNoSingleTrackVars) return;
 
   for(unsigned int iProng=0; iProng<fNProngs; iProng++) {
@@ -551,7 +561,7 @@ void AliHFTreeHandler::AddGenJetBranches() { //Gen jet branches added
 void AliHFTreeHandler::AddPidBranches(bool usePionHypo, bool useKaonHypo, bool useProtonHypo, bool useTPC, bool useTOF) 
 {
 
-  if(fPidOpt==kNoPID) return;
+  if(fPidOpt==kNoPID || fTrackTable) return;
   if(fPidOpt>kBayesianAndNsigmaPID) {
     AliWarning("Wrong PID setting!");
     return;
@@ -625,6 +635,13 @@ bool AliHFTreeHandler::SetSingleTrackVars(AliAODTrack* prongtracks[]) {
   //cannot be obtained in similar way for the different AliAODRecoDecay objects (AliAODTrack cannot
   //be used because of recomputation PV)
 
+  if(fTrackTable) { //normalized output, the prong tracks are written once per event in the track table
+    for(unsigned int iProng=0; iProng<fNProngs; iProng++) {
+      fTrackIdxProng[iProng] = fTrackTable->AddTrack(prongtracks[iProng]);
+      if(fTrackIdxProng[iProng]<0) return false;
+    }
+    return true;
+  }
   if(fSingleTrackOpt==kNoSingleTrackVars) return true;
 
   for(unsigned int iProng=0; iProng<fNProngs; iProng++) {
@@ -841,6 +858,7 @@ void AliHFTreeHandler::SetGenJetTreeVars(AliHFJet hfjet){
 //________________________________________________________________
 bool AliHFTreeHandler::SetPidVars(AliAODTrack* prongtracks[], AliPIDResponse* pidrespo, bool usePionHypo, bool useKaonHypo, bool useProtonHypo, bool useTPC, bool useTOF, AliAODPidHF* pidhf)
 {
+  if(fTrackTable) return true; //normalized output, PID variables in the track table
   if(!pidrespo) return false;
   for(unsigned int iProng=0; iProng<fNProngs; iProng++) {
     if(!prongtracks[iProng]) {
@@ -34,6 +34,8 @@
 #include "AliHFJetFinder.h"
 #endif
 
+class AliHFTreeHandlerTrackTable;
+
 class AliHFTreeHandler : public TObject
 {
   public:
@@ -121,6 +123,8 @@ class AliHFTreeHandler : public TObject
     void SetOptPID(int PIDopt) {fPidOpt=PIDopt;}
     void SetOptSingleTrackVars(int opt) {fSingleTrackOpt=opt;}
     void SetFillOnlySignal(bool fillopt=true) {fFillOnlySignal=fillopt;}
+    //normalized output: prong tracks written once per event in the track table, only their index here (to be set before BuildTree)
+    void SetTrackTable(AliHFTreeHandlerTrackTable* tracktable) {fTrackTable=tracktable;}
     void SetUpCombinedPid(); 
 
     void SetCandidateType(bool issignal, bool isbkg, bool isprompt, bool isFD, bool isreflected);
@@ -241,6 +245,8 @@ class AliHFTreeHandler : public TObject
     int fPIDNsigmaIntVector[knMaxProngs][knMaxDet4Pid+1][knMaxHypo4Pid]; ///PID nsigma variables (integers)
     float fPIDrawVector[knMaxProngs][knMaxDet4Pid]; ///raw PID variables
     float fPIDprobBayesVector[knMaxProngs][knMaxHypo4Pid]; ///bayesian PID variables
+    int fTrackIdxProng[knMaxProngs]; ///index of the prong tracks in the track table (normalized output)
+    AliHFTreeHandlerTrackTable* fTrackTable; //!<! track table for the normalized output (not owned)
     int fPidOpt; ///option for PID variables
     int fSingleTrackOpt; ///option for single-track variables
     bool fFillOnlySignal; ///flag to enable only signal filling
@@ -326,7 +332,7 @@ class AliHFTreeHandler : public TObject
     Double_t fTrackingEfficiency;
 
   /// \cond CLASSIMP
-  ClassDef(AliHFTreeHandler,9); ///
+  ClassDef(AliHFTreeHandler,10); ///
   /// \endcond
 };
 #endif
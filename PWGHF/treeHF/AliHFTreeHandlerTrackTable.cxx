@@ -0,0 +1,143 @@
+/* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+//*************************************************************************
+// \class AliHFTreeHandlerTrackTable
+// \brief helper class to handle a per-event table of the daughter tracks
+// of the HF candidates, for the normalized output of the tree creator.
+/////////////////////////////////////////////////////////////
+
+#include <TString.h>
+#include "AliHFTreeHandlerTrackTable.h"
+
+/// \cond CLASSIMP
+ClassImp(AliHFTreeHandlerTrackTable);
+/// \endcond
+
+//________________________________________________________________
+AliHFTreeHandlerTrackTable::AliHFTreeHandlerTrackTable():
+  AliHFTreeHandler(),
+  fTrackIdx(-1),
+  fTrackID(-9999),
+  fCharge(0),
+  fNTracksInEvent(0),
+  fPIDResponse(nullptr),
+  fTrackIndexMap()
+{
+  //
+  // Default constructor
+  //
+
+  fNProngs=1; // --> one track per row, cannot be changed
+}
+
+//________________________________________________________________
+AliHFTreeHandlerTrackTable::AliHFTreeHandlerTrackTable(int PIDopt):
+  AliHFTreeHandler(PIDopt),
+  fTrackIdx(-1),
+  fTrackID(-9999),
+  fCharge(0),
+  fNTracksInEvent(0),
+  fPIDResponse(nullptr),
+  fTrackIndexMap()
+{
+  //
+  // Standard constructor
+  //
+
+  fNProngs=1; // --> one track per row, cannot be changed
+}
+
+//________________________________________________________________
+AliHFTreeHandlerTrackTable::~AliHFTreeHandlerTrackTable()
+{
+  //
+  // Default Destructor
+  //
+}
+
+//________________________________________________________________
+TTree* AliHFTreeHandlerTrackTable::BuildTree(TString name, TString title)
+{
+  fIsMCGenTree=false;
+
+  if(fTreeVar) {
+    delete fTreeVar;
+    fTreeVar=nullptr;
+  }
+  fTreeVar = new TTree(name.Data(),title.Data());
+
+  //event identifiers, to be matched with the event and candidate trees
+  fTreeVar->Branch("run_number",&fRunNumber);
+  fTreeVar->Branch("ev_id",&fEvID);
+  fTreeVar->Branch("ev_id_ext",&fEvIDExt);
+  fTreeVar->Branch("ev_id_long",&fEvIDLong);
+  fTreeVar->Branch("trk_idx",&fTrackIdx);
+  fTreeVar->Branch("trk_id",&fTrackID);
+  fTreeVar->Branch("charge",&fCharge);
+
+  //set single-track variables (branch names with suffix _prong0)
+  AddSingleTrackBranches();
+
+  //set PID variables for all the hypotheses used by the candidate trees
+  if(fPidOpt!=kNoPID) AddPidBranches(true,true,true,true,true);
+
+  return fTreeVar;
+}
+
+//________________________________________________________________
+bool AliHFTreeHandlerTrackTable::SetVariables(int /*runnumber*/, int /*eventID*/, int /*eventID_Ext*/, Long64_t /*eventID_Long*/, float /*ptgen*/, AliAODRecoDecayHF* /*cand*/, float /*bfield*/, int /*masshypo*/, AliPIDResponse* /*pidrespo*/, AliAODPidHF* /*pidhf*/)
+{
+  AliWarning("The track table is filled via AddTrack(), not per candidate!");
+  return false;
+}
+
+//________________________________________________________________
+void AliHFTreeHandlerTrackTable::SetEvent(int runnumber, int eventID, int eventID_Ext, Long64_t eventID_Long, AliPIDResponse *pidrespo)
+{
+  //
+  // Start a new event: to be called once per event, before the candidate
+  // trees are filled
+  //
+
+  fRunNumber=runnumber;
+  fEvID=eventID;
+  fEvIDExt=eventID_Ext;
+  fEvIDLong=eventID_Long;
+  fPIDResponse=pidrespo;
+  fNTracksInEvent=0;
+  fTrackIndexMap.clear();
+}
+
+//________________________________________________________________
+int AliHFTreeHandlerTrackTable::AddTrack(AliAODTrack* track)
+{
+  //
+  // Write the track to the table if not already done for the current event.
+  // Returns the index of the track in the event, -1 in case of failure
+  //
+
+  if(!track) {
+    AliWarning("Prong track not found!");
+    return -1;
+  }
+
+  auto it = fTrackIndexMap.find(track);
+  if(it!=fTrackIndexMap.end()) return it->second;
+
+  AliAODTrack* tracks[1] = {track};
+  if(!SetSingleTrackVars(tracks)) return -1;
+  //nsigma values from the PID response (species-independent w.r.t. the AliAODPidHF of the cut objects)
+  if(fPidOpt!=kNoPID && !SetPidVars(tracks,fPIDResponse,true,true,true,true,true,nullptr)) return -1;
+
+  fTrackIdx=fNTracksInEvent;
+  fTrackID=track->GetID();
+  fCharge=track->Charge();
+  fTreeVar->Fill();
+  fTrackIndexMap[track]=fTrackIdx;
+  fNTracksInEvent++;
+
+  return fTrackIdx;
+}
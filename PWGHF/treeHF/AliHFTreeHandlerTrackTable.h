@@ -0,0 +1,50 @@
+#ifndef ALIHFTREEHANDLERTRACKTABLE_H
+#define ALIHFTREEHANDLERTRACKTABLE_H
+
+/* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+//*************************************************************************
+// \class AliHFTreeHandlerTrackTable
+// \brief helper class to handle a per-event table of the daughter tracks
+// of the HF candidates, for the normalized output of the tree creator.
+// Each track is written once per event, independently of the number of
+// candidates (and species) it belongs to. The candidate trees store the
+// index of the track in the event (trk_idx_prong%d) instead of the
+// single-track and PID variables.
+/////////////////////////////////////////////////////////////
+
+#include <unordered_map>
+#include "AliHFTreeHandler.h"
+
+class AliHFTreeHandlerTrackTable : public AliHFTreeHandler
+{
+  public:
+    AliHFTreeHandlerTrackTable();
+    AliHFTreeHandlerTrackTable(int PIDopt);
+
+    virtual ~AliHFTreeHandlerTrackTable();
+
+    virtual TTree* BuildTree(TString name="tree_track", TString title="tree_track");
+    virtual bool SetVariables(int runnumber, int eventID, int eventID_Ext, Long64_t eventID_Long, float ptgen, AliAODRecoDecayHF* cand, float bfield, int masshypo=0, AliPIDResponse *pidrespo=nullptr, AliAODPidHF *pidhf=nullptr);
+
+    void SetEvent(int runnumber, int eventID, int eventID_Ext, Long64_t eventID_Long, AliPIDResponse *pidrespo);
+    int AddTrack(AliAODTrack* track);
+    int GetNTracksInEvent() const {return fNTracksInEvent;}
+
+  private:
+
+    int fTrackIdx; ///index of the track in the event
+    int fTrackID; ///ID of the AOD track
+    short fCharge; ///charge of the track
+    int fNTracksInEvent; //!<! number of tracks written for the current event
+    AliPIDResponse* fPIDResponse; //!<! PID response of the current event
+    std::unordered_map<const AliAODTrack*,int> fTrackIndexMap; //!<! tracks already written for the current event
+
+    /// \cond CLASSIMP
+    ClassDef(AliHFTreeHandlerTrackTable,1); ///
+    /// \endcond
+};
+#endif
@@ -0,0 +1,123 @@
+/* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+//*************************************************************************
+// \class AliHFTreeTrackTableReader
+// \brief helper class to re-join the candidate trees written in the
+// normalized mode of AliAnalysisTaskSEHFTreeCreator with the track table
+/////////////////////////////////////////////////////////////
+
+#include <TTree.h>
+#include "AliLog.h"
+#include "AliHFTreeTrackTableReader.h"
+
+/// \cond CLASSIMP
+ClassImp(AliHFTreeTrackTableReader);
+/// \endcond
+
+//________________________________________________________________
+AliHFTreeTrackTableReader::AliHFTreeTrackTableReader():
+  TObject(),
+  fTrackTree(nullptr),
+  fEventMap()
+{
+  //
+  // Default constructor
+  //
+}
+
+//________________________________________________________________
+AliHFTreeTrackTableReader::AliHFTreeTrackTableReader(TTree* tracktree):
+  TObject(),
+  fTrackTree(nullptr),
+  fEventMap()
+{
+  //
+  // Standard constructor
+  //
+
+  SetTrackTree(tracktree);
+}
+
+//________________________________________________________________
+AliHFTreeTrackTableReader::~AliHFTreeTrackTableReader()
+{
+  //
+  // Default Destructor
+  //
+}
+
+//________________________________________________________________
+bool AliHFTreeTrackTableReader::SetTrackTree(TTree* tracktree)
+{
+  //
+  // Index the track table: the tracks of an event are written in consecutive
+  // entries, with trk_idx running from 0, so the first entry and the number of
+  // tracks per event are enough to locate any track. Only the event
+  // identifiers are read here.
+  //
+
+  fEventMap.clear();
+  fTrackTree=tracktree;
+  if(!fTrackTree) return false;
+  if(!fTrackTree->GetBranch("run_number") || !fTrackTree->GetBranch("ev_id_long") || !fTrackTree->GetBranch("trk_idx")) {
+    AliError("Tree is not a track table!");
+    fTrackTree=nullptr;
+    return false;
+  }
+
+  int runnumber=-1;
+  Long64_t evid=-1;
+  int trkidx=-1;
+  TBranch* brrun = fTrackTree->GetBranch("run_number");
+  TBranch* brev = fTrackTree->GetBranch("ev_id_long");
+  TBranch* brtrk = fTrackTree->GetBranch("trk_idx");
+  brrun->SetAddress(&runnumber);
+  brev->SetAddress(&evid);
+  brtrk->SetAddress(&trkidx);
+
+  Long64_t nentries = fTrackTree->GetEntries();
+  for(Long64_t iEntry=0; iEntry<nentries; iEntry++) {
+    brrun->GetEntry(iEntry);
+    brev->GetEntry(iEntry);
+    brtrk->GetEntry(iEntry);
+    if(trkidx==0) fEventMap[std::make_pair(runnumber,evid)] = std::make_pair(iEntry,1);
+    else {
+      auto it = fEventMap.find(std::make_pair(runnumber,evid));
+      if(it==fEventMap.end() || it->second.first+it->second.second!=iEntry || it->second.second!=trkidx) {
+        AliWarning(Form("Unexpected track index %d at entry %lld, skipped",trkidx,iEntry));
+        continue;
+      }
+      it->second.second++;
+    }
+  }
+  fTrackTree->ResetBranchAddresses();
+
+  return true;
+}
+
+//________________________________________________________________
+Long64_t AliHFTreeTrackTableReader::GetTrackEntry(int runnumber, Long64_t eventID_Long, int trackidx) const
+{
+  //
+  // Entry of the track table corresponding to the track index stored in the
+  // candidate trees, -1 if not found
+  //
+
+  if(trackidx<0) return -1;
+  auto it = fEventMap.find(std::make_pair(runnumber,eventID_Long));
+  if(it==fEventMap.end() || trackidx>=it->second.second) return -1;
+
+  return it->second.first+trackidx;
+}
+
+//________________________________________________________________
+int AliHFTreeTrackTableReader::GetNTracks(int runnumber, Long64_t eventID_Long) const
+{
+  auto it = fEventMap.find(std::make_pair(runnumber,eventID_Long));
+  if(it==fEventMap.end()) return 0;
+
+  return it->second.second;
+}
@@ -0,0 +1,54 @@
+#ifndef ALIHFTREETRACKTABLEREADER_H
+#define ALIHFTREETRACKTABLEREADER_H
+
+/* Copyright(c) 1998-2008, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/* $Id$ */
+
+//*************************************************************************
+// \class AliHFTreeTrackTableReader
+// \brief helper class to re-join the candidate trees written in the
+// normalized mode of AliAnalysisTaskSEHFTreeCreator with the track table
+// (AliHFTreeHandlerTrackTable). Usage:
+//
+//   AliHFTreeTrackTableReader reader(treeTracks);
+//   for each candidate entry (run_number, ev_id_long, trk_idx_prong0, ...):
+//     Long64_t entry = reader.GetTrackEntry(run_number, ev_id_long, trk_idx_prong0);
+//     if(entry>=0) treeTracks->GetEntry(entry);
+/////////////////////////////////////////////////////////////
+
+#include <map>
+#include <utility>
+#include <TObject.h>
+
+class TTree;
+
+class AliHFTreeTrackTableReader : public TObject
+{
+  public:
+    AliHFTreeTrackTableReader();
+    AliHFTreeTrackTableReader(TTree* tracktree);
+
+    virtual ~AliHFTreeTrackTableReader();
+
+    bool SetTrackTree(TTree* tracktree);
+    TTree* GetTrackTree() const {return fTrackTree;}
+
+    Long64_t GetTrackEntry(int runnumber, Long64_t eventID_Long, int trackidx) const;
+    int GetNTracks(int runnumber, Long64_t eventID_Long) const;
+    int GetNEvents() const {return static_cast<int>(fEventMap.size());}
+
+  private:
+
+    AliHFTreeTrackTableReader(const AliHFTreeTrackTableReader &source);
+    AliHFTreeTrackTableReader& operator=(const AliHFTreeTrackTableReader &source);
+
+    TTree* fTrackTree; //!<! track table (not owned)
+    std::map<std::pair<int,Long64_t>,std::pair<Long64_t,int> > fEventMap; //!<! (run, event ID) -> (first entry, number of tracks)
+
+    /// \cond CLASSIMP
+    ClassDef(AliHFTreeTrackTableReader,1); ///
+    /// \endcond
+};
+#endif
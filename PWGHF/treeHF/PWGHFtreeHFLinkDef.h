@@ -19,6 +19,8 @@
 #pragma link C++ class   AliHFTreeHandlerLbtoLcpi+;
 #pragma link C++ class   AliJetTreeHandler+;
 #pragma link C++ class   AliHFTreeHandlerInclusiveJet+; 
+#pragma link C++ class   AliHFTreeHandlerTrackTable+;
+#pragma link C++ class   AliHFTreeTrackTableReader+;
 #pragma link C++ class   AliParticleTreeHandler+;
 #pragma link C++ class   AliTrackletTreeHandler+;
 
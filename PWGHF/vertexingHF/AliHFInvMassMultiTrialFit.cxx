@@ -25,11 +25,27 @@
 #include "AliHFInvMassFitter.h"
 #include "AliHFInvMassMultiTrialFit.h"
 #include "AliVertexingHFUtils.h"
+#include <RVersion.h>
+#include <algorithm>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0) && !defined(_WIN32)
+#define HF_MULTITRIAL_PROCESSEXECUTOR
+#include <TVectorD.h>
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#endif
 
 /// \cond CLASSIMP
 ClassImp(AliHFInvMassMultiTrialFit);
 /// \endcond
 
+namespace {
+  // layout of the fit results of a trial, see AliHFInvMassMultiTrialFit::FitTrial
+  enum { kResFitOK, kResChi2, kResSignif, kResErSignif, kResMean, kResErMean, kResSigma, kResErSigma,
+	 kResRawYield, kResErRawYield, kResBkg, kResErBkg, kResBkgBinEdges, kResErBkgBinEdges, kNResFit };
+  // followed by the results of each bin counting step
+  enum { kResBinCOK, kResBinC0, kResErBinC0, kResBinC1, kResErBinC1, kNResBinC };
+}
+
 
 //_________________________________________________________________________
 AliHFInvMassMultiTrialFit::AliHFInvMassMultiTrialFit() : 
@@ -83,6 +99,7 @@ AliHFInvMassMultiTrialFit::AliHFInvMassMultiTrialFit() :
   fFixSigmaSecondPeak(kFALSE),
   fSaveBkgVal(kFALSE),
   fDrawIndividualFits(kFALSE),
+  fNumOfWorkers(1),
   fHistoRawYieldDistAll(0x0),
   fHistoRawYieldTrialAll(0x0),
   fHistoSigmaTrialAll(0x0),
@@ -276,290 +293,443 @@ Bool_t AliHFInvMassMultiTrialFit::CreateHistos(){
 //________________________________________________________________________
 Bool_t AliHFInvMassMultiTrialFit::DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad){
   // perform the multiple fits
+  // The trials are first listed in the order of the nested loops (rebin,
+  // first bin, fit range, background and signal configuration), then fitted
+  // (distributed among fNumOfWorkers processes if requested) and finally the
+  // histograms and ntuples are filled in the order of the list, so that the
+  // output does not depend on the number of workers
 
   Bool_t hOK=CreateHistos();
   if(!hOK) return kFALSE;
 
-  Int_t itrial=0;
-  Int_t itrialBC=0;
   Int_t totTrials=fNumOfRebinSteps*fNumOfFirstBinSteps*fNumOfLowLimFitSteps*fNumOfUpLimFitSteps;
 
-  fMinYieldGlob=999999.;
-  fMaxYieldGlob=0.;
-  Float_t xnt[16];
-  Float_t xntBC[14];
-
+  std::vector<TH1F*> rebinnedHistos;
+  std::vector<TrialConfig> trials;
+  Int_t itrial=0;
   for(Int_t ir=0; ir<fNumOfRebinSteps; ir++){
     Int_t rebin=fRebinSteps[ir];
     for(Int_t iFirstBin=1; iFirstBin<=fNumOfFirstBinSteps; iFirstBin++) {
       TH1F* hRebinned=0x0;
       if(fNumOfFirstBinSteps==1) hRebinned=(TH1F*)AliVertexingHFUtils::RebinHisto(hInvMassHisto,rebin,-1);
       else hRebinned=(TH1F*)AliVertexingHFUtils::RebinHisto(hInvMassHisto,rebin,iFirstBin);
+      rebinnedHistos.push_back(hRebinned);
       for(Int_t iMinMass=0; iMinMass<fNumOfLowLimFitSteps; iMinMass++){
-        Double_t minMassForFit=fLowLimFitSteps[iMinMass];
-        Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
         for(Int_t iMaxMass=0; iMaxMass<fNumOfUpLimFitSteps; iMaxMass++){
-          Double_t maxMassForFit=fUpLimFitSteps[iMaxMass];
-          Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
           ++itrial;
           for(Int_t typeb=0; typeb<kNBkgFuncCases; typeb++){
-            if(typeb==kExpoBkg && !fUseExpoBkg) continue;
-            if(typeb==kLinBkg && !fUseLinBkg) continue;
-            if(typeb==kPol2Bkg && !fUsePol2Bkg) continue;
-            if(typeb==kPol3Bkg && !fUsePol3Bkg) continue;
-            if(typeb==kPol4Bkg && !fUsePol4Bkg) continue;
-            if(typeb==kPol5Bkg && !fUsePol5Bkg) continue;
-            if(typeb==kPowBkg && !fUsePowLawBkg) continue;
-            if(typeb==kPowTimesExpoBkg && !fUsePowLawTimesExpoBkg) continue;  
 	    for(Int_t types=0; types<kNSigFuncCases; types++){
-	      if(types==k2Gaus && !fUse2GausSignal) continue;
-	      if(types==k2GausSigmaRatioPar && !fUse2GausSigmaRatioSignal) continue;
 	      for(Int_t igs=0; igs<kNGausSigCases; igs++){
-		if (igs==kFreeSig && !fUseFreeS) continue;
 		for(Int_t igm=0; igm<kNGausMeanCases; igm++){
-		  if (igs==kFixSig){
-		    if (igm==kFreeMean && !fUseFixSigFreeMean) continue;
-		    if (igm==kFixMean && !fUseFixSigFixMean) continue;
-		    if (igm==kFixMeanUp && !fUseFixSigFixMeanUp) continue;
-		    if (igm==kFixMeanDown && !fUseFixSigFixMeanDown) continue;
-		  }
-		  if (igs==kFreeSig){
-		    if (igm==kFixMean  && !fUseFixedMeanFreeS) continue;
-		    if (igm==kFixMeanUp && !fUseFreeSigFixMeanUp) continue;
-		    if (igm==kFixMeanDown && !fUseFreeSigFixMeanDown) continue;
-		  }
-		  if (igs==kFixSigUp){
-		    if (igm==kFreeMean && !fUseFixSigUpFreeMean) continue;
-		    if (igm==kFixMean && !fUseFixSigVarWithFixMean) continue;
-		    if (igm==kFixMeanUp && !fUseFixSigVarWithFixMean) continue;
-		    if (igm==kFixMeanDown && !fUseFixSigVarWithFixMean) continue;
-		  }
-		  if (igs==kFixSigDown){
-		    if (igm==kFreeMean && !fUseFixSigDownFreeMean) continue;
-		    if (igm==kFixMean && !fUseFixSigVarWithFixMean) continue;
-		    if (igm==kFixMeanUp && !fUseFixSigVarWithFixMean) continue;
-		    if (igm==kFixMeanDown && !fUseFixSigVarWithFixMean) continue;
-		  }
-		  
-		  Int_t theCase=igm*kNGausSigCases*kNBkgFuncCases*kNSigFuncCases+igs*kNBkgFuncCases*kNSigFuncCases+types*kNBkgFuncCases+typeb;
-		  Int_t globBin=itrial+theCase*totTrials;
-		  for(Int_t j=0; j<16; j++) xnt[j]=0.;
-		
-		  Bool_t mustDeleteFitter = kTRUE;
-		  AliHFInvMassFitter*  fitter=0x0;
-		  if(typeb==kExpoBkg){
-		    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kExpo, types);
-		  }else if(typeb==kLinBkg){
-		    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kLin, types);
-		  }else if(typeb==kPol2Bkg){
-		    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kPol2, types);
-		  }else if(typeb==kPowBkg){
-		    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kPow, types);
-		  }else if(typeb==kPowTimesExpoBkg){
-		    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kPowEx, types);
-		  }else{
-		    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, 6, types);
-		    if(typeb==kPol3Bkg) fitter->SetPolDegreeForBackgroundFit(3);
-		    if(typeb==kPol4Bkg) fitter->SetPolDegreeForBackgroundFit(4);
-		    if(typeb==kPol5Bkg) fitter->SetPolDegreeForBackgroundFit(5);
-		  }
-		  if(types==k2Gaus){
-		    if(fFixSecondGausSig>=0.) fitter->SetFixSecondGaussianSigma(fFixSecondGausSig);
-		    if(fFixSecondGausFrac>=0.) fitter->SetFixFrac2Gaus(fFixSecondGausFrac);
-		  }else if(types==k2GausSigmaRatioPar){
-		    if(fFixSecondGausSigRat>=0.) fitter->SetFixRatio2GausSigma(fFixSecondGausSigRat);
-		    if(fFixSecondGausFrac>=0.) fitter->SetFixFrac2Gaus(fFixSecondGausFrac);
-		  }
-		  // D0 Reflection
-		  if(fhTemplRefl && fhTemplSign){
-		    TH1F *hReflModif=(TH1F*)AliVertexingHFUtils::AdaptTemplateRangeAndBinning(fhTemplRefl,hRebinned,minMassForFit,maxMassForFit);
-		    TH1F *hSigModif=(TH1F*)AliVertexingHFUtils::AdaptTemplateRangeAndBinning(fhTemplSign,hRebinned,minMassForFit,maxMassForFit);
-		    TH1F* hrfl=fitter->SetTemplateReflections(hReflModif,"2gaus",minMassForFit,maxMassForFit);
-		    if(!hrfl) printf("ERROR in SetTemplateReflections\n");
-		    if(fFixRefloS>0){
-		      Double_t fixSoverRefAt=fFixRefloS*(hReflModif->Integral(hReflModif->FindBin(minMassForFit*1.0001),hReflModif->FindBin(maxMassForFit*0.999))/hSigModif->Integral(hSigModif->FindBin(minMassForFit*1.0001),hSigModif->FindBin(maxMassForFit*0.999)));
-		      fitter->SetFixReflOverS(fixSoverRefAt);
-		    }
-		    delete hReflModif;
-		    delete hSigModif;
-		  }
-		  if(fUseSecondPeak){
-		    fitter->IncludeSecondGausPeak(fMassSecondPeak, fFixMassSecondPeak, fSigmaSecondPeak, fFixSigmaSecondPeak);
-		  }
-		  if(fFitOption==1) fitter->SetUseChi2Fit();
-		  fitter->SetInitialGaussianMean(fMassD);
-		  fitter->SetInitialGaussianSigma(fSigmaGausMC);
-		  xnt[0]=rebin;
-		  xnt[1]=iFirstBin;
-		  xnt[2]=minMassForFit;
-		  xnt[3]=maxMassForFit;
-		  xnt[4]=typeb;
-		  xnt[5]=types;
-		  if(igs==kFixSig){
-		    fitter->SetFixGaussianSigma(fSigmaGausMC);
-		    xnt[6]=1;
-		  }else if(igs==kFixSigUp){
-		    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariationUp));
-		    xnt[6]=2;
-		  }else if(igs==kFixSigDown){
-		    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariationDw));
-		    xnt[6]=3;
-		  }else{ // igs==kFreeSig
-		    xnt[6]=0;
-		  }
-		  if(igm==kFixMean){
-		    fitter->SetFixGaussianMean(fMassD);
-		    xnt[7]=1;
-		  }else if(igm==kFixMeanUp){
-		    fitter->SetFixGaussianMean(fUpperMassToFix);
-		    xnt[7]=2;
-		  }else if(igm==kFixMeanDown){
-		    fitter->SetFixGaussianMean(fLowerMassToFix);
-		    xnt[7]=3;
-		  }else{ // igm==kFreeMean){
-		    xnt[7]=0;
-		  }
-		  
-		  Bool_t out=kFALSE;
-		  Double_t chisq=-1.;
-		  Double_t sigma=0.;
-		  Double_t esigma=0.;
-		  Double_t pos=.0;
-		  Double_t epos=.0;
-		  Double_t ry=.0;
-		  Double_t ery=.0;
-		  Double_t significance=0.;
-		  Double_t erSignif=0.;
-		  Double_t bkg=0.;
-		  Double_t erbkg=0.;
-		  Double_t bkgBEdge=0;
-		  Double_t erbkgBEdge=0;
-		  if(typeb<kNBkgFuncCases){
-		    printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d %d\n",hInvMassHisto->GetName(),rebin,iFirstBin,minMassForFit,maxMassForFit,typeb,igs,igm);
-		    out=fitter->MassFitter(0);
-		    chisq=fitter->GetReducedChiSquare();
-		    fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
-		    sigma=fitter->GetSigma();
-		    pos=fitter->GetMean();
-		    esigma=fitter->GetSigmaUncertainty();
-		    if(esigma<0.00001) esigma=0.0001;
-		    epos=fitter->GetMeanUncertainty();
-		    if(epos<0.00001) epos=0.0001;
-		    ry=fitter->GetRawYield();
-		    ery=fitter->GetRawYieldError();
-		    fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
-		    Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
-		    Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
-		    fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
-		    if(out && fDrawIndividualFits && thePad){
-		      thePad->Clear();
-		      fitter->DrawHere(thePad, fnSigmaForBkgEval);
-		      fMassFitters.push_back(fitter);
-		      mustDeleteFitter = kFALSE;
-		      for (auto format : fInvMassFitSaveAsFormats) {
-			thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
-		      }
-		    }
-		  }
-		  xnt[8]=chisq;
-		  if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
-		    xnt[9]=significance;
-		    xnt[10]=pos;
-		    xnt[11]=epos;
-		    xnt[12]=sigma;
-		    xnt[13]=esigma;
-		    xnt[14]=ry;
-		    xnt[15]=ery;
-		    fHistoRawYieldDistAll->Fill(ry);
-		    fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
-		    fHistoRawYieldTrialAll->SetBinError(globBin,ery);
-		    fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
-		    fHistoSigmaTrialAll->SetBinError(globBin,esigma);
-		    fHistoMeanTrialAll->SetBinContent(globBin,pos);
-		    fHistoMeanTrialAll->SetBinError(globBin,epos);
-		    fHistoChi2TrialAll->SetBinContent(globBin,chisq);
-		    fHistoChi2TrialAll->SetBinError(globBin,0.00001);
-		    fHistoSignifTrialAll->SetBinContent(globBin,significance);
-		    fHistoSignifTrialAll->SetBinError(globBin,erSignif);
-		    if(fSaveBkgVal) {
-		      fHistoBkgTrialAll->SetBinContent(globBin,bkg);
-		      fHistoBkgTrialAll->SetBinError(globBin,erbkg);
-		      fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
-		      fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
-		    }
-		    
-		    if(ry<fMinYieldGlob) fMinYieldGlob=ry;
-		    if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
-		    fHistoRawYieldDist[theCase]->Fill(ry);
-		    fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
-		    fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
-		    fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
-		    fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
-		    fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
-		    fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
-		    fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
-		    fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
-		    fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
-		    fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
-		    if(fSaveBkgVal) {
-		      fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
-		      fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
-		      fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
-		      fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
-		    }
-		    fNtupleMultiTrials->Fill(xnt);
-		    if(types==0){
-		      // bin counting done only for 1 case of signal line shape
-		      for(Int_t j=0; j<9; j++) xntBC[j]=xnt[j];
-		      
-		      
-		      for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
-			Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
-			Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
-			if(minMassBC>minMassForFit &&
-			   maxMassBC<maxMassForFit &&
-			   minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
-			   maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
-			  Double_t cnts0,ecnts0;
-			  Double_t cnts1,ecnts1;
-			  cnts0=fitter->GetRawYieldBinCounting(ecnts0,fnSigmaBinCSteps[iStepBC],0,0);
-			  cnts1=fitter->GetRawYieldBinCounting(ecnts1,fnSigmaBinCSteps[iStepBC],1,0);
-			  xntBC[9]=fnSigmaBinCSteps[iStepBC];
-			  xntBC[10]=cnts0;
-			  xntBC[11]=ecnts0;
-			  xntBC[12]=cnts1;
-			  xntBC[13]=ecnts1;
-			  ++itrialBC;
-			  fHistoRawYieldDistBinC0All->Fill(cnts0);
-			  fHistoRawYieldTrialBinC0All->SetBinContent(globBin,iStepBC+1,cnts0);
-			  fHistoRawYieldTrialBinC0All->SetBinError(globBin,iStepBC+1,ecnts0);
-			  fHistoRawYieldTrialBinC0[theCase]->SetBinContent(itrial,iStepBC+1,cnts0);
-			  fHistoRawYieldTrialBinC0[theCase]->SetBinError(itrial,iStepBC+1,ecnts0);
-			  fHistoRawYieldDistBinC0[theCase]->Fill(cnts0);
-			  fHistoRawYieldDistBinC1All->Fill(cnts1);
-			  fHistoRawYieldTrialBinC1All->SetBinContent(globBin,iStepBC+1,cnts1);
-			  fHistoRawYieldTrialBinC1All->SetBinError(globBin,iStepBC+1,ecnts1);
-			  fHistoRawYieldTrialBinC1[theCase]->SetBinContent(itrial,iStepBC+1,cnts1);
-			  fHistoRawYieldTrialBinC1[theCase]->SetBinError(itrial,iStepBC+1,ecnts1);
-			  fHistoRawYieldDistBinC1[theCase]->Fill(cnts1);
-			  fNtupleBinCount->Fill(xntBC);
-			}
-		      }
-		    }
-		  }
-		  if (mustDeleteFitter) delete fitter;
+		  if(!IsTrialEnabled(typeb,types,igs,igm)) continue;
+		  TrialConfig conf;
+		  conf.fRebinIndex=rebinnedHistos.size()-1;
+		  conf.fRebin=rebin;
+		  conf.fFirstBin=iFirstBin;
+		  conf.fMinMassStep=iMinMass;
+		  conf.fMaxMassStep=iMaxMass;
+		  conf.fBkgFunc=typeb;
+		  conf.fSigFunc=types;
+		  conf.fSigmaCase=igs;
+		  conf.fMeanCase=igm;
+		  conf.fTrial=itrial;
+		  trials.push_back(conf);
 		}
 	      }
 	    }
 	  }
 	}
       }
-      delete hRebinned;
     }
   }
+
+  // fit results, one row of nRes values per trial
+  const Int_t nTrials=trials.size();
+  const Int_t nRes=kNResFit+kNResBinC*fNumOfnSigmaBinCSteps;
+  std::vector<Double_t> results(nTrials*nRes,0.);
+  std::vector<AliHFInvMassFitter*> keptFitters(nTrials,0x0);
+  Bool_t keepFitters=(fDrawIndividualFits && thePad);
+
+  Int_t nWorkers=fNumOfWorkers;
+  if(nWorkers>1 && keepFitters){
+    printf("AliHFInvMassMultiTrialFit: individual fits are drawn, fits will be done serially\n");
+    nWorkers=1;
+  }
+#ifndef HF_MULTITRIAL_PROCESSEXECUTOR
+  if(nWorkers>1){
+    printf("AliHFInvMassMultiTrialFit: parallel fits not supported with this ROOT version, fits will be done serially\n");
+    nWorkers=1;
+  }
+#endif
+
+  if(nWorkers>1 && nTrials>1){
+#ifdef HF_MULTITRIAL_PROCESSEXECUTOR
+    // the fitters rely on TMinuit and on functions registered by name in gROOT,
+    // hence the trials are fitted in forked processes rather than in threads
+    // each worker result carries the index of its trial in the last element: the results
+    // are not returned in the order of the trials, and trials of a crashed worker are missing
+    ROOT::TProcessExecutor pool(TMath::Min(nWorkers,nTrials));
+    auto fitOneTrial=[&](Int_t iTrial){
+      TVectorD* res=new TVectorD(nRes+1);
+      const TrialConfig& conf=trials[iTrial];
+      FitTrial(conf,hInvMassHisto,rebinnedHistos[conf.fRebinIndex],res->GetMatrixArray(),0x0);
+      (*res)[nRes]=iTrial;
+      return res;
+    };
+    std::vector<TVectorD*> workerResults=pool.Map(fitOneTrial,ROOT::TSeqI(nTrials));
+    std::vector<Bool_t> fitted(nTrials,kFALSE);
+    for(UInt_t iRes=0; iRes<workerResults.size(); iRes++){
+      TVectorD* res=workerResults[iRes];
+      if(res && res->GetNrows()==nRes+1){
+	Int_t iTrial=TMath::Nint((*res)[nRes]);
+	if(iTrial>=0 && iTrial<nTrials && !fitted[iTrial]){
+	  std::copy(res->GetMatrixArray(),res->GetMatrixArray()+nRes,results.begin()+iTrial*nRes);
+	  fitted[iTrial]=kTRUE;
+	}
+      }
+      delete res;
+    }
+    Int_t nMissing=std::count(fitted.begin(),fitted.end(),kFALSE);
+    if(nMissing>0){
+      printf("AliHFInvMassMultiTrialFit: %d of %d trials not returned by the workers, fitting them serially\n",nMissing,nTrials);
+      for(Int_t iTrial=0; iTrial<nTrials; iTrial++){
+	if(fitted[iTrial]) continue;
+	const TrialConfig& conf=trials[iTrial];
+	FitTrial(conf,hInvMassHisto,rebinnedHistos[conf.fRebinIndex],&results[iTrial*nRes],0x0);
+      }
+    }
+#endif
+  }else{
+    for(Int_t iTrial=0; iTrial<nTrials; iTrial++){
+      const TrialConfig& conf=trials[iTrial];
+      FitTrial(conf,hInvMassHisto,rebinnedHistos[conf.fRebinIndex],&results[iTrial*nRes],
+	       keepFitters ? &keptFitters[iTrial] : 0x0);
+    }
+  }
+
+  fMinYieldGlob=999999.;
+  fMaxYieldGlob=0.;
+  Int_t itrialBC=0;
+  Float_t xnt[16];
+  Float_t xntBC[14];
+
+  for(Int_t iTrial=0; iTrial<nTrials; iTrial++){
+    const TrialConfig& conf=trials[iTrial];
+    const Double_t* res=&results[iTrial*nRes];
+    Int_t typeb=conf.fBkgFunc;
+    Int_t types=conf.fSigFunc;
+    Int_t igs=conf.fSigmaCase;
+    Int_t igm=conf.fMeanCase;
+    itrial=conf.fTrial;
+    Double_t minMassForFit=fLowLimFitSteps[conf.fMinMassStep];
+    Double_t maxMassForFit=fUpLimFitSteps[conf.fMaxMassStep];
+    Int_t theCase=igm*kNGausSigCases*kNBkgFuncCases*kNSigFuncCases+igs*kNBkgFuncCases*kNSigFuncCases+types*kNBkgFuncCases+typeb;
+    Int_t globBin=itrial+theCase*totTrials;
+    for(Int_t j=0; j<16; j++) xnt[j]=0.;
+    xnt[0]=conf.fRebin;
+    xnt[1]=conf.fFirstBin;
+    xnt[2]=minMassForFit;
+    xnt[3]=maxMassForFit;
+    xnt[4]=typeb;
+    xnt[5]=types;
+    if(igs==kFixSig) xnt[6]=1;
+    else if(igs==kFixSigUp) xnt[6]=2;
+    else if(igs==kFixSigDown) xnt[6]=3;
+    else xnt[6]=0; // igs==kFreeSig
+    if(igm==kFixMean) xnt[7]=1;
+    else if(igm==kFixMeanUp) xnt[7]=2;
+    else if(igm==kFixMeanDown) xnt[7]=3;
+    else xnt[7]=0; // igm==kFreeMean
+
+    AliHFInvMassFitter* fitter=keptFitters[iTrial];
+    if(fitter){
+      thePad->Clear();
+      fitter->DrawHere(thePad, fnSigmaForBkgEval);
+      fMassFitters.push_back(fitter);
+      for (auto format : fInvMassFitSaveAsFormats) {
+	thePad->SaveAs(Form("FitOutput_%s_Trial%d.%s",hInvMassHisto->GetName(),globBin, format.c_str()));
+      }
+    }
+
+    Bool_t out=(res[kResFitOK]>0.5);
+    Double_t chisq=res[kResChi2];
+    Double_t significance=res[kResSignif];
+    Double_t erSignif=res[kResErSignif];
+    Double_t pos=res[kResMean];
+    Double_t epos=res[kResErMean];
+    Double_t sigma=res[kResSigma];
+    Double_t esigma=res[kResErSigma];
+    Double_t ry=res[kResRawYield];
+    Double_t ery=res[kResErRawYield];
+    Double_t bkg=res[kResBkg];
+    Double_t erbkg=res[kResErBkg];
+    Double_t bkgBEdge=res[kResBkgBinEdges];
+    Double_t erbkgBEdge=res[kResErBkgBinEdges];
+    xnt[8]=chisq;
+    if(out && chisq>0. && sigma>0.5*fSigmaGausMC && sigma<2.0*fSigmaGausMC){
+      xnt[9]=significance;
+      xnt[10]=pos;
+      xnt[11]=epos;
+      xnt[12]=sigma;
+      xnt[13]=esigma;
+      xnt[14]=ry;
+      xnt[15]=ery;
+      fHistoRawYieldDistAll->Fill(ry);
+      fHistoRawYieldTrialAll->SetBinContent(globBin,ry);
+      fHistoRawYieldTrialAll->SetBinError(globBin,ery);
+      fHistoSigmaTrialAll->SetBinContent(globBin,sigma);
+      fHistoSigmaTrialAll->SetBinError(globBin,esigma);
+      fHistoMeanTrialAll->SetBinContent(globBin,pos);
+      fHistoMeanTrialAll->SetBinError(globBin,epos);
+      fHistoChi2TrialAll->SetBinContent(globBin,chisq);
+      fHistoChi2TrialAll->SetBinError(globBin,0.00001);
+      fHistoSignifTrialAll->SetBinContent(globBin,significance);
+      fHistoSignifTrialAll->SetBinError(globBin,erSignif);
+      if(fSaveBkgVal) {
+	fHistoBkgTrialAll->SetBinContent(globBin,bkg);
+	fHistoBkgTrialAll->SetBinError(globBin,erbkg);
+	fHistoBkgInBinEdgesTrialAll->SetBinContent(globBin,bkgBEdge);
+	fHistoBkgInBinEdgesTrialAll->SetBinError(globBin,erbkgBEdge);
+      }
+
+      if(ry<fMinYieldGlob) fMinYieldGlob=ry;
+      if(ry>fMaxYieldGlob) fMaxYieldGlob=ry;
+      fHistoRawYieldDist[theCase]->Fill(ry);
+      fHistoRawYieldTrial[theCase]->SetBinContent(itrial,ry);
+      fHistoRawYieldTrial[theCase]->SetBinError(itrial,ery);
+      fHistoSigmaTrial[theCase]->SetBinContent(itrial,sigma);
+      fHistoSigmaTrial[theCase]->SetBinError(itrial,esigma);
+      fHistoMeanTrial[theCase]->SetBinContent(itrial,pos);
+      fHistoMeanTrial[theCase]->SetBinError(itrial,epos);
+      fHistoChi2Trial[theCase]->SetBinContent(itrial,chisq);
+      fHistoChi2Trial[theCase]->SetBinError(itrial,0.00001);
+      fHistoSignifTrial[theCase]->SetBinContent(itrial,significance);
+      fHistoSignifTrial[theCase]->SetBinError(itrial,erSignif);
+      if(fSaveBkgVal) {
+	fHistoBkgTrial[theCase]->SetBinContent(itrial,bkg);
+	fHistoBkgTrial[theCase]->SetBinError(itrial,erbkg);
+	fHistoBkgInBinEdgesTrial[theCase]->SetBinContent(itrial,bkgBEdge);
+	fHistoBkgInBinEdgesTrial[theCase]->SetBinError(itrial,erbkgBEdge);
+      }
+      fNtupleMultiTrials->Fill(xnt);
+      if(types==0){
+	// bin counting done only for 1 case of signal line shape
+	for(Int_t j=0; j<9; j++) xntBC[j]=xnt[j];
+
+	for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+	  const Double_t* resBC=res+kNResFit+kNResBinC*iStepBC;
+	  if(resBC[kResBinCOK]>0.5){
+	    Double_t cnts0=resBC[kResBinC0];
+	    Double_t ecnts0=resBC[kResErBinC0];
+	    Double_t cnts1=resBC[kResBinC1];
+	    Double_t ecnts1=resBC[kResErBinC1];
+	    xntBC[9]=fnSigmaBinCSteps[iStepBC];
+	    xntBC[10]=cnts0;
+	    xntBC[11]=ecnts0;
+	    xntBC[12]=cnts1;
+	    xntBC[13]=ecnts1;
+	    ++itrialBC;
+	    fHistoRawYieldDistBinC0All->Fill(cnts0);
+	    fHistoRawYieldTrialBinC0All->SetBinContent(globBin,iStepBC+1,cnts0);
+	    fHistoRawYieldTrialBinC0All->SetBinError(globBin,iStepBC+1,ecnts0);
+	    fHistoRawYieldTrialBinC0[theCase]->SetBinContent(itrial,iStepBC+1,cnts0);
+	    fHistoRawYieldTrialBinC0[theCase]->SetBinError(itrial,iStepBC+1,ecnts0);
+	    fHistoRawYieldDistBinC0[theCase]->Fill(cnts0);
+	    fHistoRawYieldDistBinC1All->Fill(cnts1);
+	    fHistoRawYieldTrialBinC1All->SetBinContent(globBin,iStepBC+1,cnts1);
+	    fHistoRawYieldTrialBinC1All->SetBinError(globBin,iStepBC+1,ecnts1);
+	    fHistoRawYieldTrialBinC1[theCase]->SetBinContent(itrial,iStepBC+1,cnts1);
+	    fHistoRawYieldTrialBinC1[theCase]->SetBinError(itrial,iStepBC+1,ecnts1);
+	    fHistoRawYieldDistBinC1[theCase]->Fill(cnts1);
+	    fNtupleBinCount->Fill(xntBC);
+	  }
+	}
+      }
+    }
+  }
+  for(auto hRebinned : rebinnedHistos) delete hRebinned;
+  return kTRUE;
+}
+
+//________________________________________________________________________
+Bool_t AliHFInvMassMultiTrialFit::IsTrialEnabled(Int_t typeb, Int_t types, Int_t igs, Int_t igm) const{
+  // check whether the combination of background function, signal line shape
+  // and sigma/mean configuration is switched on
+
+  if(typeb==kExpoBkg && !fUseExpoBkg) return kFALSE;
+  if(typeb==kLinBkg && !fUseLinBkg) return kFALSE;
+  if(typeb==kPol2Bkg && !fUsePol2Bkg) return kFALSE;
+  if(typeb==kPol3Bkg && !fUsePol3Bkg) return kFALSE;
+  if(typeb==kPol4Bkg && !fUsePol4Bkg) return kFALSE;
+  if(typeb==kPol5Bkg && !fUsePol5Bkg) return kFALSE;
+  if(typeb==kPowBkg && !fUsePowLawBkg) return kFALSE;
+  if(typeb==kPowTimesExpoBkg && !fUsePowLawTimesExpoBkg) return kFALSE;
+  if(types==k2Gaus && !fUse2GausSignal) return kFALSE;
+  if(types==k2GausSigmaRatioPar && !fUse2GausSigmaRatioSignal) return kFALSE;
+  if (igs==kFreeSig && !fUseFreeS) return kFALSE;
+  if (igs==kFixSig){
+    if (igm==kFreeMean && !fUseFixSigFreeMean) return kFALSE;
+    if (igm==kFixMean && !fUseFixSigFixMean) return kFALSE;
+    if (igm==kFixMeanUp && !fUseFixSigFixMeanUp) return kFALSE;
+    if (igm==kFixMeanDown && !fUseFixSigFixMeanDown) return kFALSE;
+  }
+  if (igs==kFreeSig){
+    if (igm==kFixMean  && !fUseFixedMeanFreeS) return kFALSE;
+    if (igm==kFixMeanUp && !fUseFreeSigFixMeanUp) return kFALSE;
+    if (igm==kFixMeanDown && !fUseFreeSigFixMeanDown) return kFALSE;
+  }
+  if (igs==kFixSigUp){
+    if (igm==kFreeMean && !fUseFixSigUpFreeMean) return kFALSE;
+    if (igm==kFixMean && !fUseFixSigVarWithFixMean) return kFALSE;
+    if (igm==kFixMeanUp && !fUseFixSigVarWithFixMean) return kFALSE;
+    if (igm==kFixMeanDown && !fUseFixSigVarWithFixMean) return kFALSE;
+  }
+  if (igs==kFixSigDown){
+    if (igm==kFreeMean && !fUseFixSigDownFreeMean) return kFALSE;
+    if (igm==kFixMean && !fUseFixSigVarWithFixMean) return kFALSE;
+    if (igm==kFixMeanUp && !fUseFixSigVarWithFixMean) return kFALSE;
+    if (igm==kFixMeanDown && !fUseFixSigVarWithFixMean) return kFALSE;
+  }
   return kTRUE;
 }
 
+//________________________________________________________________________
+void AliHFInvMassMultiTrialFit::FitTrial(const TrialConfig& conf, const TH1D* hInvMassHisto, TH1F* hRebinned,
+					 Double_t* result, AliHFInvMassFitter** keptFitter) const{
+  // fit of a single trial, the results are stored in result (kNResFit values
+  // followed by kNResBinC values per bin counting step). If keptFitter is
+  // given, the fitter of a successful fit is handed over to the caller instead
+  // of being deleted
+
+  Int_t typeb=conf.fBkgFunc;
+  Int_t types=conf.fSigFunc;
+  Int_t igs=conf.fSigmaCase;
+  Int_t igm=conf.fMeanCase;
+  Double_t minMassForFit=fLowLimFitSteps[conf.fMinMassStep];
+  Double_t maxMassForFit=fUpLimFitSteps[conf.fMaxMassStep];
+  Double_t hmin=TMath::Max(minMassForFit,hRebinned->GetBinLowEdge(2));
+  Double_t hmax=TMath::Min(maxMassForFit,hRebinned->GetBinLowEdge(hRebinned->GetNbinsX()));
+  const Int_t nRes=kNResFit+kNResBinC*fNumOfnSigmaBinCSteps;
+  for(Int_t j=0; j<nRes; j++) result[j]=0.;
+  result[kResChi2]=-1.;
+
+  AliHFInvMassFitter*  fitter=0x0;
+  if(typeb==kExpoBkg){
+    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kExpo, types);
+  }else if(typeb==kLinBkg){
+    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kLin, types);
+  }else if(typeb==kPol2Bkg){
+    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kPol2, types);
+  }else if(typeb==kPowBkg){
+    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kPow, types);
+  }else if(typeb==kPowTimesExpoBkg){
+    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, AliHFInvMassFitter::kPowEx, types);
+  }else{
+    fitter=new AliHFInvMassFitter(hRebinned, hmin, hmax, 6, types);
+    if(typeb==kPol3Bkg) fitter->SetPolDegreeForBackgroundFit(3);
+    if(typeb==kPol4Bkg) fitter->SetPolDegreeForBackgroundFit(4);
+    if(typeb==kPol5Bkg) fitter->SetPolDegreeForBackgroundFit(5);
+  }
+  if(types==k2Gaus){
+    if(fFixSecondGausSig>=0.) fitter->SetFixSecondGaussianSigma(fFixSecondGausSig);
+    if(fFixSecondGausFrac>=0.) fitter->SetFixFrac2Gaus(fFixSecondGausFrac);
+  }else if(types==k2GausSigmaRatioPar){
+    if(fFixSecondGausSigRat>=0.) fitter->SetFixRatio2GausSigma(fFixSecondGausSigRat);
+    if(fFixSecondGausFrac>=0.) fitter->SetFixFrac2Gaus(fFixSecondGausFrac);
+  }
+  // D0 Reflection
+  if(fhTemplRefl && fhTemplSign){
+    TH1F *hReflModif=(TH1F*)AliVertexingHFUtils::AdaptTemplateRangeAndBinning(fhTemplRefl,hRebinned,minMassForFit,maxMassForFit);
+    TH1F *hSigModif=(TH1F*)AliVertexingHFUtils::AdaptTemplateRangeAndBinning(fhTemplSign,hRebinned,minMassForFit,maxMassForFit);
+    TH1F* hrfl=fitter->SetTemplateReflections(hReflModif,"2gaus",minMassForFit,maxMassForFit);
+    if(!hrfl) printf("ERROR in SetTemplateReflections\n");
+    if(fFixRefloS>0){
+      Double_t fixSoverRefAt=fFixRefloS*(hReflModif->Integral(hReflModif->FindBin(minMassForFit*1.0001),hReflModif->FindBin(maxMassForFit*0.999))/hSigModif->Integral(hSigModif->FindBin(minMassForFit*1.0001),hSigModif->FindBin(maxMassForFit*0.999)));
+      fitter->SetFixReflOverS(fixSoverRefAt);
+    }
+    delete hReflModif;
+    delete hSigModif;
+  }
+  if(fUseSecondPeak){
+    fitter->IncludeSecondGausPeak(fMassSecondPeak, fFixMassSecondPeak, fSigmaSecondPeak, fFixSigmaSecondPeak);
+  }
+  if(fFitOption==1) fitter->SetUseChi2Fit();
+  fitter->SetInitialGaussianMean(fMassD);
+  fitter->SetInitialGaussianSigma(fSigmaGausMC);
+  if(igs==kFixSig){
+    fitter->SetFixGaussianSigma(fSigmaGausMC);
+  }else if(igs==kFixSigUp){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.+fSigmaMCVariationUp));
+  }else if(igs==kFixSigDown){
+    fitter->SetFixGaussianSigma(fSigmaGausMC*(1.-fSigmaMCVariationDw));
+  }
+  if(igm==kFixMean){
+    fitter->SetFixGaussianMean(fMassD);
+  }else if(igm==kFixMeanUp){
+    fitter->SetFixGaussianMean(fUpperMassToFix);
+  }else if(igm==kFixMeanDown){
+    fitter->SetFixGaussianMean(fLowerMassToFix);
+  }
+
+  printf("****** START FIT OF HISTO %s WITH REBIN %d FIRST BIN %d MASS RANGE %f-%f BACKGROUND FIT FUNCTION=%d CONFIG SIGMA/MEAN=%d %d\n",hInvMassHisto->GetName(),conf.fRebin,conf.fFirstBin,minMassForFit,maxMassForFit,typeb,igs,igm);
+  Bool_t out=fitter->MassFitter(0);
+  Double_t significance=0.;
+  Double_t erSignif=0.;
+  Double_t bkg=0.;
+  Double_t erbkg=0.;
+  Double_t bkgBEdge=0;
+  Double_t erbkgBEdge=0;
+  Double_t chisq=fitter->GetReducedChiSquare();
+  fitter->Significance(fnSigmaForBkgEval,significance,erSignif);
+  Double_t sigma=fitter->GetSigma();
+  Double_t pos=fitter->GetMean();
+  Double_t esigma=fitter->GetSigmaUncertainty();
+  if(esigma<0.00001) esigma=0.0001;
+  Double_t epos=fitter->GetMeanUncertainty();
+  if(epos<0.00001) epos=0.0001;
+  Double_t ry=fitter->GetRawYield();
+  Double_t ery=fitter->GetRawYieldError();
+  fitter->Background(fnSigmaForBkgEval,bkg,erbkg);
+  Double_t minval = hInvMassHisto->GetXaxis()->GetBinLowEdge(hInvMassHisto->FindBin(pos-fnSigmaForBkgEval*sigma));
+  Double_t maxval = hInvMassHisto->GetXaxis()->GetBinUpEdge(hInvMassHisto->FindBin(pos+fnSigmaForBkgEval*sigma));
+  fitter->Background(minval,maxval,bkgBEdge,erbkgBEdge);
+
+  result[kResFitOK]=out ? 1. : 0.;
+  result[kResChi2]=chisq;
+  result[kResSignif]=significance;
+  result[kResErSignif]=erSignif;
+  result[kResMean]=pos;
+  result[kResErMean]=epos;
+  result[kResSigma]=sigma;
+  result[kResErSigma]=esigma;
+  result[kResRawYield]=ry;
+  result[kResErRawYield]=ery;
+  result[kResBkg]=bkg;
+  result[kResErBkg]=erbkg;
+  result[kResBkgBinEdges]=bkgBEdge;
+  result[kResErBkgBinEdges]=erbkgBEdge;
+
+  if(out && types==0){
+    // bin counting done only for 1 case of signal line shape
+    for(Int_t iStepBC=0; iStepBC<fNumOfnSigmaBinCSteps; iStepBC++){
+      Double_t minMassBC=fMassD-fnSigmaBinCSteps[iStepBC]*sigma;
+      Double_t maxMassBC=fMassD+fnSigmaBinCSteps[iStepBC]*sigma;
+      if(minMassBC>minMassForFit &&
+	 maxMassBC<maxMassForFit &&
+	 minMassBC>(hRebinned->GetXaxis()->GetXmin()) &&
+	 maxMassBC<(hRebinned->GetXaxis()->GetXmax())){
+	Double_t* resBC=result+kNResFit+kNResBinC*iStepBC;
+	resBC[kResBinCOK]=1.;
+	resBC[kResBinC0]=fitter->GetRawYieldBinCounting(resBC[kResErBinC0],fnSigmaBinCSteps[iStepBC],0,0);
+	resBC[kResBinC1]=fitter->GetRawYieldBinCounting(resBC[kResErBinC1],fnSigmaBinCSteps[iStepBC],1,0);
+      }
+    }
+  }
+
+  if(out && keptFitter) *keptFitter=fitter;
+  else delete fitter;
+}
+
 //________________________________________________________________________
 void AliHFInvMassMultiTrialFit::SaveToRoot(TString fileName, TString option) const{
   // save histos in a root file for further analysis
@@ -111,6 +111,8 @@ class AliHFInvMassMultiTrialFit : public TNamed {
   void SetSaveBkgValue(Bool_t opt=kTRUE, Double_t nsigma=3) {fSaveBkgVal=opt; fnSigmaForBkgEval=nsigma;}
 
   void SetDrawIndividualFits(Bool_t opt=kTRUE){fDrawIndividualFits=opt;}
+  /// number of worker processes among which the trials are distributed (1 = serial fits)
+  void SetNumberOfWorkers(Int_t nw){fNumOfWorkers=nw;}
 
   Bool_t DoMultiTrials(TH1D* hInvMassHisto, TPad* thePad=0x0);
   void SaveToRoot(TString fileName, TString option="recreate") const;
@@ -136,7 +138,24 @@ class AliHFInvMassMultiTrialFit : public TNamed {
 
  private:
 
+  /// configuration of a single trial, see DoMultiTrials
+  struct TrialConfig {
+    Int_t fRebinIndex;   /// index of the rebinned histogram
+    Int_t fRebin;        /// rebin factor
+    Int_t fFirstBin;     /// first bin for rebin
+    Int_t fMinMassStep;  /// index of the low limit for fit
+    Int_t fMaxMassStep;  /// index of the up limit for fit
+    Int_t fBkgFunc;      /// background function (EBkgFuncCases)
+    Int_t fSigFunc;      /// signal line shape (ESigFuncCases)
+    Int_t fSigmaCase;    /// sigma configuration (EGausSigCases)
+    Int_t fMeanCase;     /// mean configuration (EGausMeanCases)
+    Int_t fTrial;        /// trial number (rebin and fit range), starting from 1
+  };
+
   Bool_t CreateHistos();
+  Bool_t IsTrialEnabled(Int_t typeb, Int_t types, Int_t igs, Int_t igm) const;
+  void FitTrial(const TrialConfig& conf, const TH1D* hInvMassHisto, TH1F* hRebinned,
+		Double_t* result, AliHFInvMassFitter** keptFitter) const;
   Bool_t DoFitWithPol3Bkg(TH1F* histoToFit, Double_t  hmin, Double_t  hmax,
 			  Int_t theCase);
 
@@ -197,6 +216,7 @@ class AliHFInvMassMultiTrialFit : public TNamed {
   Bool_t fSaveBkgVal;		/// switch for saving bkg values in nsigma
 
   Bool_t fDrawIndividualFits; /// flag for drawing fits
+  Int_t fNumOfWorkers;        /// number of worker processes for the fits
 
   TH1F* fHistoRawYieldDistAll;  /// histo with yield from all trials
   TH1F* fHistoRawYieldTrialAll; /// histo with yield from all trials
@@ -238,7 +258,7 @@ class AliHFInvMassMultiTrialFit : public TNamed {
   std::vector<AliHFInvMassFitter*> fMassFitters; //!<! Mass fitters
 
   /// \cond CLASSIMP
-  ClassDef(AliHFInvMassMultiTrialFit,7); /// class for multiple trials of invariant mass fit
+  ClassDef(AliHFInvMassMultiTrialFit,8); /// class for multiple trials of invariant mass fit
   /// \endcond
 };
 
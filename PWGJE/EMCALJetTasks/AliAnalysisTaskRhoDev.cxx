@@ -26,6 +26,8 @@
  ************************************************************************************/
 #include "AliAnalysisTaskRhoDev.h"
 
+#include <algorithm>
+
 #include <TClonesArray.h>
 #include <TMath.h>
 
@@ -44,8 +46,15 @@ AliAnalysisTaskRhoDev::AliAnalysisTaskRhoDev() :
   fNExclLeadJets(0),
   fRhoSparse(kFALSE),
   fExclJetOverlap(),
+  fExportRhoSparse(kFALSE),
+  fExportRhoMass(kFALSE),
   fOccupancyFactor(0),
-  fHistOccCorrvsCent(nullptr)
+  fHistOccCorrvsCent(nullptr),
+  fOutRhoSparse(nullptr),
+  fOutRhoMass(nullptr),
+  fOutRhoMassScaled(nullptr),
+  fRhoValues(),
+  fRhoMassValues()
 {
 }
 
@@ -54,8 +63,15 @@ AliAnalysisTaskRhoDev::AliAnalysisTaskRhoDev(const char *name, Bool_t histo) :
   fNExclLeadJets(0),
   fRhoSparse(kFALSE),
   fExclJetOverlap(),
+  fExportRhoSparse(kFALSE),
+  fExportRhoMass(kFALSE),
   fOccupancyFactor(0),
-  fHistOccCorrvsCent(nullptr)
+  fHistOccCorrvsCent(nullptr),
+  fOutRhoSparse(nullptr),
+  fOutRhoMass(nullptr),
+  fOutRhoMassScaled(nullptr),
+  fRhoValues(),
+  fRhoMassValues()
 {
 }
 
@@ -69,12 +85,39 @@ void AliAnalysisTaskRhoDev::UserCreateOutputObjects()
   fOutput->Add(fHistOccCorrvsCent);
 }
 
+AliRhoParameter* AliAnalysisTaskRhoDev::CreateRhoParameter(const char* name)
+{
+  AliRhoParameter* rho = new AliRhoParameter(name, 0);
+
+  if (fAttachToEvent) {
+    if (!(InputEvent()->FindListObject(name))) {
+      InputEvent()->AddObject(rho);
+    } else {
+      AliFatal(Form("%s: Container with same name %s already present. Aborting", GetName(), name));
+    }
+  }
+
+  return rho;
+}
+
+void AliAnalysisTaskRhoDev::ExecOnce()
+{
+  if (fExportRhoSparse && !fOutRhoSparse) fOutRhoSparse = CreateRhoParameter(GetOutRhoSparseName());
+  if (fExportRhoMass) {
+    if (!fOutRhoMass) fOutRhoMass = CreateRhoParameter(GetOutRhoMassName());
+    if (fScaleFunction && !fOutRhoMassScaled) fOutRhoMassScaled = CreateRhoParameter(GetOutRhoMassScaledName());
+  }
+
+  AliAnalysisTaskRhoBaseDev::ExecOnce();
+}
+
 std::pair<AliEmcalJet*, AliEmcalJet*> AliAnalysisTaskRhoDev::GetLeadingJets()
 {
   std::pair<AliEmcalJet*, AliEmcalJet*> maxJets = {nullptr, nullptr};
   if (fNExclLeadJets <= 0) return maxJets;
 
   auto itJet = fSortedJets["Background"].begin();
+  if (itJet == fSortedJets["Background"].end()) return maxJets;
 
   maxJets.first = *itJet;
   if (fNExclLeadJets > 1) {
@@ -85,14 +128,41 @@ std::pair<AliEmcalJet*, AliEmcalJet*> AliAnalysisTaskRhoDev::GetLeadingJets()
   return maxJets;
 }
 
+Double_t AliAnalysisTaskRhoDev::GetMedian(std::vector<Double_t>& values, UInt_t n)
+{
+  if (n == 0) return 0;
+
+  // same definition as TMath::Median: average of the two central values for even n
+  auto itMid = values.begin() + n / 2;
+  std::nth_element(values.begin(), itMid, values.begin() + n);
+  Double_t median = *itMid;
+  if (n % 2 == 0) median = 0.5 * (*std::max_element(values.begin(), itMid) + median);
+
+  return median;
+}
+
+Double_t AliAnalysisTaskRhoDev::GetMd(AliEmcalJet* jet) const
+{
+  Double_t sum = 0;
+  for (Int_t i = 0; i < jet->GetNumberOfTracks(); i++) {
+    AliVParticle* part = jet->Track(i);
+    if (!part) continue;
+    sum += TMath::Sqrt(part->M() * part->M() + part->Pt() * part->Pt()) - part->Pt();
+  }
+  return sum;
+}
+
 void AliAnalysisTaskRhoDev::CalculateRho()
 {
+  if (fOutRhoSparse) fOutRhoSparse->SetVal(0);
+  if (fOutRhoMass) fOutRhoMass->SetVal(0);
+  if (fOutRhoMassScaled) fOutRhoMassScaled->SetVal(0);
+
   if (fJetCollArray.empty()) return;
 
   auto maxJets = GetLeadingJets();
 
-  static Double_t rhovec[999];
-  Int_t NjetAcc = 0;
+  UInt_t NjetAcc = 0;
   Double_t TotaljetArea = 0; // Total area of background jets (including ghost jets)
   Double_t TotaljetAreaPhys = 0; // Total area of physical background jets (excluding ghost jets)
   // Ghost jet is a jet made only of ghost particles
@@ -104,7 +174,11 @@ void AliAnalysisTaskRhoDev::CalculateRho()
     if (sigJetContIt != fJetCollArray.end()) sigJetCont = sigJetContIt->second;
   }
 
-  // push all jets within selected acceptance into stack
+  const UInt_t nBkgJets = bkgJetCont->GetNJets();
+  if (fRhoValues.size() < nBkgJets) fRhoValues.resize(nBkgJets);
+  if (fOutRhoMass && fRhoMassValues.size() < nBkgJets) fRhoMassValues.resize(nBkgJets);
+
+  // push all jets within selected acceptance into the buffers
   for (auto jet : bkgJetCont->accepted()) {
 
     TotaljetArea += jet->Area();
@@ -128,7 +202,8 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
     if (overlapsWithSignal) continue;
 
-    rhovec[NjetAcc] = jet->Pt() / jet->Area();
+    fRhoValues[NjetAcc] = jet->Pt() / jet->Area();
+    if (fOutRhoMass) fRhoMassValues[NjetAcc] = GetMd(jet) / jet->Area();
     ++NjetAcc;
   }
 
@@ -142,11 +217,19 @@ void AliAnalysisTaskRhoDev::CalculateRho()
 
   if (NjetAcc > 0) {
     //find median value
-    Double_t rho = TMath::Median(NjetAcc, rhovec);
+    Double_t rho = GetMedian(fRhoValues, NjetAcc);
+
+    if (fOutRhoSparse) fOutRhoSparse->SetVal(rho * fOccupancyFactor);
 
     if (fRhoSparse) rho = rho * fOccupancyFactor;
 
     fOutRho->SetVal(rho);
+
+    if (fOutRhoMass) {
+      Double_t rhom = GetMedian(fRhoMassValues, NjetAcc);
+      fOutRhoMass->SetVal(rhom);
+      if (fOutRhoMassScaled) fOutRhoMassScaled->SetVal(rhom * GetScaleFactor(fCent));
+    }
   }
 }
 
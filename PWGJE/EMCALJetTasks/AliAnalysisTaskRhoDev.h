@@ -28,6 +28,7 @@
 #define ALIANALYSISTASKRHODEV_H
 
 #include <utility>
+#include <vector>
 
 #include "AliAnalysisTaskRhoBaseDev.h"
 
@@ -78,6 +79,12 @@ public:
   void             SetExcludeLeadJets(UInt_t n)    { fNExclLeadJets = n    ; }
   void             SetRhoSparse(Bool_t b)          { fRhoSparse     = b    ; }
   void             SetExclJetOverlap(TString n)    { fExclJetOverlap= n    ; }
+  void             SetExportRhoSparse(Bool_t b)    { fExportRhoSparse = b  ; }
+  void             SetExportRhoMass(Bool_t b)      { fExportRhoMass = b    ; }
+
+  const char*      GetOutRhoSparseName() const     { return Form("%s_Sparse", fOutRhoName.Data())     ; }
+  const char*      GetOutRhoMassName() const       { return Form("%s_Mass", fOutRhoName.Data())       ; }
+  const char*      GetOutRhoMassScaledName() const { return Form("%s_Mass_Scaled", fOutRhoName.Data()); }
 
   /**
    * @brief Create an instance of this class and add it to the analysis manager
@@ -109,13 +116,47 @@ public:
   );
 
  protected:
+  /**
+   * Init the analysis: create the additional rho objects
+   * (sparse, mass) and attach them to the event.
+   */
+  void          ExecOnce();
+
   /**
    * Calculates the average background using the median approach
    * as proposed in https://arxiv.org/pdf/0707.1378.pdf.
-   * Rho is stored in fOutRho.
+   * Rho is stored in fOutRho. The occupancy corrected rho and rho_m
+   * are obtained from the same loop over the background jets and
+   * stored in fOutRhoSparse and fOutRhoMass (if enabled).
    */
   void          CalculateRho();
 
+  /**
+   * Median of the first n values, equivalent to TMath::Median.
+   * The values are partially reordered (std::nth_element) instead of sorted.
+   * @param values Values (reordered in place)
+   * @param n Number of values to be used
+   * @return Median of the values
+   */
+  static Double_t
+                GetMedian(std::vector<Double_t>& values, UInt_t n);
+
+  /**
+   * Sum of sqrt(m^2 + pt^2) - pt over the track constituents of a jet,
+   * as AliAnalysisTaskRhoMass with the kMd option (massless clusters).
+   * @param jet Pointer to the jet
+   * @return m_delta of the jet
+   */
+  Double_t      GetMd(AliEmcalJet* jet) const;
+
+  /**
+   * Create a rho object and attach it to the event (if requested).
+   * @param name Name of the rho object
+   * @return Pointer to the new rho object
+   */
+  AliRhoParameter*
+                CreateRhoParameter(const char* name);
+
   /**
    * Fill histograms.
    */
@@ -137,13 +178,21 @@ public:
   UInt_t           fNExclLeadJets;                 ///< number of leading jets to be excluded from the median calculation
   Bool_t           fRhoSparse;                     ///< flag to run CMS method as described in https://arxiv.org/abs/1207.2392
   TString          fExclJetOverlap;                ///< name of the jet collection that should be used to reject jets that are considered "signal"
+  Bool_t           fExportRhoSparse;               ///< also export the occupancy corrected rho as "<rho name>_Sparse"
+  Bool_t           fExportRhoMass;                 ///< also export rho_m as "<rho name>_Mass" (and "<rho name>_Mass_Scaled" if a scale function is given)
 
   Double_t         fOccupancyFactor;               //!<!occupancy correction factor for sparse events
   TH2F            *fHistOccCorrvsCent;             //!<!occupancy correction vs. centrality
 
+  AliRhoParameter *fOutRhoSparse;                  //!<!output occupancy corrected rho object
+  AliRhoParameter *fOutRhoMass;                    //!<!output rho_m object
+  AliRhoParameter *fOutRhoMassScaled;              //!<!output scaled rho_m object
+  std::vector<Double_t> fRhoValues;                //!<!pt/area of the background jets (median input)
+  std::vector<Double_t> fRhoMassValues;            //!<!m_delta/area of the background jets (median input)
+
   AliAnalysisTaskRhoDev(const AliAnalysisTaskRhoDev&);             // not implemented
   AliAnalysisTaskRhoDev& operator=(const AliAnalysisTaskRhoDev&);  // not implemented
   
-  ClassDef(AliAnalysisTaskRhoDev, 2);
+  ClassDef(AliAnalysisTaskRhoDev, 3);
 };
 #endif
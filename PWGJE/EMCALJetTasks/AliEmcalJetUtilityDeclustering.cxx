@@ -0,0 +1,139 @@
+#include "AliEmcalJetUtilityDeclustering.h"
+#include "AliEmcalJet.h"
+#include "AliEmcalJetDeclustering.h"
+
+ClassImp(AliEmcalJetUtilityDeclustering)
+
+//______________________________________________________________________________
+AliEmcalJetUtilityDeclustering::AliEmcalJetUtilityDeclustering() :
+  AliEmcalJetUtility(),
+  fReclusteringRadius(0.4),
+  fRecombinationScheme(0),
+  fTrackConstituentsOnly(kFALSE)
+{
+  // Dummy constructor.
+
+}
+
+//______________________________________________________________________________
+AliEmcalJetUtilityDeclustering::AliEmcalJetUtilityDeclustering(const char* name) :
+  AliEmcalJetUtility(name),
+  fReclusteringRadius(0.4),
+  fRecombinationScheme(0),
+  fTrackConstituentsOnly(kFALSE)
+{
+  // Default constructor.
+}
+
+//______________________________________________________________________________
+AliEmcalJetUtilityDeclustering::AliEmcalJetUtilityDeclustering(const AliEmcalJetUtilityDeclustering &other) :
+  AliEmcalJetUtility(other),
+  fReclusteringRadius(other.fReclusteringRadius),
+  fRecombinationScheme(other.fRecombinationScheme),
+  fTrackConstituentsOnly(other.fTrackConstituentsOnly)
+{
+  // Copy constructor.
+}
+
+//______________________________________________________________________________
+AliEmcalJetUtilityDeclustering& AliEmcalJetUtilityDeclustering::operator=(const AliEmcalJetUtilityDeclustering &other)
+{
+  // Assignment.
+
+  if (&other == this) return *this;
+  AliEmcalJetUtility::operator=(other);
+  fReclusteringRadius = other.fReclusteringRadius;
+  fRecombinationScheme = other.fRecombinationScheme;
+  fTrackConstituentsOnly = other.fTrackConstituentsOnly;
+  return *this;
+}
+
+//______________________________________________________________________________
+void AliEmcalJetUtilityDeclustering::Init()
+{
+  // Initialize the utility.
+
+  if (fReclusteringRadius <= 0) {
+    AliError(Form("%s: Invalid reclustering radius %f! Returning", GetName(), fReclusteringRadius));
+    return;
+  }
+
+  fInit = kTRUE;
+}
+
+//______________________________________________________________________________
+void AliEmcalJetUtilityDeclustering::InitEvent(AliFJWrapper& /*fjw*/)
+{
+  // Prepare the utility.
+
+}
+
+//______________________________________________________________________________
+void AliEmcalJetUtilityDeclustering::Prepare(AliFJWrapper& /*fjw*/)
+{
+  // Prepare the utility.
+
+}
+
+//______________________________________________________________________________
+void AliEmcalJetUtilityDeclustering::ProcessJet(AliEmcalJet* jet, Int_t ij, AliFJWrapper& fjw)
+{
+  // Process each jet.
+  if (!fInit) return;
+
+  #ifdef FASTJET_VERSION
+
+  AliEmcalJetDeclustering &declustering = jet->GetShapeProperties()->GetDeclustering();
+  declustering.Reset(fReclusteringRadius, fRecombinationScheme, fTrackConstituentsOnly);
+
+  std::vector<fastjet::PseudoJet> constituents;
+  std::vector<fastjet::PseudoJet> jetConstituents = fjw.GetJetConstituents(ij);
+  constituents.reserve(jetConstituents.size());
+  for (std::vector<fastjet::PseudoJet>::const_iterator it = jetConstituents.begin(); it != jetConstituents.end(); ++it) {
+    Int_t uid = it->user_index();
+    if (uid == -1) continue; // ghost
+    if (fTrackConstituentsOnly && uid < 0) continue; // cluster
+    constituents.push_back(*it);
+  }
+  if (constituents.empty()) return;
+
+  fastjet::JetDefinition jetDef(fastjet::cambridge_algorithm, fReclusteringRadius, static_cast<fastjet::RecombinationScheme>(fRecombinationScheme));
+  try {
+    fastjet::ClusterSequence cs(constituents, jetDef);
+    std::vector<fastjet::PseudoJet> reclustered = fastjet::sorted_by_pt(cs.inclusive_jets());
+    if (!reclustered.empty()) FillDeclustering(reclustered[0], declustering);
+  } catch (const fastjet::Error &) {
+    AliError(Form("%s: Reclustering of jet %d failed", GetName(), ij));
+    declustering.Reset();
+    return;
+  }
+  declustering.BuildPrimarySequence();
+
+  #endif
+}
+
+#ifdef FASTJET_VERSION
+//______________________________________________________________________________
+Int_t AliEmcalJetUtilityDeclustering::FillDeclustering(const fastjet::PseudoJet &parent, AliEmcalJetDeclustering &declustering) const
+{
+  // Add the splitting of the parent and, recursively, of its branches to the
+  // declustering tree. Returns the index of the splitting, -1 for a single constituent.
+
+  fastjet::PseudoJet j1, j2;
+  if (!parent.has_parents(j1, j2)) return -1;
+  if (j1.perp() < j2.perp()) std::swap(j1, j2);
+
+  Int_t splitting = declustering.AddSplitting(parent.perp(), parent.m(), j1.perp(), j2.perp(), j1.delta_R(j2));
+  Int_t harder = FillDeclustering(j1, declustering);
+  Int_t softer = FillDeclustering(j2, declustering);
+  declustering.SetBranches(splitting, harder, softer);
+  return splitting;
+}
+#endif
+
+//______________________________________________________________________________
+void AliEmcalJetUtilityDeclustering::Terminate(AliFJWrapper& /*fjw*/)
+{
+  // Run termination of the utility (after each event).
+
+}
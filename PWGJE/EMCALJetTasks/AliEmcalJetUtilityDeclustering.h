@@ -0,0 +1,57 @@
+#ifndef ALIEMCALJETUTILITYDECLUSTERING_H
+#define ALIEMCALJETUTILITYDECLUSTERING_H
+
+#include <TNamed.h>
+
+#include "AliEmcalJetUtility.h"
+#include "AliFJWrapper.h"
+
+class AliEmcalJetTask;
+class AliEmcalJet;
+class AliEmcalJetDeclustering;
+class AliFJWrapper;
+
+/**
+ * @class AliEmcalJetUtilityDeclustering
+ * @brief Jet utility filling the Cambridge/Aachen declustering history of each jet
+ *
+ * The constituents of each jet are reclustered once with the Cambridge/Aachen
+ * algorithm and the full declustering tree is stored in the jet shape properties
+ * (see AliEmcalJetDeclustering), from which substructure tasks can obtain the
+ * primary and secondary splittings without reclustering the jet themselves.
+ * Ghosts are always excluded from the reclustering; optionally also cluster
+ * constituents can be excluded (charged-particle substructure on full jets).
+ */
+class AliEmcalJetUtilityDeclustering : public AliEmcalJetUtility
+{
+ public:
+
+  AliEmcalJetUtilityDeclustering();
+  AliEmcalJetUtilityDeclustering(const char* name);
+  AliEmcalJetUtilityDeclustering(const AliEmcalJetUtilityDeclustering &jet);
+  AliEmcalJetUtilityDeclustering& operator=(const AliEmcalJetUtilityDeclustering &jet);
+  ~AliEmcalJetUtilityDeclustering() {;}
+
+  void                   SetReclusteringRadius(Double_t r)          { fReclusteringRadius  = r     ; }
+  void                   SetRecombinationScheme(Int_t s)            { fRecombinationScheme = s     ; }
+  void                   SetUseTrackConstituentsOnly(Bool_t b)      { fTrackConstituentsOnly = b   ; }
+
+  void Init();
+  void InitEvent(AliFJWrapper& fjw);
+  void Prepare(AliFJWrapper& fjw);
+  void ProcessJet(AliEmcalJet* jet, Int_t ij, AliFJWrapper& fjw);
+  void Terminate(AliFJWrapper& fjw);
+
+ protected:
+
+#ifdef FASTJET_VERSION
+  Int_t                  FillDeclustering(const fastjet::PseudoJet &parent, AliEmcalJetDeclustering &declustering) const;
+#endif
+
+  Double_t               fReclusteringRadius;                 ///< radius of the Cambridge/Aachen reclustering (default 0.4)
+  Int_t                  fRecombinationScheme;                ///< recombination scheme of the reclustering (fastjet::RecombinationScheme)
+  Bool_t                 fTrackConstituentsOnly;              ///< only use track constituents in the reclustering
+
+  ClassDef(AliEmcalJetUtilityDeclustering, 1) // Emcal jet utility that fills the Cambridge/Aachen declustering history of each jet
+};
+#endif
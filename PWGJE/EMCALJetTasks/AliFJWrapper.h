@@ -124,6 +124,8 @@ class AliFJWrapper
   void SetNRepeats(Int_t nrepeat)       { fNGhostRepeats  = nrepeat; }
   void SetGhostArea(Double_t gharea)    { fGhostArea      = gharea;  }
   void SetMaxRap(Double_t maxrap)       { fMaxRap         = maxrap;  }
+  void SetGhostRegion(Double_t rap, Double_t phi, Double_t r) { fGhostRegionRap = rap; fGhostRegionPhi = phi; fGhostRegionR = r; }
+  void ResetGhostRegion()               { fGhostRegionR   = 0;       }
   void SetR(Double_t r)                 { fR              = r;       }
   void SetGridScatter(Double_t gridSc)  { fGridScatter    = gridSc;  }
   void SetKtScatter(Double_t ktSc)      { fKtScatter      = ktSc;    }
@@ -179,6 +181,9 @@ class AliFJWrapper
   Int_t                                  fNGhostRepeats;      //!
   Double_t                               fGhostArea;	      //!
   Double_t                               fMaxRap;	      //!
+  Double_t                               fGhostRegionRap;     //! rapidity of the center of the ghosted region (if fGhostRegionR > 0)
+  Double_t                               fGhostRegionPhi;     //! azimuth of the center of the ghosted region (if fGhostRegionR > 0)
+  Double_t                               fGhostRegionR;       //! radius of the ghosted region (<= 0: ghosts in |y| < fMaxRap)
   Double_t                               fR;                  //!
   Double_t                               fMinJetPt;
   // no setters for the moment - used default values in the constructor
@@ -288,6 +293,9 @@ AliFJWrapper::AliFJWrapper(const char *name, const char *title)
   , fNGhostRepeats     (1)
   , fGhostArea         (0.005)
   , fMaxRap            (1.)
+  , fGhostRegionRap    (0.)
+  , fGhostRegionPhi    (0.)
+  , fGhostRegionR      (0.)
   , fR                 (0.4)
   , fGridScatter       (1.0)
   , fKtScatter         (0.1)
@@ -387,6 +395,9 @@ void AliFJWrapper::CopySettingsFrom(const AliFJWrapper& wrapper)
   fNGhostRepeats    = wrapper.fNGhostRepeats;
   fGhostArea        = wrapper.fGhostArea;
   fMaxRap           = wrapper.fMaxRap;
+  fGhostRegionRap   = wrapper.fGhostRegionRap;
+  fGhostRegionPhi   = wrapper.fGhostRegionPhi;
+  fGhostRegionR     = wrapper.fGhostRegionR;
   fR                = wrapper.fR;
   fGridScatter      = wrapper.fGridScatter;
   fKtScatter        = wrapper.fKtScatter;
@@ -702,7 +713,25 @@ Int_t AliFJWrapper::Run()
     // NOTE: hardcoded variable!
     fVorAreaSpec = new fj::VoronoiAreaSpec(1.);
     fAreaDef     = new fj::AreaDefinition(*fVorAreaSpec);
-  } else {
+  }
+#ifdef FASTJET_VERSION
+  else if (fGhostRegionR > 0) {
+    // ghosts only in a circle around a given direction (e.g. when only a region of the event is clustered)
+    fj::PseudoJet center;
+    center.reset_PtYPhiM(1., fGhostRegionRap, fGhostRegionPhi);
+    fj::Selector ghostRegion = fj::SelectorCircle(fGhostRegionR) && fj::SelectorAbsRapMax(fMaxRap);
+    ghostRegion.set_reference(center);
+    fGhostedAreaSpec = new fj::GhostedAreaSpec(ghostRegion,
+                                               fNGhostRepeats,
+                                               fGhostArea,
+                                               fGridScatter,
+                                               fKtScatter,
+                                               fMeanGhostKt);
+
+    fAreaDef = new fj::AreaDefinition(*fGhostedAreaSpec, fAreaType);
+  }
+#endif
+  else {
     fGhostedAreaSpec = new fj::GhostedAreaSpec(fMaxRap,
                                                fNGhostRepeats,
                                                fGhostArea,
@@ -10,6 +10,7 @@
 #include "AliESDCaloCluster.h"
 #include "AliVTrack.h"
 #include "AliEmcalJet.h"
+#include "AliEmcalJetDeclustering.h"
 #include "AliRhoParameter.h"
 #include "AliLog.h"
 #include "AliJetContainer.h"
@@ -41,7 +42,9 @@ AliAnalysisTaskSoftDrop::AliAnalysisTaskSoftDrop() :
   fhZg(0),
   fJetsCont(0),
   fTracksCont(0),
-  fCaloClustersCont(0)
+  fCaloClustersCont(0),
+  fUseDeclusteringFromJet(kFALSE),
+  fDeclusteringRejected(kFALSE)
 
 {
   // Default constructor.
@@ -88,7 +91,9 @@ AliAnalysisTaskSoftDrop::AliAnalysisTaskSoftDrop(const char *name) :
   fhZg(0),
   fJetsCont(0),
   fTracksCont(0),
-  fCaloClustersCont(0)
+  fCaloClustersCont(0),
+  fUseDeclusteringFromJet(kFALSE),
+  fDeclusteringRejected(kFALSE)
 {
   // Standard constructor.
 
@@ -408,19 +413,35 @@ Bool_t AliAnalysisTaskSoftDrop::FillHistograms()
 
       Double_t jetpt_ungrmd = jet->Pt() / ( jet->GetShapeProperties()->GetSoftDropPtfrac() );
 
-      std::vector<fastjet::PseudoJet> particles;
-      UShort_t ntracks = jet->GetNumberOfTracks();
-      for (int j = 0; j < ntracks; j++) {
-        particles.push_back( fastjet::PseudoJet( jet->Track(j)->Px(), jet->Track(j)->Py(), jet->Track(j)->Pz(), jet->Track(j)->E() ) );
+      const AliEmcalJetDeclustering &declustering = jet->GetShapeProperties()->GetDeclustering();
+      Bool_t useDeclustering = fUseDeclusteringFromJet && IsDeclusteringUsable(declustering);
+      if (fUseDeclusteringFromJet && !useDeclustering && !fDeclusteringRejected) {
+        AliWarning(Form("%s: Declustering history of the jets does not match the reclustering of this task "
+                        "(C/A, R = 0.4, E scheme, track constituents only), jets are reclustered in the task", GetName()));
+        fDeclusteringRejected = kTRUE;
       }
-      fastjet::JetDefinition jet_def(fastjet::cambridge_algorithm, 0.4, fastjet::E_scheme);
-      fastjet::ClusterSequence cs(particles, jet_def);
-      std::vector<fastjet::PseudoJet> jets = sorted_by_pt(cs.inclusive_jets());
-
-      if (jets.size() > 0) {
-        fSDM = 0;
-        SoftDropDeepDeclustering( jets[0], jets[0].pt() );
-        fhCorrPtZg2->Fill( jets[0].pt(), SoftDropDeclustering(jets[0], 0.5, 1.5) );
+      if (useDeclustering) {
+        if (declustering.GetNumberOfSplittings() > 0) {
+          fSDM = 0;
+          SoftDropDeepDeclustering(declustering);
+          fhCorrPtZg2->Fill( declustering.GetPtParent(0), SoftDropDeclustering(declustering, 0.5, 1.5) );
+        }
+      }
+      else {
+        std::vector<fastjet::PseudoJet> particles;
+        UShort_t ntracks = jet->GetNumberOfTracks();
+        for (int j = 0; j < ntracks; j++) {
+          particles.push_back( fastjet::PseudoJet( jet->Track(j)->Px(), jet->Track(j)->Py(), jet->Track(j)->Pz(), jet->Track(j)->E() ) );
+        }
+        fastjet::JetDefinition jet_def(fastjet::cambridge_algorithm, 0.4, fastjet::E_scheme);
+        fastjet::ClusterSequence cs(particles, jet_def);
+        std::vector<fastjet::PseudoJet> jets = sorted_by_pt(cs.inclusive_jets());
+
+        if (jets.size() > 0) {
+          fSDM = 0;
+          SoftDropDeepDeclustering( jets[0], jets[0].pt() );
+          fhCorrPtZg2->Fill( jets[0].pt(), SoftDropDeclustering(jets[0], 0.5, 1.5) );
+        }
       }
 
       fhZg->Fill(jet->GetShapeProperties()->GetSoftDropZg());
@@ -563,6 +584,50 @@ Float_t AliAnalysisTaskSoftDrop::SoftDropDeclustering(fastjet::PseudoJet jet, co
 
 }
 
+Bool_t AliAnalysisTaskSoftDrop::IsDeclusteringUsable(const AliEmcalJetDeclustering &declustering) const {
+
+  // The declustering history must correspond to the reclustering done in this task:
+  // Cambridge/Aachen with R = 0.4 and E scheme on the track constituents
+  // (AliEmcalJetUtilityDeclustering::SetUseTrackConstituentsOnly())
+  return declustering.IsAvailable() && declustering.IsTrackConstituentsOnly() &&
+         TMath::Abs(declustering.GetRadius() - 0.4) < 1e-6 && declustering.GetRecombinationScheme() == fastjet::E_scheme;
+
+}
+
+void AliAnalysisTaskSoftDrop::SoftDropDeepDeclustering(const AliEmcalJetDeclustering &declustering) {
+
+  // Same as SoftDropDeepDeclustering(fastjet::PseudoJet, const Float_t), on the primary
+  // declustering sequence attached to the jet
+  Float_t inpt = declustering.GetPtParent(0);
+  for (Int_t i = 0; i < declustering.GetNumberOfPrimarySplittings(); i++) {
+    Int_t k = declustering.GetPrimarySplitting(i);
+    Float_t z = declustering.GetZ(k);
+    Float_t dr = declustering.GetDeltaR(k);
+    if (z > 0.1) {
+      fSDM++;
+      fhCorrPtZgD->Fill(inpt, z);
+      fhCorrPtRgD->Fill(inpt, dr);
+      fhCorrPtZgSDstep->Fill(inpt, z,  fSDM);
+      fhCorrPtRgSDstep->Fill(inpt, dr, fSDM);
+    }
+  }
+
+}
+
+Float_t AliAnalysisTaskSoftDrop::SoftDropDeclustering(const AliEmcalJetDeclustering &declustering, const Float_t zcut, const Float_t beta) {
+
+  // Same as SoftDropDeclustering(fastjet::PseudoJet, const Float_t, const Float_t), on the
+  // primary declustering sequence attached to the jet
+  for (Int_t i = 0; i < declustering.GetNumberOfPrimarySplittings(); i++) {
+    Int_t k = declustering.GetPrimarySplitting(i);
+    Float_t z = declustering.GetZ(k);
+    Float_t angular_term = TMath::Power(declustering.GetDeltaR(k)/0.4, beta);
+    if ( z > (zcut*angular_term) ) return z;
+  }
+  return 0.0;
+
+}
+
 //________________________________________________________________________
 void AliAnalysisTaskSoftDrop::ExecOnce() {
 
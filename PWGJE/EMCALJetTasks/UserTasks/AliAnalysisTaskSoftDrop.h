@@ -9,6 +9,7 @@ class TH3;
 class AliJetContainer;
 class AliParticleContainer;
 class AliClusterContainer;
+class AliEmcalJetDeclustering;
 
 #include "AliAnalysisTaskEmcalJet.h"
 #include "FJ_includes.h"
@@ -24,6 +25,9 @@ class AliAnalysisTaskSoftDrop : public AliAnalysisTaskEmcalJet {
   void                        Terminate(Option_t *option);
 
   static Float_t              SoftDropDeclustering(fastjet::PseudoJet jet, const Float_t zcut, const Float_t beta);
+  static Float_t              SoftDropDeclustering(const AliEmcalJetDeclustering &declustering, const Float_t zcut, const Float_t beta);
+
+  void                        SetUseDeclusteringFromJet(Bool_t b) { fUseDeclusteringFromJet = b; }
 
   static AliAnalysisTaskSoftDrop* AddTaskSoftDrop(
     const char *ntracks            = "usedefault",
@@ -46,6 +50,8 @@ class AliAnalysisTaskSoftDrop : public AliAnalysisTaskEmcalJet {
   void                        CheckClusTrackMatching();
 
   void                        SoftDropDeepDeclustering(fastjet::PseudoJet jet, const Float_t inpt); 
+  void                        SoftDropDeepDeclustering(const AliEmcalJetDeclustering &declustering);
+  Bool_t                      IsDeclusteringUsable(const AliEmcalJetDeclustering &declustering) const;
 
   // General histograms
   TH1                       **fHistTracksPt;            //!Track pt spectrum
@@ -86,7 +92,9 @@ class AliAnalysisTaskSoftDrop : public AliAnalysisTaskEmcalJet {
   AliAnalysisTaskSoftDrop &operator=(const AliAnalysisTaskSoftDrop&); // not implemented
 
   Int_t                       fSDM;                     ///< number of the SD iterations
+  Bool_t                      fUseDeclusteringFromJet;  ///< use the declustering history attached to the jet (AliEmcalJetUtilityDeclustering) instead of reclustering
+  Bool_t                      fDeclusteringRejected;    //!<! declustering history of the jets was rejected (warning issued)
 
-  ClassDef(AliAnalysisTaskSoftDrop, 1) // jet sample analysis task
+  ClassDef(AliAnalysisTaskSoftDrop, 3) // jet sample analysis task
 };
 #endif
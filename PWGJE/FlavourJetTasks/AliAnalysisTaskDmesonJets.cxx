@@ -16,11 +16,13 @@
 //C++
 #include <sstream>
 #include <array>
+#include <algorithm>
 
 // Root
 #include <TClonesArray.h>
 #include <TDatabasePDG.h>
 #include <TParticlePDG.h>
+#include <TVector2.h>
 #include <TVector3.h>
 #include <THnSparse.h>
 #include <TParticle.h>
@@ -1641,7 +1643,10 @@ AliAnalysisTaskDmesonJets::AliHFJetDefinition::AliHFJetDefinition() :
   fMinNeutralPt(0.),
   fMaxNeutralPt(0.),
   fRhoName(),
-  fRho(0)
+  fRho(0),
+  fHistTrackRejectionReason(0),
+  fHistClusterRejectionReason(0),
+  fHistDMesonDaughterNotInJet(0)
 {
 }
 
@@ -1668,7 +1673,10 @@ AliAnalysisTaskDmesonJets::AliHFJetDefinition::AliHFJetDefinition(EJetType_t typ
   fMinNeutralPt(0.),
   fMaxNeutralPt(0.),
   fRhoName(),
-  fRho(0)
+  fRho(0),
+  fHistTrackRejectionReason(0),
+  fHistClusterRejectionReason(0),
+  fHistDMesonDaughterNotInJet(0)
 {
 }
 
@@ -1695,7 +1703,10 @@ AliAnalysisTaskDmesonJets::AliHFJetDefinition::AliHFJetDefinition(EJetType_t typ
   fMinNeutralPt(0.),
   fMaxNeutralPt(0.),
   fRhoName(rhoName),
-  fRho(0)
+  fRho(0),
+  fHistTrackRejectionReason(0),
+  fHistClusterRejectionReason(0),
+  fHistDMesonDaughterNotInJet(0)
 {
 }
 
@@ -1719,7 +1730,10 @@ AliAnalysisTaskDmesonJets::AliHFJetDefinition::AliHFJetDefinition(const AliHFJet
   fMinNeutralPt(source.fMinNeutralPt),
   fMaxNeutralPt(source.fMaxNeutralPt),
   fRhoName(source.fRhoName),
-  fRho(0)
+  fRho(0),
+  fHistTrackRejectionReason(0),
+  fHistClusterRejectionReason(0),
+  fHistDMesonDaughterNotInJet(0)
 {
 }
 
@@ -1835,6 +1849,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine() :
   fOutputHandler(nullptr),
   fRandomGen(0),
   fTrackEfficiency(0),
+  fRegionOfInterest(0),
   fRejectISR(kFALSE),
   fDmesonJets(),
   fCandidateArray(0),
@@ -1845,7 +1860,12 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine() :
   fFastJetWrapper(0),
   fHistManager(0),
   fEventInfo(),
-  fName()
+  fName(),
+  fInputVectors(),
+  fInputIndexes(),
+  fInputObjects(),
+  fInputRap(),
+  fInputPhi()
 {
 }
 
@@ -1879,6 +1899,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(ECandidateType_t type,
   fOutputHandler(nullptr),
   fRandomGen(0),
   fTrackEfficiency(0),
+  fRegionOfInterest(0),
   fDmesonJets(),
   fCandidateArray(0),
   fMCContainer(),
@@ -1888,7 +1909,12 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(ECandidateType_t type,
   fFastJetWrapper(0),
   fHistManager(0),
   fEventInfo(),
-  fName()
+  fName(),
+  fInputVectors(),
+  fInputIndexes(),
+  fInputObjects(),
+  fInputRap(),
+  fInputPhi()
 {
   SetCandidateProperties(range);
 }
@@ -1918,6 +1944,7 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(const AliAnalysisTaskD
   fD0Extended(source.fD0Extended),
   fRandomGen(source.fRandomGen),
   fTrackEfficiency(source.fTrackEfficiency),
+  fRegionOfInterest(source.fRegionOfInterest),
   fDmesonJets(),
   fCandidateArray(source.fCandidateArray),
   fMCContainer(source.fMCContainer),
@@ -1927,7 +1954,12 @@ AliAnalysisTaskDmesonJets::AnalysisEngine::AnalysisEngine(const AliAnalysisTaskD
   fFastJetWrapper(source.fFastJetWrapper),
   fHistManager(source.fHistManager),
   fEventInfo(),
-  fName()
+  fName(),
+  fInputVectors(),
+  fInputIndexes(),
+  fInputObjects(),
+  fInputRap(),
+  fInputPhi()
 {
   SetRDHFCuts(source.fRDHFCuts);
 }
@@ -2555,6 +2587,8 @@ void AliAnalysisTaskDmesonJets::AnalysisEngine::RunDetectorLevelAnalysis()
   std::array<int, 3> nAccCharm = {0};
   std::array<std::array<int, 3>, 5> nAccCharmPt = {{{0}}};
 
+  if (fRegionOfInterest > 0) PrepareInputVectors();
+
   for (Int_t icharm = 0; icharm < nD; icharm++) {   //loop over D candidates
     AliAODRecoDecayHF2Prong* charmCand = static_cast<AliAODRecoDecayHF2Prong*>(fCandidateArray->At(icharm)); // D candidates
     if (!charmCand) continue;
@@ -2676,8 +2710,6 @@ void AliAnalysisTaskDmesonJets::AnalysisEngine::RunDetectorLevelAnalysis()
 /// \return kTRUE on success, kFALSE otherwise
 Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Prong* Dcand, AliDmesonJetInfo& DmesonJet, AliHFJetDefinition& jetDef)
 {
-  TString hname;
-
   Double_t rho = 0;
   if (jetDef.fRho) rho = jetDef.fRho->GetVal();
 
@@ -2688,36 +2720,38 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Pron
 
   fFastJetWrapper->AddInputVector(DmesonJet.fD.Px(), DmesonJet.fD.Py(), DmesonJet.fD.Pz(), DmesonJet.fD.E(), 0);
 
-  if (jetDef.fJetType != AliJetContainer::kNeutralJet) {
-    for (auto track_cont : fTrackContainers) {
-      AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
-      if (hftrack_cont) hftrack_cont->SetDMesonCandidate(Dcand);
-      hname = TString::Format("%s/%s/fHistTrackRejectionReason", GetName(), jetDef.GetName());
-      AddInputVectors(track_cont, 100, static_cast<TH2*>(fHistManager->FindObject(hname)), fTrackEfficiency);
-
-      if (hftrack_cont) {
-        hname = TString::Format("%s/%s/fHistDMesonDaughterNotInJet", GetName(), jetDef.GetName());
-        TH1* histDaughterNotInJet = static_cast<TH1*>(fHistManager->FindObject(hname));
-        const TObjArray& daughters = hftrack_cont->GetDaughterList();
-        for (Int_t i = 0; i < daughters.GetEntriesFast(); i++) {
-          AliVParticle* daughter = static_cast<AliVParticle*>(daughters.At(i));
-          if (!hftrack_cont->GetArray()->FindObject(daughter)) histDaughterNotInJet->Fill(daughter->Pt());
+  if (fRegionOfInterest > 0) {
+    AddRegionInputVectors(Dcand, DmesonJet, jetDef);
+  }
+  else {
+    if (jetDef.fJetType != AliJetContainer::kNeutralJet) {
+      for (auto track_cont : fTrackContainers) {
+        AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
+        if (hftrack_cont) hftrack_cont->SetDMesonCandidate(Dcand);
+        AddInputVectors(track_cont, 100, jetDef.fHistTrackRejectionReason, fTrackEfficiency);
+
+        if (hftrack_cont && jetDef.fHistDMesonDaughterNotInJet) {
+          const TObjArray& daughters = hftrack_cont->GetDaughterList();
+          for (Int_t i = 0; i < daughters.GetEntriesFast(); i++) {
+            AliVParticle* daughter = static_cast<AliVParticle*>(daughters.At(i));
+            if (!hftrack_cont->GetArray()->FindObject(daughter)) jetDef.fHistDMesonDaughterNotInJet->Fill(daughter->Pt());
+          }
         }
       }
     }
-  }
 
-  if (jetDef.fJetType != AliJetContainer::kChargedJet) {
-    for (auto clus_cont : fClusterContainers) {
-      hname = TString::Format("%s/%s/fHistClusterRejectionReason", GetName(), jetDef.GetName());
-      AddInputVectors(clus_cont, -100, static_cast<TH2*>(fHistManager->FindObject(hname)));
+    if (jetDef.fJetType != AliJetContainer::kChargedJet) {
+      for (auto clus_cont : fClusterContainers) {
+        AddInputVectors(clus_cont, -100, jetDef.fHistClusterRejectionReason);
+      }
     }
   }
 
   // run jet finder
   fFastJetWrapper->Run();
+  fFastJetWrapper->ResetGhostRegion();
 
-  std::vector<fastjet::PseudoJet> jets_incl = fFastJetWrapper->GetInclusiveJets();
+  const std::vector<fastjet::PseudoJet>& jets_incl = fFastJetWrapper->GetInclusiveJets();
 
   for (UInt_t ijet = 0; ijet < jets_incl.size(); ++ijet) {
     std::vector<fastjet::PseudoJet> constituents(fFastJetWrapper->GetJetConstituents(ijet));
@@ -2745,13 +2779,14 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Pron
     }
 
     if (isDmesonJet) {
-      DmesonJet.fJets[jetDef.GetName()].fMomentum.SetPxPyPzE(jets_incl[ijet].px(), jets_incl[ijet].py(), jets_incl[ijet].pz(), jets_incl[ijet].E());
-      DmesonJet.fJets[jetDef.GetName()].fNConstituents = nConst;
-      DmesonJet.fJets[jetDef.GetName()].fMaxChargedPt = maxChPt;
-      DmesonJet.fJets[jetDef.GetName()].fMaxNeutralPt = maxNePt;
-      DmesonJet.fJets[jetDef.GetName()].fNEF = totalNeutralPt / jets_incl[ijet].pt();
-      DmesonJet.fJets[jetDef.GetName()].fArea = jets_incl[ijet].area();
-      DmesonJet.fJets[jetDef.GetName()].fCorrPt = DmesonJet.fJets[jetDef.GetName()].fMomentum.Pt() - jets_incl[ijet].area() * rho;
+      AliJetInfo& jetInfo = DmesonJet.fJets[jetDef.GetName()];
+      jetInfo.fMomentum.SetPxPyPzE(jets_incl[ijet].px(), jets_incl[ijet].py(), jets_incl[ijet].pz(), jets_incl[ijet].E());
+      jetInfo.fNConstituents = nConst;
+      jetInfo.fMaxChargedPt = maxChPt;
+      jetInfo.fMaxNeutralPt = maxNePt;
+      jetInfo.fNEF = totalNeutralPt / jets_incl[ijet].pt();
+      jetInfo.fArea = jets_incl[ijet].area();
+      jetInfo.fCorrPt = jetInfo.fMomentum.Pt() - jets_incl[ijet].area() * rho;
 
       return kTRUE;
     }
@@ -2760,6 +2795,60 @@ Bool_t AliAnalysisTaskDmesonJets::AnalysisEngine::FindJet(AliAODRecoDecayHF2Pron
   return kFALSE;
 }
 
+/// Adds the tracks and clusters of the current event, which were accepted once per event
+/// in PrepareInputVectors(), into the fastjet wrapper. The daughters of the D meson candidate
+/// are skipped, since they are replaced by the candidate itself. For anti-kt jets only the
+/// particles within fRegionOfInterest times the jet radius from the D meson candidate are added
+/// (and the ghosts are restricted to the same region).
+///
+/// With anti-kt, a particle can only be clustered into a jet within a distance R, and only jets
+/// within 2R of the D meson jet can compete with it for its constituents: with a region of at
+/// least 3R the D meson jet is identical to the one obtained from the whole event (up to the
+/// random placement of the ghosts), unless a chain of overlapping jets, each harder than the previous one,
+/// connects it with particles outside of the region. For other algorithms the whole event is used.
+///
+/// \param Dcand Valid pointer to a D meson candidate object
+/// \param DmesonJet Reference to a AliDmesonJetInfo object with the D meson candidate momentum
+/// \param jetDef Jet definition
+void AliAnalysisTaskDmesonJets::AnalysisEngine::AddRegionInputVectors(AliAODRecoDecayHF2Prong* Dcand, const AliDmesonJetInfo& DmesonJet, const AliHFJetDefinition& jetDef)
+{
+  std::vector<const TObject*> daughterList;
+  if (jetDef.fJetType != AliJetContainer::kNeutralJet) {
+    for (auto track_cont : fTrackContainers) {
+      AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
+      if (!hftrack_cont) continue;
+      hftrack_cont->SetDMesonCandidate(Dcand);
+      const TObjArray& daughters = hftrack_cont->GetDaughterList();
+      for (Int_t i = 0; i < daughters.GetEntriesFast(); i++) {
+        AliVParticle* daughter = static_cast<AliVParticle*>(daughters.At(i));
+        daughterList.push_back(daughter);
+        if (jetDef.fHistDMesonDaughterNotInJet && !hftrack_cont->GetArray()->FindObject(daughter)) jetDef.fHistDMesonDaughterNotInJet->Fill(daughter->Pt());
+      }
+    }
+  }
+
+  Bool_t useRegion = jetDef.fJetAlgo == AliJetContainer::antikt_algorithm;
+  Double_t regionRadius = fRegionOfInterest * jetDef.fRadius;
+  Double_t maxDist2 = regionRadius * regionRadius;
+  Double_t rap = DmesonJet.fD.Rapidity();
+  Double_t phi = DmesonJet.fD.Phi_0_2pi();
+
+  for (UInt_t i = 0; i < fInputVectors.size(); i++) {
+    if (fInputIndexes[i] >= 100 && jetDef.fJetType == AliJetContainer::kNeutralJet) continue;
+    if (fInputIndexes[i] <= -100 && jetDef.fJetType == AliJetContainer::kChargedJet) continue;
+    if (useRegion) {
+      Double_t dphi = TVector2::Phi_mpi_pi(fInputPhi[i] - phi);
+      Double_t drap = fInputRap[i] - rap;
+      if (dphi * dphi + drap * drap > maxDist2) continue;
+    }
+    if (std::find(daughterList.begin(), daughterList.end(), fInputObjects[i]) != daughterList.end()) continue;
+    const AliTLorentzVector& v = fInputVectors[i];
+    fFastJetWrapper->AddInputVector(v.Px(), v.Py(), v.Pz(), v.E(), fInputIndexes[i]);
+  }
+
+  if (useRegion) fFastJetWrapper->SetGhostRegion(rap, phi, regionRadius);
+}
+
 /// Adds all the particles contained in the container into the fastjet wrapper
 ///
 /// \param cont Pointer to a valid AliEmcalContainer object
@@ -2784,6 +2873,81 @@ void AliAnalysisTaskDmesonJets::AnalysisEngine::AddInputVectors(AliEmcalContaine
   }
 }
 
+/// Adds all the accepted particles contained in the container to the input vectors
+/// of the current event (region of interest mode)
+///
+/// \param cont Pointer to a valid AliEmcalContainer object
+/// \param offset Offset of the fastjet user index
+/// \param rejectHists Histograms filled with the rejection reasons
+/// \param eff Artificial tracking efficiency
+void AliAnalysisTaskDmesonJets::AnalysisEngine::AddInputVectors(AliEmcalContainer* cont, Int_t offset, const std::vector<TH2*>& rejectHists, Double_t eff)
+{
+  auto itcont = cont->all_momentum();
+  for (AliEmcalIterableMomentumContainer::iterator it = itcont.begin(); it != itcont.end(); it++) {
+    UInt_t rejectionReason = 0;
+    if (!cont->AcceptObject(it.current_index(), rejectionReason)) {
+      for (auto rejectHist : rejectHists) rejectHist->Fill(AliEmcalContainer::GetRejectionReasonBitPosition(rejectionReason), it->first.Pt());
+      continue;
+    }
+    if (fRandomGen && eff > 0 && eff < 1) {
+      Double_t rnd = fRandomGen->Rndm();
+      if (eff < rnd) {
+        for (auto rejectHist : rejectHists) rejectHist->Fill(6, it->first.Pt());
+        continue;
+      }
+    }
+    Int_t uid = offset >= 0 ? it.current_index() + offset: -it.current_index() - offset;
+    fInputVectors.push_back(it->first);
+    fInputIndexes.push_back(uid);
+    fInputObjects.push_back(it->second);
+    fInputRap.push_back(it->first.Rapidity());
+    fInputPhi.push_back(it->first.Phi_0_2pi());
+  }
+}
+
+/// Applies the track and cluster selection once per event for all D meson candidates
+/// and jet definitions (region of interest mode). The D meson candidate daughters are
+/// kept here and removed for each candidate in AddRegionInputVectors().
+/// The rejection reason histograms are therefore filled once per event, and the artificial
+/// tracking inefficiency is applied consistently to all candidates of the event.
+void AliAnalysisTaskDmesonJets::AnalysisEngine::PrepareInputVectors()
+{
+  fInputVectors.clear();
+  fInputIndexes.clear();
+  fInputObjects.clear();
+  fInputRap.clear();
+  fInputPhi.clear();
+
+  Bool_t useTracks = kFALSE;
+  Bool_t useClusters = kFALSE;
+  std::vector<TH2*> trackRejectHists;
+  std::vector<TH2*> clusterRejectHists;
+  for (auto& jetDef : fJetDefinitions) {
+    if (jetDef.fJetType != AliJetContainer::kNeutralJet) {
+      useTracks = kTRUE;
+      if (jetDef.fHistTrackRejectionReason) trackRejectHists.push_back(jetDef.fHistTrackRejectionReason);
+    }
+    if (jetDef.fJetType != AliJetContainer::kChargedJet) {
+      useClusters = kTRUE;
+      if (jetDef.fHistClusterRejectionReason) clusterRejectHists.push_back(jetDef.fHistClusterRejectionReason);
+    }
+  }
+
+  if (useTracks) {
+    for (auto track_cont : fTrackContainers) {
+      AliHFTrackContainer* hftrack_cont = dynamic_cast<AliHFTrackContainer*>(track_cont);
+      if (hftrack_cont) hftrack_cont->SetDMesonCandidate(nullptr);
+      AddInputVectors(track_cont, 100, trackRejectHists, fTrackEfficiency);
+    }
+  }
+
+  if (useClusters) {
+    for (auto clus_cont : fClusterContainers) {
+      AddInputVectors(clus_cont, -100, clusterRejectHists);
+    }
+  }
+}
+
 /// Run a particle level analysis
 void AliAnalysisTaskDmesonJets::AnalysisEngine::RunParticleLevelAnalysis()
 {
@@ -2965,6 +3129,7 @@ AliAnalysisTaskDmesonJets::AliAnalysisTaskDmesonJets() :
   fRejectISR(kFALSE),
   fJetAreaType(fastjet::active_area),
   fJetGhostArea(0.005),
+  fRegionOfInterest(0),
   fMCContainer(0),
   fAodEvent(0),
   fFastJetWrapper(0)
@@ -2987,6 +3152,7 @@ AliAnalysisTaskDmesonJets::AliAnalysisTaskDmesonJets(const char* name, Int_t nOu
   fRejectISR(kFALSE),
   fJetAreaType(fastjet::active_area),
   fJetGhostArea(0.005),
+  fRegionOfInterest(0),
   fMCContainer(0),
   fAodEvent(0),
   fFastJetWrapper(0)
@@ -3446,10 +3612,15 @@ void AliAnalysisTaskDmesonJets::ExecOnce()
     params.fAodEvent = fAodEvent;
     params.fFastJetWrapper = fFastJetWrapper;
     params.fTrackEfficiency = fTrackEfficiency;
+    params.fRegionOfInterest = fRegionOfInterest;
     params.fRejectISR = fRejectISR;
     params.fRandomGen = rnd;
 
     for (auto &jetdef: params.fJetDefinitions) {
+      jetdef.fHistTrackRejectionReason = static_cast<TH2*>(fHistManager.FindObject(TString::Format("%s/%s/fHistTrackRejectionReason", params.GetName(), jetdef.GetName())));
+      jetdef.fHistClusterRejectionReason = static_cast<TH2*>(fHistManager.FindObject(TString::Format("%s/%s/fHistClusterRejectionReason", params.GetName(), jetdef.GetName())));
+      jetdef.fHistDMesonDaughterNotInJet = static_cast<TH1*>(fHistManager.FindObject(TString::Format("%s/%s/fHistDMesonDaughterNotInJet", params.GetName(), jetdef.GetName())));
+
       if (!jetdef.fRhoName.IsNull()) {
         jetdef.fRho = dynamic_cast<AliRhoParameter*>(fInputEvent->FindListObject(jetdef.fRhoName));
         if (!jetdef.fRho) {
@@ -492,11 +492,14 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Double_t                  fMaxNeutralPt  ; ///<  Maximum pt of the leading neutral particle (or cluster)
     TString                   fRhoName       ; ///<  Name of the object that holds the average background value
     AliRhoParameter          *fRho           ; ///<  Object that holds the average background value
+    TH2                      *fHistTrackRejectionReason   ; //!<! Track rejection reason histogram (set at ExecOnce)
+    TH2                      *fHistClusterRejectionReason ; //!<! Cluster rejection reason histogram (set at ExecOnce)
+    TH1                      *fHistDMesonDaughterNotInJet ; //!<! D meson daughters not found in the track array (set at ExecOnce)
     std::vector<AliJetInfo>   fJets          ; //!<! Inclusive jets reconstructed in the current event (includes D meson candidate daughters, if any)
 
   private:
     /// \cond CLASSIMP
-    ClassDef(AliHFJetDefinition, 5);
+    ClassDef(AliHFJetDefinition, 6);
     /// \endcond
   };
 
@@ -772,6 +775,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     OutputHandler                     *fOutputHandler         ; //!<! Output handler
     TRandom                           *fRandomGen             ; //!<! Random number generator
     Double_t                           fTrackEfficiency       ; //!<! Artificial tracking inefficiency (0...1) -> set automatically at ExecOnce by AliAnalysisTaskDmesonJets
+    Double_t                           fRegionOfInterest      ; //!<! Radius of the reclustered region around the D meson candidate, in units of the jet radius (0 = whole event) -> set automatically at ExecOnce by AliAnalysisTaskDmesonJets
     Bool_t                             fRejectISR             ; //!<! Reject initial state radiation
     std::map<int, AliDmesonJetInfo>    fDmesonJets            ; //!<! Array containing the D meson jets
     TClonesArray                      *fCandidateArray        ; //!<! D meson candidate array
@@ -783,6 +787,11 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     THistManager                      *fHistManager           ; //!<! Histograms
     EventInfo                          fEventInfo             ; //!<! Event info (centrality, weight, pt hard etc.)
     mutable TString                    fName                  ; //!<! Name of this object
+    std::vector<AliTLorentzVector>     fInputVectors          ; //!<! Accepted tracks and clusters of the current event (region of interest mode)
+    std::vector<Int_t>                 fInputIndexes          ; //!<! Fastjet user index of the input vectors
+    std::vector<const TObject*>        fInputObjects          ; //!<! Track or cluster object of the input vectors
+    std::vector<Double_t>              fInputRap              ; //!<! Rapidity of the input vectors
+    std::vector<Double_t>              fInputPhi              ; //!<! Azimuthal angle of the input vectors
 
     friend class AliAnalysisTaskDmesonJets;
     friend class OutputHandler;
@@ -790,6 +799,9 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   private:
 
     void                AddInputVectors(AliEmcalContainer* cont, Int_t offset, TH2* rejectHist=0, Double_t eff=0.);
+    void                AddInputVectors(AliEmcalContainer* cont, Int_t offset, const std::vector<TH2*>& rejectHists, Double_t eff=0.);
+    void                PrepareInputVectors();
+    void                AddRegionInputVectors(AliAODRecoDecayHF2Prong* Dcand, const AliDmesonJetInfo& DmesonJet, const AliHFJetDefinition& jetDef);
     void                SetCandidateProperties(Double_t range);
     AliAODMCParticle*   MatchToMC() const;
     void                RunDetectorLevelAnalysis();
@@ -801,7 +813,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
     Bool_t              FindJet(AliAODRecoDecayHF2Prong* Dcand, AliDmesonJetInfo& DmesonJet, AliHFJetDefinition& jetDef);
 
     /// \cond CLASSIMP
-    ClassDef(AnalysisEngine, 3);
+    ClassDef(AnalysisEngine, 4);
     /// \endcond
   };
 
@@ -831,6 +843,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   void SetRejectISR(Bool_t b)                     { fRejectISR          = b ; }
   void SetJetArea(Int_t type,
       Double_t garea = 0.005)                     { fJetAreaType        = type; fJetGhostArea = garea; }
+  void SetRegionOfInterest(Double_t r)            { fRegionOfInterest   = r ; }
 
   virtual void         UserCreateOutputObjects();
   virtual void         ExecOnce();
@@ -863,6 +876,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   Bool_t               fRejectISR                 ; ///<  Reject initial state radiation
   Int_t                fJetAreaType               ; ///<  Jet area type
   Double_t             fJetGhostArea              ; ///<  Area of the ghost particles
+  Double_t             fRegionOfInterest          ; ///<  Radius of the reclustered region around the D meson candidates, in units of the jet radius (0 = whole event)
   AliHFAODMCParticleContainer* fMCContainer       ; //!<! MC particle container
   AliAODEvent         *fAodEvent                  ; //!<! AOD event
   AliFJWrapper        *fFastJetWrapper            ; //!<! Fastjet wrapper
@@ -873,7 +887,7 @@ class AliAnalysisTaskDmesonJets : public AliAnalysisTaskEmcalLight
   AliAnalysisTaskDmesonJets& operator=(const AliAnalysisTaskDmesonJets& source);
 
   /// \cond CLASSIMP
-  ClassDef(AliAnalysisTaskDmesonJets, 10);
+  ClassDef(AliAnalysisTaskDmesonJets, 11);
   /// \endcond
 };
 
@@ -7,6 +7,12 @@
 // with the "AND", "OR" and "NOT" operators.
 //
 
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+#include <TMath.h>
+
 #include "AliLog.h"
 
 #include "AliRsnExpression.h"
@@ -16,6 +22,141 @@
 
 ClassImp(AliRsnCutSet)
 
+namespace {
+
+   // Node of a cut scheme, used to compile it.
+   // Chains of the same operator are flattened: (a&b)&c has three operands.
+   struct CutNode {
+      Int_t                 fOp;    // AliRsnExpression::ECutOp, 0 for a single cut
+      Int_t                 fCut;   // index of the cut (fOp == 0)
+      std::vector<CutNode>  fArgs;  // operands
+      Double_t              fCost;  // expected evaluation time
+      Double_t              fPass;  // expected fraction of accepted objects
+   };
+
+   //_____________________________________________________________________________
+   Bool_t BuildNode(const AliRsnExpression *exp, Int_t nCuts, CutNode &node)
+   {
+      // Converts a parsed (indexed) expression into a node.
+      // Returns kFALSE if the expression is not a valid scheme.
+
+      if (!exp) return kFALSE;
+      node.fOp = exp->GetOperator();
+      node.fCut = -1;
+      node.fCost = 0.;
+      node.fPass = 1.;
+      node.fArgs.clear();
+
+      switch (node.fOp) {
+         case 0:
+            if (exp->GetArg2() || exp->fVname.IsNull() || !exp->fVname.IsDigit()) return kFALSE;
+            node.fCut = exp->fVname.Atoi();
+            return (node.fCut < nCuts);
+         case AliRsnExpression::kOpNOT:
+            node.fArgs.resize(1);
+            return BuildNode(exp->GetArg2(), nCuts, node.fArgs[0]);
+         case AliRsnExpression::kOpAND:
+         case AliRsnExpression::kOpOR: {
+            const AliRsnExpression *args[2] = {exp->GetArg1(), exp->GetArg2()};
+            for (Int_t i = 0; i < 2; i++) {
+               CutNode arg;
+               if (!BuildNode(args[i], nCuts, arg)) return kFALSE;
+               if (arg.fOp == node.fOp)
+                  node.fArgs.insert(node.fArgs.end(), arg.fArgs.begin(), arg.fArgs.end());
+               else
+                  node.fArgs.push_back(arg);
+            }
+            return kTRUE;
+         }
+         default:
+            return kFALSE;
+      }
+   }
+
+   //_____________________________________________________________________________
+   void OptimizeNode(CutNode &node, const std::vector<Double_t> &cost, const std::vector<Double_t> &pass)
+   {
+      // Orders the operands of each AND (OR) by increasing cost per rejected
+      // (accepted) object and estimates cost and acceptance of the node,
+      // assuming uncorrelated cuts.
+
+      if (node.fOp == 0) {
+         node.fCost = cost[node.fCut];
+         node.fPass = pass[node.fCut];
+         return;
+      }
+      for (size_t i = 0; i < node.fArgs.size(); i++) OptimizeNode(node.fArgs[i], cost, pass);
+      if (node.fOp == AliRsnExpression::kOpNOT) {
+         node.fCost = node.fArgs[0].fCost;
+         node.fPass = 1. - node.fArgs[0].fPass;
+         return;
+      }
+
+      Bool_t isAnd = (node.fOp == AliRsnExpression::kOpAND);
+      auto rank = [isAnd](const CutNode &n) {
+         Double_t decisive = isAnd ? 1. - n.fPass : n.fPass;
+         return (decisive > 0.) ? n.fCost / decisive : std::numeric_limits<Double_t>::max();
+      };
+      std::stable_sort(node.fArgs.begin(), node.fArgs.end(),
+                       [&rank](const CutNode &a, const CutNode &b) { return rank(a) < rank(b); });
+
+      // probability to go on with the next operand
+      Double_t goOn = 1.;
+      node.fCost = 0.;
+      for (size_t i = 0; i < node.fArgs.size(); i++) {
+         node.fCost += goOn * node.fArgs[i].fCost;
+         goOn *= isAnd ? node.fArgs[i].fPass : 1. - node.fArgs[i].fPass;
+      }
+      node.fPass = isAnd ? goOn : 1. - goOn;
+   }
+
+   //_____________________________________________________________________________
+   void EmitNode(const CutNode &node, std::vector<Int_t> &program)
+   {
+      // Appends the instructions of a node to the program.
+      // The result of the node is left in the accumulator.
+
+      if (node.fOp == 0) {
+         program.push_back(AliRsnCutSet::kPrgCut);
+         program.push_back(node.fCut);
+         return;
+      }
+      if (node.fOp == AliRsnExpression::kOpNOT) {
+         EmitNode(node.fArgs[0], program);
+         program.push_back(AliRsnCutSet::kPrgNot);
+         program.push_back(0);
+         return;
+      }
+
+      // AND stops at the first rejection, OR at the first acceptance
+      Int_t jump = (node.fOp == AliRsnExpression::kOpAND) ? AliRsnCutSet::kPrgJumpIfFalse : AliRsnCutSet::kPrgJumpIfTrue;
+      std::vector<size_t> targets;
+      for (size_t i = 0; i < node.fArgs.size(); i++) {
+         EmitNode(node.fArgs[i], program);
+         if (i + 1 == node.fArgs.size()) break;
+         program.push_back(jump);
+         targets.push_back(program.size());
+         program.push_back(-1);
+      }
+      for (size_t i = 0; i < targets.size(); i++) program[targets[i]] = program.size() / 2;
+   }
+
+   //_____________________________________________________________________________
+   TString NodeString(const CutNode &node, const TObjArray &cuts)
+   {
+      // Writes a node back as a cut scheme, with the cut names
+
+      if (node.fOp == 0) return cuts.At(node.fCut)->GetName();
+      if (node.fOp == AliRsnExpression::kOpNOT) return "!" + NodeString(node.fArgs[0], cuts);
+      TString str("(");
+      for (size_t i = 0; i < node.fArgs.size(); i++) {
+         if (i) str += (node.fOp == AliRsnExpression::kOpAND) ? "&" : "|";
+         str += NodeString(node.fArgs[i], cuts);
+      }
+      return str + ")";
+   }
+}
+
 //_____________________________________________________________________________
 AliRsnCutSet::AliRsnCutSet() :
    AliRsnTarget(),
@@ -27,7 +168,16 @@ AliRsnCutSet::AliRsnCutSet() :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fLazyEvaluation(kFALSE),
+   fNTraining(0),
+   fNProcessed(0),
+   fProgramReady(kFALSE),
+   fProgramValid(kFALSE),
+   fProgram(),
+   fCutCalls(),
+   fCutPassed(),
+   fCutTime()
 {
 //
 // Constructor without name (not recommended)
@@ -48,7 +198,16 @@ AliRsnCutSet::AliRsnCutSet(const char *name, RSNTARGET target) :
    fIsScheme(kFALSE),
    fExpression(0),
    fMonitors(),
-   fUseMonitor(kFALSE)
+   fUseMonitor(kFALSE),
+   fLazyEvaluation(kFALSE),
+   fNTraining(0),
+   fNProcessed(0),
+   fProgramReady(kFALSE),
+   fProgramValid(kFALSE),
+   fProgram(),
+   fCutCalls(),
+   fCutPassed(),
+   fCutTime()
 {
 //
 // Constructor with argument name (recommended)
@@ -70,7 +229,16 @@ AliRsnCutSet::AliRsnCutSet(const AliRsnCutSet &copy) :
    fIsScheme(copy.fIsScheme),
    fExpression(copy.fExpression),
    fMonitors(copy.fMonitors),
-   fUseMonitor(copy.fUseMonitor)
+   fUseMonitor(copy.fUseMonitor),
+   fLazyEvaluation(copy.fLazyEvaluation),
+   fNTraining(copy.fNTraining),
+   fNProcessed(0),
+   fProgramReady(kFALSE),
+   fProgramValid(kFALSE),
+   fProgram(),
+   fCutCalls(),
+   fCutPassed(),
+   fCutTime()
 {
 //
 // Copy constructor
@@ -104,6 +272,9 @@ AliRsnCutSet &AliRsnCutSet::operator=(const AliRsnCutSet &copy)
    fExpression = copy.fExpression;
    fMonitors = copy.fMonitors;
    fUseMonitor = copy.fUseMonitor;
+   fLazyEvaluation = copy.fLazyEvaluation;
+   fNTraining = copy.fNTraining;
+   fProgramReady = kFALSE;
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -151,6 +322,7 @@ void AliRsnCutSet::AddCut(AliRsnCut *cut)
    AliInfo(Form("====> Adding a new cut: [%s]", cut->GetName()));
    //cut->Print();
    fNumOfCuts++;
+   fProgramReady = kFALSE;
 
    if (fBoolValues) delete [] fBoolValues;
 
@@ -189,13 +361,18 @@ Bool_t AliRsnCutSet::IsSelected(TObject *object)
    if (!fNumOfCuts) return kTRUE;
 
    Bool_t boolReturn = kTRUE;
-   AliRsnCut *cut;
-   for (i = 0; i < fNumOfCuts; i++) {
-      cut = (AliRsnCut *)fCuts.At(i);
-      fBoolValues[i] = cut->IsSelected(object);
-   }
+   if (fLazyEvaluation) {
+      // without a scheme the cuts do not change the result
+      if (fIsScheme) boolReturn = RunProgram(object);
+   } else {
+      AliRsnCut *cut;
+      for (i = 0; i < fNumOfCuts; i++) {
+         cut = (AliRsnCut *)fCuts.At(i);
+         fBoolValues[i] = cut->IsSelected(object);
+      }
 
-   if (fIsScheme) boolReturn = Passed();
+      if (fIsScheme) boolReturn = Passed();
+   }
 
    // fill monitoring info
    if (boolReturn && fUseMonitor) {
@@ -224,6 +401,7 @@ void AliRsnCutSet::SetCutScheme(const char *theValue)
    fCutScheme = theValue;
    SetCutSchemeIndexed(theValue);
    fIsScheme = kTRUE;
+   fProgramReady = kFALSE;
    AliDebug(AliLog::kDebug, "->");
 }
 
@@ -278,6 +456,120 @@ Bool_t AliRsnCutSet::Passed()
    return fExpression->Value(*GetCuts());
 }
 
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::CompileScheme(Bool_t reorder)
+{
+//
+// Compiles the cut scheme into a flat program for RunProgram().
+// If 'reorder' is set, the operands of AND and OR are reordered
+// according to the time and acceptance measured for each cut,
+// otherwise the measurements are reset.
+// Returns kFALSE if the scheme cannot be compiled.
+//
+
+   fProgram.clear();
+   if (!reorder) {
+      fCutCalls.assign(fNumOfCuts, 0);
+      fCutPassed.assign(fNumOfCuts, 0);
+      fCutTime.assign(fNumOfCuts, 0.);
+   }
+
+   AliRsnExpression exp(fCutSchemeIndexed);
+   CutNode root;
+   if (!BuildNode(&exp, fNumOfCuts, root)) {
+      AliWarning(Form("Cut scheme '%s' cannot be compiled, all cuts will be evaluated", fCutScheme.Data()));
+      return kFALSE;
+   }
+
+   if (reorder) {
+      // cuts which were never reached keep the largest measured cost
+      Int_t i;
+      Double_t maxCost = 0.;
+      std::vector<Double_t> cost(fNumOfCuts, -1.), pass(fNumOfCuts, 0.5);
+      for (i = 0; i < fNumOfCuts; i++) {
+         if (!fCutCalls[i]) continue;
+         cost[i] = fCutTime[i] / fCutCalls[i];
+         pass[i] = (Double_t)fCutPassed[i] / fCutCalls[i];
+         maxCost = TMath::Max(maxCost, cost[i]);
+      }
+      for (i = 0; i < fNumOfCuts; i++) if (cost[i] < 0.) cost[i] = maxCost;
+      OptimizeNode(root, cost, pass);
+      AliInfo(Form("Cut scheme '%s' evaluated as %s", fCutScheme.Data(), NodeString(root, fCuts).Data()));
+   }
+
+   EmitNode(root, fProgram);
+   return kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t AliRsnCutSet::RunProgram(TObject *object)
+{
+//
+// Checks an object with the compiled cut scheme:
+// each cut is evaluated only if its result is needed.
+// fBoolValues is updated only for the evaluated cuts.
+//
+
+   Int_t i;
+
+   if (!fProgramReady) {
+      fProgramValid = CompileScheme(kFALSE);
+      fProgramReady = kTRUE;
+      fNProcessed = 0;
+   }
+
+   if (!fProgramValid) {
+      AliRsnCut *cut;
+      for (i = 0; i < fNumOfCuts; i++) {
+         cut = (AliRsnCut *)fCuts.At(i);
+         fBoolValues[i] = cut->IsSelected(object);
+      }
+      return Passed();
+   }
+
+   Bool_t training = (fNProcessed < fNTraining);
+   Bool_t value = kTRUE;
+   Int_t  n = fProgram.size() / 2;
+   Int_t  pc = 0;
+   while (pc < n) {
+      Int_t arg = fProgram[2 * pc + 1];
+      switch (fProgram[2 * pc]) {
+         case kPrgCut: {
+            AliRsnCut *cut = (AliRsnCut *)fCuts.UncheckedAt(arg);
+            if (training) {
+               std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+               value = cut->IsSelected(object);
+               fCutTime[arg] += std::chrono::duration<Double_t>(std::chrono::steady_clock::now() - start).count();
+               fCutCalls[arg]++;
+               if (value) fCutPassed[arg]++;
+            } else {
+               value = cut->IsSelected(object);
+            }
+            fBoolValues[arg] = value;
+            pc++;
+            break;
+         }
+         case kPrgNot:
+            value = !value;
+            pc++;
+            break;
+         case kPrgJumpIfFalse:
+            pc = value ? pc + 1 : arg;
+            break;
+         case kPrgJumpIfTrue:
+            pc = value ? arg : pc + 1;
+            break;
+         default:
+            AliError("Illegal instruction in compiled cut scheme!");
+            return kFALSE;
+      }
+   }
+
+   if (training && ++fNProcessed == fNTraining) fProgramValid = CompileScheme(kTRUE);
+
+   return value;
+}
+
 //_____________________________________________________________________________
 Bool_t AliRsnCutSet::IsValidScheme()
 {
@@ -6,12 +6,22 @@
 // and then with a logical expression which combines all cuts
 // with the "AND", "OR" and "NOT" operators.
 //
+// With SetLazyEvaluation() the scheme is compiled into a flat
+// program which evaluates the cuts only when their result is
+// needed (short-circuit). With SetCutOrderTraining(n), which
+// implies the lazy evaluation, the time and the acceptance of
+// each cut are measured on the first n objects, and the operands
+// of each AND/OR are then reordered to check the cheapest and
+// most selective cuts first.
+//
 // author: M. Vala (martin.vala@cern.ch)
 //
 
 #ifndef ALIRSNCUTSET_H
 #define ALIRSNCUTSET_H
 
+#include <vector>
+
 #include <TNamed.h>
 #include <TObjArray.h>
 
@@ -27,6 +37,14 @@ class AliRsnEvent;
 class AliRsnCutSet : public AliRsnTarget {
 public:
 
+   // instructions of the compiled cut scheme
+   enum EProgramOp {
+      kPrgCut = 0,     // evaluate cut 'arg' into the accumulator
+      kPrgNot,         // negate the accumulator
+      kPrgJumpIfFalse, // jump to instruction 'arg' if the accumulator is kFALSE
+      kPrgJumpIfTrue   // jump to instruction 'arg' if the accumulator is kTRUE
+   };
+
    AliRsnCutSet();
    AliRsnCutSet(const char *name, RSNTARGET target);
    AliRsnCutSet(const AliRsnCutSet &copy);
@@ -62,8 +80,16 @@ public:
 
    void UseMonitor(Bool_t useMonitor=kTRUE) { fUseMonitor = useMonitor; }
 
+   void SetLazyEvaluation(Bool_t yn = kTRUE) { fLazyEvaluation = yn; fProgramReady = kFALSE; }
+   Bool_t IsLazyEvaluation() const { return fLazyEvaluation; }
+   void SetCutOrderTraining(Int_t n) { fNTraining = n; if (n > 0) fLazyEvaluation = kTRUE; fProgramReady = kFALSE; }
+   Int_t GetCutOrderTraining() const { return fNTraining; }
+
 private:
 
+   Bool_t            CompileScheme(Bool_t reorder);
+   Bool_t            RunProgram(TObject *object);
+
    TObjArray         fCuts;                  // array of cuts
    Int_t             fNumOfCuts;             // number of cuts
    TString           fCutScheme;             // cut scheme
@@ -76,7 +102,17 @@ private:
    TObjArray         fMonitors;              // array of monitor object
    Bool_t            fUseMonitor;            // flag if monitoring should be used
 
-   ClassDef(AliRsnCutSet, 3)   // ROOT dictionary
+   Bool_t            fLazyEvaluation;        // evaluate only the cuts needed by the scheme (compiled, short-circuit)
+   Int_t             fNTraining;             // objects used to measure the cuts before reordering the scheme (0 = keep order)
+   Int_t             fNProcessed;            //! objects checked with the current program
+   Bool_t            fProgramReady;          //! compiled program is up to date
+   Bool_t            fProgramValid;          //! scheme could be compiled (otherwise the expression tree is used)
+   std::vector<Int_t>    fProgram;           //! compiled scheme, pairs of (EProgramOp, argument)
+   std::vector<Long64_t> fCutCalls;          //! number of evaluations of each cut
+   std::vector<Long64_t> fCutPassed;         //! number of accepted objects of each cut
+   std::vector<Double_t> fCutTime;           //! time spent in each cut [s]
+
+   ClassDef(AliRsnCutSet, 4)   // ROOT dictionary
 };
 
 #endif
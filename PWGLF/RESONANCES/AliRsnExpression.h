@@ -39,6 +39,10 @@ public:
    void SetCutSet(AliRsnCutSet *const theValue) { fgCutSet = theValue; }
    AliRsnCutSet *GetCutSet() const { return fgCutSet; }
 
+   Int_t             GetOperator() const { return fOperator; }
+   AliRsnExpression *GetArg1() const     { return fArg1; }
+   AliRsnExpression *GetArg2() const     { return fArg2; }
+
 
    TString                     fVname;   // Variable name
    static AliRsnCutSet        *fgCutSet; // global cutset
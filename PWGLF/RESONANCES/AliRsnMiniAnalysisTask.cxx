@@ -13,6 +13,10 @@
 // Developers: F. Bellini (fbellini@cern.ch)
 
 #include <Riostream.h>
+#include <algorithm>
+#include <map>
+#include <tuple>
+#include <vector>
 
 #include <TObjString.h>
 #include <TH1.h>
@@ -587,7 +591,7 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // prepare variables
    Int_t ievt, nEvents = (Int_t)fEvBuffer->GetEntries();
    Int_t idef, nDefs   = fHistograms.GetEntries();
-   Int_t imix, iloop, ifill;
+   Int_t imix, ifill;
    AliRsnMiniOutput *def = 0x0;
    AliRsnMiniOutput::EComputation compType;
 
@@ -602,10 +606,16 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    // using the appropriate procedure depending on its type
    // only mother-related histograms are filled in UserExec,
    // since they require direct access to MC event
+   // the mixing keys of all events are kept, so that the buffer
+   // does not need to be read again to search for mixing partners
+   std::vector<Float_t> evVz(nEvents), evMult(nEvents), evAngle(nEvents);
    timer.Start();
    for (ievt = 0; ievt < nEvents; ievt++) {
       // get next entry
       fEvBuffer->GetEntry(ievt);
+      evVz[ievt]    = fMiniEvent->Vz();
+      evMult[ievt]  = fMiniEvent->Mult();
+      evAngle[ievt] = fMiniEvent->Angle();
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] Std.Event %d/%d",GetName(), ievt,nEvents));
          timer.Stop(); timer.Print(); fflush(stdout); timer.Start(kFALSE);
@@ -656,65 +666,88 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
    }
 
    // initialize mixing counter
-   Int_t    nmatched[nEvents];
-   TString *smatched = new TString[nEvents];
-   for (ievt = 0; ievt < nEvents; ievt++) {
-      smatched[ievt] = "|";
-      nmatched[ievt] = 0;
-   }
-
+   std::vector<Int_t> nmatched(nEvents, 0);
+   std::vector< std::vector<Int_t> > matched(nEvents);
 
    AliInfo(Form("[%s] Std.Event %d/%d",GetName(), nEvents,nEvents));
    timer.Stop(); timer.Print(); timer.Start(); fflush(stdout);
 
+   // group the events in cells of the mixing keys:
+   // - binned mixing: the cell is the mixing bin, events match only within the same cell
+   // - continuous mixing: cells of width fMaxDiffVz and fMaxDiffMult (slightly enlarged
+   //   to absorb rounding), matching events are in the same or in a neighbouring cell
+   auto getCell = [this](Float_t vz, Float_t mult, Float_t angle) {
+      if (!fContinuousMix) return std::make_tuple((Int_t)(vz / fMaxDiffVz), (Int_t)(mult / fMaxDiffMult), (Int_t)(angle / fMaxDiffAngle));
+      Int_t cvz = (fMaxDiffVz > 0.) ? TMath::FloorNint(vz / (1.001 * fMaxDiffVz)) : 0;
+      Int_t cmult = (fMaxDiffMult > 0.) ? TMath::FloorNint(mult / (1.001 * fMaxDiffMult)) : 0;
+      return std::make_tuple(cvz, cmult, 0);
+   };
+   std::map< std::tuple<Int_t, Int_t, Int_t>, std::vector<Int_t> > cells;
+   for (ievt = 0; ievt < nEvents; ievt++) cells[getCell(evVz[ievt], evMult[ievt], evAngle[ievt])].push_back(ievt);
+
    // search for good matchings
+   // candidates are checked in the same order as in a scan of the whole buffer
+   // starting from the event following the main one
+   std::vector<Int_t> candidates;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
       if (nmatched[ievt] >= fNMix) continue;
-      fEvBuffer->GetEntry(ievt);
-      AliRsnMiniEvent evMain(*fMiniEvent);
-      for (iloop = 1; iloop < nEvents; iloop++) {
-         imix = ievt + iloop;
-         if (imix >= nEvents) imix -= nEvents;
-         if (imix == ievt) continue;
-         // text next entry
-         fEvBuffer->GetEntry(imix);
-         // skip if events are not matched
-         if (!EventsMatch(&evMain, fMiniEvent)) continue;
+      candidates.clear();
+      auto cellMain = getCell(evVz[ievt], evMult[ievt], evAngle[ievt]);
+      if (fContinuousMix) {
+         for (Int_t dvz = -1; dvz <= 1; dvz++) {
+            for (Int_t dmult = -1; dmult <= 1; dmult++) {
+               auto itCell = cells.find(std::make_tuple(std::get<0>(cellMain) + dvz, std::get<1>(cellMain) + dmult, 0));
+               if (itCell == cells.end()) continue;
+               for (Int_t jevt : itCell->second) {
+                  if (jevt == ievt) continue;
+                  if (!MixingKeysMatch(evVz[ievt], evMult[ievt], evAngle[ievt], evVz[jevt], evMult[jevt], evAngle[jevt])) continue;
+                  candidates.push_back(jevt);
+               }
+            }
+         }
+         std::sort(candidates.begin(), candidates.end(), [ievt, nEvents](Int_t a, Int_t b) {
+            return (a - ievt + nEvents) % nEvents < (b - ievt + nEvents) % nEvents;
+         });
+      } else {
+         const std::vector<Int_t> &cell = cells[cellMain];
+         auto itNext = std::upper_bound(cell.begin(), cell.end(), ievt);
+         candidates.insert(candidates.end(), itNext, cell.end());
+         candidates.insert(candidates.end(), cell.begin(), itNext - 1);
+      }
+      for (Int_t jcand = 0; jcand < (Int_t)candidates.size(); jcand++) {
+         imix = candidates[jcand];
          // check that the array of good matches for mixed does not already contain main event
-         if (smatched[imix].Contains(Form("|%d|", ievt))) continue;
+         if (std::find(matched[imix].begin(), matched[imix].end(), ievt) != matched[imix].end()) continue;
          // check that the found good events has not enough matches already
          if (nmatched[imix] >= fNMix) continue;
          // add new mixing candidate
-         smatched[ievt].Append(Form("%d|", imix));
+         matched[ievt].push_back(imix);
          nmatched[ievt]++;
          nmatched[imix]++;
          if (nmatched[ievt] >= fNMix) break;
       }
-      AliDebugClass(1, Form("Matches for event %5d = %d [%s] (missing are declared above)", evMain.ID(), nmatched[ievt], smatched[ievt].Data()));
+      AliDebugClass(1, Form("Matches for event %5d = %d (missing are declared above)", ievt, nmatched[ievt]));
    }
 
    AliInfo(Form("[%s] EventMixing searching %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout); timer.Start();
 
    // perform mixing
-   TObjArray *list = 0x0;
-   TObjString *os = 0x0;
    for (ievt = 0; ievt < nEvents; ievt++) {
       if (printNum&&(ievt%printNum==0)) {
          AliInfo(Form("[%s] EventMixing %d/%d",GetName(),ievt,nEvents));
          timer.Stop(); timer.Print(); timer.Start(kFALSE); fflush(stdout);
       }
+      if (matched[ievt].empty()) continue;
       ifill = 0;
       fEvBuffer->GetEntry(ievt);
       AliRsnMiniEvent evMain(*fMiniEvent);
-      list = smatched[ievt].Tokenize("|");
-      TObjArrayIter next(list);
-      while ( (os = (TObjString *)next()) ) {
-         imix = os->GetString().Atoi();
+      for (Int_t jmatch = 0; jmatch < (Int_t)matched[ievt].size(); jmatch++) {
+         imix = matched[ievt][jmatch];
          fEvBuffer->GetEntry(imix);
          for (idef = 0; idef < nDefs; idef++) {
             def = (AliRsnMiniOutput *)fHistograms[idef];
@@ -727,11 +760,8 @@ void AliRsnMiniAnalysisTask::FinishTaskOutput()
             }
          }
       }
-      delete list;
    }
 
-   delete [] smatched;
-
    AliInfo(Form("[%s] EventMixing %d/%d",GetName(),nEvents,nEvents));
    timer.Stop(); timer.Print(); fflush(stdout);
 
@@ -1678,13 +1708,21 @@ void AliRsnMiniAnalysisTask::SetDselection(UShort_t originDselection)
 Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEvent *event2)
 {
    if (!event1 || !event2) return kFALSE;
+   return MixingKeysMatch(event1->Vz(), event1->Mult(), event1->Angle(), event2->Vz(), event2->Mult(), event2->Angle());
+}
+
+//__________________________________________________________________________________________________
+/// Check if two events match for mixing, given their vertex z, multiplicity and angle.
+///
+Bool_t AliRsnMiniAnalysisTask::MixingKeysMatch(Float_t vz1, Float_t mult1, Float_t angle1, Float_t vz2, Float_t mult2, Float_t angle2) const
+{
    Int_t ivz1, ivz2, imult1, imult2, iangle1, iangle2;
    Double_t dv, dm, da;
 
    if (fContinuousMix) {
-      dv = TMath::Abs(event1->Vz()    - event2->Vz()   );
-      dm = TMath::Abs(event1->Mult()  - event2->Mult() );
-      da = TMath::Abs(event1->Angle() - event2->Angle());
+      dv = TMath::Abs(vz1    - vz2   );
+      dm = TMath::Abs(mult1  - mult2 );
+      da = TMath::Abs(angle1 - angle2);
       if (dv > fMaxDiffVz) {
          //AliDebugClass(2, Form("Events #%4d and #%4d don't match due to a too large diff in Vz = %f", event1->ID(), event2->ID(), dv));
          return kFALSE;
@@ -1699,12 +1737,12 @@ Bool_t AliRsnMiniAnalysisTask::EventsMatch(AliRsnMiniEvent *event1, AliRsnMiniEv
       }
       return kTRUE;
    } else {
-      ivz1 = (Int_t)(event1->Vz() / fMaxDiffVz);
-      ivz2 = (Int_t)(event2->Vz() / fMaxDiffVz);
-      imult1 = (Int_t)(event1->Mult() / fMaxDiffMult);
-      imult2 = (Int_t)(event2->Mult() / fMaxDiffMult);
-      iangle1 = (Int_t)(event1->Angle() / fMaxDiffAngle);
-      iangle2 = (Int_t)(event2->Angle() / fMaxDiffAngle);
+      ivz1 = (Int_t)(vz1 / fMaxDiffVz);
+      ivz2 = (Int_t)(vz2 / fMaxDiffVz);
+      imult1 = (Int_t)(mult1 / fMaxDiffMult);
+      imult2 = (Int_t)(mult2 / fMaxDiffMult);
+      iangle1 = (Int_t)(angle1 / fMaxDiffAngle);
+      iangle2 = (Int_t)(angle2 / fMaxDiffAngle);
       if (ivz1 != ivz2) return kFALSE;
       if (imult1 != imult2) return kFALSE;
       if (iangle1 != iangle2) return kFALSE;
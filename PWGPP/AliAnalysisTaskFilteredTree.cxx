@@ -79,6 +79,7 @@
 #include "AliMCEventHandler.h"
 #include "AliFilteredTreeEventCuts.h"
 #include "AliFilteredTreeAcceptanceCuts.h"
+#include "AliFilteredTreeWriter.h"
 
 #include "AliAnalysisTaskFilteredTree.h"
 #include "AliKFParticle.h"
@@ -144,6 +145,11 @@ ClassImp(AliAnalysisTaskFilteredTree)
   , fPtResCentPtTPCITS(0)
   , fCurrentFileName("")
   , fDummyTrack(0)
+  , fCompactOutputPrefix("")
+  , fCompactMaxBytes(0)
+  , fCompactMaxEntries(0)
+  , fCompactOutputOnly(kFALSE)
+  , fCompactWriter(0)
 {
   // Constructor
 
@@ -219,6 +225,17 @@ void AliAnalysisTaskFilteredTree::UserCreateOutputObjects()
   fLaserTree = ((*fTreeSRedirector)<<"Laser").GetTree();
   fMCEffTree = ((*fTreeSRedirector)<<"MCEffTree").GetTree();
   fCosmicPairsTree = ((*fTreeSRedirector)<<"CosmicPairs").GetTree();
+  //
+  // compact output
+  if (!fCompactOutputPrefix.IsNull()) {
+    fCompactWriter = new AliFilteredTreeWriter(fCompactOutputPrefix.Data());
+    fCompactWriter->SetMaxFileSize(fCompactMaxBytes);
+    fCompactWriter->SetMaxEntries(fCompactMaxEntries);
+    if (!fCompactWriter->Open()) {
+      delete fCompactWriter;
+      fCompactWriter=0;
+    }
+  }
 
   if (!fDummyTrack)  {
     fDummyTrack=new AliESDtrack();
@@ -410,6 +427,7 @@ void AliAnalysisTaskFilteredTree::UserExec(Option_t *)
     //ProcessMC();  //TODO - enable MC detailed view switch after holidays
   }
   if (fProcessITSTPCmatchOut) ProcessITSTPCmatchOut(fESD, fESDfriend);
+  if (fCompactWriter) fCompactWriter->EndEvent();
   printf("processed event %d\n", Int_t(Entry()));
 }
 
@@ -592,6 +610,7 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
 
   // 
   AliVEventHandler* inputHandler = AliAnalysisManager::GetAnalysisManager()->GetInputEventHandler();
+  AliPIDResponse *pidResponse = inputHandler->GetPIDResponse();
   // trigger
   if(evtCuts->IsTriggerRequired())  
   {
@@ -740,6 +759,8 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
 
       AliExternalTrackParam * tpcInner = (AliExternalTrackParam *)(track->GetTPCInnerParam());
       if (!tpcInner) continue;
+      // parameters at the TPC inner wall for the compact output, tpcInner is moved to the DCA below
+      AliExternalTrackParam tpcInnerWall(*tpcInner);
       // transform to the track reference frame 
       Bool_t isOK = kFALSE;
       isOK = tpcInner->Rotate(track->GetAlpha());
@@ -750,8 +771,23 @@ void AliAnalysisTaskFilteredTree::Process(AliESDEvent *const esdEvent, AliMCEven
       // vertex
       // TPC-ITS tracks
       //
-      TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
       if(!fFillTree) return;
+      if (fCompactWriter) {
+        fCompactWriter->FillEvent(esdEvent,vtxESD,gid,centralityF);
+        // n sigmas as in ProcessAll(), not available (-999) without PID response
+        const Int_t nSpecies=AliPID::kSPECIESC;
+        Double_t tpcNsigma[nSpecies];
+        Double_t tofNsigma[nSpecies];
+        if (pidResponse) {
+          for (Int_t ispecie=0; ispecie<nSpecies; ++ispecie) {
+            tpcNsigma[ispecie] = pidResponse->NumberOfSigmas(AliPIDResponse::kTPC, track, (AliPID::EParticleType)ispecie);
+            tofNsigma[ispecie] = pidResponse->NumberOfSigmas(AliPIDResponse::kTOF, track, (AliPID::EParticleType)ispecie);
+          }
+        }
+        fCompactWriter->FillHighPt(track,&tpcInnerWall,pidResponse ? tpcNsigma:0,pidResponse ? tofNsigma:0,nSpecies,weight,selectionPtMask);
+        if (fCompactOutputOnly) {downscaleCounter++; continue;}
+      }
+      TObjString triggerClass = esdEvent->GetFiredTriggerClasses().Data();
       if(!fTreeSRedirector) return;
       downscaleCounter++;
       (*fTreeSRedirector)<<"highPt"<<
@@ -1516,7 +1552,12 @@ void AliAnalysisTaskFilteredTree::ProcessAll(AliESDEvent *const esdEvent, AliMCE
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTPC, track, nSpecies, tpcPID.GetMatrixArray());
 	  pidResponse->ComputePIDProbability(AliPIDResponse::kTOF, track, nSpecies, tofPID.GetMatrixArray());	    
 	}
-        if(fTreeSRedirector && dumpToTree && fFillTree) {
+        if(fCompactWriter && dumpToTree && fFillTree) {
+          fCompactWriter->FillEvent(esdEvent,vtxESD,gid,centralityF);
+          fCompactWriter->FillHighPt(track,0,pidResponse ? tpcNsigma.GetMatrixArray():0,pidResponse ? tofNsigma.GetMatrixArray():0,nSpecies,weight,selectionPtMask);
+          if (fCompactOutputOnly) downscaleCounter++;
+        }
+        if(fTreeSRedirector && dumpToTree && fFillTree && !fCompactOutputOnly) {
 	  downscaleCounter++;
           (*fTreeSRedirector)<<"highPt"<<
 	    "downscaleCounter="<<downscaleCounter<<
@@ -2177,6 +2218,14 @@ void AliAnalysisTaskFilteredTree::ProcessV0(AliESDEvent *const esdEvent, AliMCEv
         if (fESDtool->IsPileup(track0->GetLabel())) isPileUpMC+=1;
         if (fESDtool->IsPileup(track1->GetLabel())) isPileUpMC+=2;
       }
+      if (fCompactWriter) {
+        fCompactWriter->FillEvent(esdEvent,vtxESD,gid,centralityF);
+        fCompactWriter->FillV0(v0,type,track0,track1,
+                               pidResponse ? tpcNsigma0.GetMatrixArray():0,pidResponse ? tofNsigma0.GetMatrixArray():0,
+                               pidResponse ? tpcNsigma1.GetMatrixArray():0,pidResponse ? tofNsigma1.GetMatrixArray():0,
+                               nSpecies,weight,selectionPtMask);
+        if (fCompactOutputOnly) continue;
+      }
       (*fTreeSRedirector)<<"V0s"<<
                          "gid="<<gid<<                         //  global id of event
                          "fLowPtV0DownscaligF="<<fLowPtV0DownscaligF<<
@@ -2784,6 +2833,11 @@ void AliAnalysisTaskFilteredTree::FinishTaskOutput()
   }
   if (deleteTrees) delete fTreeSRedirector;
   fTreeSRedirector=NULL;
+  if (fCompactWriter) {
+    fCompactWriter->Close();
+    delete fCompactWriter;
+    fCompactWriter=NULL;
+  }
 }
 
 //_____________________________________________________________________________
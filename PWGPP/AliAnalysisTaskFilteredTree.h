@@ -22,6 +22,10 @@
    3.) "Laser"      - dump laser tracks with space points if exists
    4.) "CosmicTree" - cosmic track candidate (random or triggered) + esdTracks(up/down)+ optional points
    5.) "dEdx"       - tree with high dEdx tpc tracks
+   Optional compact output (SetCompactOutput) - typed fixed layout trees written by AliFilteredTreeWriter
+   to size/entry bounded files, see AliFilteredTreeWriter:
+   1.) "highPtC"    - compact highPt tree
+   2.) "V0sC"       - compact V0 tree
 */
 class AliESDEvent;
 class AliMCEvent;
@@ -45,6 +49,7 @@ class TTreeSRedirector;
 class TParticle;
 class TH3D;
 class AliESDtools;
+class AliFilteredTreeWriter;
 #include <string>
 
 #include "AliTriggerAnalysis.h"
@@ -131,6 +136,12 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
 
   void SetFillTrees(Bool_t filltree) { fFillTree = filltree ;}
   Bool_t GetFillTrees() { return fFillTree ;}
+  /// compact highPt/V0 output in files <prefix>_<index>.root, new file when maxBytes (compressed) or maxEntries reached (0 = no limit)
+  /// compactOnly - skip the highPt and V0s entries of the TTreeSRedirector output
+  void SetCompactOutput(const char *prefix, Long64_t maxBytes=0, Long64_t maxEntries=0, Bool_t compactOnly=kFALSE) {
+    fCompactOutputPrefix = prefix; fCompactMaxBytes = maxBytes; fCompactMaxEntries = maxEntries; fCompactOutputOnly = compactOnly;
+  }
+  AliFilteredTreeWriter* GetCompactWriter() const { return fCompactWriter; }
 
   void FillHistograms(AliESDtrack* const ptrack, AliExternalTrackParam* const ptpcInnerC, Double_t centralityF, Double_t chi2TPCInnerC);
   Int_t   GetNearestTrack(const AliExternalTrackParam * trackMatch, Int_t indexSkip, AliESDEvent*event, Int_t trackType, Int_t paramType,  AliExternalTrackParam & paramNearest);
@@ -202,10 +213,15 @@ class AliAnalysisTaskFilteredTree : public AliAnalysisTaskSE {
   TH3D* fPtResCentPtTPCITS; //! sigma(pt)/pt vs Cent vs Pt for prim. TPC+ITS tracks
   TObjString fCurrentFileName; // cached value of current file name
   AliESDtrack* fDummyTrack; //! dummy track for tree init
+  TString  fCompactOutputPrefix;    // prefix of the compact output files (empty - no compact output)
+  Long64_t fCompactMaxBytes;        // max compressed size of the compact output file
+  Long64_t fCompactMaxEntries;      // max entries per tree of the compact output file
+  Bool_t   fCompactOutputOnly;      // highPt and V0s written only to the compact output
+  AliFilteredTreeWriter* fCompactWriter; //! writer of the compact output
 
   AliAnalysisTaskFilteredTree(const AliAnalysisTaskFilteredTree&); // not implemented
   AliAnalysisTaskFilteredTree& operator=(const AliAnalysisTaskFilteredTree&); // not implemented
-  ClassDef(AliAnalysisTaskFilteredTree, 1); // example of analysis
+  ClassDef(AliAnalysisTaskFilteredTree, 2); // example of analysis
 };
 
 #endif
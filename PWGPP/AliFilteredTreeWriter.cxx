@@ -0,0 +1,313 @@
+/**************************************************************************
+* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+*                                                                        *
+* Author: The ALICE Off-line Project.                                    *
+* Contributors are mentioned in the code where appropriate.              *
+*                                                                        *
+* Permission to use, copy, modify and distribute this software and its   *
+* documentation strictly for non-commercial purposes is hereby granted   *
+* without fee, provided that the above copyright notice appears in all   *
+* copies and that both the copyright notice and this permission notice   *
+* appear in the supporting documentation. The authors make no claims     *
+* about the suitability of this software for any purpose. It is          *
+* provided "as is" without express or implied warranty.                  *
+**************************************************************************/
+
+#include <TFile.h>
+#include <TTree.h>
+#include <TDirectory.h>
+
+#include "AliLog.h"
+#include "AliESDEvent.h"
+#include "AliESDVertex.h"
+#include "AliESDtrack.h"
+#include "AliESDv0.h"
+#include "AliExternalTrackParam.h"
+#include "AliFilteredTreeWriter.h"
+
+ClassImp(AliFilteredTreeWriter)
+
+//_____________________________________________________________________________
+AliFilteredTreeWriter::AliFilteredTreeWriter(const char *prefix)
+  : TObject()
+  , fPrefix(prefix)
+  , fMaxBytes(0)
+  , fMaxEntries(0)
+  , fFileIndex(-1)
+  , fFile(0)
+  , fEvent()
+  , fTrack()
+  , fTrack0()
+  , fTrack1()
+  , fV0()
+  , fWeight(0)
+  , fSelectionMask(0)
+{
+  // Constructor
+  for (Int_t i=0; i<kNTrees; i++) fTree[i]=0;
+}
+
+//_____________________________________________________________________________
+AliFilteredTreeWriter::~AliFilteredTreeWriter()
+{
+  // Destructor - write and close the current file
+  Close();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::DeclareEvent(TTree *tree)
+{
+  // event branches, common for all trees
+  tree->Branch("gid",&fEvent.fGID,"gid/l");
+  tree->Branch("runNumber",&fEvent.fRunNumber,"runNumber/I");
+  tree->Branch("evtTimeStamp",&fEvent.fTimeStamp,"evtTimeStamp/i");
+  tree->Branch("Bz",&fEvent.fBz,"Bz/F");
+  tree->Branch("vertex",fEvent.fVertex,"vertex[3]/F");
+  tree->Branch("mult",&fEvent.fNContributors,"mult/I");
+  tree->Branch("ntracks",&fEvent.fNTracks,"ntracks/I");
+  tree->Branch("centralityF",&fEvent.fCentrality,"centralityF/F");
+  tree->Branch("triggerMask",&fEvent.fTriggerMask,"triggerMask/l");
+  tree->Branch("triggerMaskNext50",&fEvent.fTriggerMaskNext50,"triggerMaskNext50/l");
+  tree->Branch("weight",&fWeight,"weight/F");
+  tree->Branch("selectionPtMask",&fSelectionMask,"selectionPtMask/I");
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::DeclareTrack(TTree *tree, const char *name, TrackRecord &record)
+{
+  // track branches <name>.<variable>
+  TString n(name);
+  tree->Branch(n+".fX",&record.fX,"fX/F");
+  tree->Branch(n+".fAlpha",&record.fAlpha,"fAlpha/F");
+  tree->Branch(n+".fP",record.fP,"fP[5]/F");
+  tree->Branch(n+".fC",record.fC,"fC[15]/F");
+  tree->Branch(n+".fInnerX",&record.fInnerX,"fInnerX/F");
+  tree->Branch(n+".fInnerAlpha",&record.fInnerAlpha,"fInnerAlpha/F");
+  tree->Branch(n+".fInnerP",record.fInnerP,"fInnerP[5]/F");
+  tree->Branch(n+".fInnerC",record.fInnerC,"fInnerC[15]/F");
+  tree->Branch(n+".fDCA",record.fDCA,"fDCA[2]/F");
+  tree->Branch(n+".fDCACov",record.fDCACov,"fDCACov[3]/F");
+  tree->Branch(n+".fTPCsignal",&record.fTPCsignal,"fTPCsignal/F");
+  tree->Branch(n+".fTPCchi2",&record.fTPCchi2,"fTPCchi2/F");
+  tree->Branch(n+".fITSchi2",&record.fITSchi2,"fITSchi2/F");
+  tree->Branch(n+".fTOFsignal",&record.fTOFsignal,"fTOFsignal/F");
+  tree->Branch(n+".fTOFsignalDz",&record.fTOFsignalDz,"fTOFsignalDz/F");
+  tree->Branch(n+".fTOFsignalDx",&record.fTOFsignalDx,"fTOFsignalDx/F");
+  tree->Branch(n+".fLength",&record.fLength,"fLength/F");
+  tree->Branch(n+".fTPCnSigma",record.fTPCnSigma,TString::Format("fTPCnSigma[%d]/F",AliPID::kSPECIESC));
+  tree->Branch(n+".fTOFnSigma",record.fTOFnSigma,TString::Format("fTOFnSigma[%d]/F",AliPID::kSPECIESC));
+  tree->Branch(n+".fStatus",&record.fStatus,"fStatus/l");
+  tree->Branch(n+".fLabel",&record.fLabel,"fLabel/I");
+  tree->Branch(n+".fTPCncl",&record.fTPCncl,"fTPCncl/S");
+  tree->Branch(n+".fTPCnclF",&record.fTPCnclF,"fTPCnclF/S");
+  tree->Branch(n+".fTPCsignalN",&record.fTPCsignalN,"fTPCsignalN/S");
+  tree->Branch(n+".fITSncl",&record.fITSncl,"fITSncl/b");
+  tree->Branch(n+".fITSClusterMap",&record.fITSClusterMap,"fITSClusterMap/b");
+}
+
+//_____________________________________________________________________________
+Bool_t AliFilteredTreeWriter::Open()
+{
+  //
+  // Open next output file and declare the trees
+  //
+  Close();
+  fFileIndex++;
+  TDirectory *dirBackup=gDirectory;
+  TString fileName=GetFileName(fFileIndex);
+  fFile=TFile::Open(fileName.Data(),"recreate");
+  if (!fFile || fFile->IsZombie()) {
+    AliError(Form("Can not open output file %s",fileName.Data()));
+    delete fFile;
+    fFile=0;
+    if (dirBackup) dirBackup->cd();
+    return kFALSE;
+  }
+  fFile->cd();
+  //
+  fTree[kHighPt]=new TTree("highPtC","compact highPt tree");
+  DeclareEvent(fTree[kHighPt]);
+  DeclareTrack(fTree[kHighPt],"track",fTrack);
+  //
+  fTree[kV0]=new TTree("V0sC","compact V0 tree");
+  DeclareEvent(fTree[kV0]);
+  fTree[kV0]->Branch("v0.fPt",&fV0.fPt,"fPt/F");
+  fTree[kV0]->Branch("v0.fEta",&fV0.fEta,"fEta/F");
+  fTree[kV0]->Branch("v0.fPhi",&fV0.fPhi,"fPhi/F");
+  fTree[kV0]->Branch("v0.fRadius",&fV0.fRadius,"fRadius/F");
+  fTree[kV0]->Branch("v0.fCosPA",&fV0.fCosPA,"fCosPA/F");
+  fTree[kV0]->Branch("v0.fDCADaughters",&fV0.fDCADaughters,"fDCADaughters/F");
+  fTree[kV0]->Branch("v0.fChi2",&fV0.fChi2,"fChi2/F");
+  fTree[kV0]->Branch("v0.fMass",fV0.fMass,"fMass[4]/F");
+  fTree[kV0]->Branch("v0.fType",&fV0.fType,"fType/I");
+  fTree[kV0]->Branch("v0.fOnFly",&fV0.fOnFly,"fOnFly/O");
+  DeclareTrack(fTree[kV0],"track0",fTrack0);
+  DeclareTrack(fTree[kV0],"track1",fTrack1);
+  if (dirBackup) dirBackup->cd();
+  AliInfo(Form("Compact filtered trees written to %s",fileName.Data()));
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::Close()
+{
+  //
+  // Write the trees and close the current file
+  //
+  if (!fFile) return;
+  TDirectory *dirBackup=(gDirectory==fFile) ? 0:gDirectory;
+  fFile->cd();
+  for (Int_t i=0; i<kNTrees; i++) {
+    if (fTree[i]) fTree[i]->Write();
+  }
+  fFile->Close();
+  delete fFile;       // trees are owned by the file
+  fFile=0;
+  for (Int_t i=0; i<kNTrees; i++) fTree[i]=0;
+  if (dirBackup) dirBackup->cd();
+}
+
+//_____________________________________________________________________________
+Long64_t AliFilteredTreeWriter::GetCurrentSize() const
+{
+  // compressed size of the baskets written to the current file
+  // baskets still in memory are not counted - limit is respected up to the size of one flush cluster
+  Long64_t size=0;
+  for (Int_t i=0; i<kNTrees; i++) {
+    if (fTree[i]) size+=fTree[i]->GetZipBytes();
+  }
+  return size;
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::EndEvent()
+{
+  //
+  // Switch to the next file if one of the limits was reached
+  // called at the event boundary - all entries of one event are in the same file
+  //
+  if (!fFile) return;
+  Bool_t full=kFALSE;
+  if (fMaxEntries>0) {
+    for (Int_t i=0; i<kNTrees; i++) if (fTree[i] && fTree[i]->GetEntries()>=fMaxEntries) full=kTRUE;
+  }
+  if (fMaxBytes>0 && GetCurrentSize()>=fMaxBytes) full=kTRUE;
+  if (full) Open();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::FillEvent(const AliESDEvent *event, const AliESDVertex *vertex, ULong64_t gid, Float_t centrality)
+{
+  //
+  // Set event record - to be called before the track/V0 entries of the event
+  //
+  fEvent.fGID=gid;
+  fEvent.fRunNumber=event->GetRunNumber();
+  fEvent.fTimeStamp=event->GetTimeStamp();
+  fEvent.fBz=event->GetMagneticField();
+  fEvent.fNTracks=event->GetNumberOfTracks();
+  fEvent.fCentrality=centrality;
+  fEvent.fTriggerMask=event->GetTriggerMask();
+  fEvent.fTriggerMaskNext50=event->GetTriggerMaskNext50();
+  fEvent.fVertex[0]=fEvent.fVertex[1]=fEvent.fVertex[2]=0;
+  fEvent.fNContributors=0;
+  if (vertex) {
+    fEvent.fVertex[0]=vertex->GetX();
+    fEvent.fVertex[1]=vertex->GetY();
+    fEvent.fVertex[2]=vertex->GetZ();
+    fEvent.fNContributors=vertex->GetNContributors();
+  }
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::FillTrack(TrackRecord &record, const AliESDtrack *track, const AliExternalTrackParam *innerWall, const Double_t *tpcNSigma, const Double_t *tofNSigma, Int_t nSpecies)
+{
+  //
+  // Copy track information to the record
+  // innerWall - TPC parameters at the inner wall, if 0 - AliESDtrack::GetTPCInnerParam()
+  //             to be given if the TPC inner parameters of the track were moved (e.g. to the DCA)
+  // nSigma    - n sigma arrays (nSpecies values), can be 0 - stored as -999 (not available)
+  //
+  record.fX=track->GetX();
+  record.fAlpha=track->GetAlpha();
+  const Double_t *param=track->GetParameter();
+  const Double_t *cov=track->GetCovariance();
+  for (Int_t i=0; i<5; i++) record.fP[i]=param[i];
+  for (Int_t i=0; i<15; i++) record.fC[i]=cov[i];
+  //
+  const AliExternalTrackParam *inner=innerWall ? innerWall:track->GetTPCInnerParam();
+  if (inner) {
+    record.fInnerX=inner->GetX();
+    record.fInnerAlpha=inner->GetAlpha();
+    param=inner->GetParameter();
+    cov=inner->GetCovariance();
+    for (Int_t i=0; i<5; i++) record.fInnerP[i]=param[i];
+    for (Int_t i=0; i<15; i++) record.fInnerC[i]=cov[i];
+  }else{
+    record.fInnerX=record.fInnerAlpha=0;
+    for (Int_t i=0; i<5; i++) record.fInnerP[i]=0;
+    for (Int_t i=0; i<15; i++) record.fInnerC[i]=0;
+  }
+  track->GetImpactParameters(record.fDCA,record.fDCACov);
+  //
+  record.fTPCsignal=track->GetTPCsignal();
+  record.fTPCchi2=track->GetTPCchi2();
+  record.fITSchi2=track->GetITSchi2();
+  record.fTOFsignal=track->GetTOFsignal();
+  record.fTOFsignalDz=track->GetTOFsignalDz();
+  record.fTOFsignalDx=track->GetTOFsignalDx();
+  record.fLength=track->GetIntegratedLength();
+  for (Int_t i=0; i<AliPID::kSPECIESC; i++) {
+    record.fTPCnSigma[i]=(tpcNSigma && i<nSpecies) ? tpcNSigma[i]:-999;
+    record.fTOFnSigma[i]=(tofNSigma && i<nSpecies) ? tofNSigma[i]:-999;
+  }
+  record.fStatus=track->GetStatus();
+  record.fLabel=track->GetLabel();
+  record.fTPCncl=track->GetTPCNcls();
+  record.fTPCnclF=track->GetTPCNclsF();
+  record.fTPCsignalN=track->GetTPCsignalN();
+  record.fITSncl=track->GetITSNcls();
+  record.fITSClusterMap=track->GetITSClusterMap();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::FillHighPt(const AliESDtrack *track, const AliExternalTrackParam *innerWall, const Double_t *tpcNSigma, const Double_t *tofNSigma, Int_t nSpecies, Float_t weight, Int_t selectionMask)
+{
+  //
+  // Fill entry of the highPt tree - event record has to be set before (FillEvent)
+  //
+  if (!fTree[kHighPt] || !track) return;
+  fWeight=weight;
+  fSelectionMask=selectionMask;
+  FillTrack(fTrack,track,innerWall,tpcNSigma,tofNSigma,nSpecies);
+  fTree[kHighPt]->Fill();
+}
+
+//_____________________________________________________________________________
+void AliFilteredTreeWriter::FillV0(const AliESDv0 *v0, Int_t type, const AliESDtrack *track0, const AliESDtrack *track1,
+                                   const Double_t *tpcNSigma0, const Double_t *tofNSigma0, const Double_t *tpcNSigma1, const Double_t *tofNSigma1, Int_t nSpecies,
+                                   Float_t weight, Int_t selectionMask)
+{
+  //
+  // Fill entry of the V0 tree - event record has to be set before (FillEvent)
+  //
+  if (!fTree[kV0] || !v0 || !track0 || !track1) return;
+  fWeight=weight;
+  fSelectionMask=selectionMask;
+  fV0.fPt=v0->Pt();
+  fV0.fEta=v0->Eta();
+  fV0.fPhi=v0->Phi();
+  fV0.fRadius=v0->GetRr();
+  fV0.fCosPA=v0->GetV0CosineOfPointingAngle();
+  fV0.fDCADaughters=v0->GetDcaV0Daughters();
+  fV0.fChi2=v0->GetChi2V0();
+  fV0.fMass[0]=v0->GetEffMass(0,0);
+  fV0.fMass[1]=v0->GetEffMass(2,2);
+  fV0.fMass[2]=v0->GetEffMass(4,2);
+  fV0.fMass[3]=v0->GetEffMass(2,4);
+  fV0.fType=type;
+  fV0.fOnFly=v0->GetOnFlyStatus();
+  FillTrack(fTrack0,track0,0,tpcNSigma0,tofNSigma0,nSpecies);
+  FillTrack(fTrack1,track1,0,tpcNSigma1,tofNSigma1,nSpecies);
+  fTree[kV0]->Fill();
+}
@@ -0,0 +1,144 @@
+#ifndef ALIFILTEREDTREEWRITER_H
+#define ALIFILTEREDTREEWRITER_H
+
+//------------------------------------------------------------------------------
+/*
+   Typed writer of the compact filtered trees - used by AliAnalysisTaskFilteredTree
+   as a lightweight alternative to the TTreeSRedirector streams
+
+   * schema of each tree is declared once (in Open()) from fixed layout records:
+     only track parameters, covariances and derived variables used in the calibration/QA
+     are stored, no AliESDtrack/AliExternalTrackParam objects are streamed
+   * per entry the records are filled by value and TTree::Fill is called - no string parsing
+   * output is split in files <prefix>_<index>.root - new file is opened at the event
+     boundary (EndEvent) once the compressed size or the number of entries of the current
+     file exceeds the limit (0 = no limit)
+
+   Exported trees:
+   1.) "highPtC"  - event record + track record
+   2.) "V0sC"     - event record + V0 record + 2 track records (positive and negative daughter)
+
+   Usage:
+     AliFilteredTreeWriter writer("filteredCompact");
+     writer.SetMaxFileSize(2000000000);
+     writer.Open();
+     ... per event:  writer.FillEvent(...); writer.FillHighPt(...); writer.FillV0(...); ... writer.EndEvent();
+     writer.Close();
+*/
+//------------------------------------------------------------------------------
+
+#include "TObject.h"
+#include "TString.h"
+#include "AliPID.h"
+
+class TFile;
+class TTree;
+class AliESDEvent;
+class AliESDtrack;
+class AliESDVertex;
+class AliESDv0;
+class AliExternalTrackParam;
+
+class AliFilteredTreeWriter : public TObject {
+public:
+  enum ETreeType { kHighPt=0, kV0=1, kNTrees=2 };
+  /// event level information
+  struct EventRecord {
+    ULong64_t fGID;              // global event id
+    Int_t     fRunNumber;        // run number
+    UInt_t    fTimeStamp;        // event time stamp (s)
+    Float_t   fBz;               // magnetic field (kG)
+    Float_t   fVertex[3];        // primary vertex position
+    Int_t     fNContributors;    // number of contributors of the primary vertex
+    Int_t     fNTracks;          // number of ESD tracks
+    Float_t   fCentrality;       // centrality
+    ULong64_t fTriggerMask;      // fired trigger classes mask
+    ULong64_t fTriggerMaskNext50;// fired trigger classes mask (classes 50-100)
+  };
+  /// track information - parameters at the DCA and at the TPC inner wall
+  struct TrackRecord {
+    Float_t   fX, fAlpha;               // reference frame of the parameters at the DCA
+    Float_t   fP[5];                    // parameters at the DCA
+    Float_t   fC[15];                   // covariance at the DCA
+    Float_t   fInnerX, fInnerAlpha;     // reference frame of the TPC parameters at the inner wall
+    Float_t   fInnerP[5];               // TPC parameters at the inner wall
+    Float_t   fInnerC[15];              // TPC covariance at the inner wall
+    Float_t   fDCA[2];                  // impact parameters r-phi, z
+    Float_t   fDCACov[3];               // impact parameters covariance
+    Float_t   fTPCsignal;               // TPC dEdx
+    Float_t   fTPCchi2;                 // TPC chi2
+    Float_t   fITSchi2;                 // ITS chi2
+    Float_t   fTOFsignal;               // TOF signal
+    Float_t   fTOFsignalDz;             // TOF cluster dz
+    Float_t   fTOFsignalDx;             // TOF cluster dx
+    Float_t   fLength;                  // integrated length
+    Float_t   fTPCnSigma[AliPID::kSPECIESC]; // TPC n sigma, -999 if not available
+    Float_t   fTOFnSigma[AliPID::kSPECIESC]; // TOF n sigma, -999 if not available
+    ULong64_t fStatus;                  // track status bits
+    Int_t     fLabel;                   // MC label
+    Short_t   fTPCncl;                  // TPC clusters
+    Short_t   fTPCnclF;                 // TPC findable clusters
+    Short_t   fTPCsignalN;              // TPC clusters used for dEdx
+    UChar_t   fITSncl;                  // ITS clusters
+    UChar_t   fITSClusterMap;           // ITS cluster map
+  };
+  /// V0 information
+  struct V0Record {
+    Float_t   fPt, fEta, fPhi;          // V0 kinematics
+    Float_t   fRadius;                  // decay radius
+    Float_t   fCosPA;                   // cosine of pointing angle
+    Float_t   fDCADaughters;            // DCA between daughters
+    Float_t   fChi2;                    // V0 chi2
+    Float_t   fMass[4];                 // effective mass for AliPID hypotheses (0,0), (2,2), (4,2), (2,4)
+    Int_t     fType;                    // KF type as in AliAnalysisTaskFilteredTree::GetKFParticle
+    Bool_t    fOnFly;                   // on the fly status
+  };
+
+  AliFilteredTreeWriter(const char *prefix="filteredCompact");
+  virtual ~AliFilteredTreeWriter();
+
+  void     SetMaxFileSize(Long64_t maxBytes)   { fMaxBytes = maxBytes; }
+  void     SetMaxEntries(Long64_t maxEntries)  { fMaxEntries = maxEntries; }
+  Long64_t GetMaxFileSize() const              { return fMaxBytes; }
+  Long64_t GetMaxEntries() const               { return fMaxEntries; }
+  Int_t    GetFileIndex() const                { return fFileIndex; }
+  TString  GetFileName(Int_t index) const      { return TString::Format("%s_%03d.root",fPrefix.Data(),index); }
+  TTree*   GetTree(Int_t type) const           { return (type>=0 && type<kNTrees) ? fTree[type]:0; }
+
+  Bool_t   Open();
+  void     Close();
+  void     EndEvent();
+
+  void     FillEvent(const AliESDEvent *event, const AliESDVertex *vertex, ULong64_t gid, Float_t centrality);
+  static void FillTrack(TrackRecord &record, const AliESDtrack *track, const AliExternalTrackParam *innerWall, const Double_t *tpcNSigma, const Double_t *tofNSigma, Int_t nSpecies);
+  void     FillHighPt(const AliESDtrack *track, const AliExternalTrackParam *innerWall, const Double_t *tpcNSigma, const Double_t *tofNSigma, Int_t nSpecies, Float_t weight, Int_t selectionMask);
+  void     FillV0(const AliESDv0 *v0, Int_t type, const AliESDtrack *track0, const AliESDtrack *track1,
+                  const Double_t *tpcNSigma0, const Double_t *tofNSigma0, const Double_t *tpcNSigma1, const Double_t *tofNSigma1, Int_t nSpecies,
+                  Float_t weight, Int_t selectionMask);
+
+protected:
+  void     DeclareEvent(TTree *tree);
+  static void DeclareTrack(TTree *tree, const char *name, TrackRecord &record);
+  Long64_t GetCurrentSize() const;
+
+  TString     fPrefix;                 // output file prefix
+  Long64_t    fMaxBytes;               // max compressed size per file (0 - no limit)
+  Long64_t    fMaxEntries;             // max entries per tree per file (0 - no limit)
+  Int_t       fFileIndex;              //! index of the current file
+  TFile      *fFile;                   //! current output file
+  TTree      *fTree[kNTrees];          //! output trees
+  EventRecord fEvent;                  //! current event record
+  TrackRecord fTrack;                  //! track record (highPt)
+  TrackRecord fTrack0;                 //! positive daughter record (V0)
+  TrackRecord fTrack1;                 //! negative daughter record (V0)
+  V0Record    fV0;                     //! V0 record
+  Float_t     fWeight;                 //! downscaling weight of the entry
+  Int_t       fSelectionMask;          //! downscaling selection mask of the entry
+
+private:
+  AliFilteredTreeWriter(const AliFilteredTreeWriter&); // not implemented
+  AliFilteredTreeWriter& operator=(const AliFilteredTreeWriter&); // not implemented
+  ClassDef(AliFilteredTreeWriter, 1); // typed writer of the compact filtered trees
+};
+
+#endif
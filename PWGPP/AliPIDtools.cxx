@@ -13,6 +13,10 @@ std::map<Int_t, AliPIDResponse *> AliPIDtools::pidAll;        /// we should use
 AliESDtrack  AliPIDtools::dummyTrack;/// dummy value to save CPU - unfortunately PID object use AliVtrack - for the moment create global variable t avoid object constructions
 TTree *       AliPIDtools::fFilteredTree = NULL;
 TTree *       AliPIDtools::fFilteredTreeV0 = NULL;
+std::map<Int_t, std::vector<Double_t> > AliPIDtools::bbTable;   /// tabulated Bethe-Bloch per PID hash
+Int_t         AliPIDtools::fBBTableNPoints = 4000;
+Double_t      AliPIDtools::fBBTableLogMin = TMath::Log(0.1);
+Double_t      AliPIDtools::fBBTableLogMax = TMath::Log(1.e4);
 
 AliPIDResponse* AliPIDtools::GetPID(Int_t hash ) {return pidAll[hash];}
 AliTPCPIDResponse& AliPIDtools::GetTPCPID(Int_t hash ) {return pidAll[hash]->GetTPCResponse();}
@@ -98,6 +102,7 @@ Int_t AliPIDtools::LoadPID(Int_t run, Int_t passNumber, TString recoPass, Bool_t
   Int_t  hash=GetHash(run,passNumber, recoPass,isMC);
   pidAll[hash]=pid;     /// we should clone them
   pidTPC[hash]=&tpcpid;  ///
+  bbTable.erase(hash);   /// table of the previous response is not valid anymore
   return hash;
 }
 
@@ -114,6 +119,122 @@ Double_t AliPIDtools::GetExpectedTOFSignal(Int_t hash, const AliVTrack *track, I
   return tofPID.GetExpectedSignal(track, (AliPID::EParticleType)type);
 }
 
+/// Bethe-Bloch for an array of bg values - hash resolved once
+/// \param hash       - hash value of the PID version
+/// \param n          - number of values
+/// \param bg         - input beta*gamma array
+/// \param dEdx       - output array (n values)
+/// \param tabulated  - use BetheBlochAlephTabulated (interpolation) instead of exact formula
+/// \return           - number of values filled, 0 if hash is not registered
+Int_t AliPIDtools::BetheBlochAlephArray(Int_t hash, Int_t n, const Double_t *bg, Double_t *dEdx, Bool_t tabulated){
+  AliTPCPIDResponse *tpcPID=pidTPC[hash];
+  if (tpcPID==0) return 0;
+  if (tabulated) {
+    for (Int_t i=0; i<n; i++) dEdx[i]=BetheBlochAlephTabulated(hash,bg[i]);
+  }else{
+    for (Int_t i=0; i<n; i++) dEdx[i]=tpcPID->Bethe(bg[i]);
+  }
+  return n;
+}
+
+/// Tabulated Bethe-Bloch - linear interpolation in log(bg) of the table created at first use for given hash
+///   * table binning set by SetBetheBlochTable (default 4000 points in bg 0.1-10000)
+///   * relative precision with default binning ~1e-5 in the relativistic rise, worse close to the lowest bg
+///   * exact formula used outside of the table range
+/// \param hash       - hash value of the PID version
+/// \param bg         - beta*gamma
+/// \return           - mean TPC dEdx
+Double_t AliPIDtools::BetheBlochAlephTabulated(Int_t hash, Double_t bg){
+  AliTPCPIDResponse *tpcPID=pidTPC[hash];
+  if (tpcPID==0) return 0;
+  if (bg<=0) return tpcPID->Bethe(bg);
+  const Double_t logBG=TMath::Log(bg);
+  if (logBG<fBBTableLogMin || logBG>=fBBTableLogMax) return tpcPID->Bethe(bg);
+  const Double_t step=(fBBTableLogMax-fBBTableLogMin)/(fBBTableNPoints-1);
+  std::vector<Double_t> &table=bbTable[hash];
+  if ((Int_t)table.size()!=fBBTableNPoints){
+    table.resize(fBBTableNPoints);
+    for (Int_t i=0; i<fBBTableNPoints; i++) table[i]=tpcPID->Bethe(TMath::Exp(fBBTableLogMin+i*step));
+  }
+  const Double_t x=(logBG-fBBTableLogMin)/step;
+  Int_t index=(Int_t)x;
+  if (index>fBBTableNPoints-2) index=fBBTableNPoints-2;
+  const Double_t frac=x-index;
+  return table[index]+frac*(table[index+1]-table[index]);
+}
+
+/// Set binning of the Bethe-Bloch tables - existing tables are removed and recreated at next use
+/// \param nPoints    - number of points (>=2)
+/// \param bgMin      - lower bg edge of the table
+/// \param bgMax      - upper bg edge of the table
+void AliPIDtools::SetBetheBlochTable(Int_t nPoints, Double_t bgMin, Double_t bgMax){
+  if (nPoints<2 || bgMin<=0 || bgMax<=bgMin){
+    ::Error("AliPIDtools::SetBetheBlochTable","Invalid table binning %d (%f,%f)",nPoints,bgMin,bgMax);
+    return;
+  }
+  fBBTableNPoints=nPoints;
+  fBBTableLogMin=TMath::Log(bgMin);
+  fBBTableLogMax=TMath::Log(bgMax);
+  bbTable.clear();
+}
+
+/// Expected TPC dEdx for an array of momenta and all species - hash and dummy track set once per momenta
+/// \param hash       - hash value of the PID version
+/// \param n          - number of momenta
+/// \param p          - momenta
+/// \param dEdx       - output array n*nSpecies - dEdx[i*nSpecies+particle]
+/// \param nSpecies   - number of species (first nSpecies of AliPID::EParticleType)
+/// \return           - number of momenta filled, 0 if hash is not registered
+Int_t AliPIDtools::GetExpectedTPCSignalArray(Int_t hash, Int_t n, const Double_t *p, Double_t *dEdx, Int_t nSpecies){
+  Double_t xyz[3] = {0., 0., 0.};
+  Double_t pxyz[3] = {0, 0., 0.};
+  Double_t cv[21] = {0.}; // dummy parameters for dummy tracks
+  AliTPCPIDResponse *tpcPID=pidTPC[hash];
+  if (tpcPID==0) return 0;
+  for (Int_t i=0; i<n; i++){
+    pxyz[0]=p[i];
+    dummyTrack.Set(xyz, pxyz, cv, 1);
+    for (Int_t particle=0; particle<nSpecies; particle++){
+      dEdx[i*nSpecies+particle]= tpcPID->GetExpectedSignal(&dummyTrack, (AliPID::EParticleType)particle, AliTPCPIDResponse::kdEdxDefault, kFALSE, kTRUE);
+    }
+  }
+  return n;
+}
+
+/// Expected TOF sigma for an array of momenta and all species
+/// \param hash       - hash value of the PID version
+/// \param n          - number of momenta
+/// \param mom        - momenta
+/// \param sigma      - output array n*nSpecies - sigma[i*nSpecies+particle]
+/// \param nSpecies   - number of species
+/// \return           - number of momenta filled, 0 if hash is not registered
+Int_t AliPIDtools::GetExpectedTOFSigmaArray(Int_t hash, Int_t n, const Float_t *mom, Double_t *sigma, Int_t nSpecies){
+  Double_t dummyTime=0;
+  if (pidAll[hash]== nullptr) return 0;
+  AliTOFPIDResponse &tofPID=GetTOFPID(hash);
+  for (Int_t i=0; i<n; i++){
+    for (Int_t particle=0; particle<nSpecies; particle++){
+      sigma[i*nSpecies+particle]=tofPID.GetExpectedSigma(mom[i],dummyTime,(AliPID::EParticleType)particle);
+    }
+  }
+  return n;
+}
+
+/// Expected TOF signal of one track for all species
+/// \param hash       - hash value of the PID version
+/// \param track      - track
+/// \param time       - output array (nSpecies values)
+/// \param nSpecies   - number of species
+/// \return           - number of species filled, 0 if hash is not registered
+Int_t AliPIDtools::GetExpectedTOFSignalArray(Int_t hash, const AliVTrack *track, Double_t *time, Int_t nSpecies){
+  if (pidAll[hash]== nullptr) return 0;
+  AliTOFPIDResponse &tofPID=GetTOFPID(hash);
+  for (Int_t particle=0; particle<nSpecies; particle++){
+    time[particle]=tofPID.GetExpectedSignal(track, (AliPID::EParticleType)particle);
+  }
+  return nSpecies;
+}
+
 ///  SetFiltered tree
 /// \param filteredTree   - pointer to filtered tree
 /// \return
@@ -578,6 +699,94 @@ Float_t AliPIDtools::NumberOfSigmas(Int_t hash, Int_t detCode, Int_t particleTyp
   return value;
 }
 
+/// Return number of sigmas for all species (AliPID::kSPECIESC) of the current track
+///   * correction flags, track and event info are set once for all species
+///   * same values as NumberOfSigmas called per species
+/// \param hash           - hash value of PID correction
+/// \param detCode        - detector code (0-ITS, 1-TPC, 2-TRD, 3-TOF)  AliPIDResponse::enum EDetector
+/// \param nSigma         - output array - AliPID::kSPECIESC values
+/// \param source         - track index
+/// \param corrMask       - correction bitMask - AliPIDTools:: enum TPCCorrFlag
+/// \return               - kFALSE if PID, track or event info not available (nSigma set to 0)
+Bool_t AliPIDtools::NumberOfSigmasAll(Int_t hash, Int_t detCode, Float_t *nSigma, Int_t source, Int_t corrMask){
+  for (Int_t particle=0; particle<AliPID::kSPECIESC; particle++) nSigma[particle]=0;
+  if (pidAll[hash]==NULL) return kFALSE;
+  AliPIDResponse *pid = pidAll[hash];
+  //
+  Int_t maskBackup=0;                     // make backup of PID state
+  if (pid->UseTPCEtaCorrection()) maskBackup+=kEtaCorr;
+  if (pid->UseTPCMultiplicityCorrection()) maskBackup+=kMultCorr;
+  if (pid->UseTPCPileupCorrection()) maskBackup+=kPileUpCorr;
+  //
+  if (corrMask<0) {
+    corrMask=maskBackup;
+  }else{
+    pid->SetUseTPCEtaCorrection(corrMask&kEtaCorr);
+    pid->SetUseTPCMultiplicityCorrection(corrMask&kMultCorr);
+    pid->SetUseTPCPileupCorrection(corrMask&kPileUpCorr);
+    if (corrMask&kPileUpCorr) pid->GetTPCResponse().SetPileupCorrectionStrategy(AliTPCPIDResponse::kPileupCorrectionInExpectedSignal);
+  }
+  AliESDtrack *track=NULL;
+  Bool_t status=kTRUE;
+  if (source<0){
+    track=GetCurrentTrack();
+    status=SetTPCEventInfo(hash,corrMask);
+  }
+  if (source>=0){
+    track=GetCurrentTrackV0(source%2);
+    status=SetTPCEventInfoV0(hash,corrMask);
+  }
+  status&=(track!=NULL);
+  if (status && detCode==3){ /// for TOF use tree values
+    TVectorD *tofInfo=(source<0) ? GetTOFInfo(1):GetTOFInfoV0(source,1);
+    if (tofInfo) {
+      Int_t nValues=TMath::Min(tofInfo->GetNrows(),(Int_t)AliPID::kSPECIESC);
+      for (Int_t particle=0; particle<nValues; particle++) nSigma[particle]=(*tofInfo)[particle];
+    }
+  }else if (status) {
+    for (Int_t particle=0; particle<AliPID::kSPECIESC; particle++) {
+      nSigma[particle] = pid->NumberOfSigmas((AliPIDResponse::EDetector) detCode, track, (AliPID::EParticleType)particle);
+    }
+  }
+  // restore flags
+  pid->SetUseTPCEtaCorrection(kEtaCorr&maskBackup);
+  pid->SetUseTPCMultiplicityCorrection(maskBackup&kMultCorr);
+  pid->SetUseTPCPileupCorrection(maskBackup&kPileUpCorr);
+  return status;
+}
+
+/// Cached version of NumberOfSigmas for TTree::Draw queries
+///   * all species are evaluated with NumberOfSigmasAll at first call for given entry and arguments
+///   * following calls for other species of the same entry are served from the cache
+/// \param hash           - hash value of PID correction
+/// \param detCode        - detector code (0-ITS, 1-TPC, 2-TRD, 3-TOF)  AliPIDResponse::enum EDetector
+/// \param particleType   - see enum
+/// \param source         - track index
+/// \param corrMask       - correction bitMask - AliPIDTools:: enum TPCCorrFlag
+/// \return
+Float_t AliPIDtools::NumberOfSigmasCached(Int_t hash, Int_t detCode, Int_t particleType, Int_t source, Int_t corrMask){
+  if (particleType<0 || particleType>=AliPID::kSPECIESC) return NumberOfSigmas(hash,detCode,particleType,source,corrMask);
+  TTree *tree= (source<0) ? fFilteredTree:fFilteredTreeV0;
+  if (tree==NULL) return 0;
+  static Float_t nSigma[AliPID::kSPECIESC]={0};
+  static Long64_t lastEntry=-1;
+  static Int_t lastTreeNumber=-1, lastHash=0, lastDetCode=-1, lastSource=-2, lastCorrMask=-2;
+  static TTree *lastTree=NULL;
+  Long64_t entry=tree->GetReadEntry();
+  Int_t treeNumber=tree->GetTreeNumber();
+  if (entry!=lastEntry || treeNumber!=lastTreeNumber || tree!=lastTree || hash!=lastHash || detCode!=lastDetCode || source!=lastSource || corrMask!=lastCorrMask){
+    NumberOfSigmasAll(hash,detCode,nSigma,source,corrMask);
+    lastEntry=entry;
+    lastTreeNumber=treeNumber;
+    lastTree=tree;
+    lastHash=hash;
+    lastDetCode=detCode;
+    lastSource=source;
+    lastCorrMask=corrMask;
+  }
+  return nSigma[particleType];
+}
+
 /// Return GetSignalDelta
 /// \param hash           - hash value of PID correction
 /// \param detCode        - detector code (0-ITS, 1-TPC, 2-TRD, 3-TOF)  AliPIDResponse::enum EDetector
@@ -808,6 +1017,10 @@ void AliPIDtools::UnitTest() {
           "TOFOn&&abs(nSigma1_2)<5&&abs(nSigma3_2)<5","goff",1000);
   status=TMath::RMS(entries, fFilteredTree->GetV1())<kEpsilon;
   ::Info("UnitTest","AliPIDtools::ComputePIDProbabilityCombined(pidHash,10,2,-1,3+0,0,0.0)-AliPIDtools::ComputePIDProbability(pidHash,1,2,-1,3+0,0,0.0)*AliPIDtools::ComputePIDProbability(pidHash,3,2,-1,3+0,0,0.0)\tStatus=%d",status);
+  //   cached n sigma check
+  entries=fFilteredTree->Draw("AliPIDtools::NumberOfSigmasCached(pidHash,1,2,-1,3)+AliPIDtools::NumberOfSigmasCached(pidHash,1,4,-1,3)-AliPIDtools::NumberOfSigmas(pidHash,1,2,-1,3)-AliPIDtools::NumberOfSigmas(pidHash,1,4,-1,3)","1","goff",1000);
+  status=TMath::RMS(entries, fFilteredTree->GetV1())<kEpsilon;
+  ::Info("UnitTest","AliPIDtools::NumberOfSigmasCached(pidHash,1,2,-1,3)+AliPIDtools::NumberOfSigmasCached(pidHash,1,4,-1,3)-AliPIDtools::NumberOfSigmas(pidHash,1,2,-1,3)-AliPIDtools::NumberOfSigmas(pidHash,1,4,-1,3)\tStatus=%d",status);
 
 }
 
@@ -21,9 +21,20 @@
 /// #### Example 3: Draw Expected dEdx
 /// AliPIDtools::SetFilteredTreeV0(treeV0)
 /// treeV0->Draw("log(track0.fTPCsignal/(AliPIDtools::GetExpectedTPCSignalV0(pidHash,0,0x1,0)))","type==1&&abs(log(track1.fTPCsignal/(AliPIDtools::GetExpectedTPCSignalV0(pidHash,0,0x1,1))))<0.1","colz",20000)
+/// #### Example 4: n sigmas of all species evaluated once per track (cached for the other species)
+/// \code
+/// tree->Draw("AliPIDtools::NumberOfSigmasCached(pidHash,1,2):AliPIDtools::NumberOfSigmasCached(pidHash,1,3)","","colz",100000)
+/// \endcode
+/// #### Example 5: array interface, expected dEdx of all species for n momenta
+/// \code
+/// std::vector<Double_t> dEdx(n*AliPID::kSPECIES);
+/// AliPIDtools::GetExpectedTPCSignalArray(hash,n,p,dEdx.data());   // dEdx[i*AliPID::kSPECIES+species]
+/// \endcode
 
 #include "map"
+#include "vector"
 #include  "AliESDtrack.h"
+#include  "AliPID.h"
 class AliPIDResponse;
 class AliTPCPIDResponse;
 class AliITSPIDResponse;
@@ -48,6 +59,14 @@ public:
   static Double_t GetExpectedITSSignal(Int_t hash, Double_t p, Int_t  particle);
   static Double_t GetExpectedTOFSigma(Int_t hash, Float_t mom, Int_t type);
   static Double_t GetExpectedTOFSignal(Int_t hash, const AliVTrack *track, Int_t  type);
+  // array interface - hash resolved once, values of all species per entry: out[i*nSpecies+species]
+  static Int_t    BetheBlochAlephArray(Int_t hash, Int_t n, const Double_t *bg, Double_t *dEdx, Bool_t tabulated=kFALSE);
+  static Int_t    GetExpectedTPCSignalArray(Int_t hash, Int_t n, const Double_t *p, Double_t *dEdx, Int_t nSpecies=AliPID::kSPECIES);
+  static Int_t    GetExpectedTOFSigmaArray(Int_t hash, Int_t n, const Float_t *mom, Double_t *sigma, Int_t nSpecies=AliPID::kSPECIES);
+  static Int_t    GetExpectedTOFSignalArray(Int_t hash, const AliVTrack *track, Double_t *time, Int_t nSpecies=AliPID::kSPECIES);
+  // tabulated Bethe-Bloch - linear interpolation in log(bg), exact outside of the table range
+  static Double_t BetheBlochAlephTabulated(Int_t hash, Double_t bg);
+  static void     SetBetheBlochTable(Int_t nPoints, Double_t bgMin, Double_t bgMax);
   // TTree interface
   static AliESDtrack* GetCurrentTrack();
   static AliESDtrack* GetCurrentTrackV0(Int_t index);
@@ -63,6 +82,8 @@ public:
   static Double_t GetITSPID(Int_t hash, Int_t particleType, Int_t valueType, Float_t resol=0);
   //
   static Float_t NumberOfSigmas(Int_t hash, Int_t detCode, Int_t particleType, Int_t source=-1, Int_t corrMask=-1);
+  static Bool_t  NumberOfSigmasAll(Int_t hash, Int_t detCode, Float_t *nSigma, Int_t source=-1, Int_t corrMask=-1);
+  static Float_t NumberOfSigmasCached(Int_t hash, Int_t detCode, Int_t particleType, Int_t source=-1, Int_t corrMask=-1);
   static Float_t GetSignalDelta(Int_t hash, Int_t detCode, Int_t particleType, Int_t source=-1, Int_t corrMask=-1);
   static Float_t ComputePIDProbability(Int_t hash, Int_t detCode, Int_t particleType, Int_t source=-1, Int_t corrMask=-1,Int_t norm=1, Float_t fakeProb=0.01, Float_t* pidVector=0);
   static Float_t ComputePIDProbabilityCombined(Int_t hash, Int_t detMask, Int_t particleType, Int_t source=-1, Int_t corrMask=-1,Int_t norm=1, Float_t fakeProb=0.01);
@@ -74,6 +95,7 @@ public:
   //
   static std::map<Int_t, AliTPCPIDResponse *> pidTPC;     /// we should use better hash map
   static std::map<Int_t, AliPIDResponse *> pidAll;        /// we should use better hash map
+  static std::map<Int_t, std::vector<Double_t> > bbTable; /// tabulated Bethe-Bloch per PID hash (see BetheBlochAlephTabulated)
   //  TTree interface for interactive queries
   static Bool_t SetFilteredTree(TTree * filteredTree); /// set variable address in filtered trees
   static Bool_t SetFilteredTreeV0(TTree * filteredTreeV0); /// set variable address in filtered trees
@@ -85,6 +107,9 @@ public:
   static void UnitTest();                       /// unit test of invariants
 private:
   static AliESDtrack  dummyTrack;     /// dummy value to save CPU - unfortunately PID object use AliVtrack - for the moment create global varaible t avoid object constructions
+  static Int_t        fBBTableNPoints; /// number of points of the Bethe-Bloch tables
+  static Double_t     fBBTableLogMin;  /// log(bg) of the first point of the Bethe-Bloch tables
+  static Double_t     fBBTableLogMax;  /// log(bg) of the last point of the Bethe-Bloch tables
 
 };
 
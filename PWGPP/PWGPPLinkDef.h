@@ -96,6 +96,7 @@
 #pragma link C++ class AliAnalysisTaskFilteredTree+;
 #pragma link C++ class AliFilteredTreeEventCuts+;
 #pragma link C++ class AliFilteredTreeAcceptanceCuts+;
+#pragma link C++ class AliFilteredTreeWriter+;
 
 #pragma link C++ class AliTaskConfigOCDB+;
 
@@ -0,0 +1,317 @@
+/**************************************************************************
+ * Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ *                                                                        *
+ * Author: The ALICE Off-line Project.                                    *
+ * Contributors are mentioned in the code where appropriate.              *
+ *                                                                        *
+ * Permission to use, copy, modify and distribute this software and its   *
+ * documentation strictly for non-commercial purposes is hereby granted   *
+ * without fee, provided that the above copyright notice appears in all   *
+ * copies and that both the copyright notice and this permission notice   *
+ * appear in the supporting documentation. The authors make no claims     *
+ * about the suitability of this software for any purpose. It is          *
+ * provided "as is" without express or implied warranty.                  *
+ **************************************************************************/
+
+#include "AliAnalysisParallelDriver.h"
+#include "TChain.h"
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "THashList.h"
+#include "TClass.h"
+#include "TObjString.h"
+#include "TSystem.h"
+#include "TMath.h"
+#include "AliAnalysisManager.h"
+#include "AliAnalysisDataContainer.h"
+#include <RVersion.h>
+#include <vector>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,10,0) && !defined(_WIN32)
+#define RUN3_PARALLELDRIVER_PROCESSEXECUTOR
+#include <ROOT/TProcessExecutor.hxx>
+#include <ROOT/TSeq.hxx>
+#endif
+
+ClassImp(AliAnalysisParallelDriver)
+
+AliAnalysisParallelDriver::AliAnalysisParallelDriver()
+   :TObject(),
+    fManager(0),
+    fNWorkers(1),
+    fWorkDir(),
+    fKeepWorkerOutputs(kFALSE)
+{
+  /// constructor
+}
+
+AliAnalysisParallelDriver::AliAnalysisParallelDriver(AliAnalysisManager *mgr)
+   :TObject(),
+    fManager(mgr),
+    fNWorkers(1),
+    fWorkDir(),
+    fKeepWorkerOutputs(kFALSE)
+{
+  /// constructor, mgr has to be initialized (InitAnalysis()) before StartAnalysis()
+}
+
+Long64_t AliAnalysisParallelDriver::StartAnalysis(TTree *tree, Long64_t nentries, Long64_t firstentry)
+{
+  /// Processes nentries entries of tree starting at firstentry (nentries < 0: all)
+  /// with GetNWorkers() worker processes and merges their outputs.
+  /// Returns the number of processed entries, -1 in case of error.
+
+  if (!fManager || !tree) {
+    Error("StartAnalysis", "No analysis manager or no input tree");
+    return -1;
+  }
+
+  Long64_t nTotal = tree->GetEntries();
+  if (firstentry < 0) firstentry = 0;
+  if (nentries < 0 || firstentry + nentries > nTotal) nentries = nTotal - firstentry;
+  if (nentries <= 0) {
+    Error("StartAnalysis", "No entries to process");
+    return -1;
+  }
+
+  Int_t nWorkers = (Int_t) TMath::Min((Long64_t) fNWorkers, nentries);
+#ifndef RUN3_PARALLELDRIVER_PROCESSEXECUTOR
+  if (nWorkers > 1) {
+    Warning("StartAnalysis", "Worker processes not supported with this ROOT version, running serially");
+    nWorkers = 1;
+  }
+#endif
+  if (nWorkers <= 1)
+    return fManager->StartAnalysis("local", tree, nentries, firstentry);
+
+  if (fWorkDir.IsNull())
+    fWorkDir = Form("%s/AliAnalysisParallelDriver_%d", gSystem->TempDirectory(), gSystem->GetPid());
+  for (Int_t i=0; i<nWorkers; i++)
+    gSystem->mkdir(GetWorkerDir(i), kTRUE);
+
+  Info("StartAnalysis", "Processing %lld entries with %d workers, outputs in %s", nentries, nWorkers, fWorkDir.Data());
+
+  Long64_t nProcessed = 0;
+  Bool_t failed = kFALSE;
+#ifdef RUN3_PARALLELDRIVER_PROCESSEXECUTOR
+  // disjoint and contiguous entry ranges, one per worker
+  ROOT::TProcessExecutor pool(nWorkers);
+  auto processOneRange = [&](Int_t iWorker) {
+    Long64_t first = firstentry + nentries * iWorker / nWorkers;
+    Long64_t last  = firstentry + nentries * (iWorker + 1) / nWorkers;
+    return ProcessRange(iWorker, tree, last - first, first);
+  };
+  std::vector<Long64_t> workerResults = pool.Map(processOneRange, ROOT::TSeqI(nWorkers));
+  // a worker which died returns no result, its entries are missing
+  if (workerResults.size() != (size_t) nWorkers) {
+    Error("StartAnalysis", "%d results from %d workers", (Int_t) workerResults.size(), nWorkers);
+    failed = kTRUE;
+  }
+  for (Int_t i=0; i<(Int_t) workerResults.size(); i++) {
+    if (workerResults[i] < 0) {
+      Error("StartAnalysis", "Worker %d failed", i);
+      failed = kTRUE;
+    }
+    else
+      nProcessed += workerResults[i];
+  }
+#endif
+
+  if (!MergeOutputs(nWorkers))
+    failed = kTRUE;
+
+  if (!fKeepWorkerOutputs) {
+    TIter next(fManager->GetOutputs());
+    AliAnalysisDataContainer *output;
+    for (Int_t i=0; i<nWorkers; i++) {
+      next.Reset();
+      while ((output = (AliAnalysisDataContainer*) next())) {
+        TString fileName = output->GetFileName();
+        fileName = fileName(0, fileName.Index(":") < 0 ? fileName.Length() : fileName.Index(":"));
+        TString path = Form("%s/%s", GetWorkerDir(i).Data(), fileName.Data());
+        if (!gSystem->AccessPathName(path))
+          gSystem->Unlink(path);
+      }
+      gSystem->Unlink(GetWorkerDir(i));
+    }
+    gSystem->Unlink(fWorkDir);
+  }
+
+  return failed ? -1 : nProcessed;
+}
+
+TString AliAnalysisParallelDriver::GetWorkerDir(Int_t iWorker) const
+{
+  /// directory for the output files of worker iWorker
+  return Form("%s/worker%d", fWorkDir.Data(), iWorker);
+}
+
+Long64_t AliAnalysisParallelDriver::ProcessRange(Int_t iWorker, TTree *tree, Long64_t nentries, Long64_t firstentry)
+{
+  /// Runs in the worker process: processes the entry range with the copy of the
+  /// manager and writes the outputs to the worker directory.
+
+  // own chain, the files opened by the parent must not be shared between processes
+  TChain *chain = new TChain(tree->GetName());
+  if (tree->InheritsFrom(TChain::Class()))
+    chain->Add((TChain*) tree);
+  else if (tree->GetCurrentFile())
+    chain->Add(tree->GetCurrentFile()->GetName());
+  else {
+    Error("ProcessRange", "Worker %d: tree %s is not attached to a file", iWorker, tree->GetName());
+    return -1;
+  }
+
+  // outputs go to the worker directory, Terminate() is skipped (also after the merging)
+  TIter next(fManager->GetOutputs());
+  AliAnalysisDataContainer *output;
+  while ((output = (AliAnalysisDataContainer*) next())) {
+    TString fileName = output->GetFileName();
+    if (fileName.IsNull() || fileName == "default") continue;
+    output->SetFileName(Form("%s/%s", GetWorkerDir(iWorker).Data(), fileName.Data()));
+  }
+  fManager->SetSkipTerminate(kTRUE);
+
+  if (fManager->StartAnalysis("local", chain, nentries, firstentry) < 0)
+    return -1;
+  return nentries;
+}
+
+Bool_t AliAnalysisParallelDriver::MergeOutputs(Int_t nWorkers)
+{
+  /// Merges the output files of the workers into the output files of the manager
+
+  TList fileNames;
+  fileNames.SetOwner(kTRUE);
+  TIter next(fManager->GetOutputs());
+  AliAnalysisDataContainer *output;
+  while ((output = (AliAnalysisDataContainer*) next())) {
+    TString fileName = output->GetFileName();
+    if (fileName.IsNull() || fileName == "default") continue;
+    fileName = fileName(0, fileName.Index(":") < 0 ? fileName.Length() : fileName.Index(":"));
+    if (!fileNames.FindObject(fileName)) fileNames.Add(new TObjString(fileName));
+  }
+
+  Bool_t ok = kTRUE;
+  TIter nextFile(&fileNames);
+  TObjString *fileName;
+  while ((fileName = (TObjString*) nextFile())) {
+    TList sources;
+    for (Int_t i=0; i<nWorkers; i++) {
+      TString path = Form("%s/%s", GetWorkerDir(i).Data(), fileName->GetName());
+      if (gSystem->AccessPathName(path)) {
+        Error("MergeOutputs", "No output %s from worker %d", fileName->GetName(), i);
+        ok = kFALSE;
+        continue;
+      }
+      TFile *source = TFile::Open(path);
+      if (!source || source->IsZombie()) {
+        Error("MergeOutputs", "Cannot open %s", path.Data());
+        delete source;
+        ok = kFALSE;
+        continue;
+      }
+      sources.Add(source);
+    }
+    if (!sources.GetEntries()) continue;
+
+    TFile *target = TFile::Open(fileName->GetName(), "RECREATE");
+    if (!target || target->IsZombie()) {
+      Error("MergeOutputs", "Cannot create %s", fileName->GetName());
+      delete target;
+      sources.Delete();
+      ok = kFALSE;
+      continue;
+    }
+    if (!MergeDirectory(target, &sources))
+      ok = kFALSE;
+    target->Close();
+    delete target;
+
+    TIter nextSource(&sources);
+    TFile *source;
+    while ((source = (TFile*) nextSource()))
+      source->Close();
+    sources.Delete();
+
+    Info("MergeOutputs", "Merged %s", fileName->GetName());
+  }
+
+  return ok;
+}
+
+Bool_t AliAnalysisParallelDriver::MergeDirectory(TDirectory *target, TList *sources)
+{
+  /// Merges the objects of the directories in sources key by key with their Merge()
+  /// and writes them to target, subdirectories are merged recursively.
+  /// All the keys found in any of the sources are merged, an object missing in
+  /// some of the sources is merged from the others.
+
+  Bool_t ok = kTRUE;
+  THashList merged;
+  merged.SetOwner(kTRUE);
+  TIter nextSource(sources);
+  TDirectory *source;
+  while ((source = (TDirectory*) nextSource())) {
+    TIter nextKey(source->GetListOfKeys());
+    TKey *key;
+    while ((key = (TKey*) nextKey())) {
+      // only the highest cycle of each key, once over all the sources
+      if (merged.FindObject(key->GetName())) continue;
+      merged.Add(new TObjString(key->GetName()));
+
+      TClass *cl = TClass::GetClass(key->GetClassName());
+      if (cl && cl->InheritsFrom(TDirectory::Class())) {
+        TDirectory *subTarget = target->mkdir(key->GetName());
+        TList subSources;
+        TIter nextSubSource(sources);
+        TDirectory *other;
+        while ((other = (TDirectory*) nextSubSource())) {
+          TDirectory *subSource = other->GetDirectory(key->GetName());
+          if (subSource) subSources.Add(subSource);
+        }
+        if (!MergeDirectory(subTarget, &subSources))
+          ok = kFALSE;
+        continue;
+      }
+      if (cl && cl->InheritsFrom(TTree::Class())) {
+        Error("MergeDirectory", "Tree %s is not merged, it is missing in the merged output", key->GetName());
+        ok = kFALSE;
+        continue;
+      }
+
+      TObject *obj = key->ReadObj();
+      if (!obj) {
+        Error("MergeDirectory", "Cannot read %s from %s", key->GetName(), source->GetPath());
+        ok = kFALSE;
+        continue;
+      }
+
+      // the sources before this one do not have the key
+      TList others;
+      TIter nextOther(sources);
+      while (nextOther() != source) {}
+      TDirectory *other;
+      while ((other = (TDirectory*) nextOther())) {
+        TObject *otherObj = other->Get(key->GetName());
+        if (otherObj) others.Add(otherObj);
+      }
+
+      if (others.GetEntries()) {
+        ROOT::MergeFunc_t merge = obj->IsA()->GetMerge();
+        if (merge)
+          merge(obj, &others, 0);
+        else {
+          Warning("MergeDirectory", "No Merge() for %s (%s), only one worker is kept", key->GetName(), obj->ClassName());
+          ok = kFALSE;
+        }
+      }
+
+      target->WriteTObject(obj, key->GetName());
+      others.Delete();
+      delete obj;
+    }
+  }
+
+  return ok;
+}
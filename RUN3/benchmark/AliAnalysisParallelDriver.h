@@ -0,0 +1,66 @@
+/* Copyright(c) 1998-1999, ALICE Experiment at CERN, All rights reserved. *
+ * See cxx source for full Copyright notice                               */
+
+/// \class AliAnalysisParallelDriver
+///
+/// Runs the configured analysis manager in local mode on several cores of one node.
+/// The entries of the chain are split into disjoint ranges, each range is processed
+/// by a forked copy of the manager (with the same task list) and the outputs of the
+/// workers are merged in memory with the Merge() of each output object, key by key
+/// as hadd would do, into the output files of the manager.
+///
+/// Usage, after mgr->InitAnalysis():
+///
+///     AliAnalysisParallelDriver driver(mgr);
+///     driver.SetNWorkers(8);
+///     driver.StartAnalysis(chain);
+///
+/// The manager is a singleton and the tasks are not thread safe, therefore the workers
+/// are processes (ROOT::TProcessExecutor) and not threads. The Terminate() of the tasks
+/// is not called, as for outputs merged on the grid. Only the output containers
+/// (AliAnalysisManager::kOutputContainer) are merged. Trees are not merged, an output
+/// containing a tree makes StartAnalysis() fail (-1) with the tree missing in the merged file.
+
+#ifndef ALIANALYSISPARALLELDRIVER_H
+#define ALIANALYSISPARALLELDRIVER_H
+
+#include <TObject.h>
+#include <TString.h>
+
+class TTree;
+class TList;
+class TDirectory;
+class AliAnalysisManager;
+
+class AliAnalysisParallelDriver : public TObject {
+ public:
+    AliAnalysisParallelDriver();
+    AliAnalysisParallelDriver(AliAnalysisManager *mgr);
+    virtual ~AliAnalysisParallelDriver() {}
+
+    void     SetNWorkers(Int_t nWorkers)          { fNWorkers = nWorkers; }
+    void     SetWorkDir(const char *dir)          { fWorkDir = dir; }
+    void     SetKeepWorkerOutputs(Bool_t keep)    { fKeepWorkerOutputs = keep; }
+
+    Int_t    GetNWorkers() const                  { return fNWorkers; }
+
+    Long64_t StartAnalysis(TTree *tree, Long64_t nentries = -1, Long64_t firstentry = 0);
+
+ private:
+    AliAnalysisParallelDriver(const AliAnalysisParallelDriver&); // not implemented
+    AliAnalysisParallelDriver& operator=(const AliAnalysisParallelDriver&); // not implemented
+
+    TString  GetWorkerDir(Int_t iWorker) const;
+    Long64_t ProcessRange(Int_t iWorker, TTree *tree, Long64_t nentries, Long64_t firstentry);
+    Bool_t   MergeOutputs(Int_t nWorkers);
+    Bool_t   MergeDirectory(TDirectory *target, TList *sources);
+
+    AliAnalysisManager *fManager;    // configured analysis manager (not owned)
+    Int_t    fNWorkers;              // number of worker processes
+    TString  fWorkDir;               // directory for the worker outputs (default: temp directory)
+    Bool_t   fKeepWorkerOutputs;     // do not delete the worker outputs after merging
+
+    ClassDef(AliAnalysisParallelDriver, 1); // local event-range parallel analysis
+};
+
+#endif